@@ -64,6 +64,43 @@ AC_DEFUN([AX_LIBEWF_CHECK_LOCAL],
   dnl Check for internationalization functions in libewf/libewf_i18n.c 
   AC_CHECK_FUNCS([bindtextdomain])
 
+  dnl Headers and functions used in libewf/libewf_index_file.c
+  AC_CHECK_HEADERS([sys/stat.h])
+  AC_CHECK_FUNCS([stat])
+
+  dnl Headers and functions used in libewf/libewf_mmap_file_io_handle.c
+  AC_CHECK_HEADERS([errno.h fcntl.h sys/mman.h unistd.h])
+  AC_CHECK_FUNCS([madvise mmap munmap])
+
+  dnl Headers and functions used in libewf/libewf_segment_file.c
+  AC_CHECK_HEADERS([errno.h fcntl.h unistd.h])
+  AC_CHECK_FUNCS([fallocate ftruncate])
+
+  dnl Headers and library used in libewf/libewf_io_uring.c
+  AC_CHECK_HEADERS([liburing.h])
+
+  ac_cv_liburing=no
+
+  AS_IF(
+    [test "x$ac_cv_header_liburing_h" = xyes],
+    [AC_CHECK_LIB(
+      uring,
+      io_uring_queue_init,
+      [ac_cv_liburing=yes])
+  ])
+
+  AS_IF(
+    [test "x$ac_cv_liburing" = xyes],
+    [AC_DEFINE(
+      [HAVE_LIBURING],
+      [1],
+      [Define to 1 if you have the 'uring' library (-luring).])
+
+    AC_SUBST(
+      [LIBURING_LIBADD],
+      ["-luring"])
+  ])
+
   dnl Check if library should be build with verbose output
   AX_COMMON_CHECK_ENABLE_VERBOSE_OUTPUT
 
@@ -123,6 +160,10 @@ AC_DEFUN([AX_EWFTOOLS_CHECK_LOCAL],
       [1])
   ])
 
+  dnl Headers and functions used in ewftools/device_handle.c and ewftools/storage_media_buffer.c
+  AC_CHECK_HEADERS([fcntl.h])
+  AC_CHECK_FUNCS([posix_memalign pread])
+
   dnl Check if tools should be build as static executables
   AX_COMMON_CHECK_ENABLE_STATIC_EXECUTABLES
 
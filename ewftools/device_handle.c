@@ -19,6 +19,12 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#if defined( __linux__ ) && !defined( _GNU_SOURCE )
+/* O_DIRECT is only defined by fcntl.h on Linux if _GNU_SOURCE is defined
+ */
+#define _GNU_SOURCE
+#endif
+
 #include <common.h>
 #include <memory.h>
 #include <narrow_string.h>
@@ -26,17 +32,37 @@
 #include <types.h>
 #include <wide_string.h>
 
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
 #include "byte_size_string.h"
 #include "device_handle.h"
 #include "ewfinput.h"
 #include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 #include "ewftools_libodraw.h"
 #include "ewftools_libsmdev.h"
 #include "ewftools_libsmraw.h"
 #include "ewftools_system_string.h"
+#include "ewftools_unused.h"
 #include "storage_media_buffer.h"
 
+/* Direct IO requires O_DIRECT, positional reads and aligned buffers
+ */
+#if defined( HAVE_FCNTL_H ) && defined( HAVE_UNISTD_H ) && defined( HAVE_PREAD ) && defined( O_DIRECT ) && defined( memory_allocate_aligned ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#define HAVE_DEVICE_HANDLE_DIRECT_IO
+#endif
+
 #define DEVICE_HANDLE_INPUT_BUFFER_SIZE		64
 #define DEVICE_HANDLE_STRING_SIZE		1024
 #define DEVICE_HANDLE_VALUE_SIZE		512
@@ -179,8 +205,9 @@ int device_handle_initialize(
 
 		goto on_error;
 	}
-	( *device_handle )->number_of_error_retries = 2;
-	( *device_handle )->notify_stream           = DEVICE_HANDLE_NOTIFY_STREAM;
+	( *device_handle )->number_of_error_retries   = 2;
+	( *device_handle )->direct_io_file_descriptor = -1;
+	( *device_handle )->notify_stream             = DEVICE_HANDLE_NOTIFY_STREAM;
 
 	return( 1 );
 
@@ -223,6 +250,22 @@ int device_handle_free(
 	}
 	if( *device_handle != NULL )
 	{
+		if( ( *device_handle )->direct_io_file_descriptor != -1 )
+		{
+			if( device_handle_close_direct_io_input(
+			     *device_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close direct IO input.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 ( *device_handle )->input_buffer );
 
@@ -465,6 +508,10 @@ int device_handle_open_input(
 	}
 	else if( device_handle->type == DEVICE_HANDLE_TYPE_OPTICAL_DISC_FILE )
 	{
+		/* Direct IO is only supported for devices
+		 */
+		device_handle->use_direct_io = 0;
+
 		if( device_handle_open_odraw_input(
 		     device_handle,
 		     filenames,
@@ -483,6 +530,8 @@ int device_handle_open_input(
 	}
 	else if( device_handle->type == DEVICE_HANDLE_TYPE_FILE )
 	{
+		device_handle->use_direct_io = 0;
+
 		if( device_handle_open_smraw_input(
 		     device_handle,
 		     filenames,
@@ -512,6 +561,7 @@ int device_handle_open_smdev_input(
      libcerror_error_t **error )
 {
 	static char *function = "device_handle_open_smdev_input";
+	int result            = 0;
 
 	if( device_handle == NULL )
 	{
@@ -593,6 +643,31 @@ int device_handle_open_smdev_input(
 
 		goto on_error;
 	}
+	if( device_handle->use_direct_io != 0 )
+	{
+		result = device_handle_open_direct_io_input(
+		          device_handle,
+		          filenames[ 0 ],
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open direct IO input.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			/* The device is read using buffered IO if direct IO is not supported
+			 */
+			device_handle->use_direct_io = 0;
+		}
+	}
 	return( 1 );
 
 on_error:
@@ -913,6 +988,130 @@ on_error:
 	return( -1 );
 }
 
+/* Opens the direct IO input of the device handle
+ * The direct IO input is used to read the device without the page cache
+ * Returns 1 if successful, 0 if direct IO is not supported or -1 on error
+ */
+int device_handle_open_direct_io_input(
+     device_handle_t *device_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function     = "device_handle_open_direct_io_input";
+
+#if defined( HAVE_DEVICE_HANDLE_DIRECT_IO )
+	size64_t media_size       = 0;
+	uint32_t bytes_per_sector = 0;
+	int file_descriptor       = -1;
+#endif
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->direct_io_file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid device handle - direct IO file descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEVICE_HANDLE_DIRECT_IO )
+	if( libsmdev_handle_get_bytes_per_sector(
+	     device_handle->smdev_input_handle,
+	     &bytes_per_sector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( bytes_per_sector < 512 )
+	{
+		bytes_per_sector = 512;
+	}
+	/* The storage media buffers are not sufficiently aligned for larger sectors
+	 */
+	if( ( ( bytes_per_sector & ( bytes_per_sector - 1 ) ) != 0 )
+	 || ( bytes_per_sector > STORAGE_MEDIA_BUFFER_ALIGNMENT ) )
+	{
+		return( 0 );
+	}
+	if( libsmdev_handle_get_media_size(
+	     device_handle->smdev_input_handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	file_descriptor = open(
+	                   filename,
+	                   O_RDONLY | O_DIRECT );
+
+	if( file_descriptor == -1 )
+	{
+		/* The file system or device does not support direct IO
+		 */
+		if( errno == EINVAL )
+		{
+			return( 0 );
+		}
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	device_handle->direct_io_file_descriptor = file_descriptor;
+	device_handle->direct_io_alignment       = (size_t) bytes_per_sector;
+	device_handle->direct_io_offset          = 0;
+	device_handle->direct_io_media_size      = media_size;
+
+	return( 1 );
+#else
+	return( 0 );
+#endif /* defined( HAVE_DEVICE_HANDLE_DIRECT_IO ) */
+}
+
 /* Closes the device handle
  * Returns the 0 if succesful or -1 on error
  */
@@ -935,6 +1134,22 @@ int device_handle_close(
 	}
 	if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
 	{
+		if( device_handle->direct_io_file_descriptor != -1 )
+		{
+			if( device_handle_close_direct_io_input(
+			     device_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close direct IO input.",
+				 function );
+
+				return( -1 );
+			}
+		}
 		if( libsmdev_handle_close(
 		     device_handle->smdev_input_handle,
 		     error ) != 0 )
@@ -984,18 +1199,15 @@ int device_handle_close(
 	return( 0 );
 }
 
-/* Reads a storage media buffer from the input of the device handle
- * Returns the number of bytes written or -1 on error
+/* Closes the direct IO input of the device handle
+ * Returns the 0 if succesful or -1 on error
  */
-ssize_t device_handle_read_storage_media_buffer(
-         device_handle_t *device_handle,
-         storage_media_buffer_t *storage_media_buffer,
-         off64_t storage_media_offset,
-         size_t read_size,
-         libcerror_error_t **error )
+int device_handle_close_direct_io_input(
+     device_handle_t *device_handle,
+     libcerror_error_t **error )
 {
-	static char *function = "device_handle_read_storage_media_buffer";
-	ssize_t read_count    = 0;
+	static char *function = "device_handle_close_direct_io_input";
+	int result            = 0;
 
 	if( device_handle == NULL )
 	{
@@ -1008,105 +1220,109 @@ ssize_t device_handle_read_storage_media_buffer(
 
 		return( -1 );
 	}
-	if( storage_media_buffer == NULL )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( device_handle->read_ahead_thread_pool != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid storage media buffer.",
-		 function );
+		if( libcthreads_thread_pool_join(
+		     &( device_handle->read_ahead_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join read-ahead thread pool.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
+	if( device_handle->read_ahead_condition != NULL )
 	{
-		read_count = libsmdev_handle_read_buffer(
-			      device_handle->smdev_input_handle,
-			      storage_media_buffer->raw_buffer,
-			      read_size,
-		              error );
-
-		if( read_count < 0 )
+		if( libcthreads_condition_free(
+		     &( device_handle->read_ahead_condition ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read buffer from device input handle.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead condition.",
 			 function );
 
-			return( -1 );
+			result = -1;
 		}
 	}
-	else if( device_handle->type == DEVICE_HANDLE_TYPE_OPTICAL_DISC_FILE )
+	if( device_handle->read_ahead_mutex != NULL )
 	{
-		read_count = libodraw_handle_read_buffer(
-			      device_handle->odraw_input_handle,
-			      storage_media_buffer->raw_buffer,
-			      read_size,
-		              error );
-
-		if( read_count < 0 )
+		if( libcthreads_mutex_free(
+		     &( device_handle->read_ahead_mutex ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read buffer from optical disc raw input handle.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead mutex.",
 			 function );
 
-			return( -1 );
+			result = -1;
 		}
 	}
-	else if( device_handle->type == DEVICE_HANDLE_TYPE_FILE )
+	if( device_handle->read_ahead_buffer != NULL )
 	{
-		read_count = libsmraw_handle_read_buffer(
-			      device_handle->smraw_input_handle,
-			      storage_media_buffer->raw_buffer,
-			      read_size,
-		              error );
+		memory_free(
+		 device_handle->read_ahead_buffer );
 
-		if( read_count < 0 )
+		device_handle->read_ahead_buffer = NULL;
+	}
+	device_handle->read_ahead_buffer_size = 0;
+	device_handle->read_ahead_is_scheduled = 0;
+	device_handle->read_ahead_is_pending   = 0;
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( HAVE_DEVICE_HANDLE_DIRECT_IO )
+	if( device_handle->direct_io_file_descriptor != -1 )
+	{
+		if( close(
+		     device_handle->direct_io_file_descriptor ) != 0 )
 		{
-			libcerror_error_set(
+			libcerror_system_set_error(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read buffer from raw input handle.",
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to close direct IO file descriptor.",
 			 function );
 
-			return( -1 );
+			result = -1;
 		}
 	}
-	if( read_count < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read storage media buffer.",
-		 function );
+#endif /* defined( HAVE_DEVICE_HANDLE_DIRECT_IO ) */
 
-		return( -1 );
-	}
-	storage_media_buffer->storage_media_offset = storage_media_offset;
-	storage_media_buffer->requested_size       = read_size;
-	storage_media_buffer->raw_buffer_data_size = (size_t) read_count;
+	device_handle->direct_io_file_descriptor = -1;
 
-	return( read_count );
+	return( result );
 }
 
-/* Seeks the offset in the input file
- * Returns the new offset if successful or -1 on error
+/* Reads a buffer at a specific offset from the direct IO input of the device handle
+ * The buffer, offset and read size must be aligned to the direct IO alignment
+ * Returns the number of bytes read or -1 on error
  */
-off64_t device_handle_seek_offset(
+ssize_t device_handle_read_direct_io_buffer(
          device_handle_t *device_handle,
+         uint8_t *buffer,
          off64_t offset,
-         int whence,
+         size_t read_size,
          libcerror_error_t **error )
 {
-	static char *function = "device_handle_seek_offset";
+	static char *function = "device_handle_read_direct_io_buffer";
+
+#if defined( HAVE_DEVICE_HANDLE_DIRECT_IO )
+	size_t buffer_offset  = 0;
+	ssize_t read_count    = 0;
+#endif
 
 	if( device_handle == NULL )
 	{
@@ -1119,8 +1335,835 @@ off64_t device_handle_seek_offset(
 
 		return( -1 );
 	}
-	if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
+	if( device_handle->direct_io_file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid device handle - missing direct IO file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
 	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid read size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEVICE_HANDLE_DIRECT_IO )
+	while( buffer_offset < read_size )
+	{
+		read_count = pread(
+		              device_handle->direct_io_file_descriptor,
+		              &( buffer[ buffer_offset ] ),
+		              read_size - buffer_offset,
+		              (off_t) ( offset + buffer_offset ) );
+
+		if( read_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		/* The end of the device was reached
+		 */
+		if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_offset += (size_t) read_count;
+	}
+	return( (ssize_t) buffer_offset );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: direct IO not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_DEVICE_HANDLE_DIRECT_IO ) */
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Reads the scheduled read-ahead of the device handle
+ * Callback function for the read-ahead thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int device_handle_read_ahead_callback(
+     device_handle_t *device_handle,
+     void *arguments EWFTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "device_handle_read_ahead_callback";
+	ssize_t read_count       = 0;
+
+	EWFTOOLS_UNREFERENCED_PARAMETER( arguments )
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = device_handle_read_direct_io_buffer(
+	              device_handle,
+	              device_handle->read_ahead_buffer,
+	              device_handle->read_ahead_offset,
+	              device_handle->read_ahead_size,
+	              &error );
+
+	/* A failed read-ahead is read again by the device input handle
+	 * so that read errors are retried and tracked
+	 */
+	if( read_count == -1 )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( libcthreads_mutex_grab(
+	     device_handle->read_ahead_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	device_handle->read_ahead_count      = read_count;
+	device_handle->read_ahead_is_pending = 0;
+
+	if( libcthreads_condition_broadcast(
+	     device_handle->read_ahead_condition,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		libcthreads_mutex_release(
+		 device_handle->read_ahead_mutex,
+		 NULL );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     device_handle->read_ahead_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Waits for the scheduled read-ahead of the device handle to complete
+ * Returns 1 if successful or -1 on error
+ */
+int device_handle_wait_for_read_ahead(
+     device_handle_t *device_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "device_handle_wait_for_read_ahead";
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->read_ahead_mutex == NULL )
+	{
+		return( 1 );
+	}
+	if( libcthreads_mutex_grab(
+	     device_handle->read_ahead_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( device_handle->read_ahead_is_pending != 0 )
+	{
+		if( libcthreads_condition_wait(
+		     device_handle->read_ahead_condition,
+		     device_handle->read_ahead_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 device_handle->read_ahead_mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     device_handle->read_ahead_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Schedules a read-ahead of the direct IO input of the device handle
+ * The read-ahead is read into a separate buffer of buffer size, while the previous buffer is being processed
+ * Returns 1 if successful or -1 on error
+ */
+int device_handle_schedule_read_ahead(
+     device_handle_t *device_handle,
+     off64_t offset,
+     size_t read_size,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "device_handle_schedule_read_ahead";
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->read_ahead_is_scheduled != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid device handle - read-ahead already scheduled.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size > buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->read_ahead_thread_pool == NULL )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( device_handle->read_ahead_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read-ahead mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcthreads_condition_initialize(
+		     &( device_handle->read_ahead_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read-ahead condition.",
+			 function );
+
+			return( -1 );
+		}
+		/* A single read is kept in flight
+		 */
+		if( libcthreads_thread_pool_create(
+		     &( device_handle->read_ahead_thread_pool ),
+		     NULL,
+		     1,
+		     1,
+		     (int (*)(intptr_t *, void *)) &device_handle_read_ahead_callback,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize read-ahead thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( device_handle->read_ahead_buffer_size != buffer_size )
+	{
+		if( device_handle->read_ahead_buffer != NULL )
+		{
+			memory_free(
+			 device_handle->read_ahead_buffer );
+
+			device_handle->read_ahead_buffer      = NULL;
+			device_handle->read_ahead_buffer_size = 0;
+		}
+		/* The read-ahead buffer is exchanged with the raw buffer of a storage media buffer
+		 * hence it is allocated in the same way
+		 */
+#if defined( memory_allocate_aligned )
+		if( memory_allocate_aligned(
+		     (void **) &( device_handle->read_ahead_buffer ),
+		     buffer_size,
+		     STORAGE_MEDIA_BUFFER_ALIGNMENT ) != 0 )
+		{
+			device_handle->read_ahead_buffer = NULL;
+		}
+#else
+		device_handle->read_ahead_buffer = (uint8_t *) memory_allocate(
+		                                                sizeof( uint8_t ) * buffer_size );
+#endif
+		if( device_handle->read_ahead_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create read-ahead buffer.",
+			 function );
+
+			return( -1 );
+		}
+		device_handle->read_ahead_buffer_size = buffer_size;
+	}
+	device_handle->read_ahead_offset     = offset;
+	device_handle->read_ahead_size       = read_size;
+	device_handle->read_ahead_count      = 0;
+	device_handle->read_ahead_is_pending = 1;
+
+	if( libcthreads_thread_pool_push(
+	     device_handle->read_ahead_thread_pool,
+	     (intptr_t *) device_handle,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push read-ahead onto thread pool queue.",
+		 function );
+
+		device_handle->read_ahead_is_pending = 0;
+
+		return( -1 );
+	}
+	device_handle->read_ahead_is_scheduled = 1;
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Reads a storage media buffer from the direct IO input of the device handle
+ * Reads that are not aligned or that fail are read by the device input handle
+ * so that read errors are retried and tracked
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t device_handle_read_direct_io_storage_media_buffer(
+         device_handle_t *device_handle,
+         storage_media_buffer_t *storage_media_buffer,
+         size_t read_size,
+         libcerror_error_t **error )
+{
+	libcerror_error_t *direct_io_error = NULL;
+	static char *function              = "device_handle_read_direct_io_storage_media_buffer";
+	off64_t offset                     = 0;
+	ssize_t read_count                 = -1;
+	uint8_t is_aligned                 = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	uint8_t *raw_buffer                = NULL;
+	size_t read_ahead_size             = 0;
+#endif
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->direct_io_alignment == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid device handle - direct IO alignment value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_size > storage_media_buffer->raw_buffer_size )
+	 || ( read_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	offset = device_handle->direct_io_offset;
+
+	if( ( ( (size64_t) offset % device_handle->direct_io_alignment ) == 0 )
+	 && ( ( read_size % device_handle->direct_io_alignment ) == 0 )
+	 && ( ( (intptr_t) storage_media_buffer->raw_buffer % device_handle->direct_io_alignment ) == 0 ) )
+	{
+		is_aligned = 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( device_handle->read_ahead_is_scheduled != 0 )
+	{
+		if( device_handle_wait_for_read_ahead(
+		     device_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for read-ahead.",
+			 function );
+
+			return( -1 );
+		}
+		device_handle->read_ahead_is_scheduled = 0;
+
+		/* The buffers are exchanged instead of copying the data read ahead
+		 */
+		if( ( is_aligned != 0 )
+		 && ( device_handle->read_ahead_offset == offset )
+		 && ( device_handle->read_ahead_size == read_size )
+		 && ( device_handle->read_ahead_count == (ssize_t) read_size )
+		 && ( device_handle->read_ahead_buffer_size == storage_media_buffer->raw_buffer_size ) )
+		{
+			raw_buffer = storage_media_buffer->raw_buffer;
+
+			storage_media_buffer->raw_buffer = device_handle->read_ahead_buffer;
+			device_handle->read_ahead_buffer = raw_buffer;
+
+			read_count = (ssize_t) read_size;
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	if( ( read_count == -1 )
+	 && ( is_aligned != 0 ) )
+	{
+		read_count = device_handle_read_direct_io_buffer(
+		              device_handle,
+		              storage_media_buffer->raw_buffer,
+		              offset,
+		              read_size,
+		              &direct_io_error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_free(
+			 &direct_io_error );
+		}
+	}
+	if( read_count == -1 )
+	{
+		if( libsmdev_handle_seek_offset(
+		     device_handle->smdev_input_handle,
+		     offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in device input handle.",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		read_count = libsmdev_handle_read_buffer(
+			      device_handle->smdev_input_handle,
+			      storage_media_buffer->raw_buffer,
+			      read_size,
+			      error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from device input handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	device_handle->direct_io_offset += read_count;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Read the next buffer while the current buffer is being processed
+	 */
+	if( ( is_aligned != 0 )
+	 && ( read_count == (ssize_t) read_size )
+	 && ( read_size > 0 )
+	 && ( (size64_t) device_handle->direct_io_offset < device_handle->direct_io_media_size ) )
+	{
+		read_ahead_size = read_size;
+
+		if( read_ahead_size > ( device_handle->direct_io_media_size - device_handle->direct_io_offset ) )
+		{
+			read_ahead_size = (size_t) ( device_handle->direct_io_media_size - device_handle->direct_io_offset );
+		}
+		if( ( read_ahead_size % device_handle->direct_io_alignment ) == 0 )
+		{
+			if( device_handle_schedule_read_ahead(
+			     device_handle,
+			     device_handle->direct_io_offset,
+			     read_ahead_size,
+			     storage_media_buffer->raw_buffer_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to schedule read-ahead.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( read_count );
+}
+
+/* Reads a storage media buffer from the input of the device handle
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t device_handle_read_storage_media_buffer(
+         device_handle_t *device_handle,
+         storage_media_buffer_t *storage_media_buffer,
+         off64_t storage_media_offset,
+         size_t read_size,
+         libcerror_error_t **error )
+{
+	static char *function = "device_handle_read_storage_media_buffer";
+	ssize_t read_count    = 0;
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
+	{
+		if( device_handle->direct_io_file_descriptor != -1 )
+		{
+			read_count = device_handle_read_direct_io_storage_media_buffer(
+				      device_handle,
+				      storage_media_buffer,
+				      read_size,
+				      error );
+		}
+		else
+		{
+			read_count = libsmdev_handle_read_buffer(
+				      device_handle->smdev_input_handle,
+				      storage_media_buffer->raw_buffer,
+				      read_size,
+				      error );
+		}
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from device input handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( device_handle->type == DEVICE_HANDLE_TYPE_OPTICAL_DISC_FILE )
+	{
+		read_count = libodraw_handle_read_buffer(
+			      device_handle->odraw_input_handle,
+			      storage_media_buffer->raw_buffer,
+			      read_size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from optical disc raw input handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( device_handle->type == DEVICE_HANDLE_TYPE_FILE )
+	{
+		read_count = libsmraw_handle_read_buffer(
+			      device_handle->smraw_input_handle,
+			      storage_media_buffer->raw_buffer,
+			      read_size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from raw input handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	storage_media_buffer->storage_media_offset = storage_media_offset;
+	storage_media_buffer->requested_size       = read_size;
+	storage_media_buffer->raw_buffer_data_size = (size_t) read_count;
+
+	return( read_count );
+}
+
+/* Seeks the offset in the input file
+ * Returns the new offset if successful or -1 on error
+ */
+off64_t device_handle_seek_offset(
+         device_handle_t *device_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "device_handle_seek_offset";
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
+	{
+		if( device_handle->direct_io_file_descriptor != -1 )
+		{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			/* A pending read-ahead is discarded
+			 */
+			if( device_handle_wait_for_read_ahead(
+			     device_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for read-ahead.",
+				 function );
+
+				return( -1 );
+			}
+			device_handle->read_ahead_is_scheduled = 0;
+#endif
+			/* The offset of the device input handle is not updated by direct IO reads
+			 */
+			if( whence == SEEK_CUR )
+			{
+				offset += device_handle->direct_io_offset;
+				whence  = SEEK_SET;
+			}
+		}
 		offset = libsmdev_handle_seek_offset(
 		          device_handle->smdev_input_handle,
 		          offset,
@@ -1138,6 +2181,7 @@ off64_t device_handle_seek_offset(
 
 			return( -1 );
 		}
+		device_handle->direct_io_offset = offset;
 	}
 	else if( device_handle->type == DEVICE_HANDLE_TYPE_OPTICAL_DISC_FILE )
 	{
@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
 #include "ewftools_libodraw.h"
 #include "ewftools_libsmdev.h"
 #include "ewftools_libsmraw.h"
@@ -111,6 +112,72 @@ struct device_handle
 	 */
 	uint8_t zero_buffer_on_error;
 
+	/* Value to indicate the device should be read using direct IO
+	 * bypassing the page cache of the operating system
+	 */
+	uint8_t use_direct_io;
+
+	/* The direct IO file descriptor
+	 * Contains -1 if the device is not read using direct IO
+	 */
+	int direct_io_file_descriptor;
+
+	/* The direct IO alignment
+	 */
+	size_t direct_io_alignment;
+
+	/* The current direct IO offset
+	 */
+	off64_t direct_io_offset;
+
+	/* The media size
+	 */
+	size64_t direct_io_media_size;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The read-ahead thread pool
+	 * Contains NULL until the first direct IO read
+	 */
+	libcthreads_thread_pool_t *read_ahead_thread_pool;
+
+	/* The mutex protecting the read-ahead values
+	 */
+	libcthreads_mutex_t *read_ahead_mutex;
+
+	/* The condition signalled when the read-ahead completes
+	 */
+	libcthreads_condition_t *read_ahead_condition;
+
+	/* The read-ahead buffer
+	 */
+	uint8_t *read_ahead_buffer;
+
+	/* The read-ahead buffer size
+	 */
+	size_t read_ahead_buffer_size;
+
+	/* The read-ahead offset
+	 */
+	off64_t read_ahead_offset;
+
+	/* The read-ahead size
+	 */
+	size_t read_ahead_size;
+
+	/* The number of bytes read by the read-ahead
+	 * Contains -1 if the read-ahead failed
+	 */
+	ssize_t read_ahead_count;
+
+	/* Value to indicate a read-ahead was scheduled
+	 */
+	uint8_t read_ahead_is_scheduled;
+
+	/* Value to indicate the read-ahead is pending
+	 */
+	uint8_t read_ahead_is_pending;
+#endif
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -155,10 +222,51 @@ int device_handle_open_smraw_input(
      int number_of_filenames,
      libcerror_error_t **error );
 
+int device_handle_open_direct_io_input(
+     device_handle_t *device_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
 int device_handle_close(
      device_handle_t *device_handle,
      libcerror_error_t **error );
 
+int device_handle_close_direct_io_input(
+     device_handle_t *device_handle,
+     libcerror_error_t **error );
+
+ssize_t device_handle_read_direct_io_buffer(
+         device_handle_t *device_handle,
+         uint8_t *buffer,
+         off64_t offset,
+         size_t read_size,
+         libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int device_handle_read_ahead_callback(
+     device_handle_t *device_handle,
+     void *arguments );
+
+int device_handle_wait_for_read_ahead(
+     device_handle_t *device_handle,
+     libcerror_error_t **error );
+
+int device_handle_schedule_read_ahead(
+     device_handle_t *device_handle,
+     off64_t offset,
+     size_t read_size,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+ssize_t device_handle_read_direct_io_storage_media_buffer(
+         device_handle_t *device_handle,
+         storage_media_buffer_t *storage_media_buffer,
+         size_t read_size,
+         libcerror_error_t **error );
+
 ssize_t device_handle_read_storage_media_buffer(
          device_handle_t *device_handle,
          storage_media_buffer_t *storage_media_buffer,
@@ -0,0 +1,564 @@
+/*
+ * Digest hash pool functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_hash_pool.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a digest hash pool
+ * A thread is started for every digest context that is not NULL
+ * Make sure the value pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_pool_create(
+     digest_hash_pool_t **pool,
+     libhmac_md5_context_t *md5_context,
+     libhmac_sha1_context_t *sha1_context,
+     libhmac_sha256_context_t *sha256_context,
+     libcthreads_queue_t *storage_media_buffer_queue,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_pool_create";
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer queue.",
+		 function );
+
+		return( -1 );
+	}
+	*pool = memory_allocate_structure(
+	         digest_hash_pool_t );
+
+	if( *pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *pool,
+	     0,
+	     sizeof( digest_hash_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear pool.",
+		 function );
+
+		memory_free(
+		 *pool );
+
+		*pool = NULL;
+
+		return( -1 );
+	}
+	( *pool )->md5_context                = md5_context;
+	( *pool )->sha1_context               = sha1_context;
+	( *pool )->sha256_context             = sha256_context;
+	( *pool )->storage_media_buffer_queue = storage_media_buffer_queue;
+
+	/* Every digest hash is calculated by a single thread so that
+	 * the storage media buffers are hashed in the order they are pushed
+	 */
+	if( md5_context != NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( ( *pool )->md5_thread_pool ),
+		     NULL,
+		     1,
+		     maximum_number_of_queued_items,
+		     (int (*)(intptr_t *, void *)) &digest_hash_pool_md5_callback,
+		     (void *) *pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create MD5 thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( sha1_context != NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( ( *pool )->sha1_thread_pool ),
+		     NULL,
+		     1,
+		     maximum_number_of_queued_items,
+		     (int (*)(intptr_t *, void *)) &digest_hash_pool_sha1_callback,
+		     (void *) *pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create SHA1 thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( sha256_context != NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( ( *pool )->sha256_thread_pool ),
+		     NULL,
+		     1,
+		     maximum_number_of_queued_items,
+		     (int (*)(intptr_t *, void *)) &digest_hash_pool_sha256_callback,
+		     (void *) *pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create SHA256 thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *pool != NULL )
+	{
+		digest_hash_pool_join(
+		 pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Waits for the digest hash threads to finish and frees the digest hash pool
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_pool_join(
+     digest_hash_pool_t **pool,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_pool_join";
+	int result            = 1;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *pool != NULL )
+	{
+		if( ( *pool )->md5_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *pool )->md5_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join MD5 thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *pool )->sha1_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *pool )->sha1_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join SHA1 thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *pool )->sha256_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *pool )->sha256_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join SHA256 thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( ( *pool )->md5_update_failed != 0 )
+		 || ( ( *pool )->sha1_update_failed != 0 )
+		 || ( ( *pool )->sha256_update_failed != 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest hash(es).",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *pool );
+
+		*pool = NULL;
+	}
+	return( result );
+}
+
+/* Updates a digest hash with the data of a storage media buffer
+ * The reference to the storage media buffer is released afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_pool_update(
+     digest_hash_pool_t *pool,
+     storage_media_buffer_t *storage_media_buffer,
+     int digest_type )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t *data            = NULL;
+	static char *function    = "digest_hash_pool_update";
+	size_t data_size         = 0;
+	int result               = 0;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( storage_media_buffer_get_data(
+	     storage_media_buffer,
+	     &data,
+	     &data_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine storage media buffer data.",
+		 function );
+
+		goto on_error;
+	}
+	/* Once a digest hash failed to update the remaining buffers are only released
+	 */
+	switch( digest_type )
+	{
+		case DIGEST_HASH_POOL_DIGEST_TYPE_MD5:
+			if( pool->md5_update_failed == 0 )
+			{
+				result = libhmac_md5_update(
+				          pool->md5_context,
+				          data,
+				          data_size,
+				          &error );
+
+				if( result != 1 )
+				{
+					pool->md5_update_failed = 1;
+				}
+			}
+			break;
+
+		case DIGEST_HASH_POOL_DIGEST_TYPE_SHA1:
+			if( pool->sha1_update_failed == 0 )
+			{
+				result = libhmac_sha1_update(
+				          pool->sha1_context,
+				          data,
+				          data_size,
+				          &error );
+
+				if( result != 1 )
+				{
+					pool->sha1_update_failed = 1;
+				}
+			}
+			break;
+
+		case DIGEST_HASH_POOL_DIGEST_TYPE_SHA256:
+			if( pool->sha256_update_failed == 0 )
+			{
+				result = libhmac_sha256_update(
+				          pool->sha256_context,
+				          data,
+				          data_size,
+				          &error );
+
+				if( result != 1 )
+				{
+					pool->sha256_update_failed = 1;
+				}
+			}
+			break;
+
+		default:
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported digest type.",
+			 function );
+
+			goto on_error;
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update digest hash.",
+		 function );
+
+		goto on_error;
+	}
+	if( storage_media_buffer_queue_release_buffer(
+	     pool->storage_media_buffer_queue,
+	     storage_media_buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to release storage media buffer onto queue.",
+		 function );
+
+		storage_media_buffer = NULL;
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( ( pool != NULL )
+	 && ( storage_media_buffer != NULL ) )
+	{
+		storage_media_buffer_queue_release_buffer(
+		 pool->storage_media_buffer_queue,
+		 storage_media_buffer,
+		 NULL );
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Updates the MD5 digest hash with the data of a storage media buffer
+ * Callback function for the MD5 thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_pool_md5_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     digest_hash_pool_t *pool )
+{
+	return( digest_hash_pool_update(
+	         pool,
+	         storage_media_buffer,
+	         DIGEST_HASH_POOL_DIGEST_TYPE_MD5 ) );
+}
+
+/* Updates the SHA1 digest hash with the data of a storage media buffer
+ * Callback function for the SHA1 thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_pool_sha1_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     digest_hash_pool_t *pool )
+{
+	return( digest_hash_pool_update(
+	         pool,
+	         storage_media_buffer,
+	         DIGEST_HASH_POOL_DIGEST_TYPE_SHA1 ) );
+}
+
+/* Updates the SHA256 digest hash with the data of a storage media buffer
+ * Callback function for the SHA256 thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_pool_sha256_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     digest_hash_pool_t *pool )
+{
+	return( digest_hash_pool_update(
+	         pool,
+	         storage_media_buffer,
+	         DIGEST_HASH_POOL_DIGEST_TYPE_SHA256 ) );
+}
+
+/* Pushes a storage media buffer onto the thread pool of every digest hash
+ * A reference to the storage media buffer is added for every digest hash
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_pool_push_buffer(
+     digest_hash_pool_t *pool,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	libcthreads_thread_pool_t *thread_pools[ 3 ] = { NULL, NULL, NULL };
+	static char *function                        = "digest_hash_pool_push_buffer";
+	int thread_pool_index                        = 0;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	thread_pools[ 0 ] = pool->md5_thread_pool;
+	thread_pools[ 1 ] = pool->sha1_thread_pool;
+	thread_pools[ 2 ] = pool->sha256_thread_pool;
+
+	for( thread_pool_index = 0;
+	     thread_pool_index < 3;
+	     thread_pool_index++ )
+	{
+		if( thread_pools[ thread_pool_index ] == NULL )
+		{
+			continue;
+		}
+		if( storage_media_buffer_add_reference(
+		     storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add reference to storage media buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcthreads_thread_pool_push(
+		     thread_pools[ thread_pool_index ],
+		     (intptr_t *) storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push storage media buffer onto digest hash thread pool queue.",
+			 function );
+
+			storage_media_buffer_queue_release_buffer(
+			 pool->storage_media_buffer_queue,
+			 storage_media_buffer,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,141 @@
+/*
+ * Digest hash pool functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DIGEST_HASH_POOL_H )
+#define _DIGEST_HASH_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+#include "storage_media_buffer.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+enum DIGEST_HASH_POOL_DIGEST_TYPES
+{
+	DIGEST_HASH_POOL_DIGEST_TYPE_MD5	= 0,
+	DIGEST_HASH_POOL_DIGEST_TYPE_SHA1	= 1,
+	DIGEST_HASH_POOL_DIGEST_TYPE_SHA256	= 2
+};
+
+typedef struct digest_hash_pool digest_hash_pool_t;
+
+/* The digest hash pool calculates every digest hash on its own thread
+ * The threads consume the same storage media buffers in order, each holding
+ * a reference to the buffer, so that the buffer is not copied
+ */
+struct digest_hash_pool
+{
+	/* The MD5 digest context
+	 * Contains NULL if the MD5 digest hash is not calculated
+	 */
+	libhmac_md5_context_t *md5_context;
+
+	/* The MD5 thread pool
+	 */
+	libcthreads_thread_pool_t *md5_thread_pool;
+
+	/* Value to indicate the MD5 digest context could not be updated
+	 */
+	uint8_t md5_update_failed;
+
+	/* The SHA1 digest context
+	 * Contains NULL if the SHA1 digest hash is not calculated
+	 */
+	libhmac_sha1_context_t *sha1_context;
+
+	/* The SHA1 thread pool
+	 */
+	libcthreads_thread_pool_t *sha1_thread_pool;
+
+	/* Value to indicate the SHA1 digest context could not be updated
+	 */
+	uint8_t sha1_update_failed;
+
+	/* The SHA256 digest context
+	 * Contains NULL if the SHA256 digest hash is not calculated
+	 */
+	libhmac_sha256_context_t *sha256_context;
+
+	/* The SHA256 thread pool
+	 */
+	libcthreads_thread_pool_t *sha256_thread_pool;
+
+	/* Value to indicate the SHA256 digest context could not be updated
+	 */
+	uint8_t sha256_update_failed;
+
+	/* The storage media buffer queue
+	 * The buffers are released onto this queue after their digest hashes were updated
+	 */
+	libcthreads_queue_t *storage_media_buffer_queue;
+};
+
+int digest_hash_pool_create(
+     digest_hash_pool_t **pool,
+     libhmac_md5_context_t *md5_context,
+     libhmac_sha1_context_t *sha1_context,
+     libhmac_sha256_context_t *sha256_context,
+     libcthreads_queue_t *storage_media_buffer_queue,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error );
+
+int digest_hash_pool_join(
+     digest_hash_pool_t **pool,
+     libcerror_error_t **error );
+
+int digest_hash_pool_update(
+     digest_hash_pool_t *pool,
+     storage_media_buffer_t *storage_media_buffer,
+     int digest_type );
+
+int digest_hash_pool_md5_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     digest_hash_pool_t *pool );
+
+int digest_hash_pool_sha1_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     digest_hash_pool_t *pool );
+
+int digest_hash_pool_sha256_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     digest_hash_pool_t *pool );
+
+int digest_hash_pool_push_buffer(
+     digest_hash_pool_t *pool,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DIGEST_HASH_POOL_H ) */
+
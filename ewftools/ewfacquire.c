@@ -36,6 +36,7 @@
 
 #include "byte_size_string.h"
 #include "device_handle.h"
+#include "digest_hash_pool.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewftools_getopt.h"
@@ -52,6 +53,7 @@
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_ring.h"
 
 #if defined( __BORLANDC__ ) && ( __BORLANDC__ < 0x0560 )
 #define EWFACQUIRE_2_TIB				0x20000000000UL
@@ -61,6 +63,7 @@
 
 #define EWFACQUIRE_INPUT_BUFFER_SIZE			64
 #define EWFACQUIRE_MAXIMUM_PROCESS_BUFFERS_SIZE		64 * 1024 * 1024
+#define EWFACQUIRE_MAXIMUM_NUMBER_OF_STRIPE_DIRECTORIES	15
 
 device_handle_t *ewfacquire_device_handle   = NULL;
 imaging_handle_t *ewfacquire_imaging_handle = NULL;
@@ -123,12 +126,13 @@ void ewfacquire_usage_fprint(
 	                 "                  [ -B number_of_bytes ] [ -c compression_values ]\n"
 	                 "                  [ -C case_number ] [ -d digest_type ] [ -D description ]\n"
 	                 "                  [ -e examiner_name ] [ -E evidence_number ] [ -f format ]\n"
-	                 "                  [ -g number_of_sectors ] [ -j jobs ] [ -l log_filename ]\n"
+	                 "                  [ -F stripe_directory ] [ -g number_of_sectors ]\n"
+	                 "                  [ -j jobs ] [ -l log_filename ]\n"
 	                 "                  [ -m media_type ] [ -M media_flags ] [ -N notes ]\n"
 	                 "                  [ -o offset ] [ -p process_buffer_size ]\n"
 	                 "                  [ -P bytes_per_sector ] [ -r read_error_retries ]\n"
 	                 "                  [ -S segment_file_size ] [ -t target ] [ -T toc_file ]\n"
-	                 "                  [ -2 secondary_target ] [ -hqRsuvVwx ] source\n\n" );
+	                 "                  [ -2 secondary_target ] [ -hOqRsuvVwx ] source\n\n" );
 
 	fprintf( stream, "\tsource: the source file(s) or device\n\n" );
 
@@ -159,6 +163,9 @@ void ewfacquire_usage_fprint(
 	fprintf( stream, "\t-f:     specify the EWF file format to write to, options: ewf, smart,\n"
 	                 "\t        ftk, encase2, encase3, encase4, encase5, encase6 (default),\n"
 	                 "\t        encase7, encase7-v2, linen5, linen6, linen7, ewfx\n" );
+	fprintf( stream, "\t-F:     specify an additional directory to stripe the segment files\n"
+	                 "\t        over, can be repeated up to 15 times (the segment files are\n"
+	                 "\t        written round-robin to the target and the stripe directories)\n" );
 	fprintf( stream, "\t-g      specify the number of sectors to be used as error granularity\n" );
 	fprintf( stream, "\t-h:     shows this help\n" );
 	fprintf( stream, "\t-j:     the number of concurrent processing jobs (threads), where\n"
@@ -170,6 +177,8 @@ void ewfacquire_usage_fprint(
 	fprintf( stream, "\t-M:     specify the media flags, options: logical, physical (default)\n" );
 	fprintf( stream, "\t-N:     specify the notes (default is notes).\n" );
 	fprintf( stream, "\t-o:     specify the offset to start to acquire (default is 0)\n" );
+	fprintf( stream, "\t-O:     read the device using direct IO, bypassing the page cache\n"
+	                 "\t        (falls back to buffered IO if not supported)\n" );
 	fprintf( stream, "\t-p:     specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-P:     specify the number of bytes per sector (default is 512)\n"
 	                 "\t        (use this to override the automatic bytes per sector detection)\n" );
@@ -607,6 +616,7 @@ int ewfacquire_read_input(
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	int maximum_number_of_queued_items           = 0;
+	uint8_t secondary_output_write_failed        = 0;
 #endif
 
 	if( imaging_handle == NULL )
@@ -777,6 +787,17 @@ int ewfacquire_read_input(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The secondary output thread writes the data chunks that were packed for the primary output,
+	 * which requires the chunk data functions, otherwise the data would be compressed
+	 * and checksummed a second time
+	 */
+	if( ( imaging_handle->number_of_threads != 0 )
+	 && ( imaging_handle->secondary_output_handle != NULL ) )
+	{
+		use_chunk_data_functions = 1;
+	}
+#endif
 	if( use_chunk_data_functions != 0 )
 	{
 		process_buffer_size       = (size_t) chunk_size;
@@ -835,15 +856,38 @@ int ewfacquire_read_input(
 
 			goto on_error;
 		}
-		if( libcdata_list_initialize(
-		     &( imaging_handle->output_list ),
+		if( imaging_handle->secondary_output_handle != NULL )
+		{
+			if( libcthreads_thread_pool_create(
+			     &( imaging_handle->secondary_output_thread_pool ),
+			     NULL,
+			     1,
+			     maximum_number_of_queued_items,
+			     (int (*)(intptr_t *, void *)) &imaging_handle_secondary_output_storage_media_buffer_callback,
+			     (void *) imaging_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize secondary output thread pool.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( storage_media_buffer_ring_initialize(
+		     &( imaging_handle->output_ring ),
+		     maximum_number_of_queued_items,
+		     process_buffer_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
+			 "%s: unable to create output ring.",
 			 function );
 
 			goto on_error;
@@ -880,6 +924,31 @@ int ewfacquire_read_input(
 
 		goto on_error;
         }
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->number_of_threads != 0 )
+	{
+		/* Every digest hash is calculated on its own thread
+		 */
+		if( digest_hash_pool_create(
+		     &( imaging_handle->digest_hash_pool ),
+		     imaging_handle->md5_context,
+		     imaging_handle->sha1_context,
+		     imaging_handle->sha256_context,
+		     imaging_handle->storage_media_buffer_queue,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest hash pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( process_status_initialize(
 	     &( imaging_handle->process_status ),
 	     _SYSTEM_STRING( "Acquiry" ),
@@ -939,6 +1008,26 @@ int ewfacquire_read_input(
 			break;
 		}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* Stop reading if the secondary output can no longer be written
+		 */
+		if( imaging_handle_get_secondary_output_write_failed(
+		     imaging_handle,
+		     &secondary_output_write_failed,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve secondary output write failed.",
+			 function );
+
+			goto on_error;
+		}
+		if( secondary_output_write_failed != 0 )
+		{
+			break;
+		}
 		if( ( storage_media_buffer == NULL )
 		 && ( imaging_handle->number_of_threads != 0 ) )
 		{
@@ -1118,6 +1207,26 @@ int ewfacquire_read_input(
 		}
 		/* Digest hashes are calcultated after swap
 		 */
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( imaging_handle->digest_hash_pool != NULL )
+		{
+			if( digest_hash_pool_push_buffer(
+			     imaging_handle->digest_hash_pool,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push storage media buffer onto digest hash pool.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+#endif
 		if( imaging_handle_update_integrity_hash(
 		     imaging_handle,
 		     data,
@@ -1152,6 +1261,28 @@ int ewfacquire_read_input(
 
 				goto on_error;
 			}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			/* The storage media buffer cannot be reused while the digest hash pool references it
+			 */
+			if( imaging_handle->digest_hash_pool != NULL )
+			{
+				if( storage_media_buffer_queue_release_buffer(
+				     imaging_handle->storage_media_buffer_queue,
+				     storage_media_buffer,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to release storage media buffer onto queue.",
+					 function );
+
+					goto on_error;
+				}
+				storage_media_buffer = NULL;
+			}
+#endif
 		}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		else if( imaging_handle->number_of_threads != 0 )
@@ -1275,9 +1406,66 @@ int ewfacquire_read_input(
 			goto on_error;
 		}
 	}
-	if( imaging_handle->output_list != NULL )
+	if( imaging_handle->secondary_output_thread_pool != NULL )
 	{
-		if( imaging_handle_empty_output_list(
+		if( libcthreads_thread_pool_join(
+		     &( imaging_handle->secondary_output_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join secondary output thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( imaging_handle_get_secondary_output_write_failed(
+		     imaging_handle,
+		     &secondary_output_write_failed,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve secondary output write failed.",
+			 function );
+
+			goto on_error;
+		}
+		if( secondary_output_write_failed != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write to secondary output.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( imaging_handle->digest_hash_pool != NULL )
+	{
+		if( digest_hash_pool_join(
+		     &( imaging_handle->digest_hash_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join digest hash pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( imaging_handle->output_ring != NULL )
+	{
+		if( imaging_handle_empty_output_ring(
 		     imaging_handle,
 		     error ) != 1 )
 		{
@@ -1285,21 +1473,20 @@ int ewfacquire_read_input(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to empty output ring.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( imaging_handle->output_list ),
-		     NULL,
+		if( storage_media_buffer_ring_free(
+		     &( imaging_handle->output_ring ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to free output ring.",
 			 function );
 
 			goto on_error;
@@ -1534,14 +1721,25 @@ on_error:
 		 &( imaging_handle->output_thread_pool ),
 		 NULL );
 	}
-	if( imaging_handle->output_list != NULL )
+	if( imaging_handle->secondary_output_thread_pool != NULL )
 	{
-		imaging_handle_empty_output_list(
+		libcthreads_thread_pool_join(
+		 &( imaging_handle->secondary_output_thread_pool ),
+		 NULL );
+	}
+	if( imaging_handle->digest_hash_pool != NULL )
+	{
+		digest_hash_pool_join(
+		 &( imaging_handle->digest_hash_pool ),
+		 NULL );
+	}
+	if( imaging_handle->output_ring != NULL )
+	{
+		imaging_handle_empty_output_ring(
 		 imaging_handle,
 		 NULL );
-		libcdata_list_free(
-		 &( imaging_handle->output_list ),
-		 NULL,
+		storage_media_buffer_ring_free(
+		 &( imaging_handle->output_ring ),
 		 NULL );
 	}
 	if( imaging_handle->storage_media_buffer_queue != NULL )
@@ -1592,6 +1790,7 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_size                      = NULL;
 	system_character_t *option_target_filename           = NULL;
 	system_character_t *option_toc_filename              = NULL;
+	system_character_t *option_stripe_directories[ EWFACQUIRE_MAXIMUM_NUMBER_OF_STRIPE_DIRECTORIES ];
 	system_character_t *program                          = _SYSTEM_STRING( "ewfacquire" );
 	system_character_t *request_string                   = NULL;
 	system_integer_t option                              = 0;
@@ -1602,11 +1801,14 @@ int main( int argc, char * const argv[] )
 	uint8_t resume_acquiry                               = 0;
 	uint8_t swap_byte_pairs                              = 0;
 	uint8_t use_chunk_data_functions                     = 0;
+	uint8_t use_direct_io                                = 0;
 	uint8_t verbose                                      = 0;
 	uint8_t zero_buffer_on_error                         = 0;
 	int8_t acquiry_parameters_confirmed                  = 0;
 	int interactive_mode                                 = 1;
+	int number_of_stripe_directories                     = 0;
 	int result                                           = 0;
+	int stripe_directory_index                           = 0;
 
 	libcnotify_stream_set(
 	 stderr,
@@ -1641,7 +1843,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hj:l:m:M:N:o:p:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:F:g:hj:l:m:M:N:o:Op:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1711,6 +1913,24 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'F':
+				if( number_of_stripe_directories >= EWFACQUIRE_MAXIMUM_NUMBER_OF_STRIPE_DIRECTORIES )
+				{
+					ewftools_output_version_fprint(
+					 stdout,
+					 program );
+
+					fprintf(
+					 stderr,
+					 "Too many stripe directories, maximum is: %d.\n",
+					 EWFACQUIRE_MAXIMUM_NUMBER_OF_STRIPE_DIRECTORIES );
+
+					goto on_error;
+				}
+				option_stripe_directories[ number_of_stripe_directories++ ] = optarg;
+
+				break;
+
 			case (system_integer_t) 'g':
 				option_sector_error_granularity = optarg;
 
@@ -1756,6 +1976,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'O':
+				use_direct_io = 1;
+
+				break;
+
 			case (system_integer_t) 'p':
 				option_process_buffer_size = optarg;
 
@@ -1955,6 +2180,10 @@ int main( int argc, char * const argv[] )
 	{
 		ewfacquire_device_handle->zero_buffer_on_error = 1;
 	}
+	if( use_direct_io != 0 )
+	{
+		ewfacquire_device_handle->use_direct_io = 1;
+	}
 	/* Open the input file or device size
 	 */
 	if( device_handle_open_input(
@@ -1969,6 +2198,13 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( ( use_direct_io != 0 )
+	 && ( ewfacquire_device_handle->use_direct_io == 0 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Direct IO not supported, using buffered IO.\n" );
+	}
 	if( device_handle_media_information_fprint(
 	     ewfacquire_device_handle,
 	     stdout,
@@ -3191,6 +3427,32 @@ int main( int argc, char * const argv[] )
 
 			goto on_error;
 		}
+		if( ( resume_acquiry != 0 )
+		 && ( number_of_stripe_directories > 0 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to stripe output file(s) when resuming acquiry.\n" );
+
+			goto on_error;
+		}
+		for( stripe_directory_index = 0;
+		     stripe_directory_index < number_of_stripe_directories;
+		     stripe_directory_index++ )
+		{
+			if( imaging_handle_append_stripe_directory(
+			     ewfacquire_imaging_handle,
+			     option_stripe_directories[ stripe_directory_index ],
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to append stripe directory: %" PRIs_SYSTEM ".\n",
+				 option_stripe_directories[ stripe_directory_index ] );
+
+				goto on_error;
+			}
+		}
 		if( ewfacquire_imaging_handle->secondary_target_filename != NULL )
 		{
 			if( imaging_handle_open_secondary_output(
@@ -43,6 +43,7 @@
 #endif
 
 #include "byte_size_string.h"
+#include "digest_hash_pool.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewftools_getopt.h"
@@ -59,6 +60,9 @@
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_ring.h"
+
+#define EWFACQUIRESTREAM_MAXIMUM_NUMBER_OF_STRIPE_DIRECTORIES	15
 
 imaging_handle_t *ewfacquirestream_imaging_handle = NULL;
 int ewfacquirestream_abort                        = 0;
@@ -120,7 +124,8 @@ void usage_fprint(
 	                 "                        [ -B number_of_bytes ] [ -c compression_values ]\n"
 	                 "                        [ -C case_number ] [ -d digest_type ]\n"
 	                 "                        [ -D description ] [ -e examiner_name ]\n"
-	                 "                        [ -E evidence_number ] [ -f format ] [ -j jobs ]\n"
+	                 "                        [ -E evidence_number ] [ -f format ]\n"
+	                 "                        [ -F stripe_directory ] [ -j jobs ]\n"
 	                 "                        [ -l log_filename ] [ -m media_type ]\n"
 	                 "                        [ -M media_flags ] [ -N notes ]\n"
 	                 "                        [ -o offset ] [ -p process_buffer_size ]\n"
@@ -157,6 +162,9 @@ void usage_fprint(
 	fprintf( stream, "\t-f: specify the EWF file format to write to, options: ftk, encase2,\n"
 	                 "\t    encase3, encase4, encase5, encase6 (default), encase7, linen5,\n"
 	                 "\t    linen6, linen7, ewfx\n" );
+	fprintf( stream, "\t-F: specify an additional directory to stripe the segment files over,\n"
+	                 "\t    can be repeated up to 15 times (the segment files are written\n"
+	                 "\t    round-robin to the target and the stripe directories)\n" );
 	fprintf( stream, "\t-h: shows this help\n" );
 	fprintf( stream, "\t-j: the number of concurrent processing jobs (threads), where\n"
 	                 "\t    a number of 0 represents single-threaded mode (default is 4\n"
@@ -514,6 +522,7 @@ int ewfacquirestream_read_input(
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	int maximum_number_of_queued_items           = 0;
+	uint8_t secondary_output_write_failed        = 0;
 #endif
 
 	if( imaging_handle == NULL )
@@ -587,6 +596,17 @@ int ewfacquirestream_read_input(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The secondary output thread writes the data chunks that were packed for the primary output,
+	 * which requires the chunk data functions, otherwise the data would be compressed
+	 * and checksummed a second time
+	 */
+	if( ( imaging_handle->number_of_threads != 0 )
+	 && ( imaging_handle->secondary_output_handle != NULL ) )
+	{
+		use_chunk_data_functions = 1;
+	}
+#endif
 	if( use_chunk_data_functions != 0 )
 	{
 		process_buffer_size       = (size_t) chunk_size;
@@ -645,15 +665,38 @@ int ewfacquirestream_read_input(
 
 			goto on_error;
 		}
-		if( libcdata_list_initialize(
-		     &( imaging_handle->output_list ),
+		if( imaging_handle->secondary_output_handle != NULL )
+		{
+			if( libcthreads_thread_pool_create(
+			     &( imaging_handle->secondary_output_thread_pool ),
+			     NULL,
+			     1,
+			     maximum_number_of_queued_items,
+			     (int (*)(intptr_t *, void *)) &imaging_handle_secondary_output_storage_media_buffer_callback,
+			     (void *) imaging_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize secondary output thread pool.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( storage_media_buffer_ring_initialize(
+		     &( imaging_handle->output_ring ),
+		     maximum_number_of_queued_items,
+		     process_buffer_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
+			 "%s: unable to create output ring.",
 			 function );
 
 			goto on_error;
@@ -690,6 +733,31 @@ int ewfacquirestream_read_input(
 
 		goto on_error;
         }
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->number_of_threads != 0 )
+	{
+		/* Every digest hash is calculated on its own thread
+		 */
+		if( digest_hash_pool_create(
+		     &( imaging_handle->digest_hash_pool ),
+		     imaging_handle->md5_context,
+		     imaging_handle->sha1_context,
+		     imaging_handle->sha256_context,
+		     imaging_handle->storage_media_buffer_queue,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest hash pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( process_status_initialize(
 	     &( imaging_handle->process_status ),
 	     _SYSTEM_STRING( "Acquiry" ),
@@ -751,6 +819,26 @@ int ewfacquirestream_read_input(
 			break;
 		}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* Stop reading if the secondary output can no longer be written
+		 */
+		if( imaging_handle_get_secondary_output_write_failed(
+		     imaging_handle,
+		     &secondary_output_write_failed,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve secondary output write failed.",
+			 function );
+
+			goto on_error;
+		}
+		if( secondary_output_write_failed != 0 )
+		{
+			break;
+		}
 		if( imaging_handle->number_of_threads != 0 )
 		{
 			if( storage_media_buffer_queue_grab_buffer(
@@ -871,6 +959,26 @@ int ewfacquirestream_read_input(
 		}
 		/* Digest hashes are calcultated after swap
 		 */
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( imaging_handle->digest_hash_pool != NULL )
+		{
+			if( digest_hash_pool_push_buffer(
+			     imaging_handle->digest_hash_pool,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push storage media buffer onto digest hash pool.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+#endif
 		if( imaging_handle_update_integrity_hash(
 		     imaging_handle,
 		     data,
@@ -1007,31 +1115,87 @@ int ewfacquirestream_read_input(
 			goto on_error;
 		}
 	}
-	if( imaging_handle->output_list != NULL )
+	if( imaging_handle->secondary_output_thread_pool != NULL )
 	{
-		if( imaging_handle_empty_output_list(
+		if( libcthreads_thread_pool_join(
+		     &( imaging_handle->secondary_output_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join secondary output thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( imaging_handle_get_secondary_output_write_failed(
 		     imaging_handle,
+		     &secondary_output_write_failed,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve secondary output write failed.",
+			 function );
+
+			goto on_error;
+		}
+		if( secondary_output_write_failed != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write to secondary output.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( imaging_handle->digest_hash_pool != NULL )
+	{
+		if( digest_hash_pool_join(
+		     &( imaging_handle->digest_hash_pool ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to join digest hash pool.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( imaging_handle->output_list ),
-		     NULL,
+	}
+	if( imaging_handle->output_ring != NULL )
+	{
+		if( imaging_handle_empty_output_ring(
+		     imaging_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to empty output ring.",
+			 function );
+
+			goto on_error;
+		}
+		if( storage_media_buffer_ring_free(
+		     &( imaging_handle->output_ring ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output ring.",
 			 function );
 
 			goto on_error;
@@ -1184,14 +1348,25 @@ on_error:
 		 &( imaging_handle->output_thread_pool ),
 		 NULL );
 	}
-	if( imaging_handle->output_list != NULL )
+	if( imaging_handle->secondary_output_thread_pool != NULL )
 	{
-		imaging_handle_empty_output_list(
+		libcthreads_thread_pool_join(
+		 &( imaging_handle->secondary_output_thread_pool ),
+		 NULL );
+	}
+	if( imaging_handle->digest_hash_pool != NULL )
+	{
+		digest_hash_pool_join(
+		 &( imaging_handle->digest_hash_pool ),
+		 NULL );
+	}
+	if( imaging_handle->output_ring != NULL )
+	{
+		imaging_handle_empty_output_ring(
 		 imaging_handle,
 		 NULL );
-		libcdata_list_free(
-		 &( imaging_handle->output_list ),
-		 NULL,
+		storage_media_buffer_ring_free(
+		 &( imaging_handle->output_ring ),
 		 NULL );
 	}
 	if( imaging_handle->storage_media_buffer_queue != NULL )
@@ -1235,6 +1410,7 @@ int main( int argc, char * const argv[] )
         system_character_t *option_sectors_per_chunk         = NULL;
 	system_character_t *option_size                      = NULL;
         system_character_t *option_target_filename           = NULL;
+	system_character_t *option_stripe_directories[ EWFACQUIRESTREAM_MAXIMUM_NUMBER_OF_STRIPE_DIRECTORIES ];
 	system_character_t *program                          = _SYSTEM_STRING( "ewfacquirestream" );
 	system_integer_t option                              = 0;
 	size_t string_length                                 = 0;
@@ -1245,7 +1421,9 @@ int main( int argc, char * const argv[] )
 	uint8_t swap_byte_pairs                              = 0;
 	uint8_t use_chunk_data_functions                     = 0;
 	uint8_t verbose                                      = 0;
+	int number_of_stripe_directories                     = 0;
 	int result                                           = 0;
+	int stripe_directory_index                           = 0;
 
 	libcnotify_stream_set(
 	 stderr,
@@ -1307,7 +1485,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:hj:l:m:M:N:o:p:P:qsS:t:vVx2:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:F:hj:l:m:M:N:o:p:P:qsS:t:vVx2:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1377,6 +1555,24 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'F':
+				if( number_of_stripe_directories >= EWFACQUIRESTREAM_MAXIMUM_NUMBER_OF_STRIPE_DIRECTORIES )
+				{
+					ewftools_output_version_fprint(
+					 stdout,
+					 program );
+
+					fprintf(
+					 stderr,
+					 "Too many stripe directories, maximum is: %d.\n",
+					 EWFACQUIRESTREAM_MAXIMUM_NUMBER_OF_STRIPE_DIRECTORIES );
+
+					goto on_error;
+				}
+				option_stripe_directories[ number_of_stripe_directories++ ] = optarg;
+
+				break;
+
 			case (system_integer_t) 'h':
 				ewftools_output_version_fprint(
 				 stdout,
@@ -2032,6 +2228,23 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	for( stripe_directory_index = 0;
+	     stripe_directory_index < number_of_stripe_directories;
+	     stripe_directory_index++ )
+	{
+		if( imaging_handle_append_stripe_directory(
+		     ewfacquirestream_imaging_handle,
+		     option_stripe_directories[ stripe_directory_index ],
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to append stripe directory: %" PRIs_SYSTEM ".\n",
+			 option_stripe_directories[ stripe_directory_index ] );
+
+			goto on_error;
+		}
+	}
 	if( ewfacquirestream_imaging_handle->secondary_target_filename != NULL )
 	{
 		if( imaging_handle_open_secondary_output(
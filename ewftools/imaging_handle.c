@@ -49,6 +49,13 @@
 #include "platform.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_ring.h"
+
+#if defined( WINAPI )
+#define IMAGING_HANDLE_PATH_SEPARATOR	'\\'
+#else
+#define IMAGING_HANDLE_PATH_SEPARATOR	'/'
+#endif
 
 #define IMAGING_HANDLE_INPUT_BUFFER_SIZE	64
 #define IMAGING_HANDLE_STRING_SIZE		1024
@@ -162,6 +169,21 @@ int imaging_handle_initialize(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *imaging_handle )->secondary_output_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create secondary output mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	if( calculate_md5 != 0 )
 	{
 		( *imaging_handle )->calculated_md5_hash_string = system_string_allocate(
@@ -212,6 +234,14 @@ on_error:
 			memory_free(
 			 ( *imaging_handle )->calculated_md5_hash_string );
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *imaging_handle )->secondary_output_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *imaging_handle )->secondary_output_mutex ),
+			 NULL );
+		}
+#endif
 		if( ( *imaging_handle )->output_handle != NULL )
 		{
 			libewf_handle_free(
@@ -384,6 +414,21 @@ int imaging_handle_free(
 				result = -1;
 			}
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *imaging_handle )->secondary_output_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free secondary output mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *imaging_handle );
 
@@ -890,6 +935,177 @@ on_error:
 	return( -1 );
 }
 
+/* Appends a directory to stripe the output segment files over
+ * The segment files in the directory use the same name as the target
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_append_stripe_directory(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *directory,
+     libcerror_error_t **error )
+{
+	system_character_t *basename = NULL;
+	static char *function        = "imaging_handle_append_stripe_directory";
+	size_t basename_size         = 0;
+	size_t directory_length      = 0;
+	size_t name_index            = 0;
+	size_t name_length           = 0;
+	size_t target_length         = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->target_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid imaging handle - missing target filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory.",
+		 function );
+
+		return( -1 );
+	}
+	directory_length = system_string_length(
+	                    directory );
+
+	if( directory_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid directory length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	target_length = system_string_length(
+	                 imaging_handle->target_filename );
+
+	for( name_index = target_length;
+	     name_index > 0;
+	     name_index-- )
+	{
+		if( ( imaging_handle->target_filename[ name_index - 1 ] == (system_character_t) IMAGING_HANDLE_PATH_SEPARATOR )
+#if defined( WINAPI )
+		 || ( imaging_handle->target_filename[ name_index - 1 ] == (system_character_t) ':' )
+#endif
+		 || ( imaging_handle->target_filename[ name_index - 1 ] == (system_character_t) '/' ) )
+		{
+			break;
+		}
+	}
+	name_length = target_length - name_index;
+
+	if( directory[ directory_length - 1 ] == (system_character_t) IMAGING_HANDLE_PATH_SEPARATOR )
+	{
+		directory_length--;
+	}
+	basename_size = directory_length + 1 + name_length + 1;
+
+	basename = system_string_allocate(
+	            basename_size );
+
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create basename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     basename,
+	     directory,
+	     directory_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy directory to basename.",
+		 function );
+
+		goto on_error;
+	}
+	basename[ directory_length ] = (system_character_t) IMAGING_HANDLE_PATH_SEPARATOR;
+
+	if( system_string_copy(
+	     &( basename[ directory_length + 1 ] ),
+	     &( imaging_handle->target_filename[ name_index ] ),
+	     name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy target name to basename.",
+		 function );
+
+		goto on_error;
+	}
+	basename[ basename_size - 1 ] = 0;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_append_stripe_basename_wide(
+	     imaging_handle->output_handle,
+	     basename,
+	     basename_size - 1,
+	     error ) != 1 )
+#else
+	if( libewf_handle_append_stripe_basename(
+	     imaging_handle->output_handle,
+	     basename,
+	     basename_size - 1,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append stripe basename.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 basename );
+
+	return( 1 );
+
+on_error:
+	if( basename != NULL )
+	{
+		memory_free(
+		 basename );
+	}
+	return( -1 );
+}
+
 /* Opens the output of the imaging handle for resume
  * Returns 1 if successful or -1 on error
  */
@@ -1692,24 +1908,13 @@ int imaging_handle_process_storage_media_buffer_callback(
 	return( 1 );
 
 on_error:
-	if( storage_media_buffer != NULL )
+	if( ( imaging_handle != NULL )
+	 && ( storage_media_buffer != NULL ) )
 	{
-		if( storage_media_buffer_queue_release_buffer(
-		     imaging_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
-
-			storage_media_buffer_free(
-			 &storage_media_buffer,
-			 NULL );
-		}
+		storage_media_buffer_queue_release_buffer(
+		 imaging_handle->storage_media_buffer_queue,
+		 storage_media_buffer,
+		 NULL );
 	}
 	if( error != NULL )
 	{
@@ -1734,8 +1939,6 @@ int imaging_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      imaging_handle_t *imaging_handle )
 {
-	libcdata_list_element_t *element      = NULL;
-	libcdata_list_element_t *next_element = NULL;
         libcerror_error_t *error              = NULL;
         static char *function                 = "imaging_handle_output_storage_media_buffer_callback";
 	ssize_t write_count                   = 0;
@@ -1763,77 +1966,65 @@ int imaging_handle_output_storage_media_buffer_callback(
 
 		goto on_error;
 	}
-	if( libcdata_list_insert_value(
-	     imaging_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+	if( storage_media_buffer_ring_insert_buffer(
+	     imaging_handle->output_ring,
+	     storage_media_buffer,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
+		 "%s: unable to insert storage media buffer into output ring.",
 		 function );
 
 		goto on_error;
 	}
 	storage_media_buffer = NULL;
 
-	if( libcdata_list_get_first_element(
-	     imaging_handle->output_list,
-	     &element,
-	     &error ) != 1 )
+	/* Write the buffers that directly follow the last buffer written in order
+	 */
+	while( imaging_handle->output_ring->number_of_buffers > 0 )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
+		result = storage_media_buffer_ring_remove_buffer(
+		          imaging_handle->output_ring,
+		          imaging_handle->last_offset_written,
+		          &storage_media_buffer,
+		          &error );
 
-		goto on_error;
-	}
-	while( element != NULL )
-	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove storage media buffer from output ring.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( storage_media_buffer == NULL )
+		else if( result == 0 )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
+			break;
 		}
-		if( storage_media_buffer->storage_media_offset != imaging_handle->last_offset_written )
+		/* The secondary output is written by the secondary output thread pool
+		 */
+		if( imaging_handle->secondary_output_thread_pool != NULL )
 		{
-			break;
+			write_count = storage_media_buffer_write_to_handle(
+			               storage_media_buffer,
+			               imaging_handle->output_handle,
+			               storage_media_buffer->processed_size,
+			               &error );
+		}
+		else
+		{
+			write_count = imaging_handle_write_storage_media_buffer(
+				       imaging_handle,
+				       storage_media_buffer,
+				       storage_media_buffer->processed_size,
+				       &error );
 		}
-		write_count = imaging_handle_write_storage_media_buffer(
-			       imaging_handle,
-			       storage_media_buffer,
-			       storage_media_buffer->processed_size,
-			       &error );
-
 		if( write_count < 0 )
 		{
 			libcerror_error_set(
@@ -1843,75 +2034,53 @@ int imaging_handle_output_storage_media_buffer_callback(
 			 "%s: unable to write storage media buffer.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		imaging_handle->last_offset_written = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
 
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     &error ) != 1 )
+		if( imaging_handle->secondary_output_thread_pool != NULL )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			storage_media_buffer = NULL;
+			/* The secondary output thread pool writes the same packed chunks
+			 * and releases the storage media buffer
+			 */
+			if( libcthreads_thread_pool_push(
+			     imaging_handle->secondary_output_thread_pool,
+			     (intptr_t *) storage_media_buffer,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push storage media buffer onto secondary output thread pool queue.",
+				 function );
 
-			goto on_error;
+				goto on_error;
+			}
 		}
-		if( libcdata_list_remove_element(
-		     imaging_handle->output_list,
-		     element,
-		     &error ) != 1 )
+		else
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
+			result = storage_media_buffer_queue_release_buffer(
+			          imaging_handle->storage_media_buffer_queue,
+			          storage_media_buffer,
+			          &error );
 
+			/* The storage media buffer can be referenced by other threads
+			 * and should not be released a second time
+			 */
 			storage_media_buffer = NULL;
 
-			goto on_error;
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
-
-			goto on_error;
-		}
-		element = next_element;
-
-		if( storage_media_buffer_queue_release_buffer(
-		     imaging_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to release storage media buffer onto queue.",
+				 function );
 
-			goto on_error;
+				goto on_error;
+			}
 		}
 		storage_media_buffer = NULL;
 
@@ -1945,25 +2114,155 @@ int imaging_handle_output_storage_media_buffer_callback(
 	return( 1 );
 
 on_error:
-	if( storage_media_buffer != NULL )
+	if( ( imaging_handle != NULL )
+	 && ( storage_media_buffer != NULL ) )
 	{
-		if( storage_media_buffer_queue_release_buffer(
-		     imaging_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     &error ) != 1 )
+		storage_media_buffer_queue_release_buffer(
+		 imaging_handle->storage_media_buffer_queue,
+		 storage_media_buffer,
+		 NULL );
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Writes a storage media buffer to the secondary output
+ * Callback function for the secondary output thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_secondary_output_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     imaging_handle_t *imaging_handle )
+{
+        libcerror_error_t *error = NULL;
+        static char *function    = "imaging_handle_secondary_output_storage_media_buffer_callback";
+	ssize_t write_count      = 0;
+	uint8_t write_failed     = 0;
+	int result               = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	/* The packed data chunk of the primary output is written as-is
+	 */
+	if( storage_media_buffer->mode != STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported storage media buffer mode.",
+		 function );
+
+		imaging_handle_set_secondary_output_write_failed(
+		 imaging_handle,
+		 NULL );
+
+		goto on_error;
+	}
+	if( imaging_handle_get_secondary_output_write_failed(
+	     imaging_handle,
+	     &write_failed,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve secondary output write failed.",
+		 function );
+
+		goto on_error;
+	}
+	/* Once a write to the secondary output failed the remaining
+	 * storage media buffers are only released
+	 */
+	if( write_failed == 0 )
+	{
+		write_count = storage_media_buffer_write_to_handle(
+		               storage_media_buffer,
+		               imaging_handle->secondary_output_handle,
+		               storage_media_buffer->processed_size,
+		               &error );
+
+		if( write_count < 0 )
 		{
 			libcerror_error_set(
 			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write storage media buffer to secondary output handle.",
 			 function );
 
-			storage_media_buffer_free(
-			 &storage_media_buffer,
+			imaging_handle_set_secondary_output_write_failed(
+			 imaging_handle,
 			 NULL );
+
+			goto on_error;
 		}
 	}
+	result = storage_media_buffer_queue_release_buffer(
+	          imaging_handle->storage_media_buffer_queue,
+	          storage_media_buffer,
+	          &error );
+
+	/* The storage media buffer can be referenced by other threads
+	 * and should not be released a second time
+	 */
+	storage_media_buffer = NULL;
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to release storage media buffer onto queue.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( ( imaging_handle != NULL )
+	 && ( storage_media_buffer != NULL ) )
+	{
+		storage_media_buffer_queue_release_buffer(
+		 imaging_handle->storage_media_buffer_queue,
+		 storage_media_buffer,
+		 NULL );
+	}
 	if( error != NULL )
 	{
 #if defined( HAVE_VERBOSE_OUTPUT )
@@ -1979,17 +2278,15 @@ on_error:
 	return( -1 );
 }
 
-/* Empties the output list
+/* Retrieves the value to indicate if a write to the secondary output failed
  * Returns 1 if successful or -1 on error
  */
-int imaging_handle_empty_output_list(
+int imaging_handle_get_secondary_output_write_failed(
      imaging_handle_t *imaging_handle,
+     uint8_t *write_failed,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
-	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "imaging_handle_empty_output_list";
+	static char *function = "imaging_handle_get_secondary_output_write_failed";
 
 	if( imaging_handle == NULL )
 	{
@@ -2002,109 +2299,160 @@ int imaging_handle_empty_output_list(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_first_element(
-	     imaging_handle->output_list,
-	     &element,
+	if( write_failed == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write failed.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     imaging_handle->secondary_output_mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab secondary output mutex.",
 		 function );
 
 		return( -1 );
 	}
-	while( element != NULL )
+	*write_failed = imaging_handle->secondary_output_write_failed;
+
+	if( libcthreads_mutex_release(
+	     imaging_handle->secondary_output_mutex,
+	     error ) != 1 )
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release secondary output mutex.",
+		 function );
 
-			return( -1 );
-		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
+		return( -1 );
+	}
+	return( 1 );
+}
 
-			return( -1 );
-		}
-		if( storage_media_buffer_queue_release_buffer(
-		     imaging_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
+/* Sets the value to indicate a write to the secondary output failed
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_set_secondary_output_write_failed(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_set_secondary_output_write_failed";
 
-			return( -1 );
-		}
-		storage_media_buffer = NULL;
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
 
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     imaging_handle->secondary_output_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab secondary output mutex.",
+		 function );
 
-			return( -1 );
-		}
-		if( libcdata_list_remove_element(
-		     imaging_handle->output_list,
-		     element,
-		     error ) != 1 )
+		return( -1 );
+	}
+	imaging_handle->secondary_output_write_failed = 1;
+
+	if( libcthreads_mutex_release(
+	     imaging_handle->secondary_output_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release secondary output mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Empties the output ring
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_empty_output_ring(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+        static char *function                        = "imaging_handle_empty_output_ring";
+	int result                                   = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		result = storage_media_buffer_ring_remove_any_buffer(
+		          imaging_handle->output_ring,
+		          &storage_media_buffer,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
+			 "%s: unable to remove storage media buffer from output ring.",
 			 function );
 
 			return( -1 );
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     error ) != 1 )
+		else if( result != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
+			if( storage_media_buffer_queue_release_buffer(
+			     imaging_handle->storage_media_buffer_queue,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to release storage media buffer onto queue.",
+				 function );
 
-			return( -1 );
+				return( -1 );
+			}
+			storage_media_buffer = NULL;
 		}
-		element = next_element;
 	}
+	while( result != 0 );
+
 	return( 1 );
 }
 
@@ -26,6 +26,7 @@
 #include <file_stream.h>
 #include <types.h>
 
+#include "digest_hash_pool.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
@@ -33,6 +34,7 @@
 #include "ewftools_libhmac.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_ring.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -224,9 +226,28 @@ struct imaging_handle
 	 */
 	libcthreads_thread_pool_t *output_thread_pool;
 
-	/* The output list
+	/* The secondary output thread pool
+	 * Contains NULL if the secondary output is written by the output thread pool
 	 */
-	libcdata_list_t *output_list;
+	libcthreads_thread_pool_t *secondary_output_thread_pool;
+
+	/* The secondary output mutex
+	 */
+	libcthreads_mutex_t *secondary_output_mutex;
+
+	/* Value to indicate if a write to the secondary output failed
+	 * Protected by the secondary output mutex
+	 */
+	uint8_t secondary_output_write_failed;
+
+	/* The digest hash pool
+	 * Contains NULL if the integrity hash(es) are updated by the read loop
+	 */
+	digest_hash_pool_t *digest_hash_pool;
+
+	/* The output ring
+	 */
+	storage_media_buffer_ring_t *output_ring;
 
 	/* The storage media buffer queue
 	 */
@@ -294,6 +315,11 @@ int imaging_handle_open_secondary_output(
      uint8_t resume,
      libcerror_error_t **error );
 
+int imaging_handle_append_stripe_directory(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *directory,
+     libcerror_error_t **error );
+
 int imaging_handle_open_output_resume(
      imaging_handle_t *imaging_handle,
      const system_character_t *filename,
@@ -350,7 +376,20 @@ int imaging_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      imaging_handle_t *imaging_handle );
 
-int imaging_handle_empty_output_list(
+int imaging_handle_secondary_output_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     imaging_handle_t *imaging_handle );
+
+int imaging_handle_get_secondary_output_write_failed(
+     imaging_handle_t *imaging_handle,
+     uint8_t *write_failed,
+     libcerror_error_t **error );
+
+int imaging_handle_set_secondary_output_write_failed(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error );
+
+int imaging_handle_empty_output_ring(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error );
 
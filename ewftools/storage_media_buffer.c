@@ -121,12 +121,13 @@ int storage_media_buffer_initialize(
 	}
 	if( size > 0 )
 	{
-/* TODO can low level functions and direct IO be combined ? */
 #if defined( memory_allocate_aligned )
+		/* The raw buffer is aligned so that it can be read into using direct IO
+		 */
 		if( memory_allocate_aligned(
 		     (void **) &( ( *buffer )->raw_buffer ),
 		     size,
-		     512 ) != 0 )
+		     STORAGE_MEDIA_BUFFER_ALIGNMENT ) != 0 )
 		{
 			libcerror_error_set(
 			 error,
@@ -173,6 +174,21 @@ int storage_media_buffer_initialize(
 			goto on_error;
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *buffer )->reference_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reference mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	( *buffer )->mode = mode;
 
 	return( 1 );
@@ -222,6 +238,24 @@ int storage_media_buffer_free(
 	}
 	if( *buffer != NULL )
 	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *buffer )->reference_mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *buffer )->reference_mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free reference mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( *buffer )->raw_buffer != NULL )
 		{
 			memory_free(
@@ -251,6 +285,203 @@ int storage_media_buffer_free(
 	return( result );
 }
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Adds a reference to a storage media buffer
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_add_reference(
+     storage_media_buffer_t *buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_add_reference";
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     buffer->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+	buffer->number_of_references += 1;
+
+	if( libcthreads_mutex_release(
+	     buffer->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the number of references of a storage media buffer
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_set_number_of_references(
+     storage_media_buffer_t *buffer,
+     int number_of_references,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_set_number_of_references";
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_references < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of references value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     buffer->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+	buffer->number_of_references = number_of_references;
+
+	if( libcthreads_mutex_release(
+	     buffer->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Removes a reference from a storage media buffer
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_remove_reference(
+     storage_media_buffer_t *buffer,
+     int *number_of_references,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_remove_reference";
+	int result            = 1;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_references == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of references.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     buffer->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer->number_of_references <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer - number of references value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		buffer->number_of_references -= 1;
+
+		*number_of_references = buffer->number_of_references;
+	}
+	if( libcthreads_mutex_release(
+	     buffer->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 /* Retrieves the reference to the actual data and its size
  * Returns 1 if successful or -1 on error
  */
@@ -215,10 +215,28 @@ int storage_media_buffer_queue_grab_buffer(
 
 		return( -1 );
 	}
+	if( *buffer != NULL )
+	{
+		if( storage_media_buffer_set_number_of_references(
+		     *buffer,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set number of references of storage media buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( 1 );
 }
 
-/* Releases a storage media buffer onto the queue
+/* Releases a reference to a storage media buffer
+ * The storage media buffer is pushed back onto the queue when its last reference is released
  * Returns 1 if successful or -1 on error
  */
 int storage_media_buffer_queue_release_buffer(
@@ -226,8 +244,27 @@ int storage_media_buffer_queue_release_buffer(
      storage_media_buffer_t *buffer,
      libcerror_error_t **error )
 {
-	static char *function = "storage_media_buffer_queue_release_buffer";
+	static char *function    = "storage_media_buffer_queue_release_buffer";
+	int number_of_references = 0;
 
+	if( storage_media_buffer_remove_reference(
+	     buffer,
+	     &number_of_references,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to remove reference from storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_references > 0 )
+	{
+		return( 1 );
+	}
 	if( libcthreads_queue_push(
 	     queue,
 	     (intptr_t *) buffer,
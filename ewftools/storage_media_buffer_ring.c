@@ -0,0 +1,401 @@
+/*
+ * Storage media buffer ring
+ *
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_ring.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a storage media buffer ring
+ * Make sure the value ring is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_ring_initialize(
+     storage_media_buffer_ring_t **ring,
+     int number_of_slots,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_ring_initialize";
+	size_t buffers_size   = 0;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *ring != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid ring value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_slots <= 0 )
+	 || ( (size_t) number_of_slots > ( (size_t) SSIZE_MAX / sizeof( storage_media_buffer_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of slots value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*ring = memory_allocate_structure(
+	         storage_media_buffer_ring_t );
+
+	if( *ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create ring.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *ring,
+	     0,
+	     sizeof( storage_media_buffer_ring_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear ring.",
+		 function );
+
+		memory_free(
+		 *ring );
+
+		*ring = NULL;
+
+		return( -1 );
+	}
+	buffers_size = sizeof( storage_media_buffer_t * ) * (size_t) number_of_slots;
+
+	( *ring )->buffers = (storage_media_buffer_t **) memory_allocate(
+	                                                  buffers_size );
+
+	if( ( *ring )->buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *ring )->buffers,
+	     0,
+	     buffers_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffers.",
+		 function );
+
+		goto on_error;
+	}
+	( *ring )->number_of_slots = number_of_slots;
+	( *ring )->buffer_size     = buffer_size;
+
+	return( 1 );
+
+on_error:
+	if( *ring != NULL )
+	{
+		if( ( *ring )->buffers != NULL )
+		{
+			memory_free(
+			 ( *ring )->buffers );
+		}
+		memory_free(
+		 *ring );
+
+		*ring = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a storage media buffer ring
+ * The buffers in the ring are not freed, use storage_media_buffer_ring_remove_any_buffer to empty the ring
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_ring_free(
+     storage_media_buffer_ring_t **ring,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_ring_free";
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *ring != NULL )
+	{
+		if( ( *ring )->buffers != NULL )
+		{
+			memory_free(
+			 ( *ring )->buffers );
+		}
+		memory_free(
+		 *ring );
+
+		*ring = NULL;
+	}
+	return( 1 );
+}
+
+/* Inserts a storage media buffer into the ring
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_ring_insert_buffer(
+     storage_media_buffer_ring_t *ring,
+     storage_media_buffer_t *buffer,
+     libcerror_error_t **error )
+{
+	static char *function    = "storage_media_buffer_ring_insert_buffer";
+	uint64_t sequence_number = 0;
+	int slot_index           = 0;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer->storage_media_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer - storage media offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	sequence_number = (uint64_t) buffer->storage_media_offset / ring->buffer_size;
+	slot_index      = (int) ( sequence_number % (uint64_t) ring->number_of_slots );
+
+	/* The slot is still in use if more buffers are outstanding than the ring has slots
+	 */
+	if( ring->buffers[ slot_index ] != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid ring - slot: %d for storage media offset: %" PRIi64 " already set.",
+		 function,
+		 slot_index,
+		 buffer->storage_media_offset );
+
+		return( -1 );
+	}
+	ring->buffers[ slot_index ] = buffer;
+
+	ring->number_of_buffers += 1;
+
+	return( 1 );
+}
+
+/* Removes the storage media buffer with a specific storage media offset from the ring
+ * Returns 1 if successful, 0 if no such buffer or -1 on error
+ */
+int storage_media_buffer_ring_remove_buffer(
+     storage_media_buffer_ring_t *ring,
+     off64_t storage_media_offset,
+     storage_media_buffer_t **buffer,
+     libcerror_error_t **error )
+{
+	static char *function    = "storage_media_buffer_ring_remove_buffer";
+	uint64_t sequence_number = 0;
+	int slot_index           = 0;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid storage media offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	sequence_number = (uint64_t) storage_media_offset / ring->buffer_size;
+	slot_index      = (int) ( sequence_number % (uint64_t) ring->number_of_slots );
+
+	if( ( ring->buffers[ slot_index ] == NULL )
+	 || ( ring->buffers[ slot_index ]->storage_media_offset != storage_media_offset ) )
+	{
+		return( 0 );
+	}
+	*buffer = ring->buffers[ slot_index ];
+
+	ring->buffers[ slot_index ] = NULL;
+
+	ring->number_of_buffers -= 1;
+
+	return( 1 );
+}
+
+/* Removes any storage media buffer from the ring
+ * Returns 1 if successful, 0 if the ring is empty or -1 on error
+ */
+int storage_media_buffer_ring_remove_any_buffer(
+     storage_media_buffer_ring_t *ring,
+     storage_media_buffer_t **buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_ring_remove_any_buffer";
+	int slot_index        = 0;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ring->number_of_buffers == 0 )
+	{
+		return( 0 );
+	}
+	for( slot_index = 0;
+	     slot_index < ring->number_of_slots;
+	     slot_index++ )
+	{
+		if( ring->buffers[ slot_index ] != NULL )
+		{
+			*buffer = ring->buffers[ slot_index ];
+
+			ring->buffers[ slot_index ] = NULL;
+
+			ring->number_of_buffers -= 1;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
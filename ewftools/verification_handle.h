@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "digest_hash.h"
+#include "digest_hash_pool.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
@@ -34,6 +35,7 @@
 #include "log_handle.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_ring.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -151,9 +153,14 @@ struct verification_handle
 	 */
 	libcthreads_thread_pool_t *output_thread_pool;
 
-	/* The output list
+	/* The digest hash pool
+	 * Contains NULL if the integrity hash(es) are updated by the output thread pool
 	 */
-	libcdata_list_t *output_list;
+	digest_hash_pool_t *digest_hash_pool;
+
+	/* The output ring
+	 */
+	storage_media_buffer_ring_t *output_ring;
 
 	/* The storage media buffer queue
 	 */
@@ -252,7 +259,7 @@ int verification_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      verification_handle_t *verification_handle );
 
-int verification_handle_empty_output_list(
+int verification_handle_empty_output_ring(
      verification_handle_t *verification_handle,
      libcerror_error_t **error );
 
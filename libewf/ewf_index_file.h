@@ -0,0 +1,276 @@
+/*
+ * EWF index file
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EWF_INDEX_FILE_H )
+#define _EWF_INDEX_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The index file header
+ * The index file is not part of the EWF format, it is written by libewf
+ * to cache the layout of a set of segment files
+ */
+typedef struct ewf_index_file_header ewf_index_file_header_t;
+
+struct ewf_index_file_header
+{
+	/* The signature
+	 * Consists of 8 bytes
+	 * Contains: EWFIDX 0x0d 0x0a
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 * Consists of 4 bytes
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* The number of segments
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_segments[ 4 ];
+
+	/* The size of the data that follows the header
+	 * Consists of 8 bytes
+	 */
+	uint8_t data_size[ 8 ];
+
+	/* The segment file major version
+	 * Consists of 1 byte
+	 */
+	uint8_t major_version;
+
+	/* The segment file minor version
+	 * Consists of 1 byte
+	 */
+	uint8_t minor_version;
+
+	/* The compression method
+	 * Consists of 2 bytes
+	 */
+	uint8_t compression_method[ 2 ];
+
+	/* The media type
+	 * Consists of 1 byte
+	 */
+	uint8_t media_type;
+
+	/* The media flags
+	 * Consists of 1 byte
+	 */
+	uint8_t media_flags;
+
+	/* Padding
+	 * Consists of 2 bytes
+	 */
+	uint8_t padding1[ 2 ];
+
+	/* The segment file set identifier
+	 * Consists of 16 bytes
+	 */
+	uint8_t set_identifier[ 16 ];
+
+	/* The media size
+	 * Consists of 8 bytes
+	 */
+	uint8_t media_size[ 8 ];
+
+	/* The chunk size
+	 * Consists of 4 bytes
+	 */
+	uint8_t chunk_size[ 4 ];
+
+	/* The number of sectors per chunk
+	 * Consists of 4 bytes
+	 */
+	uint8_t sectors_per_chunk[ 4 ];
+
+	/* The number of bytes per sector
+	 * Consists of 4 bytes
+	 */
+	uint8_t bytes_per_sector[ 4 ];
+
+	/* The error granularity
+	 * Consists of 4 bytes
+	 */
+	uint8_t error_granularity[ 4 ];
+
+	/* The number of chunks
+	 * Consists of 8 bytes
+	 */
+	uint8_t number_of_chunks[ 8 ];
+
+	/* The number of sectors
+	 * Consists of 8 bytes
+	 */
+	uint8_t number_of_sectors[ 8 ];
+
+	/* The checksum of the data that follows the header
+	 * Consists of 4 bytes
+	 */
+	uint8_t data_checksum[ 4 ];
+
+	/* The checksum of all (previous) header data
+	 * Consists of 4 bytes
+	 */
+	uint8_t checksum[ 4 ];
+};
+
+/* The index file segment
+ * The segment is followed by the section descriptor offsets
+ * and the chunk groups of the segment file
+ */
+typedef struct ewf_index_file_segment ewf_index_file_segment_t;
+
+struct ewf_index_file_segment
+{
+	/* The segment number
+	 * Consists of 4 bytes
+	 */
+	uint8_t segment_number[ 4 ];
+
+	/* The segment file type
+	 * Consists of 1 byte
+	 */
+	uint8_t type;
+
+	/* The segment file flags
+	 * Consists of 1 byte
+	 */
+	uint8_t flags;
+
+	/* Value to indicate the segment file contains section data
+	 * other than the chunk data and tables
+	 * Consists of 1 byte
+	 */
+	uint8_t has_section_data;
+
+	/* Padding
+	 * Consists of 1 byte
+	 */
+	uint8_t padding1;
+
+	/* The segment file size
+	 * Consists of 8 bytes
+	 */
+	uint8_t segment_file_size[ 8 ];
+
+	/* The segment file modification time
+	 * Consists of 8 bytes
+	 */
+	uint8_t modification_time[ 8 ];
+
+	/* The last section offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t last_section_offset[ 8 ];
+
+	/* The storage media size
+	 * Consists of 8 bytes
+	 */
+	uint8_t storage_media_size[ 8 ];
+
+	/* The number of chunks
+	 * Consists of 8 bytes
+	 */
+	uint8_t number_of_chunks[ 8 ];
+
+	/* The last chunk filled
+	 * Consists of 8 bytes
+	 */
+	uint8_t last_chunk_filled[ 8 ];
+
+	/* The device information section index
+	 * Consists of 4 bytes
+	 */
+	uint8_t device_information_section_index[ 4 ];
+
+	/* The number of sections
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_sections[ 4 ];
+
+	/* The number of chunk groups
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_chunk_groups[ 4 ];
+
+	/* Padding
+	 * Consists of 4 bytes
+	 */
+	uint8_t padding2[ 4 ];
+};
+
+/* The index file section
+ */
+typedef struct ewf_index_file_section ewf_index_file_section_t;
+
+struct ewf_index_file_section
+{
+	/* The section descriptor offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t offset[ 8 ];
+};
+
+/* The index file chunk group
+ */
+typedef struct ewf_index_file_chunk_group ewf_index_file_chunk_group_t;
+
+struct ewf_index_file_chunk_group
+{
+	/* The chunk group (table) offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t offset[ 8 ];
+
+	/* The chunk group (table) size
+	 * Consists of 8 bytes
+	 */
+	uint8_t size[ 8 ];
+
+	/* The storage media size mapped by the chunk group
+	 * Consists of 8 bytes
+	 */
+	uint8_t mapped_size[ 8 ];
+
+	/* The range flags
+	 * Consists of 4 bytes
+	 */
+	uint8_t range_flags[ 4 ];
+
+	/* Padding
+	 * Consists of 4 bytes
+	 */
+	uint8_t padding1[ 4 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EWF_INDEX_FILE_H ) */
+
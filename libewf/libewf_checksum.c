@@ -28,13 +28,405 @@
 #endif
 
 #include "libewf_checksum.h"
+#include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 #include "libewf_types.h"
 
-#if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+#if defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD )
+#include <immintrin.h>
+
+/* Sums the bytes in blocks of 32 bytes, without the modulo calculation
+ * using SSE2
+ */
+__attribute__((target("sse2")))
+static void libewf_checksum_calculate_adler32_blocks_sse2(
+             const uint8_t *buffer,
+             size_t number_of_blocks,
+             uint32_t *lower_word,
+             uint32_t *upper_word )
+{
+	__m128i data_vector             = _mm_setzero_si128();
+	__m128i lower_sum_vector        = _mm_setzero_si128();
+	__m128i previous_sum_vector     = _mm_setzero_si128();
+	__m128i upper_sum_vector        = _mm_setzero_si128();
+	__m128i zero_vector             = _mm_setzero_si128();
+	const __m128i weights_vector1   = _mm_set_epi16( 25, 26, 27, 28, 29, 30, 31, 32 );
+	const __m128i weights_vector2   = _mm_set_epi16( 17, 18, 19, 20, 21, 22, 23, 24 );
+	const __m128i weights_vector3   = _mm_set_epi16( 9, 10, 11, 12, 13, 14, 15, 16 );
+	const __m128i weights_vector4   = _mm_set_epi16( 1, 2, 3, 4, 5, 6, 7, 8 );
+	size_t block_index              = 0;
+	uint32_t lower_sum              = 0;
+	uint32_t previous_sum           = 0;
+	uint32_t upper_sum              = 0;
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		previous_sum_vector = _mm_add_epi32(
+		                       previous_sum_vector,
+		                       lower_sum_vector );
+
+		data_vector = _mm_loadu_si128(
+		               (const __m128i *) buffer );
+
+		lower_sum_vector = _mm_add_epi32(
+		                    lower_sum_vector,
+		                    _mm_sad_epu8(
+		                     data_vector,
+		                     zero_vector ) );
+
+		upper_sum_vector = _mm_add_epi32(
+		                    upper_sum_vector,
+		                    _mm_madd_epi16(
+		                     _mm_unpacklo_epi8(
+		                      data_vector,
+		                      zero_vector ),
+		                     weights_vector1 ) );
+
+		upper_sum_vector = _mm_add_epi32(
+		                    upper_sum_vector,
+		                    _mm_madd_epi16(
+		                     _mm_unpackhi_epi8(
+		                      data_vector,
+		                      zero_vector ),
+		                     weights_vector2 ) );
+
+		data_vector = _mm_loadu_si128(
+		               (const __m128i *) &( buffer[ 16 ] ) );
+
+		lower_sum_vector = _mm_add_epi32(
+		                    lower_sum_vector,
+		                    _mm_sad_epu8(
+		                     data_vector,
+		                     zero_vector ) );
+
+		upper_sum_vector = _mm_add_epi32(
+		                    upper_sum_vector,
+		                    _mm_madd_epi16(
+		                     _mm_unpacklo_epi8(
+		                      data_vector,
+		                      zero_vector ),
+		                     weights_vector3 ) );
+
+		upper_sum_vector = _mm_add_epi32(
+		                    upper_sum_vector,
+		                    _mm_madd_epi16(
+		                     _mm_unpackhi_epi8(
+		                      data_vector,
+		                      zero_vector ),
+		                     weights_vector4 ) );
+
+		buffer += 32;
+	}
+	lower_sum_vector = _mm_add_epi32(
+	                    lower_sum_vector,
+	                    _mm_shuffle_epi32(
+	                     lower_sum_vector,
+	                     0x4e ) );
+	lower_sum_vector = _mm_add_epi32(
+	                    lower_sum_vector,
+	                    _mm_shuffle_epi32(
+	                     lower_sum_vector,
+	                     0xb1 ) );
+	lower_sum = (uint32_t) _mm_cvtsi128_si32(
+	                        lower_sum_vector );
+
+	previous_sum_vector = _mm_add_epi32(
+	                       previous_sum_vector,
+	                       _mm_shuffle_epi32(
+	                        previous_sum_vector,
+	                        0x4e ) );
+	previous_sum_vector = _mm_add_epi32(
+	                       previous_sum_vector,
+	                       _mm_shuffle_epi32(
+	                        previous_sum_vector,
+	                        0xb1 ) );
+	previous_sum = (uint32_t) _mm_cvtsi128_si32(
+	                           previous_sum_vector );
+
+	upper_sum_vector = _mm_add_epi32(
+	                    upper_sum_vector,
+	                    _mm_shuffle_epi32(
+	                     upper_sum_vector,
+	                     0x4e ) );
+	upper_sum_vector = _mm_add_epi32(
+	                    upper_sum_vector,
+	                    _mm_shuffle_epi32(
+	                     upper_sum_vector,
+	                     0xb1 ) );
+	upper_sum = (uint32_t) _mm_cvtsi128_si32(
+	                        upper_sum_vector );
+
+	*upper_word += ( ( ( (uint32_t) number_of_blocks * *lower_word ) + previous_sum ) * 32 ) + upper_sum;
+	*lower_word += lower_sum;
+}
+
+/* Sums the bytes in blocks of 32 bytes, without the modulo calculation
+ * using SSSE3
+ */
+__attribute__((target("ssse3")))
+static void libewf_checksum_calculate_adler32_blocks_ssse3(
+             const uint8_t *buffer,
+             size_t number_of_blocks,
+             uint32_t *lower_word,
+             uint32_t *upper_word )
+{
+	__m128i data_vector             = _mm_setzero_si128();
+	__m128i lower_sum_vector        = _mm_setzero_si128();
+	__m128i previous_sum_vector     = _mm_setzero_si128();
+	__m128i upper_sum_vector        = _mm_setzero_si128();
+	__m128i zero_vector             = _mm_setzero_si128();
+	const __m128i ones_vector       = _mm_set1_epi16( 1 );
+	const __m128i weights_vector1   = _mm_set_epi8( 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32 );
+	const __m128i weights_vector2   = _mm_set_epi8( 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 );
+	size_t block_index              = 0;
+	uint32_t lower_sum              = 0;
+	uint32_t previous_sum           = 0;
+	uint32_t upper_sum              = 0;
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		previous_sum_vector = _mm_add_epi32(
+		                       previous_sum_vector,
+		                       lower_sum_vector );
+
+		data_vector = _mm_loadu_si128(
+		               (const __m128i *) buffer );
+
+		lower_sum_vector = _mm_add_epi32(
+		                    lower_sum_vector,
+		                    _mm_sad_epu8(
+		                     data_vector,
+		                     zero_vector ) );
+
+		upper_sum_vector = _mm_add_epi32(
+		                    upper_sum_vector,
+		                    _mm_madd_epi16(
+		                     _mm_maddubs_epi16(
+		                      data_vector,
+		                      weights_vector1 ),
+		                     ones_vector ) );
+
+		data_vector = _mm_loadu_si128(
+		               (const __m128i *) &( buffer[ 16 ] ) );
+
+		lower_sum_vector = _mm_add_epi32(
+		                    lower_sum_vector,
+		                    _mm_sad_epu8(
+		                     data_vector,
+		                     zero_vector ) );
+
+		upper_sum_vector = _mm_add_epi32(
+		                    upper_sum_vector,
+		                    _mm_madd_epi16(
+		                     _mm_maddubs_epi16(
+		                      data_vector,
+		                      weights_vector2 ),
+		                     ones_vector ) );
+
+		buffer += 32;
+	}
+	lower_sum_vector = _mm_add_epi32(
+	                    lower_sum_vector,
+	                    _mm_shuffle_epi32(
+	                     lower_sum_vector,
+	                     0x4e ) );
+	lower_sum_vector = _mm_add_epi32(
+	                    lower_sum_vector,
+	                    _mm_shuffle_epi32(
+	                     lower_sum_vector,
+	                     0xb1 ) );
+	lower_sum = (uint32_t) _mm_cvtsi128_si32(
+	                        lower_sum_vector );
+
+	previous_sum_vector = _mm_add_epi32(
+	                       previous_sum_vector,
+	                       _mm_shuffle_epi32(
+	                        previous_sum_vector,
+	                        0x4e ) );
+	previous_sum_vector = _mm_add_epi32(
+	                       previous_sum_vector,
+	                       _mm_shuffle_epi32(
+	                        previous_sum_vector,
+	                        0xb1 ) );
+	previous_sum = (uint32_t) _mm_cvtsi128_si32(
+	                           previous_sum_vector );
+
+	upper_sum_vector = _mm_add_epi32(
+	                    upper_sum_vector,
+	                    _mm_shuffle_epi32(
+	                     upper_sum_vector,
+	                     0x4e ) );
+	upper_sum_vector = _mm_add_epi32(
+	                    upper_sum_vector,
+	                    _mm_shuffle_epi32(
+	                     upper_sum_vector,
+	                     0xb1 ) );
+	upper_sum = (uint32_t) _mm_cvtsi128_si32(
+	                        upper_sum_vector );
+
+	*upper_word += ( ( ( (uint32_t) number_of_blocks * *lower_word ) + previous_sum ) * 32 ) + upper_sum;
+	*lower_word += lower_sum;
+}
+
+/* Sums the bytes in blocks of 32 bytes, without the modulo calculation
+ * using AVX2
+ */
+__attribute__((target("avx2")))
+static void libewf_checksum_calculate_adler32_blocks_avx2(
+             const uint8_t *buffer,
+             size_t number_of_blocks,
+             uint32_t *lower_word,
+             uint32_t *upper_word )
+{
+	__m128i sum_vector              = _mm_setzero_si128();
+	__m256i data_vector             = _mm256_setzero_si256();
+	__m256i lower_sum_vector        = _mm256_setzero_si256();
+	__m256i previous_sum_vector     = _mm256_setzero_si256();
+	__m256i upper_sum_vector        = _mm256_setzero_si256();
+	__m256i zero_vector             = _mm256_setzero_si256();
+	const __m256i ones_vector       = _mm256_set1_epi16( 1 );
+	const __m256i weights_vector    = _mm256_set_epi8( 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32 );
+	size_t block_index              = 0;
+	uint32_t lower_sum              = 0;
+	uint32_t previous_sum           = 0;
+	uint32_t upper_sum              = 0;
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		previous_sum_vector = _mm256_add_epi32(
+		                       previous_sum_vector,
+		                       lower_sum_vector );
+
+		data_vector = _mm256_loadu_si256(
+		               (const __m256i *) buffer );
+
+		lower_sum_vector = _mm256_add_epi32(
+		                    lower_sum_vector,
+		                    _mm256_sad_epu8(
+		                     data_vector,
+		                     zero_vector ) );
+
+		upper_sum_vector = _mm256_add_epi32(
+		                    upper_sum_vector,
+		                    _mm256_madd_epi16(
+		                     _mm256_maddubs_epi16(
+		                      data_vector,
+		                      weights_vector ),
+		                     ones_vector ) );
+
+		buffer += 32;
+	}
+	sum_vector = _mm_add_epi32(
+	              _mm256_castsi256_si128(
+	               lower_sum_vector ),
+	              _mm256_extracti128_si256(
+	               lower_sum_vector,
+	               1 ) );
+	sum_vector = _mm_add_epi32(
+	              sum_vector,
+	              _mm_shuffle_epi32(
+	               sum_vector,
+	               0x4e ) );
+	sum_vector = _mm_add_epi32(
+	              sum_vector,
+	              _mm_shuffle_epi32(
+	               sum_vector,
+	               0xb1 ) );
+	lower_sum = (uint32_t) _mm_cvtsi128_si32(
+	                        sum_vector );
+
+	sum_vector = _mm_add_epi32(
+	              _mm256_castsi256_si128(
+	               previous_sum_vector ),
+	              _mm256_extracti128_si256(
+	               previous_sum_vector,
+	               1 ) );
+	sum_vector = _mm_add_epi32(
+	              sum_vector,
+	              _mm_shuffle_epi32(
+	               sum_vector,
+	               0x4e ) );
+	sum_vector = _mm_add_epi32(
+	              sum_vector,
+	              _mm_shuffle_epi32(
+	               sum_vector,
+	               0xb1 ) );
+	previous_sum = (uint32_t) _mm_cvtsi128_si32(
+	                           sum_vector );
+
+	sum_vector = _mm_add_epi32(
+	              _mm256_castsi256_si128(
+	               upper_sum_vector ),
+	              _mm256_extracti128_si256(
+	               upper_sum_vector,
+	               1 ) );
+	sum_vector = _mm_add_epi32(
+	              sum_vector,
+	              _mm_shuffle_epi32(
+	               sum_vector,
+	               0x4e ) );
+	sum_vector = _mm_add_epi32(
+	              sum_vector,
+	              _mm_shuffle_epi32(
+	               sum_vector,
+	               0xb1 ) );
+	upper_sum = (uint32_t) _mm_cvtsi128_si32(
+	                        sum_vector );
+
+	*upper_word += ( ( ( (uint32_t) number_of_blocks * *lower_word ) + previous_sum ) * 32 ) + upper_sum;
+	*lower_word += lower_sum;
+}
+
+#endif /* defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD ) */
+
+/* Retrieves the Adler-32 block function supported by the CPU
+ * Returns 1 if successful, 0 if not available
+ */
+int libewf_checksum_get_adler32_blocks_function(
+     void (**blocks_function)(
+            const uint8_t *buffer,
+            size_t number_of_blocks,
+            uint32_t *lower_word,
+            uint32_t *upper_word ) )
+{
+	if( blocks_function == NULL )
+	{
+		return( 0 );
+	}
+	*blocks_function = NULL;
+
+#if defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD )
+	__builtin_cpu_init();
+
+	if( __builtin_cpu_supports( "avx2" ) )
+	{
+		*blocks_function = &libewf_checksum_calculate_adler32_blocks_avx2;
+	}
+	else if( __builtin_cpu_supports( "ssse3" ) )
+	{
+		*blocks_function = &libewf_checksum_calculate_adler32_blocks_ssse3;
+	}
+	else if( __builtin_cpu_supports( "sse2" ) )
+	{
+		*blocks_function = &libewf_checksum_calculate_adler32_blocks_sse2;
+	}
+#endif
+	if( *blocks_function == NULL )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
 
 /* Calculates the little-endian Adler-32 of a buffer
  * It uses the initial value to calculate a new Adler-32
+ * The bytes are summed using SIMD instructions when supported by the CPU
  * Returns 1 if successful or -1 on error
  */
 int libewf_checksum_calculate_adler32(
@@ -44,7 +436,17 @@ int libewf_checksum_calculate_adler32(
      uint32_t initial_value,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_checksum_calculate_adler32";
+	void (*blocks_function)(
+	       const uint8_t *buffer,
+	       size_t number_of_blocks,
+	       uint32_t *lower_word,
+	       uint32_t *upper_word ) = NULL;
+
+	static char *function         = "libewf_checksum_calculate_adler32";
+	size_t number_of_blocks       = 0;
+	size_t read_size              = 0;
+	uint32_t lower_word           = 0;
+	uint32_t upper_word           = 0;
 
 	if( checksum_value == NULL )
 	{
@@ -68,7 +470,7 @@ int libewf_checksum_calculate_adler32(
 
 		return( -1 );
 	}
-	if( size > (size_t) UINT_MAX )
+	if( size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
@@ -79,13 +481,78 @@ int libewf_checksum_calculate_adler32(
 
 		return( -1 );
 	}
-	*checksum_value = adler32(
-	                   (uLong) initial_value,
-	                   (const Bytef *) buffer,
-	                   (uInt) size );
+	if( libewf_checksum_get_adler32_blocks_function(
+	     &blocks_function ) != 1 )
+	{
+#if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+		if( size > (size_t) UINT_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		*checksum_value = adler32(
+		                   (uLong) initial_value,
+		                   (const Bytef *) buffer,
+		                   (uInt) size );
+
+		return( 1 );
+#else
+		return( libewf_deflate_calculate_adler32(
+		         checksum_value,
+		         buffer,
+		         size,
+		         initial_value,
+		         error ) );
+#endif
+	}
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	while( size > 0 )
+	{
+		/* The modulo calculation is needed per 5552 (0x15b0) bytes
+		 * which is rounded down to a multiple of the 32 byte block size
+		 */
+		read_size = size;
+
+		if( read_size > LIBEWF_CHECKSUM_ADLER32_MAXIMUM_READ_SIZE )
+		{
+			read_size = LIBEWF_CHECKSUM_ADLER32_MAXIMUM_READ_SIZE;
+		}
+		size -= read_size;
+
+		number_of_blocks = read_size / 32;
+
+		if( number_of_blocks > 0 )
+		{
+			blocks_function(
+			 buffer,
+			 number_of_blocks,
+			 &lower_word,
+			 &upper_word );
+
+			buffer    += number_of_blocks * 32;
+			read_size -= number_of_blocks * 32;
+		}
+		while( read_size > 0 )
+		{
+			lower_word += *buffer;
+			upper_word += lower_word;
+
+			buffer++;
+			read_size--;
+		}
+		lower_word %= 65521;
+		upper_word %= 65521;
+	}
+	*checksum_value = ( upper_word << 16 ) | lower_word;
 
 	return( 1 );
 }
 
-#endif /* defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
-
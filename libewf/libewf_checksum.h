@@ -32,7 +32,23 @@
 extern "C" {
 #endif
 
-#if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+/* The SIMD Adler-32 functions require the GCC or Clang target attribute
+ */
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( ( __GNUC__ > 4 ) || ( ( __GNUC__ == 4 ) && ( __GNUC_MINOR__ >= 9 ) ) ) ) )
+#define HAVE_LIBEWF_CHECKSUM_X86_SIMD
+#endif
+
+/* The maximum number of bytes that can be summed before the modulo calculation
+ * is needed, 5552 rounded down to a multiple of 32
+ */
+#define LIBEWF_CHECKSUM_ADLER32_MAXIMUM_READ_SIZE	5536
+
+int libewf_checksum_get_adler32_blocks_function(
+     void (**blocks_function)(
+            const uint8_t *buffer,
+            size_t number_of_blocks,
+            uint32_t *lower_word,
+            uint32_t *upper_word ) );
 
 int libewf_checksum_calculate_adler32(
      uint32_t *checksum_value,
@@ -41,12 +57,6 @@ int libewf_checksum_calculate_adler32(
      uint32_t initial_value,
      libcerror_error_t **error );
 
-#else
-#define libewf_checksum_calculate_adler32( checksum_value, buffer, size, initial_value, error ) \
-	libewf_deflate_calculate_adler32( checksum_value, buffer, size, initial_value, error )
-
-#endif /* defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
-
 #if defined( __cplusplus )
 }
 #endif
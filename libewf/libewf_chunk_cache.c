@@ -0,0 +1,919 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_cache.h"
+#include "libewf_chunk_data.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+
+/* Retrieves the queue of a specific type
+ * Returns the queue or NULL if not available
+ */
+static libewf_chunk_cache_queue_t *libewf_chunk_cache_get_queue(
+                                    libewf_chunk_cache_t *chunk_cache,
+                                    uint8_t queue_type )
+{
+	switch( queue_type )
+	{
+		case LIBEWF_CHUNK_CACHE_QUEUE_TYPE_RECENT:
+			return( &( chunk_cache->recent_queue ) );
+
+		case LIBEWF_CHUNK_CACHE_QUEUE_TYPE_FREQUENT:
+			return( &( chunk_cache->frequent_queue ) );
+
+		case LIBEWF_CHUNK_CACHE_QUEUE_TYPE_GHOST:
+			return( &( chunk_cache->ghost_queue ) );
+
+		default:
+			break;
+	}
+	return( NULL );
+}
+
+/* Prepends an entry to the queue of a specific type
+ */
+static void libewf_chunk_cache_queue_prepend_entry(
+             libewf_chunk_cache_t *chunk_cache,
+             uint8_t queue_type,
+             libewf_chunk_cache_entry_t *entry )
+{
+	libewf_chunk_cache_queue_t *queue = NULL;
+
+	queue = libewf_chunk_cache_get_queue(
+	         chunk_cache,
+	         queue_type );
+
+	entry->queue_type     = queue_type;
+	entry->previous_entry = NULL;
+	entry->next_entry     = queue->first_entry;
+
+	if( queue->first_entry != NULL )
+	{
+		queue->first_entry->previous_entry = entry;
+	}
+	queue->first_entry = entry;
+
+	if( queue->last_entry == NULL )
+	{
+		queue->last_entry = entry;
+	}
+	queue->number_of_entries += 1;
+	queue->memory_size       += entry->memory_size;
+}
+
+/* Removes an entry from its queue
+ */
+static void libewf_chunk_cache_queue_remove_entry(
+             libewf_chunk_cache_t *chunk_cache,
+             libewf_chunk_cache_entry_t *entry )
+{
+	libewf_chunk_cache_queue_t *queue = NULL;
+
+	queue = libewf_chunk_cache_get_queue(
+	         chunk_cache,
+	         entry->queue_type );
+
+	if( entry->previous_entry != NULL )
+	{
+		entry->previous_entry->next_entry = entry->next_entry;
+	}
+	else
+	{
+		queue->first_entry = entry->next_entry;
+	}
+	if( entry->next_entry != NULL )
+	{
+		entry->next_entry->previous_entry = entry->previous_entry;
+	}
+	else
+	{
+		queue->last_entry = entry->previous_entry;
+	}
+	entry->previous_entry = NULL;
+	entry->next_entry     = NULL;
+
+	queue->number_of_entries -= 1;
+	queue->memory_size       -= entry->memory_size;
+}
+
+/* Retrieves the entry of a specific chunk from the hash table
+ * Returns the entry or NULL if not available
+ */
+static libewf_chunk_cache_entry_t *libewf_chunk_cache_hash_table_get_entry(
+                                    libewf_chunk_cache_t *chunk_cache,
+                                    uint64_t chunk_index )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	int bucket_index                  = 0;
+
+	bucket_index = (int) ( chunk_index % (uint64_t) chunk_cache->number_of_hash_table_buckets );
+
+	for( entry = chunk_cache->hash_table[ bucket_index ];
+	     entry != NULL;
+	     entry = entry->next_hash_entry )
+	{
+		if( entry->chunk_index == chunk_index )
+		{
+			break;
+		}
+	}
+	return( entry );
+}
+
+/* Removes an entry from the hash table
+ */
+static void libewf_chunk_cache_hash_table_remove_entry(
+             libewf_chunk_cache_t *chunk_cache,
+             libewf_chunk_cache_entry_t *entry )
+{
+	libewf_chunk_cache_entry_t **hash_entry = NULL;
+	int bucket_index                        = 0;
+
+	bucket_index = (int) ( entry->chunk_index % (uint64_t) chunk_cache->number_of_hash_table_buckets );
+
+	for( hash_entry = &( chunk_cache->hash_table[ bucket_index ] );
+	     *hash_entry != NULL;
+	     hash_entry = &( ( *hash_entry )->next_hash_entry ) )
+	{
+		if( *hash_entry == entry )
+		{
+			*hash_entry = entry->next_hash_entry;
+
+			break;
+		}
+	}
+	entry->next_hash_entry = NULL;
+}
+
+/* Frees the chunk data of an entry
+ * Chunk data that is referenced by a chunk view is detached instead
+ * and freed when the last chunk view is released
+ */
+static void libewf_chunk_cache_free_entry_chunk_data(
+             libewf_chunk_cache_entry_t *entry )
+{
+	if( entry->chunk_data == NULL )
+	{
+		return;
+	}
+	if( entry->chunk_data->number_of_references > 0 )
+	{
+		entry->chunk_data->is_detached = 1;
+		entry->chunk_data              = NULL;
+	}
+	else
+	{
+		libewf_chunk_data_free(
+		 &( entry->chunk_data ),
+		 NULL );
+	}
+}
+
+/* Removes and frees an entry
+ */
+static void libewf_chunk_cache_free_entry(
+             libewf_chunk_cache_t *chunk_cache,
+             libewf_chunk_cache_entry_t *entry )
+{
+	libewf_chunk_cache_queue_remove_entry(
+	 chunk_cache,
+	 entry );
+
+	libewf_chunk_cache_hash_table_remove_entry(
+	 chunk_cache,
+	 entry );
+
+	libewf_chunk_cache_free_entry_chunk_data(
+	 entry );
+
+	memory_free(
+	 entry );
+}
+
+/* Evicts chunks until the cache fits the maximum memory size
+ * The entry that must be kept is never evicted
+ */
+static void libewf_chunk_cache_evict(
+             libewf_chunk_cache_t *chunk_cache,
+             libewf_chunk_cache_entry_t *keep_entry )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	size64_t maximum_recent_size      = 0;
+	int maximum_number_of_ghosts      = 0;
+
+	/* The recent queue is allowed to use 1/4 of the maximum memory size
+	 */
+	maximum_recent_size = chunk_cache->maximum_memory_size / 4;
+
+	while( ( chunk_cache->recent_queue.memory_size + chunk_cache->frequent_queue.memory_size ) > chunk_cache->maximum_memory_size )
+	{
+		entry = NULL;
+
+		if( ( chunk_cache->recent_queue.last_entry != NULL )
+		 && ( chunk_cache->recent_queue.last_entry != keep_entry ) )
+		{
+			if( ( chunk_cache->recent_queue.memory_size > maximum_recent_size )
+			 || ( chunk_cache->frequent_queue.last_entry == NULL )
+			 || ( chunk_cache->frequent_queue.last_entry == keep_entry ) )
+			{
+				entry = chunk_cache->recent_queue.last_entry;
+			}
+		}
+		if( entry != NULL )
+		{
+			/* Keep the chunk index of chunks evicted from the recent queue as a ghost
+			 */
+			libewf_chunk_cache_queue_remove_entry(
+			 chunk_cache,
+			 entry );
+
+			libewf_chunk_cache_free_entry_chunk_data(
+			 entry );
+
+			entry->memory_size = sizeof( libewf_chunk_cache_entry_t );
+
+			libewf_chunk_cache_queue_prepend_entry(
+			 chunk_cache,
+			 LIBEWF_CHUNK_CACHE_QUEUE_TYPE_GHOST,
+			 entry );
+
+			continue;
+		}
+		entry = chunk_cache->frequent_queue.last_entry;
+
+		if( ( entry == NULL )
+		 || ( entry == keep_entry ) )
+		{
+			break;
+		}
+		libewf_chunk_cache_free_entry(
+		 chunk_cache,
+		 entry );
+	}
+	/* The ghost queue remembers as many chunks as are resident
+	 */
+	maximum_number_of_ghosts = chunk_cache->recent_queue.number_of_entries
+	                         + chunk_cache->frequent_queue.number_of_entries;
+
+	if( maximum_number_of_ghosts < 16 )
+	{
+		maximum_number_of_ghosts = 16;
+	}
+	while( chunk_cache->ghost_queue.number_of_entries > maximum_number_of_ghosts )
+	{
+		libewf_chunk_cache_free_entry(
+		 chunk_cache,
+		 chunk_cache->ghost_queue.last_entry );
+	}
+}
+
+/* Resizes the hash table
+ * Returns 1 if successful or -1 on error
+ */
+static int libewf_chunk_cache_resize_hash_table(
+            libewf_chunk_cache_t *chunk_cache,
+            int number_of_hash_table_buckets,
+            libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t **hash_table = NULL;
+	libewf_chunk_cache_entry_t *entry       = NULL;
+	libewf_chunk_cache_entry_t *next_entry  = NULL;
+	static char *function                   = "libewf_chunk_cache_resize_hash_table";
+	int bucket_index                        = 0;
+
+	if( ( number_of_hash_table_buckets <= 0 )
+	 || ( (size_t) number_of_hash_table_buckets > (size_t) ( SSIZE_MAX / sizeof( libewf_chunk_cache_entry_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of hash table buckets value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	hash_table = (libewf_chunk_cache_entry_t **) memory_allocate(
+	                                              sizeof( libewf_chunk_cache_entry_t * ) * number_of_hash_table_buckets );
+
+	if( hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash table.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     hash_table,
+	     0,
+	     sizeof( libewf_chunk_cache_entry_t * ) * number_of_hash_table_buckets ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash table.",
+		 function );
+
+		memory_free(
+		 hash_table );
+
+		return( -1 );
+	}
+	if( chunk_cache->hash_table != NULL )
+	{
+		for( bucket_index = 0;
+		     bucket_index < chunk_cache->number_of_hash_table_buckets;
+		     bucket_index++ )
+		{
+			entry = chunk_cache->hash_table[ bucket_index ];
+
+			while( entry != NULL )
+			{
+				next_entry = entry->next_hash_entry;
+
+				entry->next_hash_entry = hash_table[ entry->chunk_index % (uint64_t) number_of_hash_table_buckets ];
+
+				hash_table[ entry->chunk_index % (uint64_t) number_of_hash_table_buckets ] = entry;
+
+				entry = next_entry;
+			}
+		}
+		memory_free(
+		 chunk_cache->hash_table );
+	}
+	chunk_cache->hash_table                   = hash_table;
+	chunk_cache->number_of_hash_table_buckets = number_of_hash_table_buckets;
+
+	return( 1 );
+}
+
+/* Creates a chunk cache
+ * Make sure the value chunk_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     size64_t maximum_memory_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_initialize";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_cache = memory_allocate_structure(
+	                libewf_chunk_cache_t );
+
+	if( *chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_cache,
+	     0,
+	     sizeof( libewf_chunk_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk cache.",
+		 function );
+
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+
+		return( -1 );
+	}
+	if( libewf_chunk_cache_resize_hash_table(
+	     *chunk_cache,
+	     LIBEWF_CHUNK_CACHE_NUMBER_OF_HASH_TABLE_BUCKETS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create hash table.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_cache )->maximum_memory_size = maximum_memory_size;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_cache != NULL )
+	{
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_free";
+	int result            = 1;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+		if( libewf_chunk_cache_empty(
+		     *chunk_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty chunk cache.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *chunk_cache )->hash_table );
+
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+	}
+	return( result );
+}
+
+/* Empties a chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_empty(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_empty";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	while( chunk_cache->recent_queue.last_entry != NULL )
+	{
+		libewf_chunk_cache_free_entry(
+		 chunk_cache,
+		 chunk_cache->recent_queue.last_entry );
+	}
+	while( chunk_cache->frequent_queue.last_entry != NULL )
+	{
+		libewf_chunk_cache_free_entry(
+		 chunk_cache,
+		 chunk_cache->frequent_queue.last_entry );
+	}
+	while( chunk_cache->ghost_queue.last_entry != NULL )
+	{
+		libewf_chunk_cache_free_entry(
+		 chunk_cache,
+		 chunk_cache->ghost_queue.last_entry );
+	}
+	return( 1 );
+}
+
+/* Retrieves the maximum memory size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_get_maximum_memory_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t *maximum_memory_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_get_maximum_memory_size";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_memory_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum memory size.",
+		 function );
+
+		return( -1 );
+	}
+	*maximum_memory_size = chunk_cache->maximum_memory_size;
+
+	return( 1 );
+}
+
+/* Sets the maximum memory size
+ * Chunks are evicted if the cache no longer fits
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_set_maximum_memory_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t maximum_memory_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_set_maximum_memory_size";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_cache->maximum_memory_size = maximum_memory_size;
+
+	libewf_chunk_cache_evict(
+	 chunk_cache,
+	 NULL );
+
+	return( 1 );
+}
+
+/* Retrieves the chunk data of a specific chunk
+ * The chunk data remains managed by the cache and is valid until the next call
+ * to libewf_chunk_cache_set_chunk_data or libewf_chunk_cache_empty
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_chunk_cache_get_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_get_chunk_data";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	entry = libewf_chunk_cache_hash_table_get_entry(
+	         chunk_cache,
+	         chunk_index );
+
+	if( ( entry == NULL )
+	 || ( entry->chunk_data == NULL ) )
+	{
+		chunk_cache->number_of_misses += 1;
+
+		return( 0 );
+	}
+	/* References in the recent queue are considered correlated and do not promote the chunk
+	 */
+	if( entry->queue_type == LIBEWF_CHUNK_CACHE_QUEUE_TYPE_FREQUENT )
+	{
+		libewf_chunk_cache_queue_remove_entry(
+		 chunk_cache,
+		 entry );
+
+		libewf_chunk_cache_queue_prepend_entry(
+		 chunk_cache,
+		 LIBEWF_CHUNK_CACHE_QUEUE_TYPE_FREQUENT,
+		 entry );
+	}
+	chunk_cache->number_of_hits += 1;
+
+	*chunk_data = entry->chunk_data;
+
+	return( 1 );
+}
+
+/* Determines if the chunk data of a specific chunk is in the cache
+ * This function does not change the order of the queues or the statistics
+ * Returns 1 if the chunk data is in the cache, 0 if not or -1 on error
+ */
+int libewf_chunk_cache_contains_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_contains_chunk_data";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	entry = libewf_chunk_cache_hash_table_get_entry(
+	         chunk_cache,
+	         chunk_index );
+
+	if( ( entry == NULL )
+	 || ( entry->chunk_data == NULL ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Sets the chunk data of a specific chunk
+ * The cache takes over management of the chunk data if successful
+ * The most recently set chunk data is always kept, even if it exceeds the maximum memory size
+ * Returns 1 if successful, 0 if the chunk is already cached or -1 on error
+ */
+int libewf_chunk_cache_set_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_set_chunk_data";
+	uint8_t queue_type                = LIBEWF_CHUNK_CACHE_QUEUE_TYPE_RECENT;
+	int bucket_index                  = 0;
+	int number_of_entries             = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	entry = libewf_chunk_cache_hash_table_get_entry(
+	         chunk_cache,
+	         chunk_index );
+
+	if( entry != NULL )
+	{
+		if( entry->chunk_data != NULL )
+		{
+			return( 0 );
+		}
+		/* A chunk that is referenced again after being evicted from the recent queue
+		 * is considered frequently used
+		 */
+		libewf_chunk_cache_queue_remove_entry(
+		 chunk_cache,
+		 entry );
+
+		queue_type = LIBEWF_CHUNK_CACHE_QUEUE_TYPE_FREQUENT;
+	}
+	else
+	{
+		number_of_entries = chunk_cache->recent_queue.number_of_entries
+		                  + chunk_cache->frequent_queue.number_of_entries
+		                  + chunk_cache->ghost_queue.number_of_entries;
+
+		if( number_of_entries >= ( chunk_cache->number_of_hash_table_buckets * 2 ) )
+		{
+			if( libewf_chunk_cache_resize_hash_table(
+			     chunk_cache,
+			     chunk_cache->number_of_hash_table_buckets * 2,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to resize hash table.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		entry = memory_allocate_structure(
+		         libewf_chunk_cache_entry_t );
+
+		if( entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entry.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     entry,
+		     0,
+		     sizeof( libewf_chunk_cache_entry_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear entry.",
+			 function );
+
+			memory_free(
+			 entry );
+
+			return( -1 );
+		}
+		entry->chunk_index = chunk_index;
+
+		bucket_index = (int) ( chunk_index % (uint64_t) chunk_cache->number_of_hash_table_buckets );
+
+		entry->next_hash_entry                  = chunk_cache->hash_table[ bucket_index ];
+		chunk_cache->hash_table[ bucket_index ] = entry;
+	}
+	entry->chunk_data  = chunk_data;
+	entry->memory_size = sizeof( libewf_chunk_cache_entry_t )
+	                   + sizeof( libewf_chunk_data_t )
+	                   + chunk_data->allocated_data_size;
+
+	if( chunk_data->compressed_data != NULL )
+	{
+		entry->memory_size += chunk_data->compressed_data_size;
+	}
+	libewf_chunk_cache_queue_prepend_entry(
+	 chunk_cache,
+	 queue_type,
+	 entry );
+
+	libewf_chunk_cache_evict(
+	 chunk_cache,
+	 entry );
+
+	return( 1 );
+}
+
+/* Retrieves the cache statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_get_statistics(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_get_statistics";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_hits   = chunk_cache->number_of_hits;
+	*number_of_misses = chunk_cache->number_of_misses;
+
+	return( 1 );
+}
+
@@ -0,0 +1,185 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_CACHE_H )
+#define _LIBEWF_CHUNK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_cache_entry libewf_chunk_cache_entry_t;
+
+struct libewf_chunk_cache_entry
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data
+	 * Contains NULL for a ghost entry
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The memory size
+	 */
+	size_t memory_size;
+
+	/* The queue type
+	 */
+	uint8_t queue_type;
+
+	/* The previous entry in the queue
+	 */
+	libewf_chunk_cache_entry_t *previous_entry;
+
+	/* The next entry in the queue
+	 */
+	libewf_chunk_cache_entry_t *next_entry;
+
+	/* The next entry in the hash bucket
+	 */
+	libewf_chunk_cache_entry_t *next_hash_entry;
+};
+
+typedef struct libewf_chunk_cache_queue libewf_chunk_cache_queue_t;
+
+struct libewf_chunk_cache_queue
+{
+	/* The first (most recently used) entry
+	 */
+	libewf_chunk_cache_entry_t *first_entry;
+
+	/* The last (least recently used) entry
+	 */
+	libewf_chunk_cache_entry_t *last_entry;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The memory size
+	 */
+	size64_t memory_size;
+};
+
+typedef struct libewf_chunk_cache libewf_chunk_cache_t;
+
+/* The chunk cache uses a 2Q replacement policy:
+ * chunks that are referenced for the first time are kept in the recent (A1in) queue,
+ * chunks that are referenced again after having been evicted from the recent queue
+ * are kept in the frequent (Am) queue. The ghost (A1out) queue only keeps the chunk
+ * index of chunks evicted from the recent queue. This prevents a single sequential
+ * sweep from evicting frequently used chunks.
+ */
+struct libewf_chunk_cache
+{
+	/* The maximum memory size
+	 */
+	size64_t maximum_memory_size;
+
+	/* The hash table
+	 */
+	libewf_chunk_cache_entry_t **hash_table;
+
+	/* The number of hash table buckets
+	 */
+	int number_of_hash_table_buckets;
+
+	/* The recent queue
+	 */
+	libewf_chunk_cache_queue_t recent_queue;
+
+	/* The frequent queue
+	 */
+	libewf_chunk_cache_queue_t frequent_queue;
+
+	/* The ghost queue
+	 */
+	libewf_chunk_cache_queue_t ghost_queue;
+
+	/* The number of hits
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of misses
+	 */
+	uint64_t number_of_misses;
+};
+
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     size64_t maximum_memory_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_empty(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_maximum_memory_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t *maximum_memory_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_set_maximum_memory_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t maximum_memory_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_contains_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_set_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_statistics(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_CACHE_H ) */
+
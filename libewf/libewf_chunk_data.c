@@ -27,6 +27,7 @@
 #include "libewf_checksum.h"
 #include "libewf_chunk_data.h"
 #include "libewf_compression.h"
+#include "libewf_compression_context.h"
 #include "libewf_definitions.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
@@ -35,6 +36,10 @@
 #include "libewf_types.h"
 #include "libewf_unused.h"
 
+#if defined( HAVE_LIBEWF_CHUNK_DATA_X86_SIMD )
+#include <immintrin.h>
+#endif
+
 #if !defined( LIBEWF_ATTRIBUTE_FALLTHROUGH )
 #if defined( __GNUC__ ) && __GNUC__ >= 7
 #define LIBEWF_ATTRIBUTE_FALLTHROUGH	__attribute__ ((fallthrough))
@@ -302,8 +307,11 @@ int libewf_chunk_data_clone(
 
 		return( -1 );
 	}
-	( *destination_chunk_data )->data            = NULL;
-	( *destination_chunk_data )->compressed_data = NULL;
+	( *destination_chunk_data )->data                 = NULL;
+	( *destination_chunk_data )->compressed_data      = NULL;
+	( *destination_chunk_data )->number_of_references = 0;
+	( *destination_chunk_data )->is_detached          = 0;
+	( *destination_chunk_data )->is_shared            = 0;
 
 	if( source_chunk_data->data != NULL )
 	{
@@ -560,11 +568,13 @@ ssize_t libewf_chunk_data_write_buffer(
 
 /* Packs the chunk data
  * This function either adds the checksum or compresses the chunk data
+ * The compression context is optional and is reused between chunks when provided
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_data_pack(
      libewf_chunk_data_t *chunk_data,
      libewf_io_handle_t *io_handle,
+     libewf_compression_context_t *compression_context,
      const uint8_t *compressed_zero_byte_empty_block,
      size_t compressed_zero_byte_empty_block_size,
      uint8_t pack_flags,
@@ -628,8 +638,15 @@ int libewf_chunk_data_pack(
 	{
 		return( 1 );
 	}
+	/* Zero byte chunks are also detected when compression is enabled, without empty block
+	 * compression, so that the compressed zero byte empty block is used instead of compressing
+	 * the chunk data, which results in the same compressed data
+	 */
 	if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
-	 || ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 ) )
+	 || ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 )
+	 || ( ( io_handle->compression_level != LIBEWF_COMPRESSION_NONE )
+	  &&  ( chunk_data->data_size == (size_t) chunk_data->chunk_size )
+	  &&  ( compressed_zero_byte_empty_block != NULL ) ) )
 	{
 		if( ( chunk_data->data_size % 8 ) == 0 )
 		{
@@ -653,7 +670,8 @@ int libewf_chunk_data_pack(
 			else if( result != 0 )
 			{
 				if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 )
-				 || ( fill_pattern == 0 ) )
+				 || ( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
+				  &&  ( fill_pattern == 0 ) ) )
 				{
 					pack_flags &= ~( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
 					pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION;
@@ -667,6 +685,12 @@ int libewf_chunk_data_pack(
 						pack_flags |= LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
 					}
 				}
+				else if( fill_pattern == 0 )
+				{
+					pack_flags &= ~( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
+					pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION;
+					pack_flags |= LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
+				}
 			}
 		}
 		else if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
@@ -817,15 +841,29 @@ int libewf_chunk_data_pack(
 			safe_compressed_data_size = chunk_data->compressed_data_size;
 
 /* TODO add a light weight entropy test */
-			result = libewf_compress_data(
-				  chunk_data->compressed_data,
-				  &safe_compressed_data_size,
-				  io_handle->compression_method,
-				  io_handle->compression_level,
-				  chunk_data->data,
-				  chunk_data->data_size,
-				  error );
-
+			if( compression_context != NULL )
+			{
+				result = libewf_compression_context_compress_data(
+					  compression_context,
+					  chunk_data->compressed_data,
+					  &safe_compressed_data_size,
+					  io_handle->compression_method,
+					  io_handle->compression_level,
+					  chunk_data->data,
+					  chunk_data->data_size,
+					  error );
+			}
+			else
+			{
+				result = libewf_compress_data(
+					  chunk_data->compressed_data,
+					  &safe_compressed_data_size,
+					  io_handle->compression_method,
+					  io_handle->compression_level,
+					  chunk_data->data,
+					  chunk_data->data_size,
+					  error );
+			}
 			if( result == -1 )
 			{
 				libcerror_error_set(
@@ -1360,210 +1398,886 @@ on_error:
 	return( -1 );
 }
 
-/* Checks if a buffer containing the chunk data is filled with same value bytes (empty-block)
- * Returns 1 if a pattern was found, 0 if not or -1 on error
+/* Unpacks the chunk data into a buffer
+ * This function either validates the checksum or decompresses the chunk data
+ * directly into the buffer, the buffer must be able to contain the chunk size
+ * The chunk data itself remains packed, only the corrupted range flag is set
+ * Returns the number of bytes unpacked or -1 on error
  */
-int libewf_chunk_data_check_for_empty_block(
-     const uint8_t *data,
-     size_t data_size,
-     libcerror_error_t **error )
+ssize_t libewf_chunk_data_unpack_buffer(
+         libewf_chunk_data_t *chunk_data,
+         libewf_io_handle_t *io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
 {
-	libewf_aligned_t *aligned_data_index = NULL;
-	libewf_aligned_t *aligned_data_start = NULL;
-	uint8_t *data_index                  = NULL;
-	uint8_t *data_start                  = NULL;
-	static char *function                = "libewf_chunk_data_check_for_empty_block";
+	static char *function        = "libewf_chunk_data_unpack_buffer";
+	size_t data_size             = 0;
+	uint32_t calculated_checksum = 0;
+	uint32_t stored_checksum     = 0;
+	uint8_t copy_data            = 1;
 
-	if( data == NULL )
+	if( chunk_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data.",
+		 "%s: invalid chunk data.",
 		 function );
 
 		return( -1 );
 	}
-	if( data_size > (size_t) SSIZE_MAX )
+	if( chunk_data->data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid data size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk data - missing data.",
 		 function );
 
 		return( -1 );
 	}
-	if( data_size == 0 )
-	{
-		return( 0 );
-	}
-	else if( data_size == 1 )
-	{
-		return( 1 );
-	}
-	data_start = (uint8_t *) data;
-	data_index = (uint8_t *) data + 1;
-
-	data_size--;
-
-	/* Only optimize for data larger than the alignment
-	 */
-	if( data_size > ( sizeof( libewf_aligned_t ) + sizeof( libewf_aligned_t ) ) )
-	{
-		/* Align the data start
-		 */
-		while( ( (intptr_t) data_start % sizeof( libewf_aligned_t ) ) != 0 )
-		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_start++;
-			data_index++;
-			data_size--;
-		}
-		/* Align the data index
-		 */
-		while( ( (intptr_t) data_index % sizeof( libewf_aligned_t ) ) != 0 )
-		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_index++;
-			data_size--;
-		}
-		aligned_data_start = (libewf_aligned_t *) data_start;
-		aligned_data_index = (libewf_aligned_t *) data_index;
-
-		while( data_size > sizeof( libewf_aligned_t ) )
-		{
-			if( *aligned_data_start != *aligned_data_index )
-			{
-				return( 0 );
-			}
-			aligned_data_index++;
-
-			data_size -= sizeof( libewf_aligned_t );
-		}
-		data_index = (uint8_t *) aligned_data_index;
-	}
-	while( data_size != 0 )
-	{
-		if( *data_start != *data_index )
-		{
-			return( 0 );
-		}
-		data_index++;
-		data_size--;
-	}
-	return( 1 );
-}
-
-/* Checks if a buffer containing the chunk data is filled with a 64-bit pattern
- * Returns 1 if a pattern was found, 0 if not or -1 on error
- */
-int libewf_chunk_data_check_for_64_bit_pattern_fill(
-     const uint8_t *data,
-     size_t data_size,
-     uint64_t *pattern,
-     libcerror_error_t **error )
-{
-	libewf_aligned_t *aligned_data_index = NULL;
-	libewf_aligned_t *aligned_data_start = NULL;
-	uint8_t *data_index                  = NULL;
-	uint8_t *data_start                  = NULL;
-	static char *function                = "libewf_chunk_data_check_for_64_bit_pattern_fill";
-
-	if( data == NULL )
+	if( io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data.",
+		 "%s: invalid IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( data_size > (size_t) SSIZE_MAX )
+	if( buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid data size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
 		 function );
 
 		return( -1 );
 	}
-	if( pattern == NULL )
+	if( ( buffer_size < (size_t) chunk_data->chunk_size )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid pattern.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( data_size <= 8 )
-	 || ( data_size % 8 ) != 0 )
-	{
-		return( 0 );
-	}
-	data_start = (uint8_t *) data;
-	data_index = (uint8_t *) data + 8;
-	data_size -= 8;
+	data_size = chunk_data->data_size;
 
-	/* Only optimize for data larger than the alignment
-	 */
-	if( data_size > ( sizeof( libewf_aligned_t ) + sizeof( libewf_aligned_t ) ) )
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
 	{
-		/* Align the data start
-		 */
-		while( ( (intptr_t) data_start % sizeof( libewf_aligned_t ) ) != 0 )
+		if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
 		{
-			if( *data_start != *data_index )
+			copy_data = 0;
+
+			if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
 			{
-				return( 0 );
+				if( chunk_data->data_size < (size_t) 8 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid chunk data - data size value out of bounds.",
+					 function );
+
+					return( -1 );
+				}
+				data_size = (size_t) chunk_data->chunk_size;
+
+				if( libewf_chunk_data_fill_buffer(
+				     buffer,
+				     data_size,
+				     chunk_data->data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to fill buffer with pattern.",
+					 function );
+
+					return( -1 );
+				}
 			}
-			data_start++;
-			data_index++;
-			data_size--;
-		}
-		/* Align the data index
-		 */
-		while( ( (intptr_t) data_index % sizeof( libewf_aligned_t ) ) != 0 )
-		{
-			if( *data_start != *data_index )
+			else
 			{
-				return( 0 );
+				data_size = (size_t) chunk_data->chunk_size;
+
+				if( libewf_decompress_data(
+				     chunk_data->data,
+				     chunk_data->data_size,
+				     io_handle->compression_method,
+				     buffer,
+				     &data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+					 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+					 "%s: unable to decompress chunk data.",
+					 function );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						if( ( error != NULL )
+						 && ( *error != NULL ) )
+						{
+							libcnotify_print_error_backtrace(
+							 *error );
+						}
+					}
+#endif
+					libcerror_error_free(
+					 error );
+
+					data_size                = (size_t) chunk_data->chunk_size;
+					chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+
+					if( memory_set(
+					     buffer,
+					     0,
+					     data_size ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+						 "%s: unable to clear buffer.",
+						 function );
+
+						return( -1 );
+					}
+				}
 			}
-			data_index++;
-			data_size--;
 		}
-		aligned_data_start = (libewf_aligned_t *) data_start;
-		aligned_data_index = (libewf_aligned_t *) data_index;
-
-		while( data_size > sizeof( libewf_aligned_t ) )
+		else if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
 		{
-			if( *aligned_data_start != *aligned_data_index )
+			if( chunk_data->data_size < 4 )
 			{
-				return( 0 );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid chunk data - data size value out of bounds.",
+				 function );
+
+				return( -1 );
 			}
-			aligned_data_start++;
-			aligned_data_index++;
+			data_size = chunk_data->data_size - 4;
 
-			data_size -= sizeof( libewf_aligned_t );
-		}
-		data_start = (uint8_t *) aligned_data_start;
-		data_index = (uint8_t *) aligned_data_index;
-	}
+			if( ( chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET ) == 0 )
+			{
+				byte_stream_copy_to_uint32_little_endian(
+				 &( ( chunk_data->data )[ data_size ] ),
+				 stored_checksum );
+			}
+			else
+			{
+				stored_checksum = chunk_data->checksum;
+			}
+			if( libewf_checksum_calculate_adler32(
+			     &calculated_checksum,
+			     chunk_data->data,
+			     data_size,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to calculate checksum.",
+				 function );
+
+				return( -1 );
+			}
+			if( stored_checksum != calculated_checksum )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: chunk data checksum does not match (stored: 0x%08" PRIx32 ", calculated: 0x%08" PRIx32 ").\n",
+					 function,
+					 stored_checksum,
+					 calculated_checksum );
+				}
+#endif
+				data_size                = (size_t) chunk_data->chunk_size;
+				chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+			}
+		}
+	}
+	if( data_size > buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data - data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	 && ( io_handle->zero_on_error != 0 ) )
+	{
+		if( memory_set(
+		     buffer,
+		     0,
+		     data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to zero chunk data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( copy_data != 0 )
+	{
+		if( memory_copy(
+		     buffer,
+		     chunk_data->data,
+		     data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy chunk data to buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( (ssize_t) data_size );
+}
+
+/* Fills a buffer with an 8-byte fill pattern
+ * A fill pattern of 0-byte values is set directly, other fill patterns
+ * are expanded by copying the part of the buffer that is already filled
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_fill_buffer(
+     uint8_t *buffer,
+     size_t buffer_size,
+     const uint8_t *fill_pattern,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_fill_buffer";
+	size_t buffer_offset  = 0;
+	size_t copy_size      = 0;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( fill_pattern == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fill pattern.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( fill_pattern[ 0 ] | fill_pattern[ 1 ] | fill_pattern[ 2 ] | fill_pattern[ 3 ]
+	    | fill_pattern[ 4 ] | fill_pattern[ 5 ] | fill_pattern[ 6 ] | fill_pattern[ 7 ] ) == 0 )
+	{
+		if( memory_set(
+		     buffer,
+		     0,
+		     buffer_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear buffer.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	copy_size = 8;
+
+	while( buffer_offset < buffer_size )
+	{
+		if( copy_size > ( buffer_size - buffer_offset ) )
+		{
+			copy_size = buffer_size - buffer_offset;
+		}
+		if( memory_copy(
+		     &( buffer[ buffer_offset ] ),
+		     ( buffer_offset == 0 ) ? fill_pattern : buffer,
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy fill pattern to buffer.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset += copy_size;
+		copy_size      = buffer_offset;
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_LIBEWF_CHUNK_DATA_X86_SIMD )
+
+/* Compares 32-byte blocks with a 64-bit fill pattern using SSE2
+ * Returns 1 if the blocks only contain the fill pattern or 0 if not
+ */
+__attribute__((target("sse2")))
+static int libewf_chunk_data_compare_fill_blocks_sse2(
+            const uint8_t *data,
+            size_t number_of_blocks,
+            uint64_t fill_pattern )
+{
+	__m128i difference_vector = _mm_setzero_si128();
+	__m128i fill_vector       = _mm_set1_epi64x( (long long) fill_pattern );
+	__m128i zero_vector       = _mm_setzero_si128();
+	size_t data_offset        = 0;
+	size_t read_size          = 0;
+
+	while( number_of_blocks > 0 )
+	{
+		/* Combine the differences of 4 blocks to reduce the number of branches
+		 */
+		if( number_of_blocks >= 4 )
+		{
+			read_size = 128;
+		}
+		else
+		{
+			read_size = 32;
+		}
+		difference_vector = zero_vector;
+
+		for( data_offset = 0;
+		     data_offset < read_size;
+		     data_offset += 16 )
+		{
+			difference_vector = _mm_or_si128(
+			                     difference_vector,
+			                     _mm_xor_si128(
+			                      _mm_loadu_si128(
+			                       (const __m128i *) &( data[ data_offset ] ) ),
+			                      fill_vector ) );
+		}
+		if( _mm_movemask_epi8(
+		     _mm_cmpeq_epi8(
+		      difference_vector,
+		      zero_vector ) ) != 0xffff )
+		{
+			return( 0 );
+		}
+		data             += read_size;
+		number_of_blocks -= read_size / 32;
+	}
+	return( 1 );
+}
+
+/* Compares 32-byte blocks with a 64-bit fill pattern using AVX2
+ * Returns 1 if the blocks only contain the fill pattern or 0 if not
+ */
+__attribute__((target("avx2")))
+static int libewf_chunk_data_compare_fill_blocks_avx2(
+            const uint8_t *data,
+            size_t number_of_blocks,
+            uint64_t fill_pattern )
+{
+	__m256i difference_vector = _mm256_setzero_si256();
+	__m256i fill_vector       = _mm256_set1_epi64x( (long long) fill_pattern );
+	size_t data_offset        = 0;
+	size_t read_size          = 0;
+
+	while( number_of_blocks > 0 )
+	{
+		/* Combine the differences of 4 blocks to reduce the number of branches
+		 */
+		if( number_of_blocks >= 4 )
+		{
+			read_size = 128;
+		}
+		else
+		{
+			read_size = 32;
+		}
+		difference_vector = _mm256_setzero_si256();
+
+		for( data_offset = 0;
+		     data_offset < read_size;
+		     data_offset += 32 )
+		{
+			difference_vector = _mm256_or_si256(
+			                     difference_vector,
+			                     _mm256_xor_si256(
+			                      _mm256_loadu_si256(
+			                       (const __m256i *) &( data[ data_offset ] ) ),
+			                      fill_vector ) );
+		}
+		if( _mm256_testz_si256(
+		     difference_vector,
+		     difference_vector ) == 0 )
+		{
+			return( 0 );
+		}
+		data             += read_size;
+		number_of_blocks -= read_size / 32;
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_CHUNK_DATA_X86_SIMD ) */
+
+/* Retrieves the fill pattern block compare function supported by the CPU
+ * Returns 1 if successful, 0 if not available
+ */
+int libewf_chunk_data_get_compare_fill_blocks_function(
+     int (**compare_fill_blocks_function)(
+            const uint8_t *data,
+            size_t number_of_blocks,
+            uint64_t fill_pattern ) )
+{
+	if( compare_fill_blocks_function == NULL )
+	{
+		return( 0 );
+	}
+	*compare_fill_blocks_function = NULL;
+
+#if defined( HAVE_LIBEWF_CHUNK_DATA_X86_SIMD )
+	__builtin_cpu_init();
+
+	if( __builtin_cpu_supports( "avx2" ) )
+	{
+		*compare_fill_blocks_function = &libewf_chunk_data_compare_fill_blocks_avx2;
+	}
+	else if( __builtin_cpu_supports( "sse2" ) )
+	{
+		*compare_fill_blocks_function = &libewf_chunk_data_compare_fill_blocks_sse2;
+	}
+#endif
+	if( *compare_fill_blocks_function == NULL )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Compares data with a 64-bit fill pattern
+ * The data must start at a multiple of 8 bytes relative to the start of the fill pattern
+ * Returns 1 if the data only contains the fill pattern or 0 if not
+ */
+static int libewf_chunk_data_compare_fill_pattern(
+            const uint8_t *data,
+            size_t data_size,
+            const uint8_t *fill_pattern )
+{
+	size_t data_offset = 0;
+
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		if( data[ data_offset ] != fill_pattern[ data_offset % 8 ] )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Checks if a buffer containing the chunk data is filled with same value bytes (empty-block)
+ * Returns 1 if a pattern was found, 0 if not or -1 on error
+ */
+int libewf_chunk_data_check_for_empty_block(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t fill_pattern[ 8 ];
+
+	int (*compare_fill_blocks_function)(
+	       const uint8_t *data,
+	       size_t number_of_blocks,
+	       uint64_t fill_pattern ) = NULL;
+
+	libewf_aligned_t *aligned_data_index = NULL;
+	libewf_aligned_t *aligned_data_start = NULL;
+	uint8_t *data_index                  = NULL;
+	uint8_t *data_start                  = NULL;
+	static char *function                = "libewf_chunk_data_check_for_empty_block";
+	size_t check_size                    = 0;
+	size_t data_offset                   = 0;
+	size_t number_of_blocks              = 0;
+	uint64_t fill_value                  = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == 0 )
+	{
+		return( 0 );
+	}
+	else if( data_size == 1 )
+	{
+		return( 1 );
+	}
+	if( memory_set(
+	     fill_pattern,
+	     data[ 0 ],
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to set fill pattern.",
+		 function );
+
+		return( -1 );
+	}
+	/* Data that is not an empty block most likely differs in the first or last cache line
+	 */
+	check_size = data_size;
+
+	if( check_size > LIBEWF_CHUNK_DATA_FILL_CHECK_CACHE_LINE_SIZE )
+	{
+		check_size = LIBEWF_CHUNK_DATA_FILL_CHECK_CACHE_LINE_SIZE;
+	}
+	if( libewf_chunk_data_compare_fill_pattern(
+	     data,
+	     check_size,
+	     fill_pattern ) == 0 )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_data_compare_fill_pattern(
+	     &( data[ data_size - check_size ] ),
+	     check_size,
+	     fill_pattern ) == 0 )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_data_get_compare_fill_blocks_function(
+	     &compare_fill_blocks_function ) == 1 )
+	{
+		fill_value = (uint64_t) data[ 0 ] * 0x0101010101010101ULL;
+
+		number_of_blocks = data_size / 32;
+
+		if( compare_fill_blocks_function(
+		     data,
+		     number_of_blocks,
+		     fill_value ) == 0 )
+		{
+			return( 0 );
+		}
+		data_offset = number_of_blocks * 32;
+
+		return( libewf_chunk_data_compare_fill_pattern(
+		         &( data[ data_offset ] ),
+		         data_size - data_offset,
+		         fill_pattern ) );
+	}
+	data_start = (uint8_t *) data;
+	data_index = (uint8_t *) data + 1;
+
+	data_size--;
+
+	/* Only optimize for data larger than the alignment
+	 */
+	if( data_size > ( sizeof( libewf_aligned_t ) + sizeof( libewf_aligned_t ) ) )
+	{
+		/* Align the data start
+		 */
+		while( ( (intptr_t) data_start % sizeof( libewf_aligned_t ) ) != 0 )
+		{
+			if( *data_start != *data_index )
+			{
+				return( 0 );
+			}
+			data_start++;
+			data_index++;
+			data_size--;
+		}
+		/* Align the data index
+		 */
+		while( ( (intptr_t) data_index % sizeof( libewf_aligned_t ) ) != 0 )
+		{
+			if( *data_start != *data_index )
+			{
+				return( 0 );
+			}
+			data_index++;
+			data_size--;
+		}
+		aligned_data_start = (libewf_aligned_t *) data_start;
+		aligned_data_index = (libewf_aligned_t *) data_index;
+
+		while( data_size > sizeof( libewf_aligned_t ) )
+		{
+			if( *aligned_data_start != *aligned_data_index )
+			{
+				return( 0 );
+			}
+			aligned_data_index++;
+
+			data_size -= sizeof( libewf_aligned_t );
+		}
+		data_index = (uint8_t *) aligned_data_index;
+	}
+	while( data_size != 0 )
+	{
+		if( *data_start != *data_index )
+		{
+			return( 0 );
+		}
+		data_index++;
+		data_size--;
+	}
+	return( 1 );
+}
+
+/* Checks if a buffer containing the chunk data is filled with a 64-bit pattern
+ * Returns 1 if a pattern was found, 0 if not or -1 on error
+ */
+int libewf_chunk_data_check_for_64_bit_pattern_fill(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t *pattern,
+     libcerror_error_t **error )
+{
+	int (*compare_fill_blocks_function)(
+	       const uint8_t *data,
+	       size_t number_of_blocks,
+	       uint64_t fill_pattern ) = NULL;
+
+	libewf_aligned_t *aligned_data_index = NULL;
+	libewf_aligned_t *aligned_data_start = NULL;
+	uint8_t *data_index                  = NULL;
+	uint8_t *data_start                  = NULL;
+	static char *function                = "libewf_chunk_data_check_for_64_bit_pattern_fill";
+	size_t check_size                    = 0;
+	size_t data_offset                   = 0;
+	size_t number_of_blocks              = 0;
+	uint64_t fill_value                  = 0;
+	int result                           = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( pattern == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pattern.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size <= 8 )
+	 || ( data_size % 8 ) != 0 )
+	{
+		return( 0 );
+	}
+	/* Data that is not filled with a pattern most likely differs in the first or last cache line
+	 * Since the data size is a multiple of 8 the last cache line starts at a multiple of 8
+	 */
+	check_size = data_size;
+
+	if( check_size > LIBEWF_CHUNK_DATA_FILL_CHECK_CACHE_LINE_SIZE )
+	{
+		check_size = LIBEWF_CHUNK_DATA_FILL_CHECK_CACHE_LINE_SIZE;
+	}
+	if( libewf_chunk_data_compare_fill_pattern(
+	     data,
+	     check_size,
+	     data ) == 0 )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_data_compare_fill_pattern(
+	     &( data[ data_size - check_size ] ),
+	     check_size,
+	     data ) == 0 )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_data_get_compare_fill_blocks_function(
+	     &compare_fill_blocks_function ) == 1 )
+	{
+		if( memory_copy(
+		     &fill_value,
+		     data,
+		     8 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy fill pattern.",
+			 function );
+
+			return( -1 );
+		}
+		number_of_blocks = data_size / 32;
+
+		if( compare_fill_blocks_function(
+		     data,
+		     number_of_blocks,
+		     fill_value ) == 0 )
+		{
+			return( 0 );
+		}
+		data_offset = number_of_blocks * 32;
+
+		result = libewf_chunk_data_compare_fill_pattern(
+		          &( data[ data_offset ] ),
+		          data_size - data_offset,
+		          data );
+
+		if( result != 0 )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 data,
+			 *pattern );
+		}
+		return( result );
+	}
+	data_start = (uint8_t *) data;
+	data_index = (uint8_t *) data + 8;
+	data_size -= 8;
+
+	/* Only optimize for data larger than the alignment
+	 */
+	if( data_size > ( sizeof( libewf_aligned_t ) + sizeof( libewf_aligned_t ) ) )
+	{
+		/* Align the data start
+		 */
+		while( ( (intptr_t) data_start % sizeof( libewf_aligned_t ) ) != 0 )
+		{
+			if( *data_start != *data_index )
+			{
+				return( 0 );
+			}
+			data_start++;
+			data_index++;
+			data_size--;
+		}
+		/* Align the data index
+		 */
+		while( ( (intptr_t) data_index % sizeof( libewf_aligned_t ) ) != 0 )
+		{
+			if( *data_start != *data_index )
+			{
+				return( 0 );
+			}
+			data_index++;
+			data_size--;
+		}
+		aligned_data_start = (libewf_aligned_t *) data_start;
+		aligned_data_index = (libewf_aligned_t *) data_index;
+
+		while( data_size > sizeof( libewf_aligned_t ) )
+		{
+			if( *aligned_data_start != *aligned_data_index )
+			{
+				return( 0 );
+			}
+			aligned_data_start++;
+			aligned_data_index++;
+
+			data_size -= sizeof( libewf_aligned_t );
+		}
+		data_start = (uint8_t *) aligned_data_start;
+		data_index = (uint8_t *) aligned_data_index;
+	}
 	while( data_size != 0 )
 	{
 		if( *data_start != *data_index )
@@ -1668,6 +2382,108 @@ ssize_t libewf_chunk_data_write(
 	return( total_write_count );
 }
 
+/* Writes a chunk to a buffer
+ * The buffer receives the same data libewf_chunk_data_write writes to the segment file
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_chunk_data_write_to_buffer(
+         libewf_chunk_data_t *chunk_data,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_write_to_buffer";
+	size_t write_size     = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	write_size = chunk_data->data_size + chunk_data->padding_size;
+
+	if( write_size > buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid buffer size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     buffer,
+	     chunk_data->data,
+	     write_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
+	 && ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 ) )
+	{
+		/* Check if the chunk and checksum buffers are aligned
+		 * if not the checksum needs to be written separately
+		 */
+		if( ( chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET ) != 0 )
+		{
+			if( ( buffer_size - write_size ) < 4 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: invalid buffer size value too small.",
+				 function );
+
+				return( -1 );
+			}
+			byte_stream_copy_from_uint32_little_endian(
+			 &( buffer[ write_size ] ),
+			 chunk_data->checksum );
+
+			write_size += 4;
+		}
+	}
+	return( (ssize_t) write_size );
+}
+
 /* Retrieves the write size of the chunk
  * Returns 1 if successful or -1 on error
  */
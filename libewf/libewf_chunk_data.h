@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_compression_context.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
@@ -34,6 +35,17 @@
 extern "C" {
 #endif
 
+/* The SIMD fill detection functions require the GCC or Clang target attribute
+ */
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( ( __GNUC__ > 4 ) || ( ( __GNUC__ == 4 ) && ( __GNUC_MINOR__ >= 9 ) ) ) ) )
+#define HAVE_LIBEWF_CHUNK_DATA_X86_SIMD
+#endif
+
+/* The size of the first and last part of the data that is checked
+ * before the rest of the data when detecting a fill pattern
+ */
+#define LIBEWF_CHUNK_DATA_FILL_CHECK_CACHE_LINE_SIZE	64
+
 typedef struct libewf_chunk_data libewf_chunk_data_t;
 
 struct libewf_chunk_data
@@ -85,6 +97,20 @@ struct libewf_chunk_data
 	/* The chunk IO flags
 	 */
 	int8_t chunk_io_flags;
+
+	/* The number of chunk views that reference the chunk data
+	 */
+	int number_of_references;
+
+	/* Value to indicate the chunk data is no longer managed by the chunk cache
+	 * and is freed when the last chunk view is released
+	 */
+	uint8_t is_detached;
+
+	/* Value to indicate the chunk data is a read-only fill chunk shared by the chunk views
+	 * and is not reference counted
+	 */
+	uint8_t is_shared;
 };
 
 int libewf_chunk_data_initialize(
@@ -117,6 +143,7 @@ ssize_t libewf_chunk_data_write_buffer(
 int libewf_chunk_data_pack(
      libewf_chunk_data_t *chunk_data,
      libewf_io_handle_t *io_handle,
+     libewf_compression_context_t *compression_context,
      const uint8_t *compressed_zero_byte_empty_block,
      size_t compressed_zero_byte_empty_block_size,
      uint8_t pack_flags,
@@ -127,6 +154,25 @@ int libewf_chunk_data_unpack(
      libewf_io_handle_t *io_handle,
      libcerror_error_t **error );
 
+ssize_t libewf_chunk_data_unpack_buffer(
+         libewf_chunk_data_t *chunk_data,
+         libewf_io_handle_t *io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+int libewf_chunk_data_fill_buffer(
+     uint8_t *buffer,
+     size_t buffer_size,
+     const uint8_t *fill_pattern,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_get_compare_fill_blocks_function(
+     int (**compare_fill_blocks_function)(
+            const uint8_t *data,
+            size_t number_of_blocks,
+            uint64_t fill_pattern ) );
+
 int libewf_chunk_data_check_for_empty_block(
      const uint8_t *data,
      size_t data_size,
@@ -144,6 +190,12 @@ ssize_t libewf_chunk_data_write(
          int file_io_pool_entry,
          libcerror_error_t **error );
 
+ssize_t libewf_chunk_data_write_to_buffer(
+         libewf_chunk_data_t *chunk_data,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
 int libewf_chunk_data_get_write_size(
      libewf_chunk_data_t *chunk_data,
      uint32_t *write_size,
@@ -32,6 +32,7 @@
 #include "libewf_libcnotify.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_packed_chunk_index.h"
 #include "libewf_section.h"
 #include "libewf_section_descriptor.h"
 
@@ -133,11 +134,39 @@ int libewf_chunk_group_initialize(
 
 		goto on_error;
 	}
+	/* A chunk group of a file opened read-only is not modified after it has been filled,
+	 * hence its chunks are stored in a packed chunk index that uses 8 bytes per chunk
+	 */
+	if( ( ( io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 )
+	 && ( io_handle->chunk_size != 0 ) )
+	{
+		if( libewf_packed_chunk_index_initialize(
+		     &( ( *chunk_group )->packed_chunk_index ),
+		     io_handle->chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create packed chunk index.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
 	if( *chunk_group != NULL )
 	{
+		if( ( *chunk_group )->chunks_list != NULL )
+		{
+			libfdata_list_free(
+			 &( ( *chunk_group )->chunks_list ),
+			 NULL );
+		}
 		memory_free(
 		 *chunk_group );
 
@@ -182,6 +211,22 @@ int libewf_chunk_group_free(
 
 			result = -1;
 		}
+		if( ( *chunk_group )->packed_chunk_index != NULL )
+		{
+			if( libewf_packed_chunk_index_free(
+			     &( ( *chunk_group )->packed_chunk_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free packed chunk index.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *chunk_group );
 
@@ -261,9 +306,10 @@ int libewf_chunk_group_clone(
 
 		return( -1 );
 	}
-	( *destination_chunk_group )->chunks_list = NULL;
+	( *destination_chunk_group )->chunks_list        = NULL;
+	( *destination_chunk_group )->packed_chunk_index = NULL;
 
-/* TODO clone chunks_list */
+/* TODO clone chunks_list and packed_chunk_index */
 
 	return( 1 );
 
@@ -311,9 +357,524 @@ int libewf_chunk_group_empty(
 
 		return( -1 );
 	}
+	if( chunk_group->packed_chunk_index != NULL )
+	{
+		if( libewf_packed_chunk_index_empty(
+		     chunk_group->packed_chunk_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to empty packed chunk index.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Moves the chunks of the packed chunk index into the chunks list
+ * This is used when a chunk cannot be stored in the packed chunk index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_expand_packed_chunk_index(
+     libewf_chunk_group_t *chunk_group,
+     libcerror_error_t **error )
+{
+	static char *function     = "libewf_chunk_group_expand_packed_chunk_index";
+	off64_t chunk_data_offset = 0;
+	size64_t chunk_data_size  = 0;
+	uint32_t range_flags      = 0;
+	int element_index         = 0;
+	int entry_index           = 0;
+	int file_io_pool_entry    = 0;
+	int number_of_entries     = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->packed_chunk_index == NULL )
+	{
+		return( 1 );
+	}
+	if( libewf_packed_chunk_index_get_number_of_entries(
+	     chunk_group->packed_chunk_index,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from packed chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_empty(
+	     chunk_group->chunks_list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to empty chunks list.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libewf_packed_chunk_index_get_entry_by_index(
+		     chunk_group->packed_chunk_index,
+		     entry_index,
+		     &file_io_pool_entry,
+		     &chunk_data_offset,
+		     &chunk_data_size,
+		     &range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d from packed chunk index.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( libfdata_list_append_element_with_mapped_size(
+		     chunk_group->chunks_list,
+		     &element_index,
+		     file_io_pool_entry,
+		     chunk_data_offset,
+		     chunk_data_size,
+		     range_flags,
+		     chunk_group->packed_chunk_index->chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element: %d with mapped size to chunks list.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	if( libewf_packed_chunk_index_free(
+	     &( chunk_group->packed_chunk_index ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free packed chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends a chunk
+ * The chunk is stored in the packed chunk index if possible, otherwise in the chunks list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_append_chunk(
+     libewf_chunk_group_t *chunk_group,
+     int *element_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     size32_t mapped_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_append_chunk";
+	int result            = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->packed_chunk_index != NULL )
+	{
+		result = libewf_packed_chunk_index_append_entry(
+		          chunk_group->packed_chunk_index,
+		          element_index,
+		          file_io_pool_entry,
+		          chunk_data_offset,
+		          chunk_data_size,
+		          range_flags,
+		          mapped_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append entry to packed chunk index.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			return( 1 );
+		}
+		if( libewf_chunk_group_expand_packed_chunk_index(
+		     chunk_group,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to expand packed chunk index.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libfdata_list_append_element_with_mapped_size(
+	     chunk_group->chunks_list,
+	     element_index,
+	     file_io_pool_entry,
+	     chunk_data_offset,
+	     chunk_data_size,
+	     range_flags,
+	     mapped_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append element with mapped size to chunks list.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of chunks
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_get_number_of_chunks(
+     libewf_chunk_group_t *chunk_group,
+     int *number_of_chunks,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_get_number_of_chunks";
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->packed_chunk_index != NULL )
+	{
+		if( libewf_packed_chunk_index_get_number_of_entries(
+		     chunk_group->packed_chunk_index,
+		     number_of_chunks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of entries from packed chunk index.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		if( libfdata_list_get_number_of_elements(
+		     chunk_group->chunks_list,
+		     number_of_chunks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of elements from chunks list.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_get_chunk_by_index(
+     libewf_chunk_group_t *chunk_group,
+     int element_index,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_get_chunk_by_index";
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->packed_chunk_index != NULL )
+	{
+		if( libewf_packed_chunk_index_get_entry_by_index(
+		     chunk_group->packed_chunk_index,
+		     element_index,
+		     file_io_pool_entry,
+		     chunk_data_offset,
+		     chunk_data_size,
+		     range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d from packed chunk index.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		if( libfdata_list_get_element_by_index(
+		     chunk_group->chunks_list,
+		     element_index,
+		     file_io_pool_entry,
+		     chunk_data_offset,
+		     chunk_data_size,
+		     range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d from chunks list.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets a specific chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_set_chunk_by_index(
+     libewf_chunk_group_t *chunk_group,
+     int element_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_set_chunk_by_index";
+	int result            = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->packed_chunk_index != NULL )
+	{
+		result = libewf_packed_chunk_index_set_entry_by_index(
+		          chunk_group->packed_chunk_index,
+		          element_index,
+		          file_io_pool_entry,
+		          chunk_data_offset,
+		          chunk_data_size,
+		          range_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set entry: %d in packed chunk index.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			return( 1 );
+		}
+		if( libewf_chunk_group_expand_packed_chunk_index(
+		     chunk_group,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to expand packed chunk index.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libfdata_list_set_element_by_index(
+	     chunk_group->chunks_list,
+	     element_index,
+	     file_io_pool_entry,
+	     chunk_data_offset,
+	     chunk_data_size,
+	     range_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set element: %d in chunks list.",
+		 function,
+		 element_index );
+
+		return( -1 );
+	}
 	return( 1 );
 }
 
+/* Retrieves the chunk that contains a specific offset
+ * The offset is relative to the start of the chunk group
+ * Returns 1 if successful, 0 if no chunk contains the offset or -1 on error
+ */
+int libewf_chunk_group_get_chunk_at_offset(
+     libewf_chunk_group_t *chunk_group,
+     off64_t offset,
+     int *element_index,
+     off64_t *element_data_offset,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_get_chunk_at_offset";
+	int result            = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->packed_chunk_index != NULL )
+	{
+		result = libewf_packed_chunk_index_get_entry_at_offset(
+		          chunk_group->packed_chunk_index,
+		          offset,
+		          element_index,
+		          element_data_offset,
+		          file_io_pool_entry,
+		          chunk_data_offset,
+		          chunk_data_size,
+		          range_flags,
+		          error );
+	}
+	else
+	{
+		result = libfdata_list_get_element_at_offset(
+		          chunk_group->chunks_list,
+		          offset,
+		          element_index,
+		          element_data_offset,
+		          file_io_pool_entry,
+		          chunk_data_offset,
+		          chunk_data_size,
+		          range_flags,
+		          error );
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk at offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( result );
+}
+
 /* Fills the chunks list from the EWF version 1 sector table entries
  * Returns 1 if successful or -1 on error
  */
@@ -400,6 +961,23 @@ int libewf_chunk_group_fill_v1(
 
 		return( -1 );
 	}
+	if( chunk_group->packed_chunk_index != NULL )
+	{
+		if( libewf_packed_chunk_index_reserve(
+		     chunk_group->packed_chunk_index,
+		     (int) number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize packed chunk index.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	byte_stream_copy_to_uint32_little_endian(
 	 ( ( (ewf_table_entry_v1_t *) table_entries_data )[ table_entry_index ] ).chunk_data_offset,
 	 stored_offset );
@@ -561,8 +1139,8 @@ int libewf_chunk_group_fill_v1(
 		}
 #endif /* defined( HAVE_DEBUG_OUTPUT ) */
 
-		if( libfdata_list_append_element_with_mapped_size(
-		     chunk_group->chunks_list,
+		if( libewf_chunk_group_append_chunk(
+		     chunk_group,
 		     &element_index,
 		     file_io_pool_entry,
 		     base_offset + current_offset,
@@ -575,7 +1153,7 @@ int libewf_chunk_group_fill_v1(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append element: %" PRIu32 " with mapped size to chunks list.",
+			 "%s: unable to append chunk: %" PRIu32 ".",
 			 function,
 			 table_entry_index );
 
@@ -776,8 +1354,8 @@ int libewf_chunk_group_fill_v1(
 		 "\n" );
 	}
 #endif
-	if( libfdata_list_append_element_with_mapped_size(
-	     chunk_group->chunks_list,
+	if( libewf_chunk_group_append_chunk(
+	     chunk_group,
 	     &element_index,
 	     file_io_pool_entry,
 	     last_chunk_data_offset,
@@ -790,7 +1368,7 @@ int libewf_chunk_group_fill_v1(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append element: %" PRIu32 " with mapped size to chunks list.",
+		 "%s: unable to append chunk: %" PRIu32 ".",
 		 function,
 		 table_entry_index );
 
@@ -874,6 +1452,23 @@ int libewf_chunk_group_fill_v2(
 
 		return( -1 );
 	}
+	if( chunk_group->packed_chunk_index != NULL )
+	{
+		if( libewf_packed_chunk_index_reserve(
+		     chunk_group->packed_chunk_index,
+		     (int) number_of_offsets,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize packed chunk index.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	table_entry_offset = table_section->start_offset + sizeof( ewf_table_header_v2_t );
 
 	while( table_entries_data_size >= sizeof( ewf_table_entry_v2_t ) )
@@ -978,8 +1573,8 @@ int libewf_chunk_group_fill_v2(
 		}
 		table_entry_offset += sizeof( ewf_table_entry_v2_t );
 
-		if( libfdata_list_append_element_with_mapped_size(
-		     chunk_group->chunks_list,
+		if( libewf_chunk_group_append_chunk(
+		     chunk_group,
 		     &element_index,
 		     file_io_pool_entry,
 		     chunk_data_offset,
@@ -992,7 +1587,7 @@ int libewf_chunk_group_fill_v2(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append element: %" PRIu32 " with mapped size to chunks list.",
+			 "%s: unable to append chunk: %" PRIu32 ".",
 			 function,
 			 table_entry_index );
 
@@ -1259,8 +1854,8 @@ int libewf_chunk_group_correct_v1(
 			 "\n" );
 		}
 #endif
-		if( libfdata_list_get_element_by_index(
-		     chunk_group->chunks_list,
+		if( libewf_chunk_group_get_chunk_by_index(
+		     chunk_group,
 		     table_entry_index,
 		     &previous_file_io_pool_entry,
 		     &previous_chunk_data_offset,
@@ -1272,7 +1867,7 @@ int libewf_chunk_group_correct_v1(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve element: %" PRIu32 " from chunks list.",
+			 "%s: unable to retrieve chunk: %" PRIu32 ".",
 			 function,
 			 table_entry_index );
 
@@ -1343,8 +1938,8 @@ int libewf_chunk_group_correct_v1(
 		}
 		if( update_data_range != 0 )
 		{
-			if( libfdata_list_set_element_by_index(
-			     chunk_group->chunks_list,
+			if( libewf_chunk_group_set_chunk_by_index(
+			     chunk_group,
 			     table_entry_index,
 			     file_io_pool_entry,
 			     base_offset + current_offset,
@@ -1356,7 +1951,7 @@ int libewf_chunk_group_correct_v1(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set element: %" PRIu32 " in chunks list.",
+				 "%s: unable to set chunk: %" PRIu32 ".",
 				 function,
 				 table_entry_index );
 
@@ -1536,8 +2131,8 @@ int libewf_chunk_group_correct_v1(
 		 "\n" );
 	}
 #endif
-	if( libfdata_list_get_element_by_index(
-	     chunk_group->chunks_list,
+	if( libewf_chunk_group_get_chunk_by_index(
+	     chunk_group,
 	     table_entry_index,
 	     &previous_file_io_pool_entry,
 	     &previous_chunk_data_offset,
@@ -1549,7 +2144,7 @@ int libewf_chunk_group_correct_v1(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element: %" PRIu32 " from chunks list.",
+		 "%s: unable to retrieve chunk: %" PRIu32 ".",
 		 function,
 		 table_entry_index );
 
@@ -1620,8 +2215,8 @@ int libewf_chunk_group_correct_v1(
 	}
 	if( update_data_range != 0 )
 	{
-		if( libfdata_list_set_element_by_index(
-		     chunk_group->chunks_list,
+		if( libewf_chunk_group_set_chunk_by_index(
+		     chunk_group,
 		     table_entry_index,
 		     file_io_pool_entry,
 		     base_offset + current_offset,
@@ -1633,7 +2228,7 @@ int libewf_chunk_group_correct_v1(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set element: %" PRIu32 " in chunks list.",
+			 "%s: unable to set chunk: %" PRIu32 ".",
 			 function,
 			 table_entry_index );
 
@@ -1751,8 +2346,8 @@ int libewf_chunk_group_generate_table_entries_data(
 	     table_entry_index < number_of_entries;
 	     table_entry_index++ )
 	{
-		if( libfdata_list_get_element_by_index(
-		     chunk_group->chunks_list,
+		if( libewf_chunk_group_get_chunk_by_index(
+		     chunk_group,
 		     table_entry_index,
 		     &file_io_pool_entry,
 		     &chunk_data_offset,
@@ -1764,7 +2359,7 @@ int libewf_chunk_group_generate_table_entries_data(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve element: %" PRIu32 " from chunks list.",
+			 "%s: unable to retrieve chunk: %" PRIu32 ".",
 			 function,
 			 table_entry_index );
 
@@ -28,6 +28,7 @@
 #include "libewf_io_handle.h"
 #include "libewf_libcerror.h"
 #include "libewf_libfdata.h"
+#include "libewf_packed_chunk_index.h"
 #include "libewf_section_descriptor.h"
 
 #if defined( __cplusplus )
@@ -41,6 +42,11 @@ struct libewf_chunk_group
 	/* The chunks list
 	 */
 	libfdata_list_t *chunks_list;
+
+	/* The packed chunk index
+	 * Contains NULL if the chunks are stored in the chunks list
+	 */
+	libewf_packed_chunk_index_t *packed_chunk_index;
 };
 
 int libewf_chunk_group_initialize(
@@ -61,6 +67,54 @@ int libewf_chunk_group_empty(
      libewf_chunk_group_t *chunk_group,
      libcerror_error_t **error );
 
+int libewf_chunk_group_expand_packed_chunk_index(
+     libewf_chunk_group_t *chunk_group,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_append_chunk(
+     libewf_chunk_group_t *chunk_group,
+     int *element_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     size32_t mapped_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_get_number_of_chunks(
+     libewf_chunk_group_t *chunk_group,
+     int *number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_get_chunk_by_index(
+     libewf_chunk_group_t *chunk_group,
+     int element_index,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_set_chunk_by_index(
+     libewf_chunk_group_t *chunk_group,
+     int element_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_get_chunk_at_offset(
+     libewf_chunk_group_t *chunk_group,
+     off64_t offset,
+     int *element_index,
+     off64_t *element_data_offset,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
 int libewf_chunk_group_fill_v1(
      libewf_chunk_group_t *chunk_group,
      uint64_t chunk_index,
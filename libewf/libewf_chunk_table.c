@@ -24,13 +24,17 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_chunk_cache.h"
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
 #include "libewf_definitions.h"
+#include "libewf_extent.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
 #include "libewf_segment_file.h"
@@ -145,6 +149,61 @@ int libewf_chunk_table_initialize(
 
 		goto on_error;
 	}
+	if( libewf_chunk_cache_initialize(
+	     &( ( *chunk_table )->chunk_cache ),
+	     ( LIBEWF_DEFAULT_CACHE_MEMORY_LIMIT / 4 ) * 3,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *chunk_table )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *chunk_table )->cache_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize cache mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *chunk_table )->io_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize IO mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	( *chunk_table )->io_handle = io_handle;
 
 	return( 1 );
@@ -152,6 +211,33 @@ int libewf_chunk_table_initialize(
 on_error:
 	if( *chunk_table != NULL )
 	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *chunk_table )->cache_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *chunk_table )->cache_mutex ),
+			 NULL );
+		}
+		if( ( *chunk_table )->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( ( *chunk_table )->read_write_lock ),
+			 NULL );
+		}
+#endif
+		if( ( *chunk_table )->chunk_cache != NULL )
+		{
+			libewf_chunk_cache_free(
+			 &( ( *chunk_table )->chunk_cache ),
+			 NULL );
+		}
+		if( ( *chunk_table )->checksum_errors != NULL )
+		{
+			libcdata_range_list_free(
+			 &( ( *chunk_table )->checksum_errors ),
+			 NULL,
+			 NULL );
+		}
 		if( ( *chunk_table )->corrupted_chunks_list != NULL )
 		{
 			libfdata_list_free(
@@ -173,8 +259,9 @@ int libewf_chunk_table_free(
      libewf_chunk_table_t **chunk_table,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_chunk_table_free";
-	int result            = 1;
+	static char *function       = "libewf_chunk_table_free";
+	int result                  = 1;
+	int shared_fill_chunk_index = 0;
 
 	if( chunk_table == NULL )
 	{
@@ -216,6 +303,96 @@ int libewf_chunk_table_free(
 
 			result = -1;
 		}
+		if( libewf_chunk_cache_free(
+		     &( ( *chunk_table )->chunk_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk cache.",
+			 function );
+
+			result = -1;
+		}
+		for( shared_fill_chunk_index = 0;
+		     shared_fill_chunk_index < ( *chunk_table )->number_of_shared_fill_chunks;
+		     shared_fill_chunk_index++ )
+		{
+			if( libewf_chunk_data_free(
+			     &( ( *chunk_table )->shared_fill_chunks_data[ shared_fill_chunk_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free shared fill chunk: %d data.",
+				 function,
+				 shared_fill_chunk_index );
+
+				result = -1;
+			}
+		}
+		if( ( *chunk_table )->extents != NULL )
+		{
+			if( libcdata_array_free(
+			     &( ( *chunk_table )->extents ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_extent_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free extents array.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *chunk_table )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *chunk_table )->cache_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free cache mutex.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *chunk_table )->io_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free IO mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *chunk_table );
 
@@ -297,6 +474,16 @@ int libewf_chunk_table_clone(
 	}
 	( *destination_chunk_table )->corrupted_chunks_list = NULL;
 	( *destination_chunk_table )->checksum_errors       = NULL;
+	( *destination_chunk_table )->chunk_cache           = NULL;
+	( *destination_chunk_table )->extents               = NULL;
+
+	( *destination_chunk_table )->number_of_shared_fill_chunks = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	( *destination_chunk_table )->read_write_lock       = NULL;
+	( *destination_chunk_table )->cache_mutex           = NULL;
+	( *destination_chunk_table )->io_mutex              = NULL;
+#endif
 
 /* TODO: clone corrupted_chunks_list */
 
@@ -316,11 +503,93 @@ int libewf_chunk_table_clone(
 
 		goto on_error;
 	}
+	if( libewf_chunk_cache_initialize(
+	     &( ( *destination_chunk_table )->chunk_cache ),
+	     source_chunk_table->chunk_cache->maximum_memory_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *destination_chunk_table )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *destination_chunk_table )->cache_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize cache mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *destination_chunk_table )->io_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize IO mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
 	if( *destination_chunk_table != NULL )
 	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *destination_chunk_table )->cache_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *destination_chunk_table )->cache_mutex ),
+			 NULL );
+		}
+		if( ( *destination_chunk_table )->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( ( *destination_chunk_table )->read_write_lock ),
+			 NULL );
+		}
+#endif
+		if( ( *destination_chunk_table )->chunk_cache != NULL )
+		{
+			libewf_chunk_cache_free(
+			 &( ( *destination_chunk_table )->chunk_cache ),
+			 NULL );
+		}
+		if( ( *destination_chunk_table )->checksum_errors != NULL )
+		{
+			libcdata_range_list_free(
+			 &( ( *destination_chunk_table )->checksum_errors ),
+			 NULL,
+			 NULL );
+		}
 		memory_free(
 		 *destination_chunk_table );
 
@@ -362,6 +631,21 @@ int libewf_chunk_table_get_number_of_checksum_errors(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	if( libcdata_range_list_get_number_of_elements(
 	     chunk_table->checksum_errors,
 	     &number_of_elements,
@@ -374,11 +658,34 @@ int libewf_chunk_table_get_number_of_checksum_errors(
 		 "%s: unable to retrieve number of elements from range list.",
 		 function );
 
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
 		return( -1 );
 	}
+#endif
 	*number_of_errors = (uint32_t) number_of_elements;
 
 	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 chunk_table->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
 /* Retrieves a checksum error
@@ -405,6 +712,21 @@ int libewf_chunk_table_get_checksum_error(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	if( libcdata_range_list_get_range_by_index(
 	     chunk_table->checksum_errors,
 	     (int) error_index,
@@ -421,9 +743,32 @@ int libewf_chunk_table_get_checksum_error(
 		 function,
 		 error_index );
 
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
 		return( -1 );
 	}
+#endif
 	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 chunk_table->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
 /* Appends a checksum error
@@ -449,6 +794,21 @@ int libewf_chunk_table_append_checksum_error(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	result = libcdata_range_list_insert_range(
 	          chunk_table->checksum_errors,
 	          start_sector,
@@ -467,140 +827,249 @@ int libewf_chunk_table_append_checksum_error(
 		 "%s: unable to insert checksum error in range list.",
 		 function );
 
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
 		return( -1 );
 	}
+#endif
 	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 chunk_table->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Retrieves the chunks group in a segment file at a specific offset
- * Returns 1 if successful, 0 if not or -1 on error
+/* Appends a chunk to the extents
+ * The chunk is merged with the last extent if it is adjacent and has the same flags
+ * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_table_get_segment_file_chunk_group_by_offset(
-     libewf_chunk_table_t *chunk_table,
-     libbfio_pool_t *file_io_pool,
-     libewf_segment_table_t *segment_table,
-     libfcache_cache_t *chunk_groups_cache,
+int libewf_chunk_table_append_extent(
+     libcdata_array_t *extents,
+     libewf_extent_t **last_extent,
      off64_t offset,
-     uint32_t *segment_number,
-     off64_t *segment_file_data_offset,
-     libewf_segment_file_t **segment_file,
-     int *chunk_groups_list_index,
-     off64_t *chunk_group_data_offset,
-     libewf_chunk_group_t **chunk_group,
+     size64_t size,
+     uint32_t flags,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_chunk_table_get_segment_file_chunk_group_by_offset";
-	int result            = 0;
+	libewf_extent_t *extent = NULL;
+	static char *function   = "libewf_chunk_table_append_extent";
+	int entry_index         = 0;
 
-	if( chunk_table == NULL )
+	if( last_extent == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk table.",
+		 "%s: invalid last extent.",
 		 function );
 
 		return( -1 );
 	}
-	if( segment_number == NULL )
+	if( ( *last_extent != NULL )
+	 && ( ( *last_extent )->flags == flags )
+	 && ( (off64_t) ( ( *last_extent )->offset + ( *last_extent )->size ) == offset ) )
+	{
+		( *last_extent )->size += size;
+
+		return( 1 );
+	}
+	if( libewf_extent_initialize(
+	     &extent,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment number.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create extent.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( segment_file_data_offset == NULL )
+	if( libewf_extent_set(
+	     extent,
+	     offset,
+	     size,
+	     flags,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment file data offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set extent.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( segment_file == NULL )
+	if( libcdata_array_append_entry(
+	     extents,
+	     &entry_index,
+	     (intptr_t *) extent,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append extent to array.",
+		 function );
+
+		goto on_error;
+	}
+	*last_extent = extent;
+
+	return( 1 );
+
+on_error:
+	if( extent != NULL )
+	{
+		libewf_extent_free(
+		 &extent,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the extents of the (media) data
+ * The extents are determined from the chunk groups (tables) only, the chunk data is not read
+ * This function is not multi-thread safe acquire write lock before call
+ * The chunk groups are loaded while holding the IO mutex
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_read_extents(
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group   = NULL;
+	libewf_extent_t *last_extent        = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_chunk_table_read_extents";
+	size64_t chunk_data_size            = 0;
+	size64_t mapped_size                = 0;
+	off64_t chunk_data_offset           = 0;
+	off64_t chunk_group_data_offset     = 0;
+	off64_t element_data_offset         = 0;
+	off64_t media_offset                = 0;
+	off64_t segment_file_data_offset    = 0;
+	uint32_t extent_flags               = 0;
+	uint32_t range_flags                = 0;
+	uint32_t segment_number             = 0;
+	int chunk_groups_list_index         = 0;
+	int chunks_list_index               = 0;
+	int file_io_pool_entry              = 0;
+	int number_of_chunks                = 0;
+	int result                          = 0;
+
+	if( chunk_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment file.",
+		 "%s: invalid chunk table.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_groups_list_index == NULL )
+	if( chunk_table->extents != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk groups list index.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk table - extents value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_group_data_offset == NULL )
+	if( media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk group data offset.",
+		 "%s: invalid media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_group == NULL )
+	if( media_values->chunk_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk groups.",
+		 "%s: invalid media values - missing chunk size.",
 		 function );
 
 		return( -1 );
 	}
-	result = libewf_segment_table_get_segment_file_at_offset(
-	          segment_table,
-	          offset,
-	          file_io_pool,
-	          segment_number,
-	          segment_file_data_offset,
-	          segment_file,
-	          error );
-
-	if( result == -1 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_table->io_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment file at 0x%08" PRIx64 " from segment files list.",
-		 function,
-		 offset );
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab IO mutex.",
+		 function );
 
 		return( -1 );
 	}
-	if( result != 0 )
+#endif
+	if( libcdata_array_initialize(
+	     &( chunk_table->extents ),
+	     0,
+	     error ) != 1 )
 	{
-		result = libewf_segment_file_get_chunk_group_by_offset(
-			  *segment_file,
-			  file_io_pool,
-			  chunk_groups_cache,
-			  *segment_file_data_offset,
-			  chunk_groups_list_index,
-			  chunk_group_data_offset,
-			  chunk_group,
-			  error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create extents array.",
+		 function );
+
+		goto on_error;
+	}
+	while( (size64_t) media_offset < media_values->media_size )
+	{
+		result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+		          chunk_table,
+		          file_io_pool,
+		          segment_table,
+		          chunk_groups_cache,
+		          media_offset,
+		          &segment_number,
+		          &segment_file_data_offset,
+		          &segment_file,
+		          &chunk_groups_list_index,
+		          &chunk_group_data_offset,
+		          &chunk_group,
+		          error );
 
 		if( result == -1 )
 		{
@@ -608,55 +1077,209 @@ int libewf_chunk_table_get_segment_file_chunk_group_by_offset(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve chunk group from segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+			 "%s: unable to retrieve segment file chunk group at 0x%08" PRIx64 ".",
 			 function,
-			 *segment_number,
-			 *segment_file_data_offset );
+			 media_offset );
 
-			return( -1 );
+			goto on_error;
 		}
-	}
-	if( result != 0 )
-	{
-		if( *chunk_group == NULL )
+		if( result != 0 )
+		{
+			result = libewf_chunk_group_get_chunk_at_offset(
+			          chunk_group,
+			          chunk_group_data_offset,
+			          &chunks_list_index,
+			          &element_data_offset,
+			          &file_io_pool_entry,
+			          &chunk_data_offset,
+			          &chunk_data_size,
+			          &range_flags,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk from chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+				 function,
+				 chunk_groups_list_index,
+				 segment_number,
+				 segment_file_data_offset );
+
+				goto on_error;
+			}
+		}
+		if( result == 0 )
+		{
+			/* The chunk is not stored in the segment files
+			 */
+			mapped_size = media_values->chunk_size;
+
+			if( (size64_t) ( media_offset + mapped_size ) > media_values->media_size )
+			{
+				mapped_size = media_values->media_size - media_offset;
+			}
+			if( libewf_chunk_table_append_extent(
+			     chunk_table->extents,
+			     &last_extent,
+			     media_offset,
+			     mapped_size,
+			     LIBEWF_EXTENT_FLAG_IS_MISSING,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append extent at offset: 0x%08" PRIx64 ".",
+				 function,
+				 media_offset );
+
+				goto on_error;
+			}
+			media_offset += mapped_size;
+
+			continue;
+		}
+		if( libewf_chunk_group_get_number_of_chunks(
+		     chunk_group,
+		     &number_of_chunks,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk group: %d.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of chunks of chunk group: %d.",
 			 function,
-			 *chunk_groups_list_index );
+			 chunk_groups_list_index );
 
-			return( -1 );
+			goto on_error;
+		}
+		/* Walk the remaining chunks of the chunk group
+		 * without looking up the chunk group for every chunk
+		 */
+		while( ( chunks_list_index < number_of_chunks )
+		    && ( (size64_t) media_offset < media_values->media_size ) )
+		{
+			if( libewf_chunk_group_get_chunk_by_index(
+			     chunk_group,
+			     chunks_list_index,
+			     &file_io_pool_entry,
+			     &chunk_data_offset,
+			     &chunk_data_size,
+			     &range_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk: %d from chunk group: %d.",
+				 function,
+				 chunks_list_index,
+				 chunk_groups_list_index );
+
+				goto on_error;
+			}
+			extent_flags = 0;
+
+			if( ( range_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+			{
+				extent_flags |= LIBEWF_EXTENT_FLAG_IS_SPARSE;
+			}
+			else if( ( range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
+			{
+				extent_flags |= LIBEWF_EXTENT_FLAG_USES_PATTERN_FILL;
+			}
+			if( ( range_flags & ( LIBEWF_RANGE_FLAG_IS_CORRUPTED | LIBEWF_RANGE_FLAG_IS_TAINTED ) ) != 0 )
+			{
+				extent_flags |= LIBEWF_EXTENT_FLAG_IS_CORRUPTED;
+			}
+			mapped_size = media_values->chunk_size;
+
+			if( (size64_t) ( media_offset + mapped_size ) > media_values->media_size )
+			{
+				mapped_size = media_values->media_size - media_offset;
+			}
+			if( libewf_chunk_table_append_extent(
+			     chunk_table->extents,
+			     &last_extent,
+			     media_offset,
+			     mapped_size,
+			     extent_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append extent at offset: 0x%08" PRIx64 ".",
+				 function,
+				 media_offset );
+
+				goto on_error;
+			}
+			media_offset += mapped_size;
+
+			chunks_list_index++;
 		}
 	}
-	return( result );
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_table->io_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release IO mutex.",
+		 function );
+
+		libcdata_array_free(
+		 &( chunk_table->extents ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_extent_free,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 chunk_table->io_mutex,
+	 NULL );
+#endif
+	if( chunk_table->extents != NULL )
+	{
+		libcdata_array_free(
+		 &( chunk_table->extents ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_extent_free,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Determines if the chunk exists
+/* Retrieves the number of extents
+ * The extents are read on the first call
+ * This function is safe to be called from multiple threads concurrently
  * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_table_chunk_exists_for_offset(
+int libewf_chunk_table_get_number_of_extents(
      libewf_chunk_table_t *chunk_table,
-     uint64_t chunk_index,
      libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
      libewf_segment_table_t *segment_table,
      libfcache_cache_t *chunk_groups_cache,
-     off64_t offset,
+     int *number_of_extents,
      libcerror_error_t **error )
 {
-	libewf_chunk_group_t *chunk_group           = NULL;
-	libewf_segment_file_t *segment_file         = NULL;
-	libfdata_list_element_t *chunk_list_element = NULL;
-	static char *function                       = "libewf_chunk_table_chunk_exists_for_offset";
-	off64_t chunk_data_offset                   = 0;
-	off64_t chunk_group_data_offset             = 0;
-	off64_t segment_file_data_offset            = 0;
-	uint32_t segment_number                     = 0;
-	int chunk_groups_list_index                 = 0;
-	int chunks_list_index                       = 0;
-	int result                                  = 0;
+	static char *function = "libewf_chunk_table_get_number_of_extents";
 
 	if( chunk_table == NULL )
 	{
@@ -669,105 +1292,100 @@ int libewf_chunk_table_chunk_exists_for_offset(
 
 		return( -1 );
 	}
-	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
-	          chunk_table,
-	          file_io_pool,
-	          segment_table,
-	          chunk_groups_cache,
-	          offset,
-	          &segment_number,
-	          &segment_file_data_offset,
-	          &segment_file,
-		  &chunk_groups_list_index,
-		  &chunk_group_data_offset,
-		  &chunk_group,
-	          error );
-
-	if( result == -1 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment file chunk group at 0x%08" PRIx64 ".",
-		 function,
-		 offset );
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
 		return( -1 );
 	}
-	if( result != 0 )
+#endif
+	if( chunk_table->extents == NULL )
 	{
-		if( chunk_group == NULL )
+		if( libewf_chunk_table_read_extents(
+		     chunk_table,
+		     file_io_pool,
+		     media_values,
+		     segment_table,
+		     chunk_groups_cache,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunks group: %d.",
-			 function,
-			 chunk_groups_list_index );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read extents.",
+			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		result = libfdata_list_get_list_element_at_offset(
-			  chunk_group->chunks_list,
-			  chunk_group_data_offset,
-			  &chunks_list_index,
-			  &chunk_data_offset,
-			  &chunk_list_element,
-			  error );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     chunk_table->extents,
+	     number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
 
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve chunk: %" PRIu64 " from chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
-			 function,
-			 chunk_index,
-			 chunk_groups_list_index,
-			 segment_number,
-			 segment_file_data_offset );
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	return( result );
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 chunk_table->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Retrieves the chunk data of a chunk at a specific offset
- * Adds a checksum error if the data is corrupted
+/* Retrieves a specific extent
+ * The extents are read on the first call
+ * This function is safe to be called from multiple threads concurrently
  * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_table_get_chunk_data_by_offset(
+int libewf_chunk_table_get_extent_by_index(
      libewf_chunk_table_t *chunk_table,
-     uint64_t chunk_index,
-     libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
      libewf_media_values_t *media_values,
      libewf_segment_table_t *segment_table,
      libfcache_cache_t *chunk_groups_cache,
-     libfcache_cache_t *chunks_cache,
-     off64_t offset,
-     libewf_chunk_data_t **chunk_data,
-     off64_t *chunk_data_offset,
+     int extent_index,
+     off64_t *offset,
+     size64_t *size,
+     uint32_t *flags,
      libcerror_error_t **error )
 {
-	libewf_chunk_data_t *corrupted_chunk_data = NULL;
-	libewf_chunk_group_t *chunk_group         = NULL;
-	libewf_segment_file_t *segment_file       = NULL;
-	static char *function                     = "libewf_chunk_table_get_chunk_data_by_offset";
-	off64_t chunk_offset                      = 0;
-	off64_t chunk_group_data_offset           = 0;
-	off64_t segment_file_data_offset          = 0;
-	size_t chunk_data_size                    = 0;
-	uint64_t start_sector                     = 0;
-	uint64_t number_of_sectors                = 0;
-	uint32_t segment_number                   = 0;
-	int chunk_groups_list_index               = 0;
-	int chunks_list_index                     = 0;
-	int result                                = 0;
+	libewf_extent_t *extent = NULL;
+	static char *function   = "libewf_chunk_table_get_extent_by_index";
 
 	if( chunk_table == NULL )
 	{
@@ -780,63 +1398,313 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 		return( -1 );
 	}
-	if( io_handle == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( media_values == NULL )
+#endif
+	if( chunk_table->extents == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid media values.",
-		 function );
-
-		return( -1 );
+		if( libewf_chunk_table_read_extents(
+		     chunk_table,
+		     file_io_pool,
+		     media_values,
+		     segment_table,
+		     chunk_groups_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read extents.",
+			 function );
+
+			goto on_error;
+		}
 	}
-	if( chunk_data == NULL )
+	if( libcdata_array_get_entry_by_index(
+	     chunk_table->extents,
+	     extent_index,
+	     (intptr_t **) &extent,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent: %d.",
+		 function,
+		 extent_index );
+
+		goto on_error;
+	}
+	if( libewf_extent_get(
+	     extent,
+	     offset,
+	     size,
+	     flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent: %d values.",
+		 function,
+		 extent_index );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 chunk_table->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the chunks group in a segment file at a specific offset
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     uint32_t *segment_number,
+     off64_t *segment_file_data_offset,
+     libewf_segment_file_t **segment_file,
+     int *chunk_groups_list_index,
+     off64_t *chunk_group_data_offset,
+     libewf_chunk_group_t **chunk_group,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_get_segment_file_chunk_group_by_offset";
+	int result            = 0;
+
+	if( chunk_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk data.",
+		 "%s: invalid chunk table.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_data_offset == NULL )
+	if( segment_number == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk data offset.",
+		 "%s: invalid segment number.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_groups_list_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk groups list index.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk groups.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_segment_table_get_segment_file_at_offset(
+	          segment_table,
+	          offset,
+	          file_io_pool,
+	          segment_number,
+	          segment_file_data_offset,
+	          segment_file,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file at 0x%08" PRIx64 " from segment files list.",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	if( result != 0 )
+	{
+		result = libewf_segment_file_get_chunk_group_by_offset(
+			  *segment_file,
+			  file_io_pool,
+			  chunk_groups_cache,
+			  *segment_file_data_offset,
+			  chunk_groups_list_index,
+			  chunk_group_data_offset,
+			  chunk_group,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk group from segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+			 function,
+			 *segment_number,
+			 *segment_file_data_offset );
+
+			return( -1 );
+		}
+	}
+	if( result != 0 )
+	{
+		if( *chunk_group == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk group: %d.",
+			 function,
+			 *chunk_groups_list_index );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Determines if the chunk exists
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_chunk_exists_for_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group   = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_chunk_table_chunk_exists_for_offset";
+	off64_t chunk_data_offset           = 0;
+	off64_t chunk_group_data_offset     = 0;
+	off64_t element_offset              = 0;
+	off64_t segment_file_data_offset    = 0;
+	size64_t element_size               = 0;
+	uint32_t element_flags              = 0;
+	uint32_t segment_number             = 0;
+	int chunk_groups_list_index         = 0;
+	int chunks_list_index               = 0;
+	int file_io_pool_entry              = 0;
+	int result                          = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
 		 function );
 
 		return( -1 );
 	}
 	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
-		  chunk_table,
-		  file_io_pool,
-		  segment_table,
-		  chunk_groups_cache,
-		  offset,
-		  &segment_number,
-		  &segment_file_data_offset,
-		  &segment_file,
+	          chunk_table,
+	          file_io_pool,
+	          segment_table,
+	          chunk_groups_cache,
+	          offset,
+	          &segment_number,
+	          &segment_file_data_offset,
+	          &segment_file,
 		  &chunk_groups_list_index,
 		  &chunk_group_data_offset,
 		  &chunk_group,
-		  error );
+	          error );
 
 	if( result == -1 )
 	{
@@ -848,7 +1716,7 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 		 function,
 		 offset );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( result != 0 )
 	{
@@ -858,21 +1726,21 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk group: %d.",
+			 "%s: missing chunks group: %d.",
 			 function,
 			 chunk_groups_list_index );
 
-			goto on_error;
+			return( -1 );
 		}
-		result = libfdata_list_get_element_value_at_offset(
-			  chunk_group->chunks_list,
-			  (intptr_t *) file_io_pool,
-			  (libfdata_cache_t *) chunks_cache,
+		result = libewf_chunk_group_get_chunk_at_offset(
+			  chunk_group,
 			  chunk_group_data_offset,
 			  &chunks_list_index,
-			  chunk_data_offset,
-			  (intptr_t **) chunk_data,
-			  0,
+			  &chunk_data_offset,
+			  &file_io_pool_entry,
+			  &element_offset,
+			  &element_size,
+			  &element_flags,
 			  error );
 
 		if( result == -1 )
@@ -881,54 +1749,367 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve chunk: %" PRIu64 " data from chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+			 "%s: unable to retrieve chunk: %" PRIu64 " from chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
 			 function,
 			 chunk_index,
 			 chunk_groups_list_index,
 			 segment_number,
 			 segment_file_data_offset );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
-	if( result != 0 )
-	{
-		if( *chunk_data == NULL )
+	return( result );
+}
+
+/* Reads the chunk data of a chunk at a specific offset from the segment files without unpacking it
+ * If the chunk is missing corrupted chunk data is created
+ * If fill pattern is set, no chunk data is created for a sparse or pattern fill chunk
+ * but its 8-byte fill pattern is retrieved instead
+ * If read request is set, the chunk data of a stored chunk is created but not read
+ * and the read request is set to read the chunk data instead, the read request
+ * buffer remains unset for a missing chunk
+ * The caller is responsible for freeing the chunk data
+ * Returns 1 if successful, 0 if the chunk is a fill chunk or -1 on error
+ */
+int libewf_chunk_table_read_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     off64_t *chunk_data_offset,
+     uint8_t *fill_pattern,
+     size_t fill_pattern_size,
+     libewf_io_uring_read_request_t *read_request,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group   = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_chunk_table_read_chunk_data_by_offset";
+	off64_t chunk_group_data_offset     = 0;
+	off64_t chunk_offset                = 0;
+	off64_t element_offset              = 0;
+	off64_t segment_file_data_offset    = 0;
+	size64_t element_size               = 0;
+	size_t chunk_data_size              = 0;
+	ssize_t read_count                  = 0;
+	uint32_t element_flags              = 0;
+	uint32_t segment_number             = 0;
+	int chunk_groups_list_index         = 0;
+	int chunks_list_index               = 0;
+	int file_io_pool_entry              = 0;
+	int result                          = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( fill_pattern != NULL )
+	 && ( fill_pattern_size < 8 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid fill pattern size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+		  chunk_table,
+		  file_io_pool,
+		  segment_table,
+		  chunk_groups_cache,
+		  offset,
+		  &segment_number,
+		  &segment_file_data_offset,
+		  &segment_file,
+		  &chunk_groups_list_index,
+		  &chunk_group_data_offset,
+		  &chunk_group,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file chunk group at 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		goto on_error;
+	}
+	if( result != 0 )
+	{
+		if( chunk_group == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk: %" PRIu64 " data.",
+			 "%s: missing chunk group: %d.",
+			 function,
+			 chunk_groups_list_index );
+
+			goto on_error;
+		}
+		result = libewf_chunk_group_get_chunk_at_offset(
+			  chunk_group,
+			  chunk_group_data_offset,
+			  &chunks_list_index,
+			  chunk_data_offset,
+			  &file_io_pool_entry,
+			  &element_offset,
+			  &element_size,
+			  &element_flags,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " from chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+			 function,
+			 chunk_index,
+			 chunk_groups_list_index,
+			 segment_number,
+			 segment_file_data_offset );
+
+			goto on_error;
+		}
+	}
+	if( ( result != 0 )
+	 && ( fill_pattern != NULL )
+	 && ( ( element_flags & ( LIBEWF_RANGE_FLAG_IS_SPARSE | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) ) != 0 ) )
+	{
+		/* A sparse chunk is filled with 0-byte values
+		 */
+		if( ( element_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			if( memory_set(
+			     fill_pattern,
+			     0,
+			     8 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear fill pattern.",
+				 function );
+
+				goto on_error;
+			}
+			return( 0 );
+		}
+		if( element_size != (size64_t) 8 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid chunk: %" PRIu64 " fill pattern size value out of bounds.",
 			 function,
 			 chunk_index );
 
 			goto on_error;
 		}
-		if( libewf_chunk_data_unpack(
-		     *chunk_data,
-		     io_handle,
+		if( libbfio_pool_seek_offset(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     element_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek chunk: %" PRIu64 " fill pattern offset: %" PRIi64 " in file IO pool entry: %d.",
+			 function,
+			 chunk_index,
+			 element_offset,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+		read_count = libbfio_pool_read_buffer(
+			      file_io_pool,
+			      file_io_pool_entry,
+			      fill_pattern,
+			      8,
+			      error );
+
+		if( read_count != (ssize_t) 8 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " fill pattern.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		return( 0 );
+	}
+	if( result != 0 )
+	{
+		if( ( element_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported chunk: %" PRIu64 " data flags.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( libewf_chunk_data_initialize(
+		     chunk_data,
+		     media_values->chunk_size,
+		     0,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to unpack chunk: %" PRIu64 " data.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk: %" PRIu64 " data.",
 			 function,
 			 chunk_index );
 
 			goto on_error;
 		}
-		if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+		if( read_request != NULL )
+		{
+			/* The read is described by the read request so that it can be
+			 * submitted together with the reads of other chunks
+			 */
+			if( ( element_size == 0 )
+			 || ( element_size > (size64_t) ( *chunk_data )->allocated_data_size ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid chunk: %" PRIu64 " data size value out of bounds.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			read_request->file_io_pool_entry = file_io_pool_entry;
+			read_request->offset             = element_offset;
+			read_request->buffer             = ( *chunk_data )->data;
+			read_request->size               = (size_t) element_size;
+			read_request->read_count         = 0;
+
+			( *chunk_data )->data_size   = (size_t) element_size;
+			( *chunk_data )->range_flags = ( element_flags | LIBEWF_RANGE_FLAG_IS_PACKED )
+			                             & ~( LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED );
+		}
+		else
 		{
-			chunk_offset = offset - *chunk_data_offset;
+			read_count = libewf_chunk_data_read_from_file_io_pool(
+				      *chunk_data,
+				      file_io_pool,
+				      file_io_pool_entry,
+				      element_offset,
+				      element_size,
+				      element_flags,
+				      error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
 		}
 	}
 	else
 	{
-/* TODO get chunk from chunk_table->corrupted_chunks_list */
-
 		chunk_offset    = (off64_t) chunk_index * media_values->chunk_size;
 		chunk_data_size = media_values->chunk_size;
 
@@ -937,7 +2118,7 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 			chunk_data_size = (size_t) ( media_values->media_size - chunk_offset );
 		}
 		if( libewf_chunk_data_initialize(
-		     &corrupted_chunk_data,
+		     chunk_data,
 		     media_values->chunk_size,
 		     1,
 		     error ) != 1 )
@@ -952,7 +2133,7 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 			goto on_error;
 		}
-		if( corrupted_chunk_data == NULL )
+		if( *chunk_data == NULL )
 		{
 			libcerror_error_set(
 			 error,
@@ -962,112 +2143,2654 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 			 function,
 			 chunk_index );
 
-			goto on_error;
-		}
-		corrupted_chunk_data->data_size    = chunk_data_size;
-		corrupted_chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
-
-		if( libfdata_list_cache_element_value(
-		     chunk_table->corrupted_chunks_list,
-		     (libfdata_cache_t *) chunks_cache,
-		     (int) chunk_index,
-		     (int) segment_number,
-		     chunk_offset,
-		     chunk_data_size,
-		     corrupted_chunk_data->range_flags,
-		     0,
-		     (intptr_t *) corrupted_chunk_data,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
-		     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to cache chunk: %" PRIu64 " data in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
-			 function,
-			 chunk_index,
-			 segment_number,
-			 chunk_offset );
+			goto on_error;
+		}
+		( *chunk_data )->data_size    = chunk_data_size;
+		( *chunk_data )->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+
+		*chunk_data_offset = offset - chunk_offset;
+	}
+	return( 1 );
+
+on_error:
+	if( *chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the shared read-only chunk data of a sparse or pattern fill chunk
+ * A shared fill chunk is created per fill pattern and data size, it is filled once
+ * and not modified afterwards, so that chunk views can reference it without being counted
+ * The caller must hold the chunk table lock for writing
+ * Returns 1 if successful, 0 if the maximum number of shared fill chunks was reached or -1 on error
+ */
+int libewf_chunk_table_get_shared_fill_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_media_values_t *media_values,
+     const uint8_t *fill_pattern,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *shared_fill_chunk_data = NULL;
+	static char *function                       = "libewf_chunk_table_get_shared_fill_chunk_data";
+	off64_t chunk_offset                        = 0;
+	size_t data_size                            = 0;
+	ssize_t fill_count                          = 0;
+	int shared_fill_chunk_index                 = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_table->number_of_shared_fill_chunks < 0 )
+	 || ( chunk_table->number_of_shared_fill_chunks > LIBEWF_MAXIMUM_NUMBER_OF_SHARED_FILL_CHUNKS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk table - number of shared fill chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( fill_pattern == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fill pattern.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_offset = (off64_t) chunk_index * media_values->chunk_size;
+	data_size    = (size_t) media_values->chunk_size;
+
+	if( (size64_t) ( chunk_offset + data_size ) > media_values->media_size )
+	{
+		data_size = (size_t) ( media_values->media_size - chunk_offset );
+	}
+	for( shared_fill_chunk_index = 0;
+	     shared_fill_chunk_index < chunk_table->number_of_shared_fill_chunks;
+	     shared_fill_chunk_index++ )
+	{
+		shared_fill_chunk_data = chunk_table->shared_fill_chunks_data[ shared_fill_chunk_index ];
+
+		if( ( shared_fill_chunk_data->data_size == data_size )
+		 && ( memory_compare(
+		       chunk_table->shared_fill_patterns[ shared_fill_chunk_index ],
+		       fill_pattern,
+		       8 ) == 0 ) )
+		{
+			*chunk_data = shared_fill_chunk_data;
+
+			return( 1 );
+		}
+	}
+	if( chunk_table->number_of_shared_fill_chunks == LIBEWF_MAXIMUM_NUMBER_OF_SHARED_FILL_CHUNKS )
+	{
+		return( 0 );
+	}
+	shared_fill_chunk_data = NULL;
+
+	if( libewf_chunk_data_initialize(
+	     &shared_fill_chunk_data,
+	     media_values->chunk_size,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create shared fill chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	fill_count = libewf_chunk_table_fill_buffer_at_offset(
+	              chunk_table,
+	              chunk_index,
+	              media_values,
+	              fill_pattern,
+	              0,
+	              shared_fill_chunk_data->data,
+	              shared_fill_chunk_data->allocated_data_size,
+	              error );
+
+	if( fill_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to fill chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     chunk_table->shared_fill_patterns[ chunk_table->number_of_shared_fill_chunks ],
+	     fill_pattern,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy fill pattern.",
+		 function );
+
+		goto on_error;
+	}
+	shared_fill_chunk_data->data_size   = (size_t) fill_count;
+	shared_fill_chunk_data->range_flags = 0;
+	shared_fill_chunk_data->is_shared   = 1;
+
+	chunk_table->shared_fill_chunks_data[ chunk_table->number_of_shared_fill_chunks ] = shared_fill_chunk_data;
+
+	chunk_table->number_of_shared_fill_chunks += 1;
+
+	*chunk_data = shared_fill_chunk_data;
+
+	return( 1 );
+
+on_error:
+	if( shared_fill_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &shared_fill_chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Fills a buffer with the (media) data of a sparse or pattern fill chunk at a specific offset
+ * Returns the number of bytes filled or -1 on error
+ */
+ssize_t libewf_chunk_table_fill_buffer_at_offset(
+         libewf_chunk_table_t *chunk_table,
+         uint64_t chunk_index,
+         libewf_media_values_t *media_values,
+         const uint8_t *fill_pattern,
+         off64_t chunk_data_offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	uint8_t rotated_fill_pattern[ 8 ];
+
+	static char *function = "libewf_chunk_table_fill_buffer_at_offset";
+	off64_t chunk_offset  = 0;
+	size_t data_size      = 0;
+	size_t fill_size      = 0;
+	uint8_t pattern_index = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( fill_pattern == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fill pattern.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_offset = (off64_t) chunk_index * media_values->chunk_size;
+	data_size    = (size_t) media_values->chunk_size;
+
+	if( (size64_t) ( chunk_offset + data_size ) > media_values->media_size )
+	{
+		data_size = (size_t) ( media_values->media_size - chunk_offset );
+	}
+	if( ( chunk_data_offset < 0 )
+	 || ( chunk_data_offset > (off64_t) data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	fill_size = data_size - (size_t) chunk_data_offset;
+
+	if( fill_size > buffer_size )
+	{
+		fill_size = buffer_size;
+	}
+	/* The fill pattern is aligned with the start of the chunk
+	 */
+	for( pattern_index = 0;
+	     pattern_index < 8;
+	     pattern_index++ )
+	{
+		rotated_fill_pattern[ pattern_index ] = fill_pattern[ ( chunk_data_offset + pattern_index ) % 8 ];
+	}
+	if( libewf_chunk_data_fill_buffer(
+	     buffer,
+	     fill_size,
+	     rotated_fill_pattern,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to fill buffer with chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	return( (ssize_t) fill_size );
+}
+
+/* Adds a checksum error for the chunk at a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_insert_chunk_checksum_error(
+     libewf_chunk_table_t *chunk_table,
+     libewf_media_values_t *media_values,
+     off64_t chunk_offset,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_chunk_table_insert_chunk_checksum_error";
+	uint64_t number_of_sectors = 0;
+	uint64_t start_sector      = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	start_sector      = chunk_offset / media_values->bytes_per_sector;
+	number_of_sectors = media_values->sectors_per_chunk;
+
+	if( ( start_sector + number_of_sectors ) > (uint64_t) media_values->number_of_sectors )
+	{
+		number_of_sectors = (uint64_t) media_values->number_of_sectors - start_sector;
+	}
+	if( libcdata_range_list_insert_range(
+	     chunk_table->checksum_errors,
+	     start_sector,
+	     number_of_sectors,
+	     NULL,
+	     NULL,
+	     NULL,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert checksum error in range list.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the chunk data of a chunk at a specific offset
+ * The chunk data is managed by the chunk cache and remains valid until the chunk cache is changed
+ * Adds a checksum error if the data is corrupted
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_get_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error )
+{
+	uint8_t fill_pattern[ 8 ];
+
+	libewf_chunk_data_t *read_chunk_data = NULL;
+	static char *function                = "libewf_chunk_table_get_chunk_data_by_offset";
+	ssize_t fill_count                   = 0;
+	int result                           = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_table->chunk_cache,
+	          chunk_index,
+	          chunk_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data from cache.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		*chunk_data_offset = offset - ( (off64_t) chunk_index * media_values->chunk_size );
+	}
+	else
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     chunk_table->io_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab IO mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		result = libewf_chunk_table_read_chunk_data_by_offset(
+		          chunk_table,
+		          chunk_index,
+		          file_io_pool,
+		          media_values,
+		          segment_table,
+		          chunk_groups_cache,
+		          offset,
+		          &read_chunk_data,
+		          chunk_data_offset,
+		          fill_pattern,
+		          8,
+		          NULL,
+		          error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     chunk_table->io_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release IO mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			if( libcthreads_read_write_lock_grab_for_write(
+			     chunk_table->read_write_lock,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab read/write lock for writing.",
+				 function );
+
+				goto on_error;
+			}
+#endif
+			/* Sparse and pattern fill chunks do not take up space in the chunk cache
+			 * the chunk data is provided by a shared read-only fill chunk
+			 */
+			result = libewf_chunk_table_get_shared_fill_chunk_data(
+			          chunk_table,
+			          chunk_index,
+			          media_values,
+			          fill_pattern,
+			          chunk_data,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve shared fill chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				goto on_error_with_lock;
+			}
+			else if( result == 0 )
+			{
+				/* When the maximum number of shared fill chunks was reached
+				 * the fill chunk data is managed by the chunk cache
+				 */
+				if( libewf_chunk_data_initialize(
+				     &read_chunk_data,
+				     media_values->chunk_size,
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
+
+					goto on_error_with_lock;
+				}
+				fill_count = libewf_chunk_table_fill_buffer_at_offset(
+				              chunk_table,
+				              chunk_index,
+				              media_values,
+				              fill_pattern,
+				              0,
+				              read_chunk_data->data,
+				              read_chunk_data->allocated_data_size,
+				              error );
+
+				if( fill_count == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to fill chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
+
+					goto on_error_with_lock;
+				}
+				read_chunk_data->data_size = (size_t) fill_count;
+
+				if( libewf_chunk_cache_set_chunk_data(
+				     chunk_table->chunk_cache,
+				     chunk_index,
+				     read_chunk_data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set chunk: %" PRIu64 " data in cache.",
+					 function,
+					 chunk_index );
+
+					goto on_error_with_lock;
+				}
+				/* The chunk cache takes over management of read_chunk_data
+				 */
+				*chunk_data     = read_chunk_data;
+				read_chunk_data = NULL;
+			}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			if( libcthreads_read_write_lock_release_for_write(
+			     chunk_table->read_write_lock,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release read/write lock for writing.",
+				 function );
+
+				goto on_error;
+			}
+#endif
+			return( 1 );
+		}
+		if( libewf_chunk_data_unpack(
+		     read_chunk_data,
+		     io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		result = libewf_chunk_cache_set_chunk_data(
+		          chunk_table->chunk_cache,
+		          chunk_index,
+		          read_chunk_data,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk: %" PRIu64 " data in cache.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		/* The chunk cache takes over management of read_chunk_data
+		 */
+		*chunk_data     = read_chunk_data;
+		read_chunk_data = NULL;
+	}
+	if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		if( libewf_chunk_table_insert_chunk_checksum_error(
+		     chunk_table,
+		     media_values,
+		     offset - *chunk_data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add checksum error for chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error_with_lock:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 chunk_table->read_write_lock,
+	 NULL );
+#endif
+on_error:
+	if( read_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &read_chunk_data,
+		 NULL );
+	}
+	*chunk_data = NULL;
+
+	return( -1 );
+}
+
+/* Sets the chunk data of a chunk at a specific offset
+ * Adds a checksum error if the data is corrupted
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_set_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     libfcache_cache_t *chunks_cache,
+     off64_t offset,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group   = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_chunk_table_set_chunk_data_by_offset";
+	off64_t chunk_group_data_offset     = 0;
+	off64_t segment_file_data_offset    = 0;
+	uint32_t segment_number             = 0;
+	int chunk_groups_list_index         = 0;
+	int result                          = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+		  chunk_table,
+		  file_io_pool,
+		  segment_table,
+		  chunk_groups_cache,
+		  offset,
+		  &segment_number,
+		  &segment_file_data_offset,
+		  &segment_file,
+		  &chunk_groups_list_index,
+		  &chunk_group_data_offset,
+		  &chunk_group,
+		  error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file chunk group at 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk group: %d.",
+		 function,
+		 chunk_groups_list_index );
+
+		return( -1 );
+	}
+	/* The chunk data is cached as the value of the chunks list element
+	 */
+	if( libewf_chunk_group_expand_packed_chunk_index(
+	     chunk_group,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to expand packed chunk index of chunk group: %d.",
+		 function,
+		 chunk_groups_list_index );
+
+		return( -1 );
+	}
+	result = libfdata_list_set_element_value_at_offset(
+		  chunk_group->chunks_list,
+		  (intptr_t *) file_io_pool,
+		  (libfdata_cache_t *) chunks_cache,
+		  chunk_group_data_offset,
+		  (intptr_t *) chunk_data,
+		  (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+		  LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+		  error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " data in chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+		 function,
+		 chunk_index,
+		 chunk_groups_list_index,
+		 segment_number,
+		 segment_file_data_offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads (media) data of a chunk at a specific offset into a buffer
+ * The chunk data is referenced as a view and copied after the chunk table lock is released
+ * This function is safe to be called from multiple threads concurrently
+ * Adds a checksum error if the data is corrupted
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_chunk_table_read_buffer_at_offset(
+         libewf_chunk_table_t *chunk_table,
+         uint64_t chunk_index,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_media_values_t *media_values,
+         libewf_segment_table_t *segment_table,
+         libfcache_cache_t *chunk_groups_cache,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_chunk_table_read_buffer_at_offset";
+	off64_t chunk_data_offset       = 0;
+	size_t read_size                = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data_offset = offset - ( (off64_t) chunk_index * media_values->chunk_size );
+
+	if( libewf_chunk_table_get_chunk_view(
+	     chunk_table,
+	     chunk_index,
+	     io_handle,
+	     file_io_pool,
+	     media_values,
+	     segment_table,
+	     chunk_groups_cache,
+	     &chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " view.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( ( chunk_data_offset < 0 )
+	 || ( chunk_data_offset > (off64_t) chunk_data->data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
+
+	if( read_size > buffer_size )
+	{
+		read_size = buffer_size;
+	}
+	/* The view keeps the chunk data valid while it is copied,
+	 * also if another thread evicts it from the chunk cache
+	 */
+	if( memory_copy(
+	     buffer,
+	     &( ( chunk_data->data )[ chunk_data_offset ] ),
+	     read_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( libewf_chunk_table_release_chunk_view(
+	     chunk_table,
+	     &chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release chunk: %" PRIu64 " view.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	return( (ssize_t) read_size );
+
+on_error:
+	libewf_chunk_table_release_chunk_view(
+	 chunk_table,
+	 &chunk_data,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Reads the packed (media) data of a full chunk so that it can be unpacked directly into a buffer
+ * If the chunk is cached its data is copied into the buffer instead, the cached chunk data
+ * is referenced by a chunk view while it is copied so that the chunk table lock is not held
+ * Sparse and pattern fill chunks are filled directly into the buffer outside the chunk table lock
+ * The packed chunk data is read while holding the IO mutex instead of the chunk table lock
+ * If read request is set, the packed chunk data is not read but the read request is set
+ * to read it instead, refer to libewf_chunk_table_read_chunk_data_by_offset
+ * This function is safe to be called from multiple threads concurrently
+ * Corrupted cached chunk data is read again, the caller adds the checksum error after unpacking
+ * Returns 1 if the packed chunk data was read, 0 if the chunk data was copied or filled into the buffer or -1 on error
+ */
+int libewf_chunk_table_read_packed_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *data_size,
+     libewf_chunk_data_t **chunk_data,
+     libewf_io_uring_read_request_t *read_request,
+     libcerror_error_t **error )
+{
+	uint8_t fill_pattern[ 8 ];
+
+	libewf_chunk_data_t *cached_chunk_data = NULL;
+	static char *function                  = "libewf_chunk_table_read_packed_chunk_data";
+	off64_t chunk_data_offset              = 0;
+	off64_t offset                         = 0;
+	ssize_t fill_count                     = 0;
+	int result                             = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size < (size_t) media_values->chunk_size )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_cached_chunk_view(
+	          chunk_table,
+	          chunk_index,
+	          &cached_chunk_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cached chunk: %" PRIu64 " view.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		/* The cached chunk data is referenced by the view and is copied
+		 * without holding the chunk table lock
+		 */
+		if( cached_chunk_data->data_size > buffer_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: chunk: %" PRIu64 " data size exceeds buffer size.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     buffer,
+		     cached_chunk_data->data,
+		     cached_chunk_data->data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		*data_size = cached_chunk_data->data_size;
+
+		if( libewf_chunk_table_release_chunk_view(
+		     chunk_table,
+		     &cached_chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release cached chunk: %" PRIu64 " view.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		return( 0 );
+	}
+	offset = (off64_t) chunk_index * media_values->chunk_size;
+
+	/* The packed chunk data is read without holding the chunk table lock
+	 */
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_table->io_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab IO mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_chunk_table_read_chunk_data_by_offset(
+	          chunk_table,
+	          chunk_index,
+	          file_io_pool,
+	          media_values,
+	          segment_table,
+	          chunk_groups_cache,
+	          offset,
+	          chunk_data,
+	          &chunk_data_offset,
+	          fill_pattern,
+	          8,
+	          read_request,
+	          error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_table->io_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release IO mutex.",
+		 function );
+
+		if( *chunk_data != NULL )
+		{
+			libewf_chunk_data_free(
+			 chunk_data,
+			 NULL );
+		}
+		return( -1 );
+	}
+#endif
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		/* Sparse and pattern fill chunks are filled directly into the buffer
+		 * and do not need to be unpacked
+		 */
+		fill_count = libewf_chunk_table_fill_buffer_at_offset(
+		              chunk_table,
+		              chunk_index,
+		              media_values,
+		              fill_pattern,
+		              0,
+		              buffer,
+		              buffer_size,
+		              error );
+
+		if( fill_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill buffer with chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		*data_size = (size_t) fill_count;
+	}
+	else
+	{
+		*data_size = 0;
+	}
+	return( result );
+
+on_error:
+	if( cached_chunk_data != NULL )
+	{
+		libewf_chunk_table_release_chunk_view(
+		 chunk_table,
+		 &cached_chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Adds a checksum error for a corrupted chunk that was unpacked outside the chunk table
+ * This function is safe to be called from multiple threads concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_set_chunk_corrupted(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_media_values_t *media_values,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_set_chunk_corrupted";
+	int result            = 1;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_chunk_table_insert_chunk_checksum_error(
+	     chunk_table,
+	     media_values,
+	     (off64_t) chunk_index * media_values->chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to add checksum error for chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads the (media) data of a full chunk directly into a buffer
+ * A chunk that is not cached is unpacked into the buffer without being added to the chunk cache
+ * This function is safe to be called from multiple threads concurrently
+ * The chunk is decompressed outside the chunk table lock
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_chunk_table_read_chunk_into_buffer(
+         libewf_chunk_table_t *chunk_table,
+         uint64_t chunk_index,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_media_values_t *media_values,
+         libewf_segment_table_t *segment_table,
+         libfcache_cache_t *chunk_groups_cache,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_chunk_table_read_chunk_into_buffer";
+	size_t data_size                = 0;
+	ssize_t read_count              = 0;
+	int result                      = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_read_packed_chunk_data(
+	          chunk_table,
+	          chunk_index,
+	          file_io_pool,
+	          media_values,
+	          segment_table,
+	          chunk_groups_cache,
+	          buffer,
+	          buffer_size,
+	          &data_size,
+	          &chunk_data,
+	          NULL,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( (ssize_t) data_size );
+	}
+	/* The chunk data is unpacked directly into the buffer
+	 */
+	read_count = libewf_chunk_data_unpack_buffer(
+	              chunk_data,
+	              io_handle,
+	              buffer,
+	              buffer_size,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		if( libewf_chunk_table_set_chunk_corrupted(
+		     chunk_table,
+		     chunk_index,
+		     media_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add checksum error for chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	if( libewf_chunk_data_free(
+	     &chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	return( read_count );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves a view of the (media) data of a specific chunk if it is cached
+ * Only the chunk table lock for reading is held, so that threads that reference
+ * cached chunks do not block each other
+ * Corrupted chunk data is not referenced, since adding the checksum error
+ * requires the chunk table lock for writing
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_chunk_table_get_cached_chunk_view(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *cached_chunk_data = NULL;
+	static char *function                  = "libewf_chunk_table_get_cached_chunk_view";
+	int result                             = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+	/* The chunk cache lookup changes the order of the queues
+	 */
+	if( libcthreads_mutex_grab(
+	     chunk_table->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 chunk_table->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_table->chunk_cache,
+	          chunk_index,
+	          &cached_chunk_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data from cache.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( ( cached_chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+		{
+			result = 0;
+		}
+		else
+		{
+			cached_chunk_data->number_of_references += 1;
+
+			*chunk_data = cached_chunk_data;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_table->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 chunk_table->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libcthreads_read_write_lock_release_for_read(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 chunk_table->cache_mutex,
+	 NULL );
+
+	libcthreads_read_write_lock_release_for_read(
+	 chunk_table->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves a view of the (media) data of a specific chunk
+ * The chunk data is referenced instead of copied and remains valid until the view is released
+ * This function is safe to be called from multiple threads concurrently
+ * The chunk is read while holding the IO mutex and decompressed outside the chunk table lock
+ * Adds a checksum error if the data is corrupted
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_get_chunk_view(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	uint8_t fill_pattern[ 8 ];
+
+	libewf_chunk_data_t *read_chunk_data = NULL;
+	static char *function                = "libewf_chunk_table_get_chunk_view";
+	off64_t chunk_data_offset            = 0;
+	off64_t offset                       = 0;
+	ssize_t fill_count                   = 0;
+	int read_result                      = 0;
+	int result                           = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index >= media_values->number_of_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_cached_chunk_view(
+	          chunk_table,
+	          chunk_index,
+	          chunk_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cached chunk: %" PRIu64 " view.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( 1 );
+	}
+	offset = (off64_t) chunk_index * media_values->chunk_size;
+
+	/* The chunk data is read without holding the chunk table lock, so that
+	 * other threads can retrieve cached chunks in the meantime
+	 */
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_table->io_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab IO mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_result = libewf_chunk_table_read_chunk_data_by_offset(
+	               chunk_table,
+	               chunk_index,
+	               file_io_pool,
+	               media_values,
+	               segment_table,
+	               chunk_groups_cache,
+	               offset,
+	               &read_chunk_data,
+	               &chunk_data_offset,
+	               fill_pattern,
+	               8,
+	               NULL,
+	               error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_table->io_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release IO mutex.",
+		 function );
+
+		if( read_chunk_data != NULL )
+		{
+			libewf_chunk_data_free(
+			 &read_chunk_data,
+			 NULL );
+		}
+		*chunk_data = NULL;
+
+		return( -1 );
+	}
+#endif
+	if( read_result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		*chunk_data = NULL;
+
+		return( -1 );
+	}
+	else if( read_result != 0 )
+	{
+		if( libewf_chunk_data_unpack(
+		     read_chunk_data,
+		     io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			libewf_chunk_data_free(
+			 &read_chunk_data,
+			 NULL );
+
+			*chunk_data = NULL;
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		if( read_chunk_data != NULL )
+		{
+			libewf_chunk_data_free(
+			 &read_chunk_data,
+			 NULL );
+		}
+		*chunk_data = NULL;
+
+		return( -1 );
+	}
+#endif
+	if( read_result == 0 )
+	{
+		/* Sparse and pattern fill chunks do not take up space in the chunk cache
+		 * the view is provided by a shared read-only fill chunk
+		 */
+		result = libewf_chunk_table_get_shared_fill_chunk_data(
+		          chunk_table,
+		          chunk_index,
+		          media_values,
+		          fill_pattern,
+		          chunk_data,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve shared fill chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			if( libcthreads_read_write_lock_release_for_write(
+			     chunk_table->read_write_lock,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release read/write lock for writing.",
+				 function );
+
+				*chunk_data = NULL;
+
+				return( -1 );
+			}
+#endif
+			return( 1 );
+		}
+		/* When the maximum number of shared fill chunks was reached
+		 * the view is provided by chunk data that is freed when the view is released
+		 */
+		if( libewf_chunk_data_initialize(
+		     &read_chunk_data,
+		     media_values->chunk_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		fill_count = libewf_chunk_table_fill_buffer_at_offset(
+		              chunk_table,
+		              chunk_index,
+		              media_values,
+		              fill_pattern,
+		              0,
+		              read_chunk_data->data,
+		              read_chunk_data->allocated_data_size,
+		              error );
+
+		if( fill_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		read_chunk_data->data_size   = (size_t) fill_count;
+		read_chunk_data->is_detached = 1;
+
+		*chunk_data     = read_chunk_data;
+		read_chunk_data = NULL;
+	}
+	else
+	{
+		/* Another thread could have cached the same chunk while the chunk table lock was not held
+		 */
+		result = libewf_chunk_cache_set_chunk_data(
+		          chunk_table->chunk_cache,
+		          chunk_index,
+		          read_chunk_data,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk: %" PRIu64 " data in cache.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			/* The chunk cache takes over management of read_chunk_data
+			 */
+			*chunk_data     = read_chunk_data;
+			read_chunk_data = NULL;
+		}
+		else
+		{
+			/* The view references the chunk data that was cached by the other thread
+			 */
+			result = libewf_chunk_cache_get_chunk_data(
+			          chunk_table->chunk_cache,
+			          chunk_index,
+			          chunk_data,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk: %" PRIu64 " data from cache.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			if( libewf_chunk_data_free(
+			     &read_chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+	}
+	if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		if( libewf_chunk_table_insert_chunk_checksum_error(
+		     chunk_table,
+		     media_values,
+		     offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add checksum error for chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			if( ( *chunk_data )->is_detached != 0 )
+			{
+				read_chunk_data = *chunk_data;
+			}
+			goto on_error;
+		}
+	}
+	( *chunk_data )->number_of_references += 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 chunk_table->read_write_lock,
+	 NULL );
+#endif
+	if( read_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &read_chunk_data,
+		 NULL );
+	}
+	*chunk_data = NULL;
+
+	return( -1 );
+}
+
+/* Releases a view of the (media) data of a chunk
+ * This function is safe to be called from multiple threads concurrently
+ * Only the chunk table lock for reading is held, since the chunk cache evicts
+ * chunk data while holding the lock for writing
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_release_chunk_view(
+     libewf_chunk_table_t *chunk_table,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_release_chunk_view";
+	int result            = 1;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data == NULL )
+	{
+		return( 1 );
+	}
+	/* Shared fill chunk data is not reference counted and is freed with the chunk table
+	 */
+	if( ( *chunk_data )->is_shared != 0 )
+	{
+		*chunk_data = NULL;
+
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     chunk_table->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 chunk_table->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	if( ( *chunk_data )->number_of_references <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data - number of references value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		( *chunk_data )->number_of_references -= 1;
+
+		/* Chunk data that was evicted from the chunk cache while being referenced
+		 * is freed when the last view is released, it is no longer reachable
+		 * from the chunk cache
+		 */
+		if( ( ( *chunk_data )->number_of_references == 0 )
+		 && ( ( *chunk_data )->is_detached != 0 ) )
+		{
+			if( libewf_chunk_data_free(
+			     chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk data.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_table->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_read_write_lock_release_for_read(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	*chunk_data = NULL;
+
+	return( result );
+}
+
+/* Reads and unpacks the chunk data of a specific chunk into the chunk cache
+ * This function is safe to be called from multiple threads concurrently
+ * The chunk is read while holding the IO mutex and decompressed outside the chunk table lock
+ * Sparse and pattern fill chunks are not cached
+ * Returns 1 if successful, 0 if the chunk was already cached or is not cached or -1 on error
+ */
+int libewf_chunk_table_prefetch_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     libcerror_error_t **error )
+{
+	uint8_t fill_pattern[ 8 ];
+
+	libewf_chunk_data_t *read_chunk_data = NULL;
+	static char *function                = "libewf_chunk_table_prefetch_chunk_data";
+	off64_t chunk_data_offset            = 0;
+	off64_t offset                       = 0;
+	int result                           = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index >= media_values->number_of_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	offset = (off64_t) chunk_index * media_values->chunk_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     chunk_table->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 chunk_table->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_chunk_cache_contains_chunk_data(
+	          chunk_table->chunk_cache,
+	          chunk_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if chunk: %" PRIu64 " data is in cache.",
+		 function,
+		 chunk_index );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		libcthreads_mutex_release(
+		 chunk_table->cache_mutex,
+		 NULL );
+
+		libcthreads_read_write_lock_release_for_read(
+		 chunk_table->read_write_lock,
+		 NULL );
+#endif
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_table->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 chunk_table->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libcthreads_read_write_lock_release_for_read(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result != 0 )
+	{
+		return( 0 );
+	}
+	/* The chunk data is read without holding the chunk table lock, so that
+	 * other threads can retrieve cached chunks in the meantime
+	 */
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_table->io_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab IO mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* Sparse and pattern fill chunks are filled on demand
+	 * in that case no chunk data is returned
+	 */
+	result = libewf_chunk_table_read_chunk_data_by_offset(
+	          chunk_table,
+	          chunk_index,
+	          file_io_pool,
+	          media_values,
+	          segment_table,
+	          chunk_groups_cache,
+	          offset,
+	          &read_chunk_data,
+	          &chunk_data_offset,
+	          fill_pattern,
+	          8,
+	          NULL,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		libcthreads_mutex_release(
+		 chunk_table->io_mutex,
+		 NULL );
+#endif
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_table->io_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release IO mutex.",
+		 function );
+
+		if( read_chunk_data != NULL )
+		{
+			libewf_chunk_data_free(
+			 &read_chunk_data,
+			 NULL );
+		}
+		return( -1 );
+	}
+#endif
+	if( read_chunk_data == NULL )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_data_unpack(
+	     read_chunk_data,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		libewf_chunk_data_free(
+		 &read_chunk_data,
+		 NULL );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		libewf_chunk_data_free(
+		 &read_chunk_data,
+		 NULL );
 
-			return( -1 );
-		}
-		*chunk_data = corrupted_chunk_data;
+		return( -1 );
+	}
+#endif
+	/* Another thread could have cached the same chunk in the meantime
+	 */
+	result = libewf_chunk_cache_set_chunk_data(
+	          chunk_table->chunk_cache,
+	          chunk_index,
+	          read_chunk_data,
+	          error );
 
-		/* chunks_cache takes over management of chunk_data
-		 */
-		corrupted_chunk_data = NULL;
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " data in cache.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
 	}
-	if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	else if( result != 0 )
 	{
-		/* Add checksum error
+		/* The chunk cache takes over management of read_chunk_data
 		 */
-		start_sector      = chunk_offset / media_values->bytes_per_sector;
-		number_of_sectors = media_values->sectors_per_chunk;
+		read_chunk_data = NULL;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-		if( ( start_sector + number_of_sectors ) > (uint64_t) media_values->number_of_sectors )
+		if( read_chunk_data != NULL )
 		{
-			number_of_sectors = (uint64_t) media_values->number_of_sectors - start_sector;
+			libewf_chunk_data_free(
+			 &read_chunk_data,
+			 NULL );
 		}
-		result = libcdata_range_list_insert_range(
-		          chunk_table->checksum_errors,
-		          start_sector,
-		          number_of_sectors,
-		          NULL,
-		          NULL,
-		          NULL,
-		          error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to insert checksum error in range list.",
-			 function );
+		return( -1 );
+	}
+#endif
+	if( read_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &read_chunk_data,
+		 NULL );
 
-			goto on_error;
-		}
+		return( 0 );
 	}
 	return( 1 );
 
 on_error:
-	if( corrupted_chunk_data != NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 chunk_table->read_write_lock,
+	 NULL );
+#endif
+	if( read_chunk_data != NULL )
 	{
 		libewf_chunk_data_free(
-		 &corrupted_chunk_data,
+		 &read_chunk_data,
 		 NULL );
 	}
-	*chunk_data = NULL;
-
 	return( -1 );
 }
 
-/* Sets the chunk data of a chunk at a specific offset
- * Adds a checksum error if the data is corrupted
+/* Retrieves the maximum memory size of the chunk cache
  * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_table_set_chunk_data_by_offset(
+int libewf_chunk_table_get_maximum_cache_memory_size(
      libewf_chunk_table_t *chunk_table,
-     uint64_t chunk_index,
-     libbfio_pool_t *file_io_pool,
-     libewf_segment_table_t *segment_table,
-     libfcache_cache_t *chunk_groups_cache,
-     libfcache_cache_t *chunks_cache,
-     off64_t offset,
-     libewf_chunk_data_t *chunk_data,
+     size64_t *maximum_memory_size,
      libcerror_error_t **error )
 {
-	libewf_chunk_group_t *chunk_group   = NULL;
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_chunk_table_set_chunk_data_by_offset";
-	off64_t chunk_group_data_offset     = 0;
-	off64_t segment_file_data_offset    = 0;
-	uint32_t segment_number             = 0;
-	int chunk_groups_list_index         = 0;
-	int result                          = 0;
+	static char *function = "libewf_chunk_table_get_maximum_cache_memory_size";
 
 	if( chunk_table == NULL )
 	{
@@ -1080,80 +4803,253 @@ int libewf_chunk_table_set_chunk_data_by_offset(
 
 		return( -1 );
 	}
-	if( chunk_data == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_chunk_cache_get_maximum_memory_size(
+	     chunk_table->chunk_cache,
+	     maximum_memory_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve maximum memory size of chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 chunk_table->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Sets the maximum memory size of the chunk cache
+ * Cached chunks are evicted if they no longer fit
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_set_maximum_cache_memory_size(
+     libewf_chunk_table_t *chunk_table,
+     size64_t maximum_memory_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_set_maximum_cache_memory_size";
+
+	if( chunk_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk data.",
+		 "%s: invalid chunk table.",
 		 function );
 
 		return( -1 );
 	}
-	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
-		  chunk_table,
-		  file_io_pool,
-		  segment_table,
-		  chunk_groups_cache,
-		  offset,
-		  &segment_number,
-		  &segment_file_data_offset,
-		  &segment_file,
-		  &chunk_groups_list_index,
-		  &chunk_group_data_offset,
-		  &chunk_group,
-		  error );
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-	if( result != 1 )
+		return( -1 );
+	}
+#endif
+	if( libewf_chunk_cache_set_maximum_memory_size(
+	     chunk_table->chunk_cache,
+	     maximum_memory_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment file chunk group at 0x%08" PRIx64 ".",
-		 function,
-		 offset );
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum memory size of chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
 		return( -1 );
 	}
-	if( chunk_group == NULL )
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 chunk_table->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the chunk cache statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_get_cache_statistics(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_get_cache_statistics";
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing chunk group: %d.",
-		 function,
-		 chunk_groups_list_index );
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
 
 		return( -1 );
 	}
-	result = libfdata_list_set_element_value_at_offset(
-		  chunk_group->chunks_list,
-		  (intptr_t *) file_io_pool,
-		  (libfdata_cache_t *) chunks_cache,
-		  chunk_group_data_offset,
-		  (intptr_t *) chunk_data,
-		  (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
-		  LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
-		  error );
+	/* The statistics are updated by cache lookups of threads that hold the lock for reading
+	 */
+	if( libcthreads_mutex_grab(
+	     chunk_table->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
 
-	if( result != 1 )
+		libcthreads_read_write_lock_release_for_read(
+		 chunk_table->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_chunk_cache_get_statistics(
+	     chunk_table->chunk_cache,
+	     number_of_hits,
+	     number_of_misses,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk cache statistics.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_table->cache_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set chunk: %" PRIu64 " data in chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
-		 function,
-		 chunk_index,
-		 chunk_groups_list_index,
-		 segment_number,
-		 segment_file_data_offset );
+		 "%s: unable to release cache mutex.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 chunk_table->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libcthreads_read_write_lock_release_for_read(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
 		return( -1 );
 	}
+#endif
 	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 chunk_table->cache_mutex,
+	 NULL );
+
+	libcthreads_read_write_lock_release_for_read(
+	 chunk_table->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
@@ -25,10 +25,16 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_chunk_cache.h"
 #include "libewf_chunk_group.h"
+#include "libewf_definitions.h"
+#include "libewf_extent.h"
 #include "libewf_io_handle.h"
+#include "libewf_io_uring.h"
 #include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
 #include "libewf_segment_file.h"
@@ -61,6 +67,46 @@ struct libewf_chunk_table
 	/* The sectors with checksum errors
 	 */
 	libcdata_range_list_t *checksum_errors;
+
+	/* The chunk cache
+	 */
+	libewf_chunk_cache_t *chunk_cache;
+
+	/* The shared fill chunks data
+	 * Referenced by the sparse and pattern fill chunk views, which are never modified once filled
+	 */
+	libewf_chunk_data_t *shared_fill_chunks_data[ LIBEWF_MAXIMUM_NUMBER_OF_SHARED_FILL_CHUNKS ];
+
+	/* The fill patterns of the shared fill chunks data
+	 */
+	uint8_t shared_fill_patterns[ LIBEWF_MAXIMUM_NUMBER_OF_SHARED_FILL_CHUNKS ][ 8 ];
+
+	/* The number of shared fill chunks data
+	 */
+	int number_of_shared_fill_chunks;
+
+	/* The extents of the (media) data
+	 * Contains NULL if the extents have not been read
+	 */
+	libcdata_array_t *extents;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+
+	/* The cache mutex
+	 * Serializes the chunk cache lookups and the chunk data references
+	 * of threads that hold the read/write lock for reading
+	 */
+	libcthreads_mutex_t *cache_mutex;
+
+	/* The IO mutex
+	 * Serializes the file IO pool access and the chunk group loading
+	 * of threads that do not hold the read/write lock for writing
+	 */
+	libcthreads_mutex_t *io_mutex;
+#endif
 };
 
 int libewf_chunk_table_initialize(
@@ -95,6 +141,43 @@ int libewf_chunk_table_append_checksum_error(
      uint64_t number_of_sectors,
      libcerror_error_t **error );
 
+int libewf_chunk_table_append_extent(
+     libcdata_array_t *extents,
+     libewf_extent_t **last_extent,
+     off64_t offset,
+     size64_t size,
+     uint32_t flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_read_extents(
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_number_of_extents(
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     int *number_of_extents,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_extent_by_index(
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     int extent_index,
+     off64_t *offset,
+     size64_t *size,
+     uint32_t *flags,
+     libcerror_error_t **error );
+
 int libewf_chunk_table_get_segment_file_chunk_group_by_offset(
      libewf_chunk_table_t *chunk_table,
      libbfio_pool_t *file_io_pool,
@@ -118,6 +201,45 @@ int libewf_chunk_table_chunk_exists_for_offset(
      off64_t offset,
      libcerror_error_t **error );
 
+int libewf_chunk_table_read_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     off64_t *chunk_data_offset,
+     uint8_t *fill_pattern,
+     size_t fill_pattern_size,
+     libewf_io_uring_read_request_t *read_request,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_shared_fill_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_media_values_t *media_values,
+     const uint8_t *fill_pattern,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+ssize_t libewf_chunk_table_fill_buffer_at_offset(
+         libewf_chunk_table_t *chunk_table,
+         uint64_t chunk_index,
+         libewf_media_values_t *media_values,
+         const uint8_t *fill_pattern,
+         off64_t chunk_data_offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+int libewf_chunk_table_insert_chunk_checksum_error(
+     libewf_chunk_table_t *chunk_table,
+     libewf_media_values_t *media_values,
+     off64_t chunk_offset,
+     libcerror_error_t **error );
+
 int libewf_chunk_table_get_chunk_data_by_offset(
      libewf_chunk_table_t *chunk_table,
      uint64_t chunk_index,
@@ -126,7 +248,6 @@ int libewf_chunk_table_get_chunk_data_by_offset(
      libewf_media_values_t *media_values,
      libewf_segment_table_t *segment_table,
      libfcache_cache_t *chunk_groups_cache,
-     libfcache_cache_t *chunks_cache,
      off64_t offset,
      libewf_chunk_data_t **chunk_data,
      off64_t *chunk_data_offset,
@@ -143,6 +264,99 @@ int libewf_chunk_table_set_chunk_data_by_offset(
      libewf_chunk_data_t *chunk_data,
      libcerror_error_t **error );
 
+ssize_t libewf_chunk_table_read_buffer_at_offset(
+         libewf_chunk_table_t *chunk_table,
+         uint64_t chunk_index,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_media_values_t *media_values,
+         libewf_segment_table_t *segment_table,
+         libfcache_cache_t *chunk_groups_cache,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+int libewf_chunk_table_read_packed_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *data_size,
+     libewf_chunk_data_t **chunk_data,
+     libewf_io_uring_read_request_t *read_request,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_set_chunk_corrupted(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_media_values_t *media_values,
+     libcerror_error_t **error );
+
+ssize_t libewf_chunk_table_read_chunk_into_buffer(
+         libewf_chunk_table_t *chunk_table,
+         uint64_t chunk_index,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_media_values_t *media_values,
+         libewf_segment_table_t *segment_table,
+         libfcache_cache_t *chunk_groups_cache,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+int libewf_chunk_table_get_cached_chunk_view(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_chunk_view(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_release_chunk_view(
+     libewf_chunk_table_t *chunk_table,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_prefetch_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_maximum_cache_memory_size(
+     libewf_chunk_table_t *chunk_table,
+     size64_t *maximum_memory_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_set_maximum_cache_memory_size(
+     libewf_chunk_table_t *chunk_table,
+     size64_t maximum_memory_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_cache_statistics(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
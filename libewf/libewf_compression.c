@@ -543,7 +543,7 @@ int libewf_decompress_data(
 			result = -1;
 		}
 #else
-		result = libewf_deflate_decompress(
+		result = libewf_deflate_decompress_zlib(
 		          compressed_data,
 		          compressed_data_size,
 		          uncompressed_data,
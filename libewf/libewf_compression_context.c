@@ -0,0 +1,403 @@
+/*
+ * Compression context functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "libewf_compression.h"
+#include "libewf_compression_context.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+
+/* Creates a compression context
+ * Make sure the value compression_context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_initialize(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_initialize";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_context = memory_allocate_structure(
+	                        libewf_compression_context_t );
+
+	if( *compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compression_context,
+	     0,
+	     sizeof( libewf_compression_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *compression_context != NULL )
+	{
+		memory_free(
+		 *compression_context );
+
+		*compression_context = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a compression context
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_free(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_free";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context != NULL )
+	{
+#if defined( HAVE_LIBEWF_COMPRESSION_CONTEXT_ZLIB_STREAM )
+		if( ( *compression_context )->zlib_stream_initialized != 0 )
+		{
+			/* deflateEnd returns Z_DATA_ERROR if the stream was freed prematurely
+			 * which is expected after a failed compression and can be ignored
+			 */
+			deflateEnd(
+			 &( ( *compression_context )->zlib_stream ) );
+		}
+#endif
+		memory_free(
+		 *compression_context );
+
+		*compression_context = NULL;
+	}
+	return( 1 );
+}
+
+/* Compresses data using the compression method
+ * The deflate compression state is retained and reset between calls
+ * Other compression methods are handled by libewf_compress_data
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_compression_context_compress_data(
+     libewf_compression_context_t *compression_context,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     uint16_t compression_method,
+     int8_t compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_compression_context_compress_data";
+
+#if defined( HAVE_LIBEWF_COMPRESSION_CONTEXT_ZLIB_STREAM )
+	int zlib_compression_level = 0;
+	int result                 = 0;
+#endif
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_COMPRESSION_CONTEXT_ZLIB_STREAM )
+	if( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	{
+		if( compressed_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid compressed data buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( compressed_data_size == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid compressed data size.",
+			 function );
+
+			return( -1 );
+		}
+		if( uncompressed_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid uncompressed data buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( compressed_data == uncompressed_data )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid uncompressed data buffer equals compressed data buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( compression_level == LIBEWF_COMPRESSION_DEFAULT )
+		{
+			zlib_compression_level = Z_DEFAULT_COMPRESSION;
+		}
+		else if( compression_level == LIBEWF_COMPRESSION_FAST )
+		{
+			zlib_compression_level = Z_BEST_SPEED;
+		}
+		else if( compression_level == LIBEWF_COMPRESSION_BEST )
+		{
+			zlib_compression_level = Z_BEST_COMPRESSION;
+		}
+		else if( compression_level == LIBEWF_COMPRESSION_NONE )
+		{
+			zlib_compression_level = Z_NO_COMPRESSION;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported compression level.",
+			 function );
+
+			return( -1 );
+		}
+		if( *compressed_data_size > (size_t) UINT_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid compressed data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( uncompressed_data_size > (size_t) UINT_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid uncompressed data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( compression_context->zlib_stream_initialized != 0 )
+		 && ( compression_context->zlib_compression_level != zlib_compression_level ) )
+		{
+			deflateEnd(
+			 &( compression_context->zlib_stream ) );
+
+			compression_context->zlib_stream_initialized = 0;
+		}
+		if( compression_context->zlib_stream_initialized == 0 )
+		{
+			if( memory_set(
+			     &( compression_context->zlib_stream ),
+			     0,
+			     sizeof( z_stream ) ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear zlib stream.",
+				 function );
+
+				return( -1 );
+			}
+			result = deflateInit(
+			          &( compression_context->zlib_stream ),
+			          zlib_compression_level );
+
+			if( result != Z_OK )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+				 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+				 "%s: unable to initialize zlib stream with error: %d.",
+				 function,
+				 result );
+
+				return( -1 );
+			}
+			compression_context->zlib_stream_initialized = 1;
+			compression_context->zlib_compression_level  = zlib_compression_level;
+
+			compression_context->number_of_initializations += 1;
+		}
+		else
+		{
+			result = deflateReset(
+			          &( compression_context->zlib_stream ) );
+
+			if( result != Z_OK )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+				 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+				 "%s: unable to reset zlib stream with error: %d.",
+				 function,
+				 result );
+
+				return( -1 );
+			}
+		}
+		compression_context->zlib_stream.next_in   = (Bytef *) uncompressed_data;
+		compression_context->zlib_stream.avail_in  = (uInt) uncompressed_data_size;
+		compression_context->zlib_stream.next_out  = (Bytef *) compressed_data;
+		compression_context->zlib_stream.avail_out = (uInt) *compressed_data_size;
+
+		result = deflate(
+		          &( compression_context->zlib_stream ),
+		          Z_FINISH );
+
+		if( result == Z_STREAM_END )
+		{
+			*compressed_data_size = (size_t) compression_context->zlib_stream.total_out;
+
+			return( 1 );
+		}
+		else if( ( result == Z_OK )
+		      || ( result == Z_BUF_ERROR ) )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to write compressed data: target buffer too small.\n",
+				 function );
+			}
+#endif
+#if defined( HAVE_COMPRESS_BOUND ) || defined( WINAPI )
+			/* Use deflateBound to determine the size of the uncompressed buffer
+			 */
+			*compressed_data_size = (size_t) deflateBound(
+			                                  &( compression_context->zlib_stream ),
+			                                  (uLong) uncompressed_data_size );
+#else
+			/* Estimate that a factor 2 enlargement should suffice
+			 */
+			*compressed_data_size *= 2;
+#endif
+			return( 0 );
+		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: zlib returned undefined error: %d.",
+		 function,
+		 result );
+
+		*compressed_data_size = 0;
+
+		return( -1 );
+	}
+#endif /* defined( HAVE_LIBEWF_COMPRESSION_CONTEXT_ZLIB_STREAM ) */
+
+	return( libewf_compress_data(
+	         compressed_data,
+	         compressed_data_size,
+	         compression_method,
+	         compression_level,
+	         uncompressed_data,
+	         uncompressed_data_size,
+	         error ) );
+}
+
@@ -0,0 +1,91 @@
+/*
+ * Compression context functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_COMPRESSION_CONTEXT_H )
+#define _LIBEWF_COMPRESSION_CONTEXT_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_DEFLATE ) ) || defined( ZLIB_DLL )
+#define HAVE_LIBEWF_COMPRESSION_CONTEXT_ZLIB_STREAM
+#endif
+
+typedef struct libewf_compression_context libewf_compression_context_t;
+
+/* The compression context retains the compression state between chunks
+ * so that it does not need to be allocated and initialized for every chunk
+ */
+struct libewf_compression_context
+{
+#if defined( HAVE_LIBEWF_COMPRESSION_CONTEXT_ZLIB_STREAM )
+	/* The zlib stream
+	 */
+	z_stream zlib_stream;
+
+	/* The zlib compression level
+	 */
+	int zlib_compression_level;
+
+	/* Value to indicate the zlib stream was initialized
+	 */
+	uint8_t zlib_stream_initialized;
+#endif
+
+	/* The number of times the compression state was (re)initialized
+	 */
+	uint64_t number_of_initializations;
+};
+
+int libewf_compression_context_initialize(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
+int libewf_compression_context_free(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
+int libewf_compression_context_compress_data(
+     libewf_compression_context_t *compression_context,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     uint16_t compression_method,
+     int8_t compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_COMPRESSION_CONTEXT_H ) */
+
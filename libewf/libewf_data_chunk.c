@@ -23,6 +23,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_compression_context.h"
 #include "libewf_data_chunk.h"
 #include "libewf_definitions.h"
 #include "libewf_io_handle.h"
@@ -436,6 +437,7 @@ ssize_t libewf_data_chunk_write_buffer(
          size_t buffer_size,
          libcerror_error_t **error )
 {
+	libewf_compression_context_t *compression_context = NULL;
 	libewf_internal_data_chunk_t *internal_data_chunk = NULL;
 	static char *function                             = "libewf_data_chunk_write_buffer";
 	ssize_t write_count                               = 0;
@@ -540,9 +542,24 @@ ssize_t libewf_data_chunk_write_buffer(
 	}
 	internal_data_chunk->data_size = buffer_size;
 
+	if( libewf_write_io_handle_grab_compression_context(
+	     internal_data_chunk->write_io_handle,
+	     &compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab compression context.",
+		 function );
+
+		goto on_error;
+	}
 	if( libewf_chunk_data_pack(
 	     internal_data_chunk->chunk_data,
 	     internal_data_chunk->io_handle,
+	     compression_context,
 	     internal_data_chunk->write_io_handle->compressed_zero_byte_empty_block,
 	     internal_data_chunk->write_io_handle->compressed_zero_byte_empty_block_size,
 	     internal_data_chunk->write_io_handle->pack_flags,
@@ -558,6 +575,20 @@ ssize_t libewf_data_chunk_write_buffer(
 
 		goto on_error;
 	}
+	if( libewf_write_io_handle_release_compression_context(
+	     internal_data_chunk->write_io_handle,
+	     &compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release compression context.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_data_chunk->read_write_lock,
@@ -576,6 +607,13 @@ ssize_t libewf_data_chunk_write_buffer(
 	return( write_count );
 
 on_error:
+	if( compression_context != NULL )
+	{
+		libewf_write_io_handle_release_compression_context(
+		 internal_data_chunk->write_io_handle,
+		 &compression_context,
+		 NULL );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	libcthreads_read_write_lock_release_for_write(
 	 internal_data_chunk->read_write_lock,
@@ -24,6 +24,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_checksum.h"
 #include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 
@@ -32,6 +33,77 @@ libewf_deflate_huffman_table_t libewf_deflate_fixed_huffman_literals_table;
 
 int libewf_deflate_fixed_huffman_tables_initialized = 0;
 
+/* Reads bits from the underlying byte stream into the bit buffer
+ * The bit buffer is filled with as many whole bytes as fit, using a single 64-bit load if 8 or more bytes remain
+ * Returns 1 on success or -1 on error
+ */
+int libewf_deflate_bit_stream_read(
+     libewf_deflate_bit_stream_t *bit_stream,
+     libcerror_error_t **error )
+{
+	static char *function     = "libewf_deflate_bit_stream_read";
+	uint64_t safe_value_64bit = 0;
+	uint8_t number_of_bytes   = 0;
+
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( bit_stream->byte_stream_offset > bit_stream->byte_stream_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bit stream - byte stream offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bit_stream->byte_stream_size - bit_stream->byte_stream_offset ) >= 8 )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 &( bit_stream->byte_stream[ bit_stream->byte_stream_offset ] ),
+		 safe_value_64bit );
+
+		/* Only add whole bytes so that the bits above the bit buffer size remain 0
+		 */
+		number_of_bytes = ( 63 - bit_stream->bit_buffer_size ) / 8;
+
+		if( number_of_bytes > 0 )
+		{
+			safe_value_64bit &= ( (uint64_t) 1 << ( number_of_bytes * 8 ) ) - 1;
+
+			bit_stream->bit_buffer         |= safe_value_64bit << bit_stream->bit_buffer_size;
+			bit_stream->bit_buffer_size    += number_of_bytes * 8;
+			bit_stream->byte_stream_offset += number_of_bytes;
+		}
+	}
+	else
+	{
+		while( bit_stream->bit_buffer_size <= 56 )
+		{
+			if( bit_stream->byte_stream_offset >= bit_stream->byte_stream_size )
+			{
+				break;
+			}
+			safe_value_64bit   = bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ];
+			safe_value_64bit <<= bit_stream->bit_buffer_size;
+
+			bit_stream->bit_buffer      |= safe_value_64bit;
+			bit_stream->bit_buffer_size += 8;
+		}
+	}
+	return( 1 );
+}
+
 /* Retrieves a value from the bit stream
  * Returns 1 on success or -1 on error
  */
@@ -42,6 +114,7 @@ int libewf_deflate_bit_stream_get_value(
      libcerror_error_t **error )
 {
 	static char *function     = "libewf_deflate_bit_stream_get_value";
+	uint64_t safe_value_64bit = 0;
 	uint32_t safe_value_32bit = 0;
 
 	if( bit_stream == NULL )
@@ -96,28 +169,23 @@ int libewf_deflate_bit_stream_get_value(
 
 			return( -1 );
 		}
-		safe_value_32bit   = bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ];
-		safe_value_32bit <<= bit_stream->bit_buffer_size;
+		safe_value_64bit   = bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ];
+		safe_value_64bit <<= bit_stream->bit_buffer_size;
 
-		bit_stream->bit_buffer      |= safe_value_32bit;
+		bit_stream->bit_buffer      |= safe_value_64bit;
 		bit_stream->bit_buffer_size += 8;
 	}
-	safe_value_32bit = bit_stream->bit_buffer;
+	safe_value_32bit = (uint32_t) bit_stream->bit_buffer;
 
 	if( number_of_bits < 32 )
 	{
 		/* On VS 2008 32-bit "~( 0xfffffffUL << 32 )" does not behave as expected
 		 */
 		safe_value_32bit &= ~( 0xffffffffUL << number_of_bits );
-
-		bit_stream->bit_buffer     >>= number_of_bits;
-		bit_stream->bit_buffer_size -= number_of_bits;
-	}
-	else
-	{
-		bit_stream->bit_buffer      = 0;
-		bit_stream->bit_buffer_size = 0;
 	}
+	bit_stream->bit_buffer     >>= number_of_bits;
+	bit_stream->bit_buffer_size -= number_of_bits;
+
 	*value_32bit = safe_value_32bit;
 
 	return( 1 );
@@ -136,9 +204,15 @@ int libewf_deflate_huffman_table_construct(
 
 	static char *function = "libewf_deflate_huffman_table_construct";
 	uint16_t code_size    = 0;
+	uint16_t lookup_value = 0;
 	uint8_t bit_index     = 0;
+	int code_index        = 0;
 	int code_offset       = 0;
+	int code_size_count   = 0;
+	int huffman_code      = 0;
 	int left_value        = 0;
+	int lookup_index      = 0;
+	int reversed_code     = 0;
 	int symbol            = 0;
 
 	if( table == NULL )
@@ -218,6 +292,20 @@ int libewf_deflate_huffman_table_construct(
 
 		return( -1 );
 	}
+	if( memory_set(
+	     &( table->lookup_table ),
+	     0,
+	     LIBEWF_DEFLATE_HUFFMAN_TABLE_LOOKUP_SIZE * sizeof( uint16_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear lookup table.",
+		 function );
+
+		return( -1 );
+	}
 	for( symbol = 0;
 	     symbol < number_of_code_sizes;
 	     symbol++ )
@@ -309,6 +397,40 @@ int libewf_deflate_huffman_table_construct(
 		code_offsets_array[ code_size ]  += 1;
 		table->codes_array[ code_offset ] = symbol;
 	}
+	/* Fill the lookup table with the codes of up to 10 bits
+	 * The Huffman codes are stored MSB first in the LSB first bit stream
+	 * hence the lookup index is the bit reversed Huffman code
+	 */
+	for( bit_index = 1;
+	     bit_index <= LIBEWF_DEFLATE_HUFFMAN_TABLE_LOOKUP_NUMBER_OF_BITS;
+	     bit_index++ )
+	{
+		for( code_size_count = table->code_counts_array[ bit_index ];
+		     code_size_count > 0;
+		     code_size_count-- )
+		{
+			reversed_code = 0;
+
+			for( code_offset = 0;
+			     code_offset < (int) bit_index;
+			     code_offset++ )
+			{
+				reversed_code <<= 1;
+				reversed_code  |= ( huffman_code >> code_offset ) & 0x00000001UL;
+			}
+			lookup_value = (uint16_t) ( ( table->codes_array[ code_index ] << 4 ) | bit_index );
+
+			for( lookup_index = reversed_code;
+			     lookup_index < LIBEWF_DEFLATE_HUFFMAN_TABLE_LOOKUP_SIZE;
+			     lookup_index += 1 << bit_index )
+			{
+				table->lookup_table[ lookup_index ] = lookup_value;
+			}
+			huffman_code += 1;
+			code_index   += 1;
+		}
+		huffman_code <<= 1;
+	}
 /* TODO only used by dynamic Huffman
 	if( left_value > 0 )
 	{
@@ -335,9 +457,11 @@ int libewf_deflate_bit_stream_get_huffman_encoded_value(
      libcerror_error_t **error )
 {
 	static char *function     = "libewf_deflate_bit_stream_get_huffman_encoded_value";
-	uint32_t bit_buffer       = 0;
+	uint64_t bit_buffer       = 0;
 	uint32_t safe_value_32bit = 0;
+	uint16_t lookup_value     = 0;
 	uint8_t bit_index         = 0;
+	uint8_t code_size         = 0;
 	uint8_t number_of_bits    = 0;
 	int code_size_count       = 0;
 	int first_huffman_code    = 0;
@@ -380,18 +504,39 @@ int libewf_deflate_bit_stream_get_huffman_encoded_value(
 	}
 	/* Try to fill the bit buffer with the maximum number of bits
 	 */
-	while( bit_stream->bit_buffer_size < table->maximum_number_of_bits )
+	if( bit_stream->bit_buffer_size < table->maximum_number_of_bits )
 	{
-		if( bit_stream->byte_stream_offset >= bit_stream->byte_stream_size )
+		if( libewf_deflate_bit_stream_read(
+		     bit_stream,
+		     error ) != 1 )
 		{
-			break;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read bits.",
+			 function );
+
+			return( -1 );
 		}
-		safe_value_32bit   = bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ];
-		safe_value_32bit <<= bit_stream->bit_buffer_size;
+	}
+	/* Codes of up to 10 bits are resolved using the lookup table
+	 */
+	lookup_value = table->lookup_table[ bit_stream->bit_buffer & ( LIBEWF_DEFLATE_HUFFMAN_TABLE_LOOKUP_SIZE - 1 ) ];
+	code_size    = (uint8_t) ( lookup_value & 0x000f );
 
-		bit_stream->bit_buffer      |= safe_value_32bit;
-		bit_stream->bit_buffer_size += 8;
+	if( ( code_size != 0 )
+	 && ( code_size <= bit_stream->bit_buffer_size ) )
+	{
+		bit_stream->bit_buffer     >>= code_size;
+		bit_stream->bit_buffer_size -= code_size;
+
+		*value_32bit = (uint32_t) ( lookup_value >> 4 );
+
+		return( 1 );
 	}
+	/* Longer codes are resolved bit by bit
+	 */
 	if( table->maximum_number_of_bits < bit_stream->bit_buffer_size )
 	{
 		number_of_bits = table->maximum_number_of_bits;
@@ -836,14 +981,67 @@ int libewf_deflate_decode_huffman(
 		0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
 		7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
 
+	const uint8_t *byte_stream    = NULL;
 	static char *function         = "libewf_deflate_decode_huffman";
+	size_t byte_stream_offset     = 0;
+	size_t byte_stream_size       = 0;
 	size_t data_offset            = 0;
+	uint64_t bit_buffer           = 0;
+	uint64_t value_64bit          = 0;
 	uint32_t code_value           = 0;
 	uint32_t extra_bits           = 0;
 	uint16_t compression_offset   = 0;
 	uint16_t compression_size     = 0;
+	uint16_t lookup_value         = 0;
 	uint16_t number_of_extra_bits = 0;
+	uint8_t bit_buffer_size       = 0;
+	uint8_t code_size             = 0;
+	uint8_t number_of_bytes       = 0;
+
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( bit_stream->byte_stream_offset > bit_stream->byte_stream_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bit stream - byte stream offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( literals_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid literals table.",
+		 function );
 
+		return( -1 );
+	}
+	if( distances_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid distances table.",
+		 function );
+
+		return( -1 );
+	}
 	if( uncompressed_data == NULL )
 	{
 		libcerror_error_set(
@@ -879,22 +1077,83 @@ int libewf_deflate_decode_huffman(
 	}
 	data_offset = *uncompressed_data_offset;
 
+	/* The bit stream state is kept in local variables while decoding and
+	 * only written back to the bit stream when the bit by bit functions are needed
+	 */
+	byte_stream        = bit_stream->byte_stream;
+	byte_stream_size   = bit_stream->byte_stream_size;
+	byte_stream_offset = bit_stream->byte_stream_offset;
+	bit_buffer         = bit_stream->bit_buffer;
+	bit_buffer_size    = bit_stream->bit_buffer_size;
+
 	do
 	{
-		if( libewf_deflate_bit_stream_get_huffman_encoded_value(
-		     bit_stream,
-		     literals_table,
-		     &code_value,
-		     error ) != 1 )
+		/* Refill the bit buffer, if 8 or more bytes remain this provides
+		 * the up to 48 bits needed to decode a length and distance pair
+		 */
+		if( bit_buffer_size < 48 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve listeral value from bit stream.",
-			 function );
+			if( ( byte_stream_size - byte_stream_offset ) >= 8 )
+			{
+				byte_stream_copy_to_uint64_little_endian(
+				 &( byte_stream[ byte_stream_offset ] ),
+				 value_64bit );
 
-			return( -1 );
+				number_of_bytes = ( 63 - bit_buffer_size ) / 8;
+
+				value_64bit &= ( (uint64_t) 1 << ( number_of_bytes * 8 ) ) - 1;
+
+				bit_buffer         |= value_64bit << bit_buffer_size;
+				bit_buffer_size    += number_of_bytes * 8;
+				byte_stream_offset += number_of_bytes;
+			}
+			else
+			{
+				while( ( bit_buffer_size <= 56 )
+				    && ( byte_stream_offset < byte_stream_size ) )
+				{
+					value_64bit = byte_stream[ byte_stream_offset++ ];
+
+					bit_buffer      |= value_64bit << bit_buffer_size;
+					bit_buffer_size += 8;
+				}
+			}
+		}
+		lookup_value = literals_table->lookup_table[ bit_buffer & ( LIBEWF_DEFLATE_HUFFMAN_TABLE_LOOKUP_SIZE - 1 ) ];
+		code_size    = (uint8_t) ( lookup_value & 0x000f );
+
+		if( ( code_size != 0 )
+		 && ( code_size <= bit_buffer_size ) )
+		{
+			bit_buffer     >>= code_size;
+			bit_buffer_size -= code_size;
+
+			code_value = (uint32_t) ( lookup_value >> 4 );
+		}
+		else
+		{
+			bit_stream->byte_stream_offset = byte_stream_offset;
+			bit_stream->bit_buffer         = bit_buffer;
+			bit_stream->bit_buffer_size    = bit_buffer_size;
+
+			if( libewf_deflate_bit_stream_get_huffman_encoded_value(
+			     bit_stream,
+			     literals_table,
+			     &code_value,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve literal value from bit stream.",
+				 function );
+
+				return( -1 );
+			}
+			byte_stream_offset = bit_stream->byte_stream_offset;
+			bit_buffer         = bit_stream->bit_buffer;
+			bit_buffer_size    = bit_stream->bit_buffer_size;
 		}
 		if( code_value < 256 )
 		{
@@ -918,11 +1177,10 @@ int libewf_deflate_decode_huffman(
 
 			number_of_extra_bits = literal_codes_number_of_extra_bits[ code_value ];
 
-			if( libewf_deflate_bit_stream_get_value(
-			     bit_stream,
-			     (uint8_t) number_of_extra_bits,
-			     &extra_bits,
-			     error ) != 1 )
+			/* After the refill the bit buffer contains all the bits needed
+			 * for the length and distance pair unless the byte stream is exhausted
+			 */
+			if( number_of_extra_bits > bit_buffer_size )
 			{
 				libcerror_error_set(
 				 error,
@@ -933,30 +1191,63 @@ int libewf_deflate_decode_huffman(
 
 				return( -1 );
 			}
+			extra_bits = (uint32_t) ( bit_buffer & ( ( (uint64_t) 1 << number_of_extra_bits ) - 1 ) );
+
+			bit_buffer     >>= number_of_extra_bits;
+			bit_buffer_size -= (uint8_t) number_of_extra_bits;
+
 			compression_size = literal_codes_base[ code_value ] + (uint16_t) extra_bits;
 
-			if( libewf_deflate_bit_stream_get_huffman_encoded_value(
-			     bit_stream,
-			     distances_table,
-			     &code_value,
-			     error ) != 1 )
+			lookup_value = distances_table->lookup_table[ bit_buffer & ( LIBEWF_DEFLATE_HUFFMAN_TABLE_LOOKUP_SIZE - 1 ) ];
+			code_size    = (uint8_t) ( lookup_value & 0x000f );
+
+			if( ( code_size != 0 )
+			 && ( code_size <= bit_buffer_size ) )
+			{
+				bit_buffer     >>= code_size;
+				bit_buffer_size -= code_size;
+
+				code_value = (uint32_t) ( lookup_value >> 4 );
+			}
+			else
+			{
+				bit_stream->byte_stream_offset = byte_stream_offset;
+				bit_stream->bit_buffer         = bit_buffer;
+				bit_stream->bit_buffer_size    = bit_buffer_size;
+
+				if( libewf_deflate_bit_stream_get_huffman_encoded_value(
+				     bit_stream,
+				     distances_table,
+				     &code_value,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve distance value from bit stream.",
+					 function );
+
+					return( -1 );
+				}
+				byte_stream_offset = bit_stream->byte_stream_offset;
+				bit_buffer         = bit_stream->bit_buffer;
+				bit_buffer_size    = bit_stream->bit_buffer_size;
+			}
+			if( code_value >= 30 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve distance value from bit stream.",
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid distance code value out of bounds.",
 				 function );
 
 				return( -1 );
 			}
 			number_of_extra_bits = distance_codes_number_of_extra_bits[ code_value ];
 
-			if( libewf_deflate_bit_stream_get_value(
-			     bit_stream,
-			     (uint8_t) number_of_extra_bits,
-			     &extra_bits,
-			     error ) != 1 )
+			if( number_of_extra_bits > bit_buffer_size )
 			{
 				libcerror_error_set(
 				 error,
@@ -967,6 +1258,11 @@ int libewf_deflate_decode_huffman(
 
 				return( -1 );
 			}
+			extra_bits = (uint32_t) ( bit_buffer & ( ( (uint64_t) 1 << number_of_extra_bits ) - 1 ) );
+
+			bit_buffer     >>= number_of_extra_bits;
+			bit_buffer_size -= (uint8_t) number_of_extra_bits;
+
 			compression_offset = distance_codes_base[ code_value ] + (uint16_t) extra_bits;
 
 			if( compression_offset > data_offset )
@@ -991,12 +1287,54 @@ int libewf_deflate_decode_huffman(
 
 				return( -1 );
 			}
-			while( compression_size > 0 )
+			if( compression_offset == 1 )
 			{
-				uncompressed_data[ data_offset ] = uncompressed_data[ data_offset - compression_offset ];
+				/* A run of the same byte value
+				 */
+				if( memory_set(
+				     &( uncompressed_data[ data_offset ] ),
+				     uncompressed_data[ data_offset - 1 ],
+				     (size_t) compression_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to set uncompressed data.",
+					 function );
 
-				data_offset++;
-				compression_size--;
+					return( -1 );
+				}
+				data_offset += compression_size;
+			}
+			else
+			{
+				/* If the source is at least 8 bytes behind, 8 bytes can be copied
+				 * at a time without the source overlapping the bytes being written
+				 */
+				if( compression_offset >= 8 )
+				{
+					while( compression_size >= 8 )
+					{
+						byte_stream_copy_to_uint64_little_endian(
+						 &( uncompressed_data[ data_offset - compression_offset ] ),
+						 value_64bit );
+
+						byte_stream_copy_from_uint64_little_endian(
+						 &( uncompressed_data[ data_offset ] ),
+						 value_64bit );
+
+						data_offset      += 8;
+						compression_size -= 8;
+					}
+				}
+				while( compression_size > 0 )
+				{
+					uncompressed_data[ data_offset ] = uncompressed_data[ data_offset - compression_offset ];
+
+					data_offset++;
+					compression_size--;
+				}
 			}
 		}
 		else if( code_value != 256 )
@@ -1014,6 +1352,10 @@ int libewf_deflate_decode_huffman(
 	}
 	while( code_value != 256 );
 
+	bit_stream->byte_stream_offset = byte_stream_offset;
+	bit_stream->bit_buffer         = bit_buffer;
+	bit_stream->bit_buffer_size    = bit_buffer_size;
+
 	*uncompressed_data_offset = data_offset;
 
 	return( 1 );
@@ -1486,8 +1828,6 @@ int libewf_deflate_read_block(
 		}
 		libewf_deflate_fixed_huffman_tables_initialized = 1;
 	}
-/* TODO find optimized solution to read bit stream from bytes */
-
 	if( libewf_deflate_bit_stream_get_value(
 	     bit_stream,
 	     3,
@@ -1547,6 +1887,13 @@ int libewf_deflate_read_block(
 
 				return( -1 );
 			}
+			/* The stored data starts at the first byte not yet consumed,
+			 * hence return the whole bytes remaining in the bit buffer to the byte stream
+			 */
+			bit_stream->byte_stream_offset -= bit_stream->bit_buffer_size / 8;
+			bit_stream->bit_buffer          = 0;
+			bit_stream->bit_buffer_size     = 0;
+
 			block_size_copy = ( block_size >> 16 ) ^ 0x0000ffffUL;
 			block_size     &= 0x0000ffffUL;
 
@@ -1773,7 +2120,10 @@ int libewf_deflate_decompress(
 	bit_stream.bit_buffer         = 0;
 	bit_stream.bit_buffer_size    = 0;
 
-	while( bit_stream.byte_stream_offset < bit_stream.byte_stream_size )
+	/* The bit buffer can contain whole bytes that have not been consumed
+	 */
+	while( ( bit_stream.byte_stream_offset < bit_stream.byte_stream_size )
+	    || ( bit_stream.bit_buffer_size >= 8 ) )
 	{
 		if( libewf_deflate_read_block(
 		     &bit_stream,
@@ -1908,7 +2258,10 @@ int libewf_deflate_decompress_zlib(
 	bit_stream.bit_buffer         = 0;
 	bit_stream.bit_buffer_size    = 0;
 
-	while( bit_stream.byte_stream_offset < bit_stream.byte_stream_size )
+	/* The bit buffer can contain whole bytes that have not been consumed
+	 */
+	while( ( bit_stream.byte_stream_offset < bit_stream.byte_stream_size )
+	    || ( bit_stream.bit_buffer_size >= 8 ) )
 	{
 		if( libewf_deflate_read_block(
 		     &bit_stream,
@@ -1932,18 +2285,20 @@ int libewf_deflate_decompress_zlib(
 			break;
 		}
 	}
+	/* Return the whole bytes remaining in the bit buffer to the byte stream
+	 */
+	while( bit_stream.bit_buffer_size >= 8 )
+	{
+		bit_stream.byte_stream_offset -= 1;
+		bit_stream.bit_buffer_size    -= 8;
+	}
 	if( ( bit_stream.byte_stream_size - bit_stream.byte_stream_offset ) >= 4 )
 	{
-		while( bit_stream.bit_buffer_size >= 8 )
-		{
-			bit_stream.byte_stream_offset -= 1;
-			bit_stream.bit_buffer_size    -= 8;
-		}
 		byte_stream_copy_to_uint32_big_endian(
 		 &( bit_stream.byte_stream[ bit_stream.byte_stream_offset ] ),
 		 stored_checksum );
 
-		if( libewf_deflate_calculate_adler32(
+		if( libewf_checksum_calculate_adler32(
 		     &calculated_checksum,
 		     uncompressed_data,
 		     uncompressed_data_offset,
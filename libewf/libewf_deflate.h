@@ -41,6 +41,12 @@ enum LIBEWF_DEFLATE_BLOCK_TYPES
 	LIBEWF_DEFLATE_BLOCK_TYPE_RESERVED		= 0x03
 };
 
+/* The number of bits of the Huffman table lookup
+ */
+#define LIBEWF_DEFLATE_HUFFMAN_TABLE_LOOKUP_NUMBER_OF_BITS	10
+
+#define LIBEWF_DEFLATE_HUFFMAN_TABLE_LOOKUP_SIZE		( 1 << LIBEWF_DEFLATE_HUFFMAN_TABLE_LOOKUP_NUMBER_OF_BITS )
+
 typedef struct libewf_deflate_bit_stream libewf_deflate_bit_stream_t;
 
 struct libewf_deflate_bit_stream
@@ -59,7 +65,7 @@ struct libewf_deflate_bit_stream
 
 	/* The bit buffer
 	 */
-	uint32_t bit_buffer;
+	uint64_t bit_buffer;
 
 	/* The number of bits remaining in the bit buffer
 	 */
@@ -83,11 +89,21 @@ struct libewf_deflate_huffman_table
 	 */
 	int code_counts_array[ 16 ];
 
+	/* The lookup table
+	 * Contains the symbol and code size of codes of up to 10 bits, indexed by the next 10 bits in the bit stream
+	 * The symbol is stored in the upper 12 bits and the code size in the lower 4 bits, 0 represents a longer code
+	 */
+	uint16_t lookup_table[ LIBEWF_DEFLATE_HUFFMAN_TABLE_LOOKUP_SIZE ];
+
 	/* The number of codes
 	 */
 	int number_of_codes;
 };
 
+int libewf_deflate_bit_stream_read(
+     libewf_deflate_bit_stream_t *bit_stream,
+     libcerror_error_t **error );
+
 int libewf_deflate_bit_stream_get_value(
      libewf_deflate_bit_stream_t *bit_stream,
      uint8_t number_of_bits,
@@ -0,0 +1,80 @@
+/*
+ * Extent functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_EXTENT_H )
+#define _LIBEWF_EXTENT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_extent libewf_extent_t;
+
+/* An extent is a run of (media) data with the same storage properties
+ */
+struct libewf_extent
+{
+	/* The (media) offset
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The extent flags
+	 */
+	uint32_t flags;
+};
+
+int libewf_extent_initialize(
+     libewf_extent_t **extent,
+     libcerror_error_t **error );
+
+int libewf_extent_free(
+     libewf_extent_t **extent,
+     libcerror_error_t **error );
+
+int libewf_extent_get(
+     libewf_extent_t *extent,
+     off64_t *offset,
+     size64_t *size,
+     uint32_t *flags,
+     libcerror_error_t **error );
+
+int libewf_extent_set(
+     libewf_extent_t *extent,
+     off64_t offset,
+     size64_t size,
+     uint32_t flags,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_EXTENT_H ) */
+
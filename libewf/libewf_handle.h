@@ -31,6 +31,7 @@
 #include "libewf_data_chunk.h"
 #include "libewf_extern.h"
 #include "libewf_hash_sections.h"
+#include "libewf_index_file.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
@@ -40,10 +41,14 @@
 #include "libewf_libfvalue.h"
 #include "libewf_io_handle.h"
 #include "libewf_media_values.h"
+#include "libewf_pack_pool.h"
+#include "libewf_read_ahead.h"
 #include "libewf_read_io_handle.h"
+#include "libewf_reorder_buffer.h"
 #include "libewf_segment_table.h"
 #include "libewf_single_files.h"
 #include "libewf_types.h"
+#include "libewf_unpack_pool.h"
 #include "libewf_write_io_handle.h"
 
 #if defined( __cplusplus )
@@ -82,6 +87,18 @@ struct libewf_internal_handle
 	 */
 	uint8_t file_io_pool_created_in_library;
 
+	/* Value to indicate if the pool contains memory-mapped file handles
+	 */
+	uint8_t file_io_pool_memory_mapped;
+
+	/* The index file IO handle
+	 */
+	libbfio_handle_t *index_file_io_handle;
+
+	/* The index file
+	 */
+	libewf_index_file_t *index_file;
+
 	/* The read IO handle
 	 */
 	libewf_read_io_handle_t *read_io_handle;
@@ -114,9 +131,37 @@ struct libewf_internal_handle
 	 */
 	libfcache_cache_t *chunk_groups_cache;
 
-	/* The chunks cache
+	/* The cache memory limit
+	 */
+	size64_t cache_memory_limit;
+
+	/* The number of read-ahead threads
+	 */
+	int read_ahead_number_of_threads;
+
+	/* The number of chunks to read ahead
+	 */
+	int read_ahead_number_of_chunks;
+
+	/* The number of threads used to unpack the chunks of a single large read
 	 */
-	libfcache_cache_t *chunks_cache;
+	int unpack_number_of_threads;
+
+	/* The number of threads used to pack the chunks written using write buffer
+	 */
+	int pack_number_of_threads;
+
+	/* The maximum number of chunks in the reorder buffer
+	 */
+	int reorder_buffer_maximum_number_of_chunks;
+
+	/* The maximum memory size of the chunks in the reorder buffer
+	 */
+	size64_t reorder_buffer_maximum_memory_size;
+
+	/* The memory-mapped IO mode
+	 */
+	int memory_mapped_io_mode;
 
 	/* The current chunk data
 	 */
@@ -150,10 +195,39 @@ struct libewf_internal_handle
 	 */
 	libewf_single_files_t *single_files;
 
+	/* The reorder buffer of write data chunk at index
+	 */
+	libewf_reorder_buffer_t *reorder_buffer;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The read-ahead
+	 */
+	libewf_read_ahead_t *read_ahead;
+
+	/* The unpack pool
+	 */
+	libewf_unpack_pool_t *unpack_pool;
+
+	/* The pack pool
+	 */
+	libewf_pack_pool_t *pack_pool;
+
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
+
+	/* The mutex protecting the reorder number of chunks written
+	 */
+	libcthreads_mutex_t *reorder_mutex;
+
+	/* The condition signalled when write data chunk at index has written chunks
+	 */
+	libcthreads_condition_t *reorder_condition;
+
+	/* The number of chunks written by write data chunk at index
+	 * Protected by the reorder mutex
+	 */
+	uint64_t reorder_number_of_chunks_written;
 #endif
 };
 
@@ -205,12 +279,45 @@ int libewf_internal_handle_open_read_segment_file_section_data(
      int file_io_pool_entry,
      libcerror_error_t **error );
 
+int libewf_internal_handle_get_segment_file_modification_time(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_handle_t *file_io_handle,
+     int64_t *modification_time,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_open_read_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libewf_segment_file_t *segment_file,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_open_write_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_open_append_index_file_segment(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_file_t *segment_file,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error );
+
 int libewf_internal_handle_open_read_segment_files(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
      libewf_segment_table_t *segment_table,
      libcerror_error_t **error );
 
+int libewf_internal_handle_initialize_chunk_groups_cache(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_initialize_read_ahead(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
 int libewf_internal_handle_open_file_io_pool(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
@@ -252,6 +359,37 @@ ssize_t libewf_handle_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+ssize_t libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_handle_pread_buffer(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_view(
+     libewf_handle_t *handle,
+     uint64_t chunk_index,
+     libewf_chunk_view_t **chunk_view,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_release_chunk_view(
+     libewf_handle_t *handle,
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -304,6 +442,20 @@ ssize_t libewf_handle_write_data_chunk(
          libewf_data_chunk_t *data_chunk,
          libcerror_error_t **error );
 
+ssize_t libewf_internal_handle_write_data_chunk_at_index_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint64_t chunk_index,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_handle_write_data_chunk_at_index(
+         libewf_handle_t *handle,
+         uint64_t chunk_index,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_write_finalize_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -339,6 +491,107 @@ int libewf_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_cache_memory_limit(
+     libewf_handle_t *handle,
+     size64_t *cache_memory_limit,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_cache_memory_limit(
+     libewf_handle_t *handle,
+     size64_t cache_memory_limit,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_cache_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_read_ahead(
+     libewf_handle_t *handle,
+     int *number_of_threads,
+     int *number_of_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_read_ahead(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     int number_of_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_unpack_threads(
+     libewf_handle_t *handle,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_unpack_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_pack_threads(
+     libewf_handle_t *handle,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_pack_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_reorder_buffer(
+     libewf_handle_t *handle,
+     int *maximum_number_of_chunks,
+     size64_t *maximum_memory_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_reorder_buffer(
+     libewf_handle_t *handle,
+     int maximum_number_of_chunks,
+     size64_t maximum_memory_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_memory_mapped_io_mode(
+     libewf_handle_t *handle,
+     int *memory_mapped_io_mode,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_memory_mapped_io_mode(
+     libewf_handle_t *handle,
+     int memory_mapped_io_mode,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_index_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBEWF_EXTERN \
+int libewf_handle_set_index_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
 LIBEWF_EXTERN \
 int libewf_handle_segment_files_corrupted(
      libewf_handle_t *handle,
@@ -405,6 +658,24 @@ int libewf_handle_set_maximum_segment_size(
      size64_t maximum_segment_size,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_append_stripe_basename(
+     libewf_handle_t *handle,
+     const char *basename,
+     size_t basename_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBEWF_EXTERN \
+int libewf_handle_append_stripe_basename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *basename,
+     size_t basename_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
 LIBEWF_EXTERN \
 int libewf_handle_get_filename_size(
      libewf_handle_t *handle,
@@ -719,6 +990,21 @@ int libewf_handle_append_checksum_error(
      uint64_t number_of_sectors,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_extents(
+     libewf_handle_t *handle,
+     int *number_of_extents,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_extent(
+     libewf_handle_t *handle,
+     int extent_index,
+     off64_t *offset,
+     size64_t *size,
+     uint32_t *flags,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_number_of_sessions(
      libewf_handle_t *handle,
@@ -0,0 +1,1846 @@
+/*
+ * Index file functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#include "libewf_checksum.h"
+#include "libewf_index_file.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libfdata.h"
+#include "libewf_media_values.h"
+
+#include "ewf_index_file.h"
+
+const uint8_t ewf_index_file_signature[ 8 ] = { 'E', 'W', 'F', 'I', 'D', 'X', 0x0d, 0x0a };
+
+/* Creates an index file
+ * Make sure the value index_file is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_initialize(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_initialize";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*index_file = memory_allocate_structure(
+	               libewf_index_file_t );
+
+	if( *index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index file.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *index_file,
+	     0,
+	     sizeof( libewf_index_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *index_file != NULL )
+	{
+		memory_free(
+		 *index_file );
+
+		*index_file = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_free(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_free";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_file != NULL )
+	{
+		if( ( *index_file )->segment_data_offsets != NULL )
+		{
+			memory_free(
+			 ( *index_file )->segment_data_offsets );
+		}
+		if( ( *index_file )->data != NULL )
+		{
+			memory_free(
+			 ( *index_file )->data );
+		}
+		memory_free(
+		 *index_file );
+
+		*index_file = NULL;
+	}
+	return( 1 );
+}
+
+/* Resizes the data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_resize_data(
+     libewf_index_file_t *index_file,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	void *reallocation         = NULL;
+	static char *function      = "libewf_index_file_resize_data";
+	size_t allocated_data_size = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > index_file->allocated_data_size )
+	{
+		/* Grow the data by half to limit the number of reallocations
+		 * when the segments are appended
+		 */
+		allocated_data_size = index_file->allocated_data_size + ( index_file->allocated_data_size / 2 );
+
+		if( ( allocated_data_size < data_size )
+		 || ( allocated_data_size > (size_t) SSIZE_MAX ) )
+		{
+			allocated_data_size = data_size;
+		}
+		reallocation = memory_reallocate(
+		                index_file->data,
+		                sizeof( uint8_t ) * allocated_data_size );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize data.",
+			 function );
+
+			return( -1 );
+		}
+		index_file->data                = (uint8_t *) reallocation;
+		index_file->allocated_data_size = allocated_data_size;
+	}
+	index_file->data_size = data_size;
+
+	return( 1 );
+}
+
+/* Sets the header values
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_set_header_values(
+     libewf_index_file_t *index_file,
+     uint8_t major_version,
+     uint8_t minor_version,
+     uint16_t compression_method,
+     const uint8_t *set_identifier,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_set_header_values";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( set_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     index_file->set_identifier,
+	     set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	index_file->major_version      = major_version;
+	index_file->minor_version      = minor_version;
+	index_file->compression_method = compression_method;
+
+	return( 1 );
+}
+
+/* Compares the header values
+ * Returns 1 if equal, 0 if not or -1 on error
+ */
+int libewf_index_file_compare_header_values(
+     libewf_index_file_t *index_file,
+     uint8_t major_version,
+     uint8_t minor_version,
+     uint16_t compression_method,
+     const uint8_t *set_identifier,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_compare_header_values";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( set_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( index_file->major_version != major_version )
+	 || ( index_file->minor_version != minor_version )
+	 || ( index_file->compression_method != compression_method ) )
+	{
+		return( 0 );
+	}
+	if( memory_compare(
+	     index_file->set_identifier,
+	     set_identifier,
+	     16 ) != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the media values
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_get_media_values(
+     libewf_index_file_t *index_file,
+     libewf_media_values_t *media_values,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_get_media_values";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     media_values,
+	     &( index_file->media_values ),
+	     sizeof( libewf_media_values_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy media values.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the media values
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_set_media_values(
+     libewf_index_file_t *index_file,
+     libewf_media_values_t *media_values,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_set_media_values";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     &( index_file->media_values ),
+	     media_values,
+	     sizeof( libewf_media_values_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy media values.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of segments
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_get_number_of_segments(
+     libewf_index_file_t *index_file,
+     uint32_t *number_of_segments,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_get_number_of_segments";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_segments = index_file->number_of_segments;
+
+	return( 1 );
+}
+
+/* Appends a segment
+ * The sections and chunk groups of the segment file are stored from the lists
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_append_segment(
+     libewf_index_file_t *index_file,
+     libewf_index_file_segment_t *segment,
+     libfdata_list_t *sections_list,
+     libfdata_list_t *chunk_groups_list,
+     libcerror_error_t **error )
+{
+	uint8_t *segment_data       = NULL;
+	void *reallocation          = NULL;
+	static char *function       = "libewf_index_file_append_segment";
+	size_t segment_data_offset  = 0;
+	size_t segment_data_size    = 0;
+	size64_t element_size       = 0;
+	size64_t mapped_size        = 0;
+	off64_t element_offset      = 0;
+	uint32_t element_flags      = 0;
+	uint32_t number_of_segments = 0;
+	int element_file_index      = 0;
+	int element_index           = 0;
+	int number_of_chunk_groups  = 0;
+	int number_of_sections      = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_file->number_of_segments == UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid index file - number of segments value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     sections_list,
+	     &number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements from sections list.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     chunk_groups_list,
+	     &number_of_chunk_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements from chunk groups list.",
+		 function );
+
+		return( -1 );
+	}
+	segment_data_size = sizeof( ewf_index_file_segment_t )
+	                  + ( sizeof( ewf_index_file_section_t ) * (size_t) number_of_sections )
+	                  + ( sizeof( ewf_index_file_chunk_group_t ) * (size_t) number_of_chunk_groups );
+
+	/* The data starts with the index file header
+	 */
+	segment_data_offset = index_file->data_size;
+
+	if( segment_data_offset == 0 )
+	{
+		segment_data_offset = sizeof( ewf_index_file_header_t );
+	}
+	if( segment_data_size > ( (size_t) SSIZE_MAX - segment_data_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid segment data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_file->number_of_segments >= index_file->number_of_allocated_segments )
+	{
+		number_of_segments = index_file->number_of_allocated_segments * 2;
+
+		if( number_of_segments < 16 )
+		{
+			number_of_segments = 16;
+		}
+		if( (size_t) number_of_segments > ( (size_t) SSIZE_MAX / sizeof( size_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of allocated segments value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = memory_reallocate(
+		                index_file->segment_data_offsets,
+		                sizeof( size_t ) * number_of_segments );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize segment data offsets.",
+			 function );
+
+			return( -1 );
+		}
+		index_file->segment_data_offsets         = (size_t *) reallocation;
+		index_file->number_of_allocated_segments = number_of_segments;
+	}
+	if( libewf_index_file_resize_data(
+	     index_file,
+	     segment_data_offset + segment_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize data.",
+		 function );
+
+		return( -1 );
+	}
+	segment_data = &( index_file->data[ segment_data_offset ] );
+
+	if( memory_set(
+	     segment_data,
+	     0,
+	     sizeof( ewf_index_file_segment_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment data.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_index_file_segment_t *) segment_data )->segment_number,
+	 segment->segment_number );
+
+	( (ewf_index_file_segment_t *) segment_data )->type             = segment->type;
+	( (ewf_index_file_segment_t *) segment_data )->flags            = segment->flags;
+	( (ewf_index_file_segment_t *) segment_data )->has_section_data = segment->has_section_data;
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_index_file_segment_t *) segment_data )->segment_file_size,
+	 segment->segment_file_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_index_file_segment_t *) segment_data )->modification_time,
+	 (uint64_t) segment->modification_time );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_index_file_segment_t *) segment_data )->last_section_offset,
+	 (uint64_t) segment->last_section_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_index_file_segment_t *) segment_data )->storage_media_size,
+	 segment->storage_media_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_index_file_segment_t *) segment_data )->number_of_chunks,
+	 segment->number_of_chunks );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_index_file_segment_t *) segment_data )->last_chunk_filled,
+	 (uint64_t) segment->last_chunk_filled );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_index_file_segment_t *) segment_data )->device_information_section_index,
+	 (uint32_t) segment->device_information_section_index );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_index_file_segment_t *) segment_data )->number_of_sections,
+	 (uint32_t) number_of_sections );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_index_file_segment_t *) segment_data )->number_of_chunk_groups,
+	 (uint32_t) number_of_chunk_groups );
+
+	segment_data += sizeof( ewf_index_file_segment_t );
+
+	for( element_index = 0;
+	     element_index < number_of_sections;
+	     element_index++ )
+	{
+		if( libfdata_list_get_element_by_index(
+		     sections_list,
+		     element_index,
+		     &element_file_index,
+		     &element_offset,
+		     &element_size,
+		     &element_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d from sections list.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_index_file_section_t *) segment_data )->offset,
+		 (uint64_t) element_offset );
+
+		segment_data += sizeof( ewf_index_file_section_t );
+	}
+	for( element_index = 0;
+	     element_index < number_of_chunk_groups;
+	     element_index++ )
+	{
+		if( libfdata_list_get_element_by_index(
+		     chunk_groups_list,
+		     element_index,
+		     &element_file_index,
+		     &element_offset,
+		     &element_size,
+		     &element_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d from chunk groups list.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+		if( libfdata_list_get_mapped_size_by_index(
+		     chunk_groups_list,
+		     element_index,
+		     &mapped_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve mapped size: %d from chunk groups list.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_index_file_chunk_group_t *) segment_data )->offset,
+		 (uint64_t) element_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_index_file_chunk_group_t *) segment_data )->size,
+		 element_size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_index_file_chunk_group_t *) segment_data )->mapped_size,
+		 mapped_size );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_index_file_chunk_group_t *) segment_data )->range_flags,
+		 element_flags );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_index_file_chunk_group_t *) segment_data )->padding1,
+		 0 );
+
+		segment_data += sizeof( ewf_index_file_chunk_group_t );
+	}
+	index_file->segment_data_offsets[ index_file->number_of_segments ] = segment_data_offset;
+
+	index_file->number_of_segments += 1;
+
+	return( 1 );
+
+on_error:
+	index_file->data_size = segment_data_offset;
+
+	return( -1 );
+}
+
+/* Retrieves the values of a specific segment
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_index_file_get_segment_by_index(
+     libewf_index_file_t *index_file,
+     uint32_t segment_index,
+     libewf_index_file_segment_t *segment,
+     libcerror_error_t **error )
+{
+	ewf_index_file_segment_t *segment_data = NULL;
+	static char *function                  = "libewf_index_file_get_segment_by_index";
+	uint64_t value_64bit                   = 0;
+	uint32_t value_32bit                   = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_index >= index_file->number_of_segments )
+	{
+		return( 0 );
+	}
+	segment_data = (ewf_index_file_segment_t *) &( index_file->data[ index_file->segment_data_offsets[ segment_index ] ] );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 segment_data->segment_number,
+	 segment->segment_number );
+
+	segment->type             = segment_data->type;
+	segment->flags            = segment_data->flags;
+	segment->has_section_data = segment_data->has_section_data;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 segment_data->segment_file_size,
+	 segment->segment_file_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 segment_data->modification_time,
+	 value_64bit );
+
+	segment->modification_time = (int64_t) value_64bit;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 segment_data->last_section_offset,
+	 value_64bit );
+
+	segment->last_section_offset = (off64_t) value_64bit;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 segment_data->storage_media_size,
+	 segment->storage_media_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 segment_data->number_of_chunks,
+	 segment->number_of_chunks );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 segment_data->last_chunk_filled,
+	 value_64bit );
+
+	segment->last_chunk_filled = (int64_t) value_64bit;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 segment_data->device_information_section_index,
+	 value_32bit );
+
+	segment->device_information_section_index = (int32_t) value_32bit;
+
+	return( 1 );
+}
+
+/* Fills the sections and chunk groups lists of a specific segment
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_index_file_fill_segment_lists(
+     libewf_index_file_t *index_file,
+     uint32_t segment_index,
+     int file_io_pool_entry,
+     size_t section_descriptor_size,
+     libfdata_list_t *sections_list,
+     libfdata_list_t *chunk_groups_list,
+     int *chunk_groups_index,
+     libcerror_error_t **error )
+{
+	uint8_t *segment_data           = NULL;
+	static char *function           = "libewf_index_file_fill_segment_lists";
+	uint64_t mapped_size            = 0;
+	uint64_t size                   = 0;
+	uint64_t offset                 = 0;
+	uint32_t number_of_chunk_groups = 0;
+	uint32_t number_of_sections     = 0;
+	uint32_t range_flags            = 0;
+	uint32_t value_index            = 0;
+	int element_index               = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_groups_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk groups index.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_index >= index_file->number_of_segments )
+	{
+		return( 0 );
+	}
+	segment_data = &( index_file->data[ index_file->segment_data_offsets[ segment_index ] ] );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_index_file_segment_t *) segment_data )->number_of_sections,
+	 number_of_sections );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_index_file_segment_t *) segment_data )->number_of_chunk_groups,
+	 number_of_chunk_groups );
+
+	segment_data += sizeof( ewf_index_file_segment_t );
+
+	for( value_index = 0;
+	     value_index < number_of_sections;
+	     value_index++ )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_index_file_section_t *) segment_data )->offset,
+		 offset );
+
+		segment_data += sizeof( ewf_index_file_section_t );
+
+		if( libfdata_list_append_element(
+		     sections_list,
+		     &element_index,
+		     file_io_pool_entry,
+		     (off64_t) offset,
+		     (size64_t) section_descriptor_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element to sections list.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	for( value_index = 0;
+	     value_index < number_of_chunk_groups;
+	     value_index++ )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_index_file_chunk_group_t *) segment_data )->offset,
+		 offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_index_file_chunk_group_t *) segment_data )->size,
+		 size );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_index_file_chunk_group_t *) segment_data )->mapped_size,
+		 mapped_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_index_file_chunk_group_t *) segment_data )->range_flags,
+		 range_flags );
+
+		segment_data += sizeof( ewf_index_file_chunk_group_t );
+
+		if( libfdata_list_append_element_with_mapped_size(
+		     chunk_groups_list,
+		     chunk_groups_index,
+		     file_io_pool_entry,
+		     (off64_t) offset,
+		     (size64_t) size,
+		     range_flags,
+		     (size64_t) mapped_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element with mapped size to chunk groups list.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reads the index file data
+ * Returns 1 if successful, 0 if the data does not contain a supported index file or -1 on error
+ */
+int libewf_index_file_read_data(
+     libewf_index_file_t *index_file,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	ewf_index_file_header_t *header = NULL;
+	void *reallocation              = NULL;
+	static char *function           = "libewf_index_file_read_data";
+	size_t data_offset              = 0;
+	size_t segment_data_size        = 0;
+	uint64_t stored_data_size       = 0;
+	uint32_t calculated_checksum    = 0;
+	uint32_t format_version         = 0;
+	uint32_t number_of_chunk_groups = 0;
+	uint32_t number_of_sections     = 0;
+	uint32_t number_of_segments     = 0;
+	uint32_t segment_index          = 0;
+	uint32_t stored_checksum        = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_file->number_of_segments != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index file - segments value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < sizeof( ewf_index_file_header_t ) )
+	{
+		return( 0 );
+	}
+	header = (ewf_index_file_header_t *) data;
+
+	if( memory_compare(
+	     header->signature,
+	     ewf_index_file_signature,
+	     8 ) != 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 header->format_version,
+	 format_version );
+
+	if( format_version != LIBEWF_INDEX_FILE_FORMAT_VERSION )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 header->checksum,
+	 stored_checksum );
+
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     data,
+	     sizeof( ewf_index_file_header_t ) - 4,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate header checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 header->data_size,
+	 stored_data_size );
+
+	if( stored_data_size != (uint64_t) ( data_size - sizeof( ewf_index_file_header_t ) ) )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 header->data_checksum,
+	 stored_checksum );
+
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     &( data[ sizeof( ewf_index_file_header_t ) ] ),
+	     data_size - sizeof( ewf_index_file_header_t ),
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate data checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 header->number_of_segments,
+	 number_of_segments );
+
+	/* Every segment consists of at least the segment values
+	 */
+	if( (size_t) number_of_segments > ( ( data_size - sizeof( ewf_index_file_header_t ) ) / sizeof( ewf_index_file_segment_t ) ) )
+	{
+		return( 0 );
+	}
+	if( number_of_segments > 0 )
+	{
+		reallocation = memory_reallocate(
+		                index_file->segment_data_offsets,
+		                sizeof( size_t ) * number_of_segments );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize segment data offsets.",
+			 function );
+
+			return( -1 );
+		}
+		index_file->segment_data_offsets         = (size_t *) reallocation;
+		index_file->number_of_allocated_segments = number_of_segments;
+	}
+	data_offset = sizeof( ewf_index_file_header_t );
+
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( sizeof( ewf_index_file_segment_t ) > ( data_size - data_offset ) )
+		{
+			return( 0 );
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_index_file_segment_t *) &( data[ data_offset ] ) )->number_of_sections,
+		 number_of_sections );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_index_file_segment_t *) &( data[ data_offset ] ) )->number_of_chunk_groups,
+		 number_of_chunk_groups );
+
+		if( ( number_of_sections > (uint32_t) INT_MAX )
+		 || ( number_of_chunk_groups > (uint32_t) INT_MAX ) )
+		{
+			return( 0 );
+		}
+		index_file->segment_data_offsets[ segment_index ] = data_offset;
+
+		data_offset += sizeof( ewf_index_file_segment_t );
+
+		segment_data_size = data_size - data_offset;
+
+		if( (size_t) number_of_sections > ( segment_data_size / sizeof( ewf_index_file_section_t ) ) )
+		{
+			return( 0 );
+		}
+		data_offset       += sizeof( ewf_index_file_section_t ) * (size_t) number_of_sections;
+		segment_data_size -= sizeof( ewf_index_file_section_t ) * (size_t) number_of_sections;
+
+		if( (size_t) number_of_chunk_groups > ( segment_data_size / sizeof( ewf_index_file_chunk_group_t ) ) )
+		{
+			return( 0 );
+		}
+		data_offset += sizeof( ewf_index_file_chunk_group_t ) * (size_t) number_of_chunk_groups;
+	}
+	if( data_offset != data_size )
+	{
+		return( 0 );
+	}
+	if( libewf_index_file_resize_data(
+	     index_file,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     index_file->data,
+	     data,
+	     data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy data.",
+		 function );
+
+		index_file->data_size = 0;
+
+		return( -1 );
+	}
+	index_file->major_version = header->major_version;
+	index_file->minor_version = header->minor_version;
+
+	byte_stream_copy_to_uint16_little_endian(
+	 header->compression_method,
+	 index_file->compression_method );
+
+	if( memory_copy(
+	     index_file->set_identifier,
+	     header->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		index_file->data_size = 0;
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 header->media_size,
+	 index_file->media_values.media_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 header->chunk_size,
+	 index_file->media_values.chunk_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 header->sectors_per_chunk,
+	 index_file->media_values.sectors_per_chunk );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 header->bytes_per_sector,
+	 index_file->media_values.bytes_per_sector );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 header->error_granularity,
+	 index_file->media_values.error_granularity );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 header->number_of_chunks,
+	 index_file->media_values.number_of_chunks );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 header->number_of_sectors,
+	 index_file->media_values.number_of_sectors );
+
+	index_file->media_values.media_type  = header->media_type;
+	index_file->media_values.media_flags = header->media_flags;
+
+	if( memory_copy(
+	     index_file->media_values.set_identifier,
+	     header->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy media set identifier.",
+		 function );
+
+		index_file->data_size = 0;
+
+		return( -1 );
+	}
+	index_file->number_of_segments = number_of_segments;
+
+	return( 1 );
+}
+
+/* Reads the index file from a file IO handle
+ * Returns 1 if successful, 0 if the file IO handle does not contain a supported index file or -1 on error
+ */
+int libewf_index_file_read_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t *data              = NULL;
+	static char *function      = "libewf_index_file_read_file_io_handle";
+	size64_t file_size         = 0;
+	ssize_t read_count         = 0;
+	int file_io_handle_is_open = 0;
+	int result                 = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to determine if file IO handle is open.",
+		 function );
+
+		goto on_error;
+	}
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( file_size >= (size64_t) sizeof( ewf_index_file_header_t ) )
+	 && ( file_size <= (size64_t) SSIZE_MAX ) )
+	{
+		data = (uint8_t *) memory_allocate(
+		                    sizeof( uint8_t ) * (size_t) file_size );
+
+		if( data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_handle_seek_offset(
+		     file_io_handle,
+		     0,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek file header offset: 0.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              data,
+		              (size_t) file_size,
+		              error );
+
+		if( read_count != (ssize_t) file_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read index file data.",
+			 function );
+
+			goto on_error;
+		}
+		result = libewf_index_file_read_data(
+		          index_file,
+		          data,
+		          (size_t) file_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read index file data.",
+			 function );
+
+			goto on_error;
+		}
+		memory_free(
+		 data );
+
+		data = NULL;
+	}
+	if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( file_io_handle_is_open == 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the index file to a file IO handle
+ * The file IO handle is expected to be opened for writing
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_write_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	ewf_index_file_header_t *header = NULL;
+	static char *function           = "libewf_index_file_write_file_io_handle";
+	ssize_t write_count             = 0;
+	uint32_t checksum               = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_file->data_size < sizeof( ewf_index_file_header_t ) )
+	{
+		if( libewf_index_file_resize_data(
+		     index_file,
+		     sizeof( ewf_index_file_header_t ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	header = (ewf_index_file_header_t *) index_file->data;
+
+	if( memory_set(
+	     header,
+	     0,
+	     sizeof( ewf_index_file_header_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear header.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     header->signature,
+	     ewf_index_file_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 header->format_version,
+	 LIBEWF_INDEX_FILE_FORMAT_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 header->number_of_segments,
+	 index_file->number_of_segments );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 header->data_size,
+	 (uint64_t) ( index_file->data_size - sizeof( ewf_index_file_header_t ) ) );
+
+	header->major_version = index_file->major_version;
+	header->minor_version = index_file->minor_version;
+
+	byte_stream_copy_from_uint16_little_endian(
+	 header->compression_method,
+	 index_file->compression_method );
+
+	header->media_type  = index_file->media_values.media_type;
+	header->media_flags = index_file->media_values.media_flags;
+
+	if( memory_copy(
+	     header->set_identifier,
+	     index_file->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 header->media_size,
+	 index_file->media_values.media_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 header->chunk_size,
+	 index_file->media_values.chunk_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 header->sectors_per_chunk,
+	 index_file->media_values.sectors_per_chunk );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 header->bytes_per_sector,
+	 index_file->media_values.bytes_per_sector );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 header->error_granularity,
+	 index_file->media_values.error_granularity );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 header->number_of_chunks,
+	 index_file->media_values.number_of_chunks );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 header->number_of_sectors,
+	 index_file->media_values.number_of_sectors );
+
+	if( libewf_checksum_calculate_adler32(
+	     &checksum,
+	     &( index_file->data[ sizeof( ewf_index_file_header_t ) ] ),
+	     index_file->data_size - sizeof( ewf_index_file_header_t ),
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate data checksum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 header->data_checksum,
+	 checksum );
+
+	if( libewf_checksum_calculate_adler32(
+	     &checksum,
+	     index_file->data,
+	     sizeof( ewf_index_file_header_t ) - 4,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate header checksum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 header->checksum,
+	 checksum );
+
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek file header offset: 0.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               index_file->data,
+	               index_file->data_size,
+	               error );
+
+	if( write_count != (ssize_t) index_file->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write index file data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the modification time of the file of a file IO handle
+ * The file IO handle must be a file handle
+ * The modification time is set to 0 if not available
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_index_file_get_modification_time(
+     libbfio_handle_t *file_io_handle,
+     int64_t *modification_time,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_STAT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	struct stat file_statistics;
+
+	char *name       = NULL;
+	size_t name_size = 0;
+#endif
+	static char *function = "libewf_index_file_get_modification_time";
+
+	if( modification_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid modification time.",
+		 function );
+
+		return( -1 );
+	}
+	*modification_time = 0;
+
+#if defined( HAVE_STAT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_get_name_size(
+	     file_io_handle,
+	     &name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( name_size == 0 )
+	 || ( name_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	name = narrow_string_allocate(
+	        name_size );
+
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_get_name(
+	     file_io_handle,
+	     name,
+	     name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name.",
+		 function );
+
+		goto on_error;
+	}
+	if( stat(
+	     name,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 name );
+
+	*modification_time = (int64_t) file_statistics.st_mtime;
+
+	return( 1 );
+
+on_error:
+	if( name != NULL )
+	{
+		memory_free(
+		 name );
+	}
+	return( -1 );
+#else
+	return( 0 );
+#endif
+}
@@ -0,0 +1,242 @@
+/*
+ * Index file functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_INDEX_FILE_H )
+#define _LIBEWF_INDEX_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libfdata.h"
+#include "libewf_media_values.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+extern const uint8_t ewf_index_file_signature[ 8 ];
+
+/* The index file format version
+ */
+#define LIBEWF_INDEX_FILE_FORMAT_VERSION		1
+
+typedef struct libewf_index_file_segment libewf_index_file_segment_t;
+
+/* The values of a segment file stored in the index file
+ */
+struct libewf_index_file_segment
+{
+	/* The segment number
+	 */
+	uint32_t segment_number;
+
+	/* The segment file type
+	 */
+	uint8_t type;
+
+	/* The segment file flags
+	 */
+	uint8_t flags;
+
+	/* Value to indicate the segment file contains section data
+	 * other than the chunk data and tables
+	 */
+	uint8_t has_section_data;
+
+	/* The segment file size
+	 */
+	size64_t segment_file_size;
+
+	/* The segment file modification time
+	 */
+	int64_t modification_time;
+
+	/* The last section offset
+	 */
+	off64_t last_section_offset;
+
+	/* The storage media size
+	 */
+	size64_t storage_media_size;
+
+	/* The number of chunks
+	 */
+	uint64_t number_of_chunks;
+
+	/* The last chunk filled
+	 */
+	int64_t last_chunk_filled;
+
+	/* The device information section index
+	 */
+	int device_information_section_index;
+};
+
+typedef struct libewf_index_file libewf_index_file_t;
+
+/* The index file caches the section layout and chunk groups (tables)
+ * of a set of segment files, so that they do not need to be read
+ * when the set is opened again
+ */
+struct libewf_index_file
+{
+	/* The segment file major version
+	 */
+	uint8_t major_version;
+
+	/* The segment file minor version
+	 */
+	uint8_t minor_version;
+
+	/* The compression method
+	 */
+	uint16_t compression_method;
+
+	/* The segment file set identifier
+	 */
+	uint8_t set_identifier[ 16 ];
+
+	/* The media values
+	 */
+	libewf_media_values_t media_values;
+
+	/* The data
+	 * Contains the index file header followed by the segments
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The allocated data size
+	 */
+	size_t allocated_data_size;
+
+	/* The offsets of the segments in the data
+	 */
+	size_t *segment_data_offsets;
+
+	/* The number of segments
+	 */
+	uint32_t number_of_segments;
+
+	/* The number of allocated segments
+	 */
+	uint32_t number_of_allocated_segments;
+};
+
+int libewf_index_file_initialize(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error );
+
+int libewf_index_file_free(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error );
+
+int libewf_index_file_resize_data(
+     libewf_index_file_t *index_file,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libewf_index_file_set_header_values(
+     libewf_index_file_t *index_file,
+     uint8_t major_version,
+     uint8_t minor_version,
+     uint16_t compression_method,
+     const uint8_t *set_identifier,
+     libcerror_error_t **error );
+
+int libewf_index_file_compare_header_values(
+     libewf_index_file_t *index_file,
+     uint8_t major_version,
+     uint8_t minor_version,
+     uint16_t compression_method,
+     const uint8_t *set_identifier,
+     libcerror_error_t **error );
+
+int libewf_index_file_get_media_values(
+     libewf_index_file_t *index_file,
+     libewf_media_values_t *media_values,
+     libcerror_error_t **error );
+
+int libewf_index_file_set_media_values(
+     libewf_index_file_t *index_file,
+     libewf_media_values_t *media_values,
+     libcerror_error_t **error );
+
+int libewf_index_file_get_number_of_segments(
+     libewf_index_file_t *index_file,
+     uint32_t *number_of_segments,
+     libcerror_error_t **error );
+
+int libewf_index_file_append_segment(
+     libewf_index_file_t *index_file,
+     libewf_index_file_segment_t *segment,
+     libfdata_list_t *sections_list,
+     libfdata_list_t *chunk_groups_list,
+     libcerror_error_t **error );
+
+int libewf_index_file_get_segment_by_index(
+     libewf_index_file_t *index_file,
+     uint32_t segment_index,
+     libewf_index_file_segment_t *segment,
+     libcerror_error_t **error );
+
+int libewf_index_file_fill_segment_lists(
+     libewf_index_file_t *index_file,
+     uint32_t segment_index,
+     int file_io_pool_entry,
+     size_t section_descriptor_size,
+     libfdata_list_t *sections_list,
+     libfdata_list_t *chunk_groups_list,
+     int *chunk_groups_index,
+     libcerror_error_t **error );
+
+int libewf_index_file_read_data(
+     libewf_index_file_t *index_file,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libewf_index_file_read_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_index_file_write_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_index_file_get_modification_time(
+     libbfio_handle_t *file_io_handle,
+     int64_t *modification_time,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_INDEX_FILE_H ) */
+
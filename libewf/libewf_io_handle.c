@@ -267,6 +267,7 @@ int libewf_io_handle_clone(
 		goto on_error;
 	}
 	( *destination_io_handle )->zero_on_error = source_io_handle->zero_on_error;
+	( *destination_io_handle )->index_file    = NULL;
 
 	return( 1 );
 
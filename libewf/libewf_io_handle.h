@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_index_file.h"
 #include "libewf_libcerror.h"
 
 #if defined( __cplusplus )
@@ -86,6 +87,12 @@ struct libewf_io_handle
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
+
+	/* The index file
+	 * Used to restore the segment files without reading the sections
+	 * The index file is not managed by the IO handle
+	 */
+	libewf_index_file_t *index_file;
 };
 
 int libewf_io_handle_initialize(
@@ -0,0 +1,732 @@
+/*
+ * io_uring batched read functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libewf_io_uring.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( HAVE_LIBEWF_IO_URING )
+
+/* Creates an io_uring
+ * Make sure the value io_uring is referencing, is set to NULL
+ * Returns 1 if successful, 0 if io_uring is not supported by the kernel or -1 on error
+ */
+int libewf_io_uring_initialize(
+     libewf_io_uring_t **io_uring,
+     unsigned int queue_depth,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_io_uring_initialize";
+	int result            = 0;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_uring != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid io_uring value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( queue_depth == 0 )
+	 || ( queue_depth > (unsigned int) INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid queue depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*io_uring = memory_allocate_structure(
+	             libewf_io_uring_t );
+
+	if( *io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create io_uring.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *io_uring,
+	     0,
+	     sizeof( libewf_io_uring_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear io_uring.",
+		 function );
+
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+
+		return( -1 );
+	}
+	/* The ring cannot be set up on kernels without io_uring support
+	 * or when io_uring is disabled, in which case the caller falls back
+	 * to reading from the file IO pool
+	 */
+	result = io_uring_queue_init(
+	          queue_depth,
+	          &( ( *io_uring )->ring ),
+	          0 );
+
+	if( result < 0 )
+	{
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+
+		return( 0 );
+	}
+	( *io_uring )->queue_depth = queue_depth;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *io_uring )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *io_uring != NULL )
+	{
+		if( ( *io_uring )->queue_depth != 0 )
+		{
+			io_uring_queue_exit(
+			 &( ( *io_uring )->ring ) );
+		}
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an io_uring
+ * Closes the files opened by the io_uring
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_uring_free(
+     libewf_io_uring_t **io_uring,
+     libcerror_error_t **error )
+{
+	static char *function  = "libewf_io_uring_free";
+	int file_io_pool_entry = 0;
+	int result             = 1;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_uring != NULL )
+	{
+		io_uring_queue_exit(
+		 &( ( *io_uring )->ring ) );
+
+		if( ( *io_uring )->file_descriptors != NULL )
+		{
+			for( file_io_pool_entry = 0;
+			     file_io_pool_entry < ( *io_uring )->number_of_file_descriptors;
+			     file_io_pool_entry++ )
+			{
+				if( ( *io_uring )->file_descriptors[ file_io_pool_entry ] == -1 )
+				{
+					continue;
+				}
+				if( close(
+				     ( *io_uring )->file_descriptors[ file_io_pool_entry ] ) != 0 )
+				{
+					libcerror_system_set_error(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+					 errno,
+					 "%s: unable to close file IO pool entry: %d.",
+					 function,
+					 file_io_pool_entry );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *io_uring )->file_descriptors );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *io_uring )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the file descriptor of a specific file IO pool entry
+ * The file is opened read-only by name if it was not opened before
+ * The file IO pool entry must be a file handle
+ * This function must be called with the io_uring mutex grabbed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_uring_get_file_descriptor(
+     libewf_io_uring_t *io_uring,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     int *file_descriptor,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	char *name                       = NULL;
+	int *file_descriptors            = NULL;
+	static char *function            = "libewf_io_uring_get_file_descriptor";
+	size_t name_size                 = 0;
+	int entry_index                  = 0;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file IO pool entry value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry >= io_uring->number_of_file_descriptors )
+	{
+		file_descriptors = (int *) memory_reallocate(
+		                            io_uring->file_descriptors,
+		                            sizeof( int ) * ( file_io_pool_entry + 1 ) );
+
+		if( file_descriptors == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize file descriptors.",
+			 function );
+
+			return( -1 );
+		}
+		for( entry_index = io_uring->number_of_file_descriptors;
+		     entry_index <= file_io_pool_entry;
+		     entry_index++ )
+		{
+			file_descriptors[ entry_index ] = -1;
+		}
+		io_uring->file_descriptors           = file_descriptors;
+		io_uring->number_of_file_descriptors = file_io_pool_entry + 1;
+	}
+	if( io_uring->file_descriptors[ file_io_pool_entry ] == -1 )
+	{
+		if( libbfio_pool_get_handle(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file IO handle: %d from pool.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+		if( libbfio_file_get_name_size(
+		     file_io_handle,
+		     &name_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve name size of file IO handle: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+		if( ( name_size == 0 )
+		 || ( name_size > (size_t) SSIZE_MAX ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid name size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		name = (char *) memory_allocate(
+		                 sizeof( char ) * name_size );
+
+		if( name == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create name.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_file_get_name(
+		     file_io_handle,
+		     name,
+		     name_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve name of file IO handle: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+		io_uring->file_descriptors[ file_io_pool_entry ] = open(
+		                                                    name,
+		                                                    O_RDONLY );
+
+		if( io_uring->file_descriptors[ file_io_pool_entry ] == -1 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to open file: %s.",
+			 function,
+			 name );
+
+			goto on_error;
+		}
+		memory_free(
+		 name );
+
+		name = NULL;
+	}
+	*file_descriptor = io_uring->file_descriptors[ file_io_pool_entry ];
+
+	return( 1 );
+
+on_error:
+	if( name != NULL )
+	{
+		memory_free(
+		 name );
+	}
+	return( -1 );
+}
+
+/* Reads the buffers of multiple read requests
+ * Up to queue depth reads are submitted at once, short reads are resubmitted
+ * for the remaining data until the read requests are complete
+ * This function is safe to be called from multiple threads concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_uring_read_buffers(
+     libewf_io_uring_t *io_uring,
+     libbfio_pool_t *file_io_pool,
+     libewf_io_uring_read_request_t *read_requests,
+     int number_of_read_requests,
+     libcerror_error_t **error )
+{
+	libewf_io_uring_read_request_t *read_request = NULL;
+	struct io_uring_cqe *completion_queue_entry  = NULL;
+	struct io_uring_sqe *submission_queue_entry  = NULL;
+	static char *function                        = "libewf_io_uring_read_buffers";
+	unsigned int number_of_submitted_reads       = 0;
+	unsigned int submitted_read_index            = 0;
+	int completion_result                        = 0;
+	int file_descriptor                          = 0;
+	int read_request_index                       = 0;
+	int result                                   = 1;
+	int window_index                             = 0;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read requests.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_read_requests < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of read requests value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_uring->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	while( read_request_index < number_of_read_requests )
+	{
+		number_of_submitted_reads = 0;
+
+		for( window_index = read_request_index;
+		     window_index < number_of_read_requests;
+		     window_index++ )
+		{
+			if( number_of_submitted_reads >= io_uring->queue_depth )
+			{
+				break;
+			}
+			read_request = &( read_requests[ window_index ] );
+
+			if( read_request->read_count >= read_request->size )
+			{
+				continue;
+			}
+			if( ( read_request->buffer == NULL )
+			 || ( read_request->size > (size_t) SSIZE_MAX ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+				 "%s: invalid read request: %d.",
+				 function,
+				 window_index );
+
+				result = -1;
+
+				break;
+			}
+			if( libewf_io_uring_get_file_descriptor(
+			     io_uring,
+			     file_io_pool,
+			     read_request->file_io_pool_entry,
+			     &file_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve file descriptor of file IO pool entry: %d.",
+				 function,
+				 read_request->file_io_pool_entry );
+
+				result = -1;
+
+				break;
+			}
+			submission_queue_entry = io_uring_get_sqe(
+			                          &( io_uring->ring ) );
+
+			if( submission_queue_entry == NULL )
+			{
+				break;
+			}
+			io_uring_prep_read(
+			 submission_queue_entry,
+			 file_descriptor,
+			 &( read_request->buffer[ read_request->read_count ] ),
+			 (unsigned int) ( read_request->size - read_request->read_count ),
+			 (uint64_t) ( read_request->offset + read_request->read_count ) );
+
+			io_uring_sqe_set_data(
+			 submission_queue_entry,
+			 (void *) read_request );
+
+			number_of_submitted_reads++;
+		}
+		if( number_of_submitted_reads == 0 )
+		{
+			if( result == -1 )
+			{
+				goto on_error;
+			}
+			read_request_index = window_index;
+
+			continue;
+		}
+		completion_result = io_uring_submit_and_wait(
+		                     &( io_uring->ring ),
+		                     number_of_submitted_reads );
+
+		if( completion_result < 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 -completion_result,
+			 "%s: unable to submit reads.",
+			 function );
+
+			goto on_error;
+		}
+		/* All the completions of the submitted reads are reaped, also when
+		 * a read failed, so that no completions are left in the ring
+		 */
+		for( submitted_read_index = 0;
+		     submitted_read_index < number_of_submitted_reads;
+		     submitted_read_index++ )
+		{
+			completion_result = io_uring_wait_cqe(
+			                     &( io_uring->ring ),
+			                     &completion_queue_entry );
+
+			if( completion_result < 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 -completion_result,
+				 "%s: unable to wait for read completion.",
+				 function );
+
+				goto on_error;
+			}
+			read_request      = (libewf_io_uring_read_request_t *) io_uring_cqe_get_data(
+			                                                        completion_queue_entry );
+			completion_result = completion_queue_entry->res;
+
+			io_uring_cqe_seen(
+			 &( io_uring->ring ),
+			 completion_queue_entry );
+
+			if( ( completion_result == -EAGAIN )
+			 || ( completion_result == -EINTR ) )
+			{
+				/* The read is resubmitted with the next window
+				 */
+				continue;
+			}
+			else if( completion_result < 0 )
+			{
+				if( result != -1 )
+				{
+					libcerror_system_set_error(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 -completion_result,
+					 "%s: unable to read from file IO pool entry: %d at offset: %" PRIi64 ".",
+					 function,
+					 read_request->file_io_pool_entry,
+					 read_request->offset );
+
+					result = -1;
+				}
+			}
+			else if( completion_result == 0 )
+			{
+				if( result != -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unexpected end of file in file IO pool entry: %d at offset: %" PRIi64 ".",
+					 function,
+					 read_request->file_io_pool_entry,
+					 read_request->offset );
+
+					result = -1;
+				}
+			}
+			else
+			{
+				read_request->read_count += (size_t) completion_result;
+			}
+		}
+		if( result == -1 )
+		{
+			goto on_error;
+		}
+		while( read_request_index < number_of_read_requests )
+		{
+			if( read_requests[ read_request_index ].read_count < read_requests[ read_request_index ].size )
+			{
+				break;
+			}
+			read_request_index++;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_uring->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 io_uring->mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_IO_URING ) */
+
@@ -0,0 +1,142 @@
+/*
+ * io_uring batched read functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_IO_URING_H )
+#define _LIBEWF_IO_URING_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_LIBURING_H )
+#include <liburing.h>
+#endif
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The io_uring batched reads require liburing and the POSIX file functions
+ */
+#if defined( HAVE_LIBURING_H ) && defined( HAVE_LIBURING ) && !defined( WINAPI )
+#define HAVE_LIBEWF_IO_URING
+#endif
+
+/* The default number of reads that are submitted at once
+ */
+#define LIBEWF_IO_URING_DEFAULT_QUEUE_DEPTH		64
+
+typedef struct libewf_io_uring_read_request libewf_io_uring_read_request_t;
+
+/* A read request describes a read of a buffer from a file IO pool entry
+ * without seeking, so that multiple read requests can be submitted at once
+ */
+struct libewf_io_uring_read_request
+{
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The size
+	 */
+	size_t size;
+
+	/* The number of bytes read
+	 */
+	size_t read_count;
+};
+
+#if defined( HAVE_LIBEWF_IO_URING )
+
+typedef struct libewf_io_uring libewf_io_uring_t;
+
+/* The io_uring submits the reads of a batch of read requests at once
+ * The files of the file IO pool entries are opened read-only by name
+ * the first time they are read from and remain open until the io_uring is freed
+ */
+struct libewf_io_uring
+{
+	/* The ring
+	 */
+	struct io_uring ring;
+
+	/* The queue depth
+	 */
+	unsigned int queue_depth;
+
+	/* The file descriptors
+	 * Contains a file descriptor per file IO pool entry or -1 if not opened
+	 */
+	int *file_descriptors;
+
+	/* The number of file descriptors
+	 */
+	int number_of_file_descriptors;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex protecting the ring and the file descriptors
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_io_uring_initialize(
+     libewf_io_uring_t **io_uring,
+     unsigned int queue_depth,
+     libcerror_error_t **error );
+
+int libewf_io_uring_free(
+     libewf_io_uring_t **io_uring,
+     libcerror_error_t **error );
+
+int libewf_io_uring_get_file_descriptor(
+     libewf_io_uring_t *io_uring,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     int *file_descriptor,
+     libcerror_error_t **error );
+
+int libewf_io_uring_read_buffers(
+     libewf_io_uring_t *io_uring,
+     libbfio_pool_t *file_io_pool,
+     libewf_io_uring_read_request_t *read_requests,
+     int number_of_read_requests,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_IO_URING ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_IO_URING_H ) */
+
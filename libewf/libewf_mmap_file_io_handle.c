@@ -0,0 +1,1568 @@
+/*
+ * Memory-mapped file IO handle functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libclocale.h"
+#include "libewf_libuna.h"
+#include "libewf_mmap_file_io_handle.h"
+#include "libewf_unused.h"
+
+#if defined( HAVE_LIBEWF_MMAP_FILE_IO_HANDLE )
+
+/* Creates a memory-mapped file IO handle
+ * Make sure the value mmap_file_io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mmap_file_io_handle_initialize(
+     libewf_mmap_file_io_handle_t **mmap_file_io_handle,
+     int memory_mapped_io_mode,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mmap_file_io_handle_initialize";
+
+	if( mmap_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory-mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *mmap_file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid memory-mapped file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( memory_mapped_io_mode != LIBEWF_MEMORY_MAPPED_IO_MODE_SEQUENTIAL )
+	 && ( memory_mapped_io_mode != LIBEWF_MEMORY_MAPPED_IO_MODE_RANDOM ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported memory-mapped IO mode.",
+		 function );
+
+		return( -1 );
+	}
+	*mmap_file_io_handle = memory_allocate_structure(
+	                        libewf_mmap_file_io_handle_t );
+
+	if( *mmap_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create memory-mapped file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *mmap_file_io_handle,
+	     0,
+	     sizeof( libewf_mmap_file_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear memory-mapped file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *mmap_file_io_handle )->memory_mapped_io_mode = memory_mapped_io_mode;
+
+	return( 1 );
+
+on_error:
+	if( *mmap_file_io_handle != NULL )
+	{
+		memory_free(
+		 *mmap_file_io_handle );
+
+		*mmap_file_io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Creates a memory-mapped file handle
+ * Make sure the value handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mmap_file_initialize(
+     libbfio_handle_t **handle,
+     int memory_mapped_io_mode,
+     libcerror_error_t **error )
+{
+	libewf_mmap_file_io_handle_t *mmap_file_io_handle = NULL;
+	static char *function                             = "libewf_mmap_file_initialize";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_mmap_file_io_handle_initialize(
+	     &mmap_file_io_handle,
+	     memory_mapped_io_mode,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create memory-mapped file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_initialize(
+	     handle,
+	     (intptr_t *) mmap_file_io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libewf_mmap_file_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libewf_mmap_file_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libewf_mmap_file_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_mmap_file_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libewf_mmap_file_io_handle_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libewf_mmap_file_io_handle_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libewf_mmap_file_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_mmap_file_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_mmap_file_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libewf_mmap_file_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( mmap_file_io_handle != NULL )
+	{
+		libewf_mmap_file_io_handle_free(
+		 &mmap_file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a memory-mapped file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mmap_file_io_handle_free(
+     libewf_mmap_file_io_handle_t **mmap_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mmap_file_io_handle_free";
+	int result            = 1;
+
+	if( mmap_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory-mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *mmap_file_io_handle != NULL )
+	{
+		if( ( *mmap_file_io_handle )->is_open != 0 )
+		{
+			if( libewf_mmap_file_io_handle_close(
+			     *mmap_file_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close memory-mapped file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *mmap_file_io_handle )->name != NULL )
+		{
+			memory_free(
+			 ( *mmap_file_io_handle )->name );
+		}
+		memory_free(
+		 *mmap_file_io_handle );
+
+		*mmap_file_io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the memory-mapped file IO handle
+ * The clone is not opened and does not share the mapping of the source
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mmap_file_io_handle_clone(
+     libewf_mmap_file_io_handle_t **destination_mmap_file_io_handle,
+     libewf_mmap_file_io_handle_t *source_mmap_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mmap_file_io_handle_clone";
+
+	if( destination_mmap_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination memory-mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_mmap_file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination memory-mapped file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_mmap_file_io_handle == NULL )
+	{
+		*destination_mmap_file_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libewf_mmap_file_io_handle_initialize(
+	     destination_mmap_file_io_handle,
+	     source_mmap_file_io_handle->memory_mapped_io_mode,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination memory-mapped file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( source_mmap_file_io_handle->name != NULL )
+	{
+		if( libewf_mmap_file_io_handle_set_name(
+		     *destination_mmap_file_io_handle,
+		     source_mmap_file_io_handle->name,
+		     source_mmap_file_io_handle->name_size - 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name in destination memory-mapped file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *destination_mmap_file_io_handle != NULL )
+	{
+		libewf_mmap_file_io_handle_free(
+		 destination_mmap_file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the name
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mmap_file_io_handle_set_name(
+     libewf_mmap_file_io_handle_t *mmap_file_io_handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mmap_file_io_handle_set_name";
+
+	if( mmap_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory-mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mmap_file_io_handle->is_open != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid memory-mapped file IO handle - file already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_length == 0 )
+	 || ( name_length > (size_t) ( SSIZE_MAX - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( mmap_file_io_handle->name != NULL )
+	{
+		memory_free(
+		 mmap_file_io_handle->name );
+
+		mmap_file_io_handle->name      = NULL;
+		mmap_file_io_handle->name_size = 0;
+	}
+	mmap_file_io_handle->name = narrow_string_allocate(
+	                             name_length + 1 );
+
+	if( mmap_file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name.",
+		 function );
+
+		goto on_error;
+	}
+	if( narrow_string_copy(
+	     mmap_file_io_handle->name,
+	     name,
+	     name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		goto on_error;
+	}
+	mmap_file_io_handle->name[ name_length ] = 0;
+
+	mmap_file_io_handle->name_size = name_length + 1;
+
+	return( 1 );
+
+on_error:
+	if( mmap_file_io_handle->name != NULL )
+	{
+		memory_free(
+		 mmap_file_io_handle->name );
+
+		mmap_file_io_handle->name = NULL;
+	}
+	mmap_file_io_handle->name_size = 0;
+
+	return( -1 );
+}
+
+/* Opens the memory-mapped file IO handle
+ * The file is mapped read-only and the file descriptor is closed afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mmap_file_io_handle_open(
+     libewf_mmap_file_io_handle_t *mmap_file_io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	void *mapped_data     = NULL;
+	static char *function = "libewf_mmap_file_io_handle_open";
+	int file_descriptor   = -1;
+
+	if( mmap_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory-mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mmap_file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid memory-mapped file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( mmap_file_io_handle->is_open != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid memory-mapped file IO handle - file already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access not supported.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & LIBBFIO_ACCESS_FLAG_READ ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
+
+		return( -1 );
+	}
+	file_descriptor = open(
+	                   mmap_file_io_handle->name,
+	                   O_RDONLY );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 mmap_file_io_handle->name );
+
+		goto on_error;
+	}
+	if( fstat(
+	     file_descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( file_statistics.st_size < 0 )
+	 || ( (size64_t) file_statistics.st_size > (size64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	/* An empty file cannot be mapped
+	 */
+	if( file_statistics.st_size > 0 )
+	{
+		mapped_data = mmap(
+		               NULL,
+		               (size_t) file_statistics.st_size,
+		               PROT_READ,
+		               MAP_SHARED,
+		               file_descriptor,
+		               0 );
+
+		if( mapped_data == MAP_FAILED )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to map file: %s.",
+			 function,
+			 mmap_file_io_handle->name );
+
+			mapped_data = NULL;
+
+			goto on_error;
+		}
+#if defined( HAVE_MADVISE )
+		/* The access hint is advisory, failure to set it is not an error
+		 */
+		if( mmap_file_io_handle->memory_mapped_io_mode == LIBEWF_MEMORY_MAPPED_IO_MODE_SEQUENTIAL )
+		{
+			madvise(
+			 mapped_data,
+			 (size_t) file_statistics.st_size,
+			 MADV_SEQUENTIAL );
+		}
+		else
+		{
+			madvise(
+			 mapped_data,
+			 (size_t) file_statistics.st_size,
+			 MADV_RANDOM );
+		}
+#endif
+	}
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file: %s.",
+		 function,
+		 mmap_file_io_handle->name );
+
+		file_descriptor = -1;
+
+		goto on_error;
+	}
+	mmap_file_io_handle->mapped_data       = (uint8_t *) mapped_data;
+	mmap_file_io_handle->file_size         = (size64_t) file_statistics.st_size;
+	mmap_file_io_handle->modification_time = (int64_t) file_statistics.st_mtime;
+	mmap_file_io_handle->current_offset    = 0;
+	mmap_file_io_handle->access_flags      = access_flags;
+	mmap_file_io_handle->is_open           = 1;
+
+	return( 1 );
+
+on_error:
+	if( mapped_data != NULL )
+	{
+		munmap(
+		 mapped_data,
+		 (size_t) file_statistics.st_size );
+	}
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+	return( -1 );
+}
+
+/* Closes the memory-mapped file IO handle
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_mmap_file_io_handle_close(
+     libewf_mmap_file_io_handle_t *mmap_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mmap_file_io_handle_close";
+	int result            = 0;
+
+	if( mmap_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory-mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mmap_file_io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid memory-mapped file IO handle - file not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( mmap_file_io_handle->mapped_data != NULL )
+	{
+		if( munmap(
+		     mmap_file_io_handle->mapped_data,
+		     (size_t) mmap_file_io_handle->file_size ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to unmap file.",
+			 function );
+
+			result = -1;
+		}
+		mmap_file_io_handle->mapped_data = NULL;
+	}
+	mmap_file_io_handle->current_offset = 0;
+	mmap_file_io_handle->access_flags   = 0;
+	mmap_file_io_handle->is_open        = 0;
+
+	return( result );
+}
+
+/* Reads a buffer from the memory-mapped file IO handle
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libewf_mmap_file_io_handle_read(
+         libewf_mmap_file_io_handle_t *mmap_file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_mmap_file_io_handle_read";
+	size_t read_size      = 0;
+
+	if( mmap_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory-mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mmap_file_io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid memory-mapped file IO handle - file not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) mmap_file_io_handle->current_offset >= mmap_file_io_handle->file_size )
+	{
+		return( 0 );
+	}
+	read_size = (size_t) ( mmap_file_io_handle->file_size - mmap_file_io_handle->current_offset );
+
+	if( read_size > size )
+	{
+		read_size = size;
+	}
+	if( memory_copy(
+	     buffer,
+	     &( mmap_file_io_handle->mapped_data[ mmap_file_io_handle->current_offset ] ),
+	     read_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy mapped data.",
+		 function );
+
+		return( -1 );
+	}
+	mmap_file_io_handle->current_offset += (off64_t) read_size;
+
+	return( (ssize_t) read_size );
+}
+
+/* Writes a buffer to the memory-mapped file IO handle
+ * Writing is not supported, since the file is mapped read-only
+ * Returns -1
+ */
+ssize_t libewf_mmap_file_io_handle_write(
+         libewf_mmap_file_io_handle_t *mmap_file_io_handle LIBEWF_ATTRIBUTE_UNUSED,
+         const uint8_t *buffer LIBEWF_ATTRIBUTE_UNUSED,
+         size_t size LIBEWF_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_mmap_file_io_handle_write";
+
+	LIBEWF_UNREFERENCED_PARAMETER( mmap_file_io_handle )
+	LIBEWF_UNREFERENCED_PARAMETER( buffer )
+	LIBEWF_UNREFERENCED_PARAMETER( size )
+
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: write not supported.",
+	 function );
+
+	return( -1 );
+}
+
+/* Seeks a certain offset within the memory-mapped file IO handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libewf_mmap_file_io_handle_seek_offset(
+         libewf_mmap_file_io_handle_t *mmap_file_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_mmap_file_io_handle_seek_offset";
+
+	if( mmap_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory-mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mmap_file_io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid memory-mapped file IO handle - file not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += mmap_file_io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) mmap_file_io_handle->file_size;
+	}
+	else if( whence != SEEK_SET )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	mmap_file_io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if a file exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int libewf_mmap_file_io_handle_exists(
+     libewf_mmap_file_io_handle_t *mmap_file_io_handle,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function = "libewf_mmap_file_io_handle_exists";
+
+	if( mmap_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory-mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mmap_file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid memory-mapped file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( stat(
+	     mmap_file_io_handle->name,
+	     &file_statistics ) == 0 )
+	{
+		return( 1 );
+	}
+	if( errno == ENOENT )
+	{
+		return( 0 );
+	}
+	libcerror_system_set_error(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_GENERIC,
+	 errno,
+	 "%s: unable to determine if file: %s exists.",
+	 function,
+	 mmap_file_io_handle->name );
+
+	return( -1 );
+}
+
+/* Check if the file is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libewf_mmap_file_io_handle_is_open(
+     libewf_mmap_file_io_handle_t *mmap_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mmap_file_io_handle_is_open";
+
+	if( mmap_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory-mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mmap_file_io_handle->is_open == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the file size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mmap_file_io_handle_get_size(
+     libewf_mmap_file_io_handle_t *mmap_file_io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function = "libewf_mmap_file_io_handle_get_size";
+
+	if( mmap_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory-mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( mmap_file_io_handle->is_open != 0 )
+	{
+		*size = mmap_file_io_handle->file_size;
+
+		return( 1 );
+	}
+	if( mmap_file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid memory-mapped file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( stat(
+	     mmap_file_io_handle->name,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_statistics.st_size < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*size = (size64_t) file_statistics.st_size;
+
+	return( 1 );
+}
+
+/* Retrieves the memory-mapped file IO handle of a handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mmap_file_get_io_handle(
+     libbfio_handle_t *handle,
+     libewf_mmap_file_io_handle_t **mmap_file_io_handle,
+     libcerror_error_t **error )
+{
+	intptr_t *io_handle   = NULL;
+	static char *function = "libewf_mmap_file_get_io_handle";
+
+	if( mmap_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory-mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_io_handle(
+	     handle,
+	     &io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	*mmap_file_io_handle = (libewf_mmap_file_io_handle_t *) io_handle;
+
+	return( 1 );
+}
+
+/* Sets the name of the memory-mapped file handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mmap_file_set_name(
+     libbfio_handle_t *handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	libewf_mmap_file_io_handle_t *mmap_file_io_handle = NULL;
+	static char *function                             = "libewf_mmap_file_set_name";
+
+	if( libewf_mmap_file_get_io_handle(
+	     handle,
+	     &mmap_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve memory-mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_mmap_file_io_handle_set_name(
+	     mmap_file_io_handle,
+	     name,
+	     name_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in memory-mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the name size of the memory-mapped file handle
+ * The name size includes the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mmap_file_get_name_size(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error )
+{
+	libewf_mmap_file_io_handle_t *mmap_file_io_handle = NULL;
+	static char *function                             = "libewf_mmap_file_get_name_size";
+
+	if( libewf_mmap_file_get_io_handle(
+	     handle,
+	     &mmap_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve memory-mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mmap_file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid memory-mapped file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name size.",
+		 function );
+
+		return( -1 );
+	}
+	*name_size = mmap_file_io_handle->name_size;
+
+	return( 1 );
+}
+
+/* Retrieves the name of the memory-mapped file handle
+ * The name size should include the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mmap_file_get_name(
+     libbfio_handle_t *handle,
+     char *name,
+     size_t name_size,
+     libcerror_error_t **error )
+{
+	libewf_mmap_file_io_handle_t *mmap_file_io_handle = NULL;
+	static char *function                             = "libewf_mmap_file_get_name";
+
+	if( libewf_mmap_file_get_io_handle(
+	     handle,
+	     &mmap_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve memory-mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mmap_file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid memory-mapped file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_size < mmap_file_io_handle->name_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: name size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( narrow_string_copy(
+	     name,
+	     mmap_file_io_handle->name,
+	     mmap_file_io_handle->name_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Retrieves the wide name size of the memory-mapped file handle
+ * The name size includes the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mmap_file_get_name_size_wide(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error )
+{
+	libewf_mmap_file_io_handle_t *mmap_file_io_handle = NULL;
+	static char *function                             = "libewf_mmap_file_get_name_size_wide";
+	int result                                        = 0;
+
+	if( libewf_mmap_file_get_io_handle(
+	     handle,
+	     &mmap_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve memory-mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mmap_file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid memory-mapped file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_size_from_utf8(
+		          (libuna_utf8_character_t *) mmap_file_io_handle->name,
+		          mmap_file_io_handle->name_size,
+		          name_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_size_from_utf8(
+		          (libuna_utf8_character_t *) mmap_file_io_handle->name,
+		          mmap_file_io_handle->name_size,
+		          name_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_size_from_byte_stream(
+		          (uint8_t *) mmap_file_io_handle->name,
+		          mmap_file_io_handle->name_size,
+		          libclocale_codepage,
+		          name_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_size_from_byte_stream(
+		          (uint8_t *) mmap_file_io_handle->name,
+		          mmap_file_io_handle->name_size,
+		          libclocale_codepage,
+		          name_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine name size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the wide name of the memory-mapped file handle
+ * The name size should include the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mmap_file_get_name_wide(
+     libbfio_handle_t *handle,
+     wchar_t *name,
+     size_t name_size,
+     libcerror_error_t **error )
+{
+	libewf_mmap_file_io_handle_t *mmap_file_io_handle = NULL;
+	static char *function                             = "libewf_mmap_file_get_name_wide";
+	int result                                        = 0;
+
+	if( libewf_mmap_file_get_io_handle(
+	     handle,
+	     &mmap_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve memory-mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mmap_file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid memory-mapped file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_copy_from_utf8(
+		          (libuna_utf32_character_t *) name,
+		          name_size,
+		          (libuna_utf8_character_t *) mmap_file_io_handle->name,
+		          mmap_file_io_handle->name_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_copy_from_utf8(
+		          (libuna_utf16_character_t *) name,
+		          name_size,
+		          (libuna_utf8_character_t *) mmap_file_io_handle->name,
+		          mmap_file_io_handle->name_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_copy_from_byte_stream(
+		          (libuna_utf32_character_t *) name,
+		          name_size,
+		          (uint8_t *) mmap_file_io_handle->name,
+		          mmap_file_io_handle->name_size,
+		          libclocale_codepage,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_copy_from_byte_stream(
+		          (libuna_utf16_character_t *) name,
+		          name_size,
+		          (uint8_t *) mmap_file_io_handle->name,
+		          mmap_file_io_handle->name_size,
+		          libclocale_codepage,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set name.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Retrieves the modification time of the memory-mapped file handle
+ * The modification time is retrieved when the file is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mmap_file_get_modification_time(
+     libbfio_handle_t *handle,
+     int64_t *modification_time,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	libewf_mmap_file_io_handle_t *mmap_file_io_handle = NULL;
+	static char *function                             = "libewf_mmap_file_get_modification_time";
+
+	if( libewf_mmap_file_get_io_handle(
+	     handle,
+	     &mmap_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve memory-mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( modification_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid modification time.",
+		 function );
+
+		return( -1 );
+	}
+	if( mmap_file_io_handle->is_open != 0 )
+	{
+		*modification_time = mmap_file_io_handle->modification_time;
+
+		return( 1 );
+	}
+	if( mmap_file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid memory-mapped file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( stat(
+	     mmap_file_io_handle->name,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		return( -1 );
+	}
+	*modification_time = (int64_t) file_statistics.st_mtime;
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MMAP_FILE_IO_HANDLE ) */
+
@@ -0,0 +1,203 @@
+/*
+ * Memory-mapped file IO handle functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_MMAP_FILE_IO_HANDLE_H )
+#define _LIBEWF_MMAP_FILE_IO_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The memory-mapped file IO handle requires mmap, munmap and the POSIX file functions
+ */
+#if defined( HAVE_SYS_MMAN_H ) && defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && !defined( WINAPI )
+#define HAVE_LIBEWF_MMAP_FILE_IO_HANDLE
+#endif
+
+#if defined( HAVE_LIBEWF_MMAP_FILE_IO_HANDLE )
+
+typedef struct libewf_mmap_file_io_handle libewf_mmap_file_io_handle_t;
+
+/* The memory-mapped file IO handle maps the file when it is opened
+ * and unmaps it when it is closed, so that the file IO pool limits
+ * also limit the number of mapped files
+ * The file descriptor is closed once the file is mapped
+ */
+struct libewf_mmap_file_io_handle
+{
+	/* The name
+	 */
+	char *name;
+
+	/* The name size
+	 */
+	size_t name_size;
+
+	/* Value to indicate the file is open
+	 */
+	uint8_t is_open;
+
+	/* The mapped data
+	 */
+	uint8_t *mapped_data;
+
+	/* The file size
+	 */
+	size64_t file_size;
+
+	/* The modification time
+	 */
+	int64_t modification_time;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The memory-mapped IO mode
+	 */
+	int memory_mapped_io_mode;
+
+	/* The access flags
+	 */
+	int access_flags;
+};
+
+int libewf_mmap_file_io_handle_initialize(
+     libewf_mmap_file_io_handle_t **mmap_file_io_handle,
+     int memory_mapped_io_mode,
+     libcerror_error_t **error );
+
+int libewf_mmap_file_initialize(
+     libbfio_handle_t **handle,
+     int memory_mapped_io_mode,
+     libcerror_error_t **error );
+
+int libewf_mmap_file_io_handle_free(
+     libewf_mmap_file_io_handle_t **mmap_file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_mmap_file_io_handle_clone(
+     libewf_mmap_file_io_handle_t **destination_mmap_file_io_handle,
+     libewf_mmap_file_io_handle_t *source_mmap_file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_mmap_file_io_handle_set_name(
+     libewf_mmap_file_io_handle_t *mmap_file_io_handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+int libewf_mmap_file_io_handle_open(
+     libewf_mmap_file_io_handle_t *mmap_file_io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libewf_mmap_file_io_handle_close(
+     libewf_mmap_file_io_handle_t *mmap_file_io_handle,
+     libcerror_error_t **error );
+
+ssize_t libewf_mmap_file_io_handle_read(
+         libewf_mmap_file_io_handle_t *mmap_file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libewf_mmap_file_io_handle_write(
+         libewf_mmap_file_io_handle_t *mmap_file_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libewf_mmap_file_io_handle_seek_offset(
+         libewf_mmap_file_io_handle_t *mmap_file_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libewf_mmap_file_io_handle_exists(
+     libewf_mmap_file_io_handle_t *mmap_file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_mmap_file_io_handle_is_open(
+     libewf_mmap_file_io_handle_t *mmap_file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_mmap_file_io_handle_get_size(
+     libewf_mmap_file_io_handle_t *mmap_file_io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+int libewf_mmap_file_get_io_handle(
+     libbfio_handle_t *handle,
+     libewf_mmap_file_io_handle_t **mmap_file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_mmap_file_set_name(
+     libbfio_handle_t *handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+int libewf_mmap_file_get_name_size(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error );
+
+int libewf_mmap_file_get_name(
+     libbfio_handle_t *handle,
+     char *name,
+     size_t name_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+int libewf_mmap_file_get_name_size_wide(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error );
+
+int libewf_mmap_file_get_name_wide(
+     libbfio_handle_t *handle,
+     wchar_t *name,
+     size_t name_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+int libewf_mmap_file_get_modification_time(
+     libbfio_handle_t *handle,
+     int64_t *modification_time,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MMAP_FILE_IO_HANDLE ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_MMAP_FILE_IO_HANDLE_H ) */
+
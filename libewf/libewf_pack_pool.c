@@ -0,0 +1,899 @@
+/*
+ * Pack pool functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_compression_context.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_pack_pool.h"
+#include "libewf_write_io_handle.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates a pack pool
+ * Make sure the value pack_pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_pack_pool_initialize(
+     libewf_pack_pool_t **pack_pool,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_pack_pool_initialize";
+	size_t requests_size  = 0;
+
+	if( pack_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pack pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *pack_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid pack pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_PACK_POOL_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*pack_pool = memory_allocate_structure(
+	                libewf_pack_pool_t );
+
+	if( *pack_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create pack pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *pack_pool,
+	     0,
+	     sizeof( libewf_pack_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear pack pool.",
+		 function );
+
+		memory_free(
+		 *pack_pool );
+
+		*pack_pool = NULL;
+
+		return( -1 );
+	}
+	( *pack_pool )->number_of_requests = number_of_threads * LIBEWF_PACK_POOL_NUMBER_OF_CHUNKS_PER_THREAD;
+
+	requests_size = sizeof( libewf_pack_pool_request_t ) * ( *pack_pool )->number_of_requests;
+
+	( *pack_pool )->requests = (libewf_pack_pool_request_t *) memory_allocate(
+	                                                               requests_size );
+
+	if( ( *pack_pool )->requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *pack_pool )->requests,
+	     0,
+	     requests_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *pack_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *pack_pool )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	( *pack_pool )->number_of_threads = number_of_threads;
+
+	return( 1 );
+
+on_error:
+	if( *pack_pool != NULL )
+	{
+		if( ( *pack_pool )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *pack_pool )->mutex ),
+			 NULL );
+		}
+		if( ( *pack_pool )->requests != NULL )
+		{
+			memory_free(
+			 ( *pack_pool )->requests );
+		}
+		memory_free(
+		 *pack_pool );
+
+		*pack_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a pack pool
+ * The chunk data of requests that were not written is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_pack_pool_free(
+     libewf_pack_pool_t **pack_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_pack_pool_free";
+	int request_index     = 0;
+	int result            = 1;
+
+	if( pack_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pack pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *pack_pool != NULL )
+	{
+		if( ( *pack_pool )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *pack_pool )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *pack_pool )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *pack_pool )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		for( request_index = 0;
+		     request_index < ( *pack_pool )->number_of_requests;
+		     request_index++ )
+		{
+			if( ( *pack_pool )->requests[ request_index ].chunk_data != NULL )
+			{
+				if( libewf_chunk_data_free(
+				     &( ( *pack_pool )->requests[ request_index ].chunk_data ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free chunk: %" PRIu64 " data.",
+					 function,
+					 ( *pack_pool )->requests[ request_index ].chunk_index );
+
+					result = -1;
+				}
+			}
+		}
+		memory_free(
+		 ( *pack_pool )->requests );
+
+		memory_free(
+		 *pack_pool );
+
+		*pack_pool = NULL;
+	}
+	return( result );
+}
+
+
+/* Processes a pack pool request
+ * Callback function for the pack pool thread pool
+ * Errors are not propagated, the request pack result is set to -1 instead
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_pack_pool_process_request(
+     libewf_pack_pool_request_t *request,
+     libewf_pack_pool_t *pack_pool )
+{
+	libewf_compression_context_t *compression_context = NULL;
+	libcerror_error_t *error                          = NULL;
+	static char *function                             = "libewf_pack_pool_process_request";
+	int pack_result                                   = 1;
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		goto on_error;
+	}
+	if( pack_pool == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pack pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_write_io_handle_grab_compression_context(
+	     pack_pool->write_io_handle,
+	     &compression_context,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab compression context.",
+		 function );
+
+		pack_result = -1;
+	}
+	else
+	{
+		if( libewf_chunk_data_pack(
+		     request->chunk_data,
+		     pack_pool->io_handle,
+		     compression_context,
+		     pack_pool->write_io_handle->compressed_zero_byte_empty_block,
+		     pack_pool->write_io_handle->compressed_zero_byte_empty_block_size,
+		     pack_pool->write_io_handle->pack_flags,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %" PRIu64 " data.",
+			 function,
+			 request->chunk_index );
+
+			pack_result = -1;
+		}
+		if( libewf_write_io_handle_release_compression_context(
+		     pack_pool->write_io_handle,
+		     &compression_context,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release compression context.",
+			 function );
+
+			pack_result = -1;
+		}
+	}
+	if( pack_result == -1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( libcthreads_mutex_grab(
+	     pack_pool->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	request->pack_result = pack_result;
+
+	if( libcthreads_condition_broadcast(
+	     pack_pool->condition,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		libcthreads_mutex_release(
+		 pack_pool->mutex,
+		 NULL );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     pack_pool->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+/* Retrieves the number of queued requests
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_pack_pool_get_number_of_queued_requests(
+     libewf_pack_pool_t *pack_pool,
+     int *number_of_queued_requests,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_pack_pool_get_number_of_queued_requests";
+
+	if( pack_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pack pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_queued_requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of queued requests.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     pack_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_queued_requests = pack_pool->number_of_queued_requests;
+
+	if( libcthreads_mutex_release(
+	     pack_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Queues a chunk to be packed by the thread pool
+ * The pack pool takes over the chunk data if successful
+ * A request must be available, call libewf_pack_pool_write_chunks first if the queue is full
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_pack_pool_queue_chunk(
+     libewf_pack_pool_t *pack_pool,
+     libewf_io_handle_t *io_handle,
+     libewf_write_io_handle_t *write_io_handle,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t input_data_size,
+     libcerror_error_t **error )
+{
+	libewf_pack_pool_request_t *request = NULL;
+	static char *function               = "libewf_pack_pool_queue_chunk";
+	int number_of_queued_requests       = 0;
+	int request_index                   = 0;
+
+	if( pack_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pack pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( pack_pool->thread_pool == NULL )
+	{
+		pack_pool->io_handle       = io_handle;
+		pack_pool->write_io_handle = write_io_handle;
+
+		if( libcthreads_thread_pool_create(
+		     &( pack_pool->thread_pool ),
+		     NULL,
+		     pack_pool->number_of_threads,
+		     pack_pool->number_of_requests,
+		     (int (*)(intptr_t *, void *)) &libewf_pack_pool_process_request,
+		     (void *) pack_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libewf_pack_pool_get_number_of_queued_requests(
+	     pack_pool,
+	     &number_of_queued_requests,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of queued requests.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_queued_requests >= pack_pool->number_of_requests )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid pack pool - no request available.",
+		 function );
+
+		return( -1 );
+	}
+	request_index = ( pack_pool->first_request_index + number_of_queued_requests ) % pack_pool->number_of_requests;
+
+	request = &( pack_pool->requests[ request_index ] );
+
+	request->chunk_index     = chunk_index;
+	request->chunk_data      = chunk_data;
+	request->input_data_size = input_data_size;
+	request->pack_result     = 0;
+
+	if( libcthreads_thread_pool_push(
+	     pack_pool->thread_pool,
+	     (intptr_t *) request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push request for chunk: %" PRIu64 " onto thread pool queue.",
+		 function,
+		 chunk_index );
+
+		request->chunk_data = NULL;
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     pack_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	pack_pool->number_of_queued_requests += 1;
+
+	if( libcthreads_mutex_release(
+	     pack_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes the packed chunks in the order they were queued
+ * If write_all is set all queued chunks are written, otherwise the chunks that
+ * have been packed are written and only waits for the first queued chunk if
+ * the queue is full
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_pack_pool_write_chunks(
+         libewf_pack_pool_t *pack_pool,
+         libewf_io_handle_t *io_handle,
+         libewf_write_io_handle_t *write_io_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_media_values_t *media_values,
+         libewf_segment_table_t *segment_table,
+         libfvalue_table_t *header_values,
+         libfvalue_table_t *hash_values,
+         libewf_hash_sections_t *hash_sections,
+         libcdata_array_t *sessions,
+         libcdata_array_t *tracks,
+         libcdata_range_list_t *acquiry_errors,
+         uint8_t write_all,
+         libcerror_error_t **error )
+{
+	libewf_pack_pool_request_t *request = NULL;
+	static char *function               = "libewf_pack_pool_write_chunks";
+	ssize_t total_write_count           = 0;
+	ssize_t write_count                 = 0;
+	int pack_result                     = 0;
+
+	if( pack_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pack pool.",
+		 function );
+
+		return( -1 );
+	}
+	while( 1 )
+	{
+		if( libcthreads_mutex_grab(
+		     pack_pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( pack_pool->number_of_queued_requests == 0 )
+		{
+			if( libcthreads_mutex_release(
+			     pack_pool->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release mutex.",
+				 function );
+
+				return( -1 );
+			}
+			break;
+		}
+		request = &( pack_pool->requests[ pack_pool->first_request_index ] );
+
+		while( ( request->pack_result == 0 )
+		    && ( ( write_all != 0 )
+		     ||  ( pack_pool->number_of_queued_requests >= pack_pool->number_of_requests ) ) )
+		{
+			if( libcthreads_condition_wait(
+			     pack_pool->condition,
+			     pack_pool->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 pack_pool->mutex,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+		pack_result = request->pack_result;
+
+		if( libcthreads_mutex_release(
+		     pack_pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( pack_result == 0 )
+		{
+			break;
+		}
+		else if( pack_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %" PRIu64 " data.",
+			 function,
+			 request->chunk_index );
+
+			return( -1 );
+		}
+		write_count = libewf_write_io_handle_write_new_chunk(
+		               write_io_handle,
+		               io_handle,
+		               file_io_pool,
+		               media_values,
+		               segment_table,
+		               header_values,
+		               hash_values,
+		               hash_sections,
+		               sessions,
+		               tracks,
+		               acquiry_errors,
+		               request->chunk_index,
+		               request->chunk_data,
+		               request->input_data_size,
+		               error );
+
+		if( write_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk: %" PRIu64 ".",
+			 function,
+			 request->chunk_index );
+
+			return( -1 );
+		}
+		total_write_count += write_count;
+
+		if( libewf_chunk_data_free(
+		     &( request->chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk: %" PRIu64 " data.",
+			 function,
+			 request->chunk_index );
+
+			return( -1 );
+		}
+		if( libcthreads_mutex_grab(
+		     pack_pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		pack_pool->first_request_index = ( pack_pool->first_request_index + 1 ) % pack_pool->number_of_requests;
+
+		pack_pool->number_of_queued_requests -= 1;
+
+		if( libcthreads_mutex_release(
+		     pack_pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( total_write_count );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
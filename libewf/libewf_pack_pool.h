@@ -0,0 +1,170 @@
+/*
+ * Pack pool functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_PACK_POOL_H )
+#define _LIBEWF_PACK_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_hash_sections.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfvalue.h"
+#include "libewf_media_values.h"
+#include "libewf_segment_table.h"
+#include "libewf_write_io_handle.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_pack_pool_request libewf_pack_pool_request_t;
+
+struct libewf_pack_pool_request
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The size of the chunk data before it was packed
+	 */
+	size_t input_data_size;
+
+	/* The pack result
+	 * Contains 0 while the chunk is being packed, 1 if the chunk was packed
+	 * or -1 if the chunk could not be packed
+	 */
+	int pack_result;
+};
+
+typedef struct libewf_pack_pool libewf_pack_pool_t;
+
+/* The pack pool packs the chunks of consecutive writes in parallel
+ * and writes the packed chunks in order
+ */
+struct libewf_pack_pool
+{
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The requests
+	 * The requests are used as a ring buffer of queued chunks
+	 */
+	libewf_pack_pool_request_t *requests;
+
+	/* The number of requests
+	 */
+	int number_of_requests;
+
+	/* The index of the first queued request
+	 */
+	int first_request_index;
+
+	/* The number of queued requests
+	 * Protected by the mutex
+	 */
+	int number_of_queued_requests;
+
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The write IO handle
+	 */
+	libewf_write_io_handle_t *write_io_handle;
+
+	/* The thread pool
+	 * Contains NULL until the first chunk is queued
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex protecting the pack result of the requests and the number of queued requests
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition signalled when a request completes
+	 */
+	libcthreads_condition_t *condition;
+};
+
+int libewf_pack_pool_initialize(
+     libewf_pack_pool_t **pack_pool,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_pack_pool_free(
+     libewf_pack_pool_t **pack_pool,
+     libcerror_error_t **error );
+
+int libewf_pack_pool_process_request(
+     libewf_pack_pool_request_t *request,
+     libewf_pack_pool_t *pack_pool );
+
+int libewf_pack_pool_get_number_of_queued_requests(
+     libewf_pack_pool_t *pack_pool,
+     int *number_of_queued_requests,
+     libcerror_error_t **error );
+
+int libewf_pack_pool_queue_chunk(
+     libewf_pack_pool_t *pack_pool,
+     libewf_io_handle_t *io_handle,
+     libewf_write_io_handle_t *write_io_handle,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t input_data_size,
+     libcerror_error_t **error );
+
+ssize_t libewf_pack_pool_write_chunks(
+         libewf_pack_pool_t *pack_pool,
+         libewf_io_handle_t *io_handle,
+         libewf_write_io_handle_t *write_io_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_media_values_t *media_values,
+         libewf_segment_table_t *segment_table,
+         libfvalue_table_t *header_values,
+         libfvalue_table_t *hash_values,
+         libewf_hash_sections_t *hash_sections,
+         libcdata_array_t *sessions,
+         libcdata_array_t *tracks,
+         libcdata_range_list_t *acquiry_errors,
+         uint8_t write_all,
+         libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_PACK_POOL_H ) */
+
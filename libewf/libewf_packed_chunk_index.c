@@ -0,0 +1,821 @@
+/*
+ * Packed chunk index functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_packed_chunk_index.h"
+
+#include "ewf_table.h"
+
+/* The range flags in order of their packed bit
+ */
+static const uint32_t libewf_packed_chunk_index_range_flags[ 8 ] = {
+	LIBEWF_RANGE_FLAG_IS_SPARSE,
+	LIBEWF_RANGE_FLAG_IS_COMPRESSED,
+	LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+	LIBEWF_RANGE_FLAG_USES_PATTERN_FILL,
+	LIBEWF_RANGE_FLAG_IS_PACKED,
+	LIBEWF_RANGE_FLAG_IS_TAINTED,
+	LIBEWF_RANGE_FLAG_IS_CORRUPTED,
+	LIBEWF_RANGE_FLAG_IS_ENCRYPTED };
+
+/* Creates a packed chunk index
+ * Make sure the value packed_chunk_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_packed_chunk_index_initialize(
+     libewf_packed_chunk_index_t **packed_chunk_index,
+     size32_t chunk_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_packed_chunk_index_initialize";
+
+	if( packed_chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *packed_chunk_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid packed chunk index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid chunk size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*packed_chunk_index = memory_allocate_structure(
+	                       libewf_packed_chunk_index_t );
+
+	if( *packed_chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create packed chunk index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *packed_chunk_index,
+	     0,
+	     sizeof( libewf_packed_chunk_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear packed chunk index.",
+		 function );
+
+		goto on_error;
+	}
+	( *packed_chunk_index )->chunk_size = chunk_size;
+
+	return( 1 );
+
+on_error:
+	if( *packed_chunk_index != NULL )
+	{
+		memory_free(
+		 *packed_chunk_index );
+
+		*packed_chunk_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a packed chunk index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_packed_chunk_index_free(
+     libewf_packed_chunk_index_t **packed_chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_packed_chunk_index_free";
+
+	if( packed_chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *packed_chunk_index != NULL )
+	{
+		if( ( *packed_chunk_index )->entries != NULL )
+		{
+			memory_free(
+			 ( *packed_chunk_index )->entries );
+		}
+		memory_free(
+		 *packed_chunk_index );
+
+		*packed_chunk_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Empties a packed chunk index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_packed_chunk_index_empty(
+     libewf_packed_chunk_index_t *packed_chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_packed_chunk_index_empty";
+
+	if( packed_chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	packed_chunk_index->file_io_pool_entry          = 0;
+	packed_chunk_index->base_offset                 = 0;
+	packed_chunk_index->table_entries_offset        = 0;
+	packed_chunk_index->base_offset_is_set          = 0;
+	packed_chunk_index->table_entries_offset_is_set = 0;
+	packed_chunk_index->number_of_entries           = 0;
+
+	return( 1 );
+}
+
+/* Makes sure the packed chunk index has room for a number of additional entries
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_packed_chunk_index_reserve(
+     libewf_packed_chunk_index_t *packed_chunk_index,
+     int number_of_entries,
+     libcerror_error_t **error )
+{
+	void *reallocation              = NULL;
+	static char *function           = "libewf_packed_chunk_index_reserve";
+	int number_of_allocated_entries = 0;
+
+	if( packed_chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_entries < 0 )
+	 || ( number_of_entries > ( INT_MAX - packed_chunk_index->number_of_entries ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_allocated_entries = packed_chunk_index->number_of_entries + number_of_entries;
+
+	if( number_of_allocated_entries <= packed_chunk_index->number_of_allocated_entries )
+	{
+		return( 1 );
+	}
+	if( (size_t) number_of_allocated_entries > ( (size_t) SSIZE_MAX / sizeof( libewf_packed_chunk_index_entry_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of allocated entries value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	reallocation = memory_reallocate(
+	                packed_chunk_index->entries,
+	                sizeof( libewf_packed_chunk_index_entry_t ) * number_of_allocated_entries );
+
+	if( reallocation == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize entries.",
+		 function );
+
+		return( -1 );
+	}
+	packed_chunk_index->entries                     = (libewf_packed_chunk_index_entry_t *) reallocation;
+	packed_chunk_index->number_of_allocated_entries = number_of_allocated_entries;
+
+	return( 1 );
+}
+
+/* Retrieves the number of entries
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_packed_chunk_index_get_number_of_entries(
+     libewf_packed_chunk_index_t *packed_chunk_index,
+     int *number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_packed_chunk_index_get_number_of_entries";
+
+	if( packed_chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_entries = packed_chunk_index->number_of_entries;
+
+	return( 1 );
+}
+
+/* Packs the values of a specific entry
+ * The base and table entries offsets are set if the values can be packed and
+ * the offsets were not set before
+ * Returns 1 if successful, 0 if the values cannot be packed or -1 on error
+ */
+int libewf_packed_chunk_index_pack_entry(
+     libewf_packed_chunk_index_t *packed_chunk_index,
+     int entry_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     libewf_packed_chunk_index_entry_t *entry,
+     libcerror_error_t **error )
+{
+	static char *function        = "libewf_packed_chunk_index_pack_entry";
+	off64_t table_entries_offset = 0;
+	uint64_t relative_offset     = 0;
+	uint32_t packed_flags        = 0;
+	uint32_t unpacked_flags      = 0;
+	uint8_t flag_index           = 0;
+
+	if( packed_chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( packed_chunk_index->number_of_entries > 0 )
+	 && ( file_io_pool_entry != packed_chunk_index->file_io_pool_entry ) )
+	{
+		return( 0 );
+	}
+	if( ( chunk_data_offset < 0 )
+	 || ( chunk_data_size > (size64_t) LIBEWF_PACKED_CHUNK_INDEX_MAXIMUM_CHUNK_DATA_SIZE ) )
+	{
+		return( 0 );
+	}
+	unpacked_flags = range_flags;
+
+	for( flag_index = 0;
+	     flag_index < 8;
+	     flag_index++ )
+	{
+		if( ( range_flags & libewf_packed_chunk_index_range_flags[ flag_index ] ) != 0 )
+		{
+			packed_flags   |= (uint32_t) 1 << flag_index;
+			unpacked_flags &= ~( libewf_packed_chunk_index_range_flags[ flag_index ] );
+		}
+	}
+	if( unpacked_flags != 0 )
+	{
+		return( 0 );
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
+	{
+		/* The chunk data offset of a chunk that uses pattern fill
+		 * is the offset of its table entry and is not stored
+		 */
+		table_entries_offset = chunk_data_offset - ( (off64_t) entry_index * sizeof( ewf_table_entry_v2_t ) );
+
+		if( table_entries_offset < 0 )
+		{
+			return( 0 );
+		}
+		if( ( packed_chunk_index->table_entries_offset_is_set != 0 )
+		 && ( table_entries_offset != packed_chunk_index->table_entries_offset ) )
+		{
+			return( 0 );
+		}
+		packed_chunk_index->table_entries_offset        = table_entries_offset;
+		packed_chunk_index->table_entries_offset_is_set = 1;
+	}
+	else
+	{
+		if( packed_chunk_index->base_offset_is_set != 0 )
+		{
+			if( chunk_data_offset < packed_chunk_index->base_offset )
+			{
+				return( 0 );
+			}
+			relative_offset = (uint64_t) ( chunk_data_offset - packed_chunk_index->base_offset );
+
+			if( relative_offset > (uint64_t) UINT32_MAX )
+			{
+				return( 0 );
+			}
+		}
+		else
+		{
+			packed_chunk_index->base_offset        = chunk_data_offset;
+			packed_chunk_index->base_offset_is_set = 1;
+		}
+	}
+	packed_chunk_index->file_io_pool_entry = file_io_pool_entry;
+
+	entry->relative_offset = (uint32_t) relative_offset;
+	entry->packed_size     = ( (uint32_t) chunk_data_size << 8 ) | packed_flags;
+
+	return( 1 );
+}
+
+/* Retrieves a specific entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_packed_chunk_index_get_entry_by_index(
+     libewf_packed_chunk_index_t *packed_chunk_index,
+     int entry_index,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	libewf_packed_chunk_index_entry_t *entry = NULL;
+	static char *function                    = "libewf_packed_chunk_index_get_entry_by_index";
+	uint32_t unpacked_flags                  = 0;
+	uint8_t flag_index                       = 0;
+
+	if( packed_chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= packed_chunk_index->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+	entry = &( packed_chunk_index->entries[ entry_index ] );
+
+	for( flag_index = 0;
+	     flag_index < 8;
+	     flag_index++ )
+	{
+		if( ( entry->packed_size & ( (uint32_t) 1 << flag_index ) ) != 0 )
+		{
+			unpacked_flags |= libewf_packed_chunk_index_range_flags[ flag_index ];
+		}
+	}
+	if( ( unpacked_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
+	{
+		*chunk_data_offset = packed_chunk_index->table_entries_offset
+		                   + ( (off64_t) entry_index * sizeof( ewf_table_entry_v2_t ) );
+	}
+	else
+	{
+		*chunk_data_offset = packed_chunk_index->base_offset + entry->relative_offset;
+	}
+	*file_io_pool_entry = packed_chunk_index->file_io_pool_entry;
+	*chunk_data_size    = (size64_t) ( entry->packed_size >> 8 );
+	*range_flags        = unpacked_flags;
+
+	return( 1 );
+}
+
+/* Sets a specific entry
+ * Returns 1 if successful, 0 if the values cannot be packed or -1 on error
+ */
+int libewf_packed_chunk_index_set_entry_by_index(
+     libewf_packed_chunk_index_t *packed_chunk_index,
+     int entry_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error )
+{
+	libewf_packed_chunk_index_entry_t entry;
+
+	static char *function = "libewf_packed_chunk_index_set_entry_by_index";
+	int result            = 0;
+
+	if( packed_chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= packed_chunk_index->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_packed_chunk_index_pack_entry(
+	          packed_chunk_index,
+	          entry_index,
+	          file_io_pool_entry,
+	          chunk_data_offset,
+	          chunk_data_size,
+	          range_flags,
+	          &entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to pack entry: %d.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		packed_chunk_index->entries[ entry_index ] = entry;
+	}
+	return( result );
+}
+
+/* Appends an entry
+ * The chunk is mapped to the next chunk size in the index, hence the mapped size must match the chunk size
+ * Returns 1 if successful, 0 if the values cannot be packed or -1 on error
+ */
+int libewf_packed_chunk_index_append_entry(
+     libewf_packed_chunk_index_t *packed_chunk_index,
+     int *entry_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     size32_t mapped_size,
+     libcerror_error_t **error )
+{
+	libewf_packed_chunk_index_entry_t entry;
+
+	static char *function = "libewf_packed_chunk_index_append_entry";
+	int number_of_entries = 0;
+	int result            = 0;
+
+	if( packed_chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	if( mapped_size != packed_chunk_index->chunk_size )
+	{
+		return( 0 );
+	}
+	if( packed_chunk_index->number_of_entries == INT_MAX )
+	{
+		return( 0 );
+	}
+	result = libewf_packed_chunk_index_pack_entry(
+	          packed_chunk_index,
+	          packed_chunk_index->number_of_entries,
+	          file_io_pool_entry,
+	          chunk_data_offset,
+	          chunk_data_size,
+	          range_flags,
+	          &entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to pack entry: %d.",
+		 function,
+		 packed_chunk_index->number_of_entries );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( packed_chunk_index->number_of_entries >= packed_chunk_index->number_of_allocated_entries )
+	{
+		/* Grow the allocation by half its size to limit the number of reallocations
+		 */
+		number_of_entries = packed_chunk_index->number_of_allocated_entries / 2;
+
+		if( number_of_entries < 64 )
+		{
+			number_of_entries = 64;
+		}
+		else if( number_of_entries > ( INT_MAX - packed_chunk_index->number_of_entries ) )
+		{
+			number_of_entries = INT_MAX - packed_chunk_index->number_of_entries;
+		}
+		if( libewf_packed_chunk_index_reserve(
+		     packed_chunk_index,
+		     number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize entries.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*entry_index = packed_chunk_index->number_of_entries;
+
+	packed_chunk_index->entries[ *entry_index ] = entry;
+
+	packed_chunk_index->number_of_entries += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the entry that contains a specific offset
+ * The offset is relative to the start of the chunks in the index
+ * Returns 1 if successful, 0 if no entry contains the offset or -1 on error
+ */
+int libewf_packed_chunk_index_get_entry_at_offset(
+     libewf_packed_chunk_index_t *packed_chunk_index,
+     off64_t offset,
+     int *entry_index,
+     off64_t *entry_data_offset,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_packed_chunk_index_get_entry_at_offset";
+	uint64_t safe_index   = 0;
+
+	if( packed_chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry data offset.",
+		 function );
+
+		return( -1 );
+	}
+	safe_index = (uint64_t) offset / packed_chunk_index->chunk_size;
+
+	if( safe_index >= (uint64_t) packed_chunk_index->number_of_entries )
+	{
+		return( 0 );
+	}
+	if( libewf_packed_chunk_index_get_entry_by_index(
+	     packed_chunk_index,
+	     (int) safe_index,
+	     file_io_pool_entry,
+	     chunk_data_offset,
+	     chunk_data_size,
+	     range_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry: %" PRIu64 ".",
+		 function,
+		 safe_index );
+
+		return( -1 );
+	}
+	*entry_index       = (int) safe_index;
+	*entry_data_offset = offset - ( (off64_t) safe_index * packed_chunk_index->chunk_size );
+
+	return( 1 );
+}
+
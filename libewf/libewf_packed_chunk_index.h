@@ -0,0 +1,177 @@
+/*
+ * Packed chunk index functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_PACKED_CHUNK_INDEX_H )
+#define _LIBEWF_PACKED_CHUNK_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum chunk data size that can be stored in a packed entry
+ */
+#define LIBEWF_PACKED_CHUNK_INDEX_MAXIMUM_CHUNK_DATA_SIZE	0x00ffffffUL
+
+typedef struct libewf_packed_chunk_index_entry libewf_packed_chunk_index_entry_t;
+
+struct libewf_packed_chunk_index_entry
+{
+	/* The chunk data offset relative to the base offset
+	 */
+	uint32_t relative_offset;
+
+	/* The chunk data size in the upper 24 bits
+	 * and the packed range flags in the lower 8 bits
+	 */
+	uint32_t packed_size;
+};
+
+typedef struct libewf_packed_chunk_index libewf_packed_chunk_index_t;
+
+/* The packed chunk index stores the chunks of a chunk group in a single array
+ * of 8 bytes per chunk instead of a list element per chunk
+ * Chunks are mapped with a fixed chunk size, hence the chunk that contains
+ * a specific offset is determined without a search
+ */
+struct libewf_packed_chunk_index
+{
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The base offset
+	 * Contains the offset of the chunk data of the first chunk that does not use pattern fill
+	 */
+	off64_t base_offset;
+
+	/* The table entries offset
+	 * A chunk that uses pattern fill refers to its (EWF version 2) table entry
+	 */
+	off64_t table_entries_offset;
+
+	/* Value to indicate the base offset is set
+	 */
+	uint8_t base_offset_is_set;
+
+	/* Value to indicate the table entries offset is set
+	 */
+	uint8_t table_entries_offset_is_set;
+
+	/* The entries
+	 */
+	libewf_packed_chunk_index_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The number of allocated entries
+	 */
+	int number_of_allocated_entries;
+};
+
+int libewf_packed_chunk_index_initialize(
+     libewf_packed_chunk_index_t **packed_chunk_index,
+     size32_t chunk_size,
+     libcerror_error_t **error );
+
+int libewf_packed_chunk_index_free(
+     libewf_packed_chunk_index_t **packed_chunk_index,
+     libcerror_error_t **error );
+
+int libewf_packed_chunk_index_empty(
+     libewf_packed_chunk_index_t *packed_chunk_index,
+     libcerror_error_t **error );
+
+int libewf_packed_chunk_index_reserve(
+     libewf_packed_chunk_index_t *packed_chunk_index,
+     int number_of_entries,
+     libcerror_error_t **error );
+
+int libewf_packed_chunk_index_get_number_of_entries(
+     libewf_packed_chunk_index_t *packed_chunk_index,
+     int *number_of_entries,
+     libcerror_error_t **error );
+
+int libewf_packed_chunk_index_pack_entry(
+     libewf_packed_chunk_index_t *packed_chunk_index,
+     int entry_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     libewf_packed_chunk_index_entry_t *entry,
+     libcerror_error_t **error );
+
+int libewf_packed_chunk_index_get_entry_by_index(
+     libewf_packed_chunk_index_t *packed_chunk_index,
+     int entry_index,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libewf_packed_chunk_index_set_entry_by_index(
+     libewf_packed_chunk_index_t *packed_chunk_index,
+     int entry_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error );
+
+int libewf_packed_chunk_index_append_entry(
+     libewf_packed_chunk_index_t *packed_chunk_index,
+     int *entry_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     size32_t mapped_size,
+     libcerror_error_t **error );
+
+int libewf_packed_chunk_index_get_entry_at_offset(
+     libewf_packed_chunk_index_t *packed_chunk_index,
+     off64_t offset,
+     int *entry_index,
+     off64_t *entry_data_offset,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_PACKED_CHUNK_INDEX_H ) */
+
@@ -0,0 +1,747 @@
+/*
+ * Read-ahead functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_table.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_read_ahead.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates a read-ahead
+ * Make sure the value read_ahead is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_initialize(
+     libewf_read_ahead_t **read_ahead,
+     int number_of_threads,
+     int number_of_chunks,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_initialize";
+	size_t requests_size  = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read-ahead value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_READ_AHEAD_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_chunks <= 0 )
+	 || ( number_of_chunks > LIBEWF_MAXIMUM_READ_AHEAD_NUMBER_OF_CHUNKS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*read_ahead = memory_allocate_structure(
+	               libewf_read_ahead_t );
+
+	if( *read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_ahead,
+	     0,
+	     sizeof( libewf_read_ahead_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read-ahead.",
+		 function );
+
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+
+		return( -1 );
+	}
+	requests_size = sizeof( libewf_read_ahead_request_t ) * number_of_chunks;
+
+	( *read_ahead )->requests = (libewf_read_ahead_request_t *) memory_allocate(
+	                                                             requests_size );
+
+	if( ( *read_ahead )->requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *read_ahead )->requests,
+	     0,
+	     requests_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *read_ahead )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *read_ahead )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	( *read_ahead )->number_of_threads = number_of_threads;
+	( *read_ahead )->number_of_chunks  = number_of_chunks;
+
+	return( 1 );
+
+on_error:
+	if( *read_ahead != NULL )
+	{
+		if( ( *read_ahead )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *read_ahead )->mutex ),
+			 NULL );
+		}
+		if( ( *read_ahead )->requests != NULL )
+		{
+			memory_free(
+			 ( *read_ahead )->requests );
+		}
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read-ahead
+ * Stops the read-ahead if it is running
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_free(
+     libewf_read_ahead_t **read_ahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_free";
+	int result            = 1;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead != NULL )
+	{
+		if( libewf_read_ahead_stop(
+		     *read_ahead,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop read-ahead.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_condition_free(
+		     &( ( *read_ahead )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *read_ahead )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *read_ahead )->requests );
+
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+	}
+	return( result );
+}
+
+/* Processes a read-ahead request
+ * Callback function for the read-ahead thread pool
+ * Errors are not propagated, the chunk is read again when it is accessed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_process_request(
+     libewf_read_ahead_request_t *request,
+     libewf_read_ahead_t *read_ahead )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_read_ahead_process_request";
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_chunk_table_prefetch_chunk_data(
+	     read_ahead->chunk_table,
+	     request->chunk_index,
+	     read_ahead->io_handle,
+	     read_ahead->file_io_pool,
+	     read_ahead->media_values,
+	     read_ahead->segment_table,
+	     read_ahead->chunk_groups_cache,
+	     &error ) == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to prefetch chunk: %" PRIu64 " data.",
+		 function,
+		 request->chunk_index );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( libcthreads_mutex_grab(
+	     read_ahead->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	request->is_pending = 0;
+
+	read_ahead->number_of_pending_requests -= 1;
+
+	if( libcthreads_condition_broadcast(
+	     read_ahead->condition,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		libcthreads_mutex_release(
+		 read_ahead->mutex,
+		 NULL );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     read_ahead->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+/* Stops the read-ahead
+ * Waits for the pending requests to complete and resets the sequential access detection
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_stop(
+     libewf_read_ahead_t *read_ahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_stop";
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead->thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( read_ahead->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	read_ahead->number_of_sequential_reads = 0;
+	read_ahead->next_chunk_index           = 0;
+
+	return( 1 );
+}
+
+/* Updates the read-ahead with the chunk that is being read
+ * Schedules the next chunks to be prefetched when the chunks are read sequentially
+ * Returns 1 if chunks were scheduled, 0 if not or -1 on error
+ */
+int libewf_read_ahead_update(
+     libewf_read_ahead_t *read_ahead,
+     uint64_t chunk_index,
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     libcerror_error_t **error )
+{
+	libewf_read_ahead_request_t *request = NULL;
+	static char *function                = "libewf_read_ahead_update";
+	uint64_t last_chunk_index            = 0;
+	int request_index                    = 0;
+	int result                           = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_ahead->number_of_sequential_reads > 0 )
+	 && ( chunk_index == read_ahead->last_chunk_index ) )
+	{
+		/* A partial chunk read does not change the access pattern
+		 */
+	}
+	else if( ( read_ahead->number_of_sequential_reads > 0 )
+	      && ( chunk_index == ( read_ahead->last_chunk_index + 1 ) ) )
+	{
+		read_ahead->number_of_sequential_reads += 1;
+	}
+	else
+	{
+		read_ahead->number_of_sequential_reads = 1;
+		read_ahead->next_chunk_index           = chunk_index + 1;
+	}
+	read_ahead->last_chunk_index = chunk_index;
+
+	if( read_ahead->number_of_sequential_reads < LIBEWF_READ_AHEAD_MINIMUM_NUMBER_OF_SEQUENTIAL_READS )
+	{
+		return( 0 );
+	}
+	if( read_ahead->next_chunk_index <= chunk_index )
+	{
+		read_ahead->next_chunk_index = chunk_index + 1;
+	}
+	if( read_ahead->next_chunk_index >= media_values->number_of_chunks )
+	{
+		return( 0 );
+	}
+	last_chunk_index = chunk_index + read_ahead->number_of_chunks;
+
+	if( last_chunk_index >= media_values->number_of_chunks )
+	{
+		last_chunk_index = media_values->number_of_chunks - 1;
+	}
+	if( read_ahead->thread_pool == NULL )
+	{
+		read_ahead->chunk_table        = chunk_table;
+		read_ahead->io_handle          = io_handle;
+		read_ahead->file_io_pool       = file_io_pool;
+		read_ahead->media_values       = media_values;
+		read_ahead->segment_table      = segment_table;
+		read_ahead->chunk_groups_cache = chunk_groups_cache;
+
+		if( libcthreads_thread_pool_create(
+		     &( read_ahead->thread_pool ),
+		     NULL,
+		     read_ahead->number_of_threads,
+		     read_ahead->number_of_chunks,
+		     (int (*)(intptr_t *, void *)) &libewf_read_ahead_process_request,
+		     (void *) read_ahead,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	while( read_ahead->next_chunk_index <= last_chunk_index )
+	{
+		if( libcthreads_mutex_grab(
+		     read_ahead->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		request = NULL;
+
+		if( read_ahead->number_of_pending_requests < read_ahead->number_of_chunks )
+		{
+			for( request_index = 0;
+			     request_index < read_ahead->number_of_chunks;
+			     request_index++ )
+			{
+				if( read_ahead->requests[ request_index ].is_pending == 0 )
+				{
+					request = &( read_ahead->requests[ request_index ] );
+
+					request->chunk_index = read_ahead->next_chunk_index;
+					request->is_pending  = 1;
+
+					read_ahead->number_of_pending_requests += 1;
+
+					break;
+				}
+			}
+		}
+		if( libcthreads_mutex_release(
+		     read_ahead->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+		/* All requests are pending, the remaining chunks are scheduled on a next update
+		 */
+		if( request == NULL )
+		{
+			break;
+		}
+		if( libcthreads_thread_pool_push(
+		     read_ahead->thread_pool,
+		     (intptr_t *) request,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push request onto thread pool queue.",
+			 function );
+
+			if( libcthreads_mutex_grab(
+			     read_ahead->mutex,
+			     NULL ) == 1 )
+			{
+				request->is_pending = 0;
+
+				read_ahead->number_of_pending_requests -= 1;
+
+				libcthreads_mutex_release(
+				 read_ahead->mutex,
+				 NULL );
+			}
+			return( -1 );
+		}
+		read_ahead->next_chunk_index += 1;
+
+		result = 1;
+	}
+	return( result );
+}
+
+/* Waits for a pending request of a specific chunk to complete
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_wait_for_chunk(
+     libewf_read_ahead_t *read_ahead,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_wait_for_chunk";
+	int is_pending        = 0;
+	int request_index     = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead->thread_pool == NULL )
+	{
+		return( 1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		is_pending = 0;
+
+		if( read_ahead->number_of_pending_requests > 0 )
+		{
+			for( request_index = 0;
+			     request_index < read_ahead->number_of_chunks;
+			     request_index++ )
+			{
+				if( ( read_ahead->requests[ request_index ].is_pending != 0 )
+				 && ( read_ahead->requests[ request_index ].chunk_index == chunk_index ) )
+				{
+					is_pending = 1;
+
+					break;
+				}
+			}
+		}
+		if( is_pending != 0 )
+		{
+			if( libcthreads_condition_wait(
+			     read_ahead->condition,
+			     read_ahead->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 read_ahead->mutex,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+	}
+	while( is_pending != 0 );
+
+	if( libcthreads_mutex_release(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,171 @@
+/*
+ * Read-ahead functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_READ_AHEAD_H )
+#define _LIBEWF_READ_AHEAD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_table.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfcache.h"
+#include "libewf_media_values.h"
+#include "libewf_segment_table.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_read_ahead_request libewf_read_ahead_request_t;
+
+struct libewf_read_ahead_request
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* Value to indicate the request is pending
+	 */
+	uint8_t is_pending;
+};
+
+typedef struct libewf_read_ahead libewf_read_ahead_t;
+
+/* The read-ahead detects sequential chunk access and prefetches
+ * and decompresses the next chunks into the chunk cache using a thread pool
+ */
+struct libewf_read_ahead
+{
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The number of chunks to read ahead
+	 */
+	int number_of_chunks;
+
+	/* The requests
+	 * Contains a request per chunk that can be read ahead
+	 */
+	libewf_read_ahead_request_t *requests;
+
+	/* The number of pending requests
+	 */
+	int number_of_pending_requests;
+
+	/* The last chunk index read
+	 */
+	uint64_t last_chunk_index;
+
+	/* The next chunk index to read ahead
+	 */
+	uint64_t next_chunk_index;
+
+	/* The number of consecutive sequential reads
+	 */
+	int number_of_sequential_reads;
+
+	/* The chunk table
+	 */
+	libewf_chunk_table_t *chunk_table;
+
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The file IO pool
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The media values
+	 */
+	libewf_media_values_t *media_values;
+
+	/* The segment table
+	 */
+	libewf_segment_table_t *segment_table;
+
+	/* The chunk groups cache
+	 */
+	libfcache_cache_t *chunk_groups_cache;
+
+	/* The thread pool
+	 * Contains NULL if the read-ahead is stopped
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex protecting the requests
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition signalled when a request completes
+	 */
+	libcthreads_condition_t *condition;
+};
+
+int libewf_read_ahead_initialize(
+     libewf_read_ahead_t **read_ahead,
+     int number_of_threads,
+     int number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_free(
+     libewf_read_ahead_t **read_ahead,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_process_request(
+     libewf_read_ahead_request_t *request,
+     libewf_read_ahead_t *read_ahead );
+
+int libewf_read_ahead_stop(
+     libewf_read_ahead_t *read_ahead,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_update(
+     libewf_read_ahead_t *read_ahead,
+     uint64_t chunk_index,
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_wait_for_chunk(
+     libewf_read_ahead_t *read_ahead,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_READ_AHEAD_H ) */
+
@@ -0,0 +1,367 @@
+/*
+ * Reorder buffer functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_reorder_buffer.h"
+
+/* Creates a reorder buffer
+ * Make sure the value reorder_buffer is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_reorder_buffer_initialize(
+     libewf_reorder_buffer_t **reorder_buffer,
+     int maximum_number_of_chunks,
+     size64_t maximum_memory_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_reorder_buffer_initialize";
+	size_t entries_size   = 0;
+
+	if( reorder_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reorder_buffer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid reorder buffer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_chunks <= 0 )
+	 || ( maximum_number_of_chunks > LIBEWF_MAXIMUM_REORDER_BUFFER_NUMBER_OF_CHUNKS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*reorder_buffer = memory_allocate_structure(
+	                   libewf_reorder_buffer_t );
+
+	if( *reorder_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reorder buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *reorder_buffer,
+	     0,
+	     sizeof( libewf_reorder_buffer_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear reorder buffer.",
+		 function );
+
+		memory_free(
+		 *reorder_buffer );
+
+		*reorder_buffer = NULL;
+
+		return( -1 );
+	}
+	entries_size = sizeof( libewf_reorder_buffer_entry_t ) * maximum_number_of_chunks;
+
+	( *reorder_buffer )->entries = (libewf_reorder_buffer_entry_t *) memory_allocate(
+	                                                                  entries_size );
+
+	if( ( *reorder_buffer )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *reorder_buffer )->entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	( *reorder_buffer )->maximum_number_of_chunks = maximum_number_of_chunks;
+	( *reorder_buffer )->maximum_memory_size      = maximum_memory_size;
+
+	return( 1 );
+
+on_error:
+	if( *reorder_buffer != NULL )
+	{
+		if( ( *reorder_buffer )->entries != NULL )
+		{
+			memory_free(
+			 ( *reorder_buffer )->entries );
+		}
+		memory_free(
+		 *reorder_buffer );
+
+		*reorder_buffer = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a reorder buffer
+ * The chunk data of the chunks in the reorder buffer is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_reorder_buffer_free(
+     libewf_reorder_buffer_t **reorder_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_reorder_buffer_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( reorder_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reorder_buffer != NULL )
+	{
+		for( entry_index = 0;
+		     entry_index < ( *reorder_buffer )->maximum_number_of_chunks;
+		     entry_index++ )
+		{
+			if( ( *reorder_buffer )->entries[ entry_index ].chunk_data != NULL )
+			{
+				if( libewf_chunk_data_free(
+				     &( ( *reorder_buffer )->entries[ entry_index ].chunk_data ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free chunk: %" PRIu64 " data.",
+					 function,
+					 ( *reorder_buffer )->entries[ entry_index ].chunk_index );
+
+					result = -1;
+				}
+			}
+		}
+		memory_free(
+		 ( *reorder_buffer )->entries );
+
+		memory_free(
+		 *reorder_buffer );
+
+		*reorder_buffer = NULL;
+	}
+	return( result );
+}
+
+/* Inserts a chunk into the reorder buffer
+ * The reorder buffer takes over the chunk data if successful
+ * The chunk must lie within the maximum number of chunks after the next chunk
+ * to be written, the first chunk is always accepted regardless of the maximum memory size
+ * Returns 1 if successful, 0 if the chunk does not fit in the reorder buffer or -1 on error
+ */
+int libewf_reorder_buffer_insert_chunk(
+     libewf_reorder_buffer_t *reorder_buffer,
+     uint64_t next_chunk_index,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libewf_reorder_buffer_entry_t *entry = NULL;
+	static char *function                = "libewf_reorder_buffer_insert_chunk";
+
+	if( reorder_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index < next_chunk_index )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_index - next_chunk_index ) >= (uint64_t) reorder_buffer->maximum_number_of_chunks )
+	{
+		return( 0 );
+	}
+	if( ( reorder_buffer->number_of_chunks > 0 )
+	 && ( ( reorder_buffer->memory_size + chunk_data->allocated_data_size ) > reorder_buffer->maximum_memory_size ) )
+	{
+		return( 0 );
+	}
+	entry = &( reorder_buffer->entries[ chunk_index % reorder_buffer->maximum_number_of_chunks ] );
+
+	if( entry->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: chunk: %" PRIu64 " already set.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	entry->chunk_index = chunk_index;
+	entry->chunk_data  = chunk_data;
+	entry->data_size   = data_size;
+
+	reorder_buffer->number_of_chunks += 1;
+	reorder_buffer->memory_size      += chunk_data->allocated_data_size;
+
+	return( 1 );
+}
+
+/* Removes a specific chunk from the reorder buffer
+ * The caller takes over the chunk data if successful
+ * Returns 1 if successful, 0 if the chunk is not in the reorder buffer or -1 on error
+ */
+int libewf_reorder_buffer_remove_chunk(
+     libewf_reorder_buffer_t *reorder_buffer,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	libewf_reorder_buffer_entry_t *entry = NULL;
+	static char *function                = "libewf_reorder_buffer_remove_chunk";
+
+	if( reorder_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	entry = &( reorder_buffer->entries[ chunk_index % reorder_buffer->maximum_number_of_chunks ] );
+
+	if( ( entry->chunk_data == NULL )
+	 || ( entry->chunk_index != chunk_index ) )
+	{
+		return( 0 );
+	}
+	*chunk_data = entry->chunk_data;
+	*data_size  = entry->data_size;
+
+	reorder_buffer->number_of_chunks -= 1;
+	reorder_buffer->memory_size      -= entry->chunk_data->allocated_data_size;
+
+	entry->chunk_data = NULL;
+
+	return( 1 );
+}
+
@@ -0,0 +1,112 @@
+/*
+ * Reorder buffer functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_REORDER_BUFFER_H )
+#define _LIBEWF_REORDER_BUFFER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_reorder_buffer_entry libewf_reorder_buffer_entry_t;
+
+struct libewf_reorder_buffer_entry
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data
+	 * Contains NULL if the entry is not used
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The size of the chunk data before it was packed
+	 */
+	size_t data_size;
+};
+
+typedef struct libewf_reorder_buffer libewf_reorder_buffer_t;
+
+/* The reorder buffer holds the chunks that were written ahead of
+ * the next chunk to be written to the segment files
+ */
+struct libewf_reorder_buffer
+{
+	/* The entries
+	 * The entry of a chunk is determined by the chunk index modulo the maximum number of chunks
+	 */
+	libewf_reorder_buffer_entry_t *entries;
+
+	/* The maximum number of chunks
+	 */
+	int maximum_number_of_chunks;
+
+	/* The maximum memory size
+	 */
+	size64_t maximum_memory_size;
+
+	/* The number of chunks
+	 */
+	int number_of_chunks;
+
+	/* The memory size of the chunks
+	 */
+	size64_t memory_size;
+};
+
+int libewf_reorder_buffer_initialize(
+     libewf_reorder_buffer_t **reorder_buffer,
+     int maximum_number_of_chunks,
+     size64_t maximum_memory_size,
+     libcerror_error_t **error );
+
+int libewf_reorder_buffer_free(
+     libewf_reorder_buffer_t **reorder_buffer,
+     libcerror_error_t **error );
+
+int libewf_reorder_buffer_insert_chunk(
+     libewf_reorder_buffer_t *reorder_buffer,
+     uint64_t next_chunk_index,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libewf_reorder_buffer_remove_chunk(
+     libewf_reorder_buffer_t *reorder_buffer,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_REORDER_BUFFER_H ) */
+
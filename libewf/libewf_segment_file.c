@@ -19,12 +19,30 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#if defined( __linux__ ) && !defined( _GNU_SOURCE )
+/* fallocate is only defined by fcntl.h on Linux if _GNU_SOURCE is defined
+ */
+#define _GNU_SOURCE
+#endif
+
 #include <common.h>
 #include <byte_stream.h>
 #include <memory.h>
 #include <system_string.h>
 #include <types.h>
 
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
 #if defined( TIME_WITH_SYS_TIME )
 #include <sys/time.h>
 #include <time.h>
@@ -43,6 +61,7 @@
 #include "libewf_error2_section.h"
 #include "libewf_hash_values.h"
 #include "libewf_header_values.h"
+#include "libewf_index_file.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
@@ -67,6 +86,12 @@
 #include "ewf_section.h"
 #include "ewf_volume.h"
 
+/* Preallocation requires fallocate with support to keep the file size unchanged
+ */
+#if defined( HAVE_FCNTL_H ) && defined( HAVE_UNISTD_H ) && defined( HAVE_FALLOCATE ) && defined( HAVE_FTRUNCATE ) && defined( FALLOC_FL_KEEP_SIZE ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#define HAVE_LIBEWF_SEGMENT_FILE_PREALLOCATE
+#endif
+
 const uint8_t ewf1_dvf_file_signature[ 8 ] = { 0x64, 0x76, 0x66, 0x09, 0x0d, 0x0a, 0xff, 0x00 };
 const uint8_t ewf1_evf_file_signature[ 8 ] = { 0x45, 0x56, 0x46, 0x09, 0x0d, 0x0a, 0xff, 0x00 };
 const uint8_t ewf1_lvf_file_signature[ 8 ] = { 0x4c, 0x56, 0x46, 0x09, 0x0d, 0x0a, 0xff, 0x00 };
@@ -271,6 +296,36 @@ int libewf_segment_file_free(
 
 			result = -1;
 		}
+		/* The preallocated space has not been released when the segment file
+		 * was not closed for writing, e.g. when writing failed or was aborted.
+		 * Truncating the file to its end of file releases the unused preallocated
+		 * space without changing the data that was written.
+		 */
+		if( ( *segment_file )->preallocated_filename != NULL )
+		{
+			if( libewf_segment_file_truncate_preallocated(
+			     ( *segment_file )->preallocated_filename,
+			     -1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to truncate segment file: %" PRIu32 ".",
+				 function,
+				 ( *segment_file )->segment_number );
+
+				result = -1;
+			}
+			memory_free(
+			 ( *segment_file )->preallocated_filename );
+		}
+		if( ( *segment_file )->write_buffer != NULL )
+		{
+			memory_free(
+			 ( *segment_file )->write_buffer );
+		}
 		memory_free(
 		 *segment_file );
 
@@ -358,9 +413,13 @@ int libewf_segment_file_clone(
 
 		return( -1 );
 	}
-	( *destination_segment_file )->sections_list      = NULL;
-	( *destination_segment_file )->chunk_groups_list  = NULL;
-	( *destination_segment_file )->chunk_groups_index = 0;
+	( *destination_segment_file )->sections_list                = NULL;
+	( *destination_segment_file )->chunk_groups_list            = NULL;
+	( *destination_segment_file )->chunk_groups_index           = 0;
+	( *destination_segment_file )->write_buffer                 = NULL;
+	( *destination_segment_file )->write_buffer_size            = 0;
+	( *destination_segment_file )->write_buffer_data_size       = 0;
+	( *destination_segment_file )->preallocated_filename        = NULL;
 
 	if( libfdata_list_initialize(
 	     &( ( *destination_segment_file )->sections_list ),
@@ -3635,6 +3694,24 @@ ssize_t libewf_segment_file_write_chunks_section_end(
 			return( -1 );
 		}
 	}
+	/* Write the chunk data that remains in the write buffer
+	 */
+	if( libewf_segment_file_flush_write_buffer(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     1,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush write buffer.",
+		 function );
+
+		goto on_error;
+	}
 	if( libewf_section_descriptor_initialize(
 	     &section_descriptor,
 	     error ) != 1 )
@@ -4235,12 +4312,85 @@ ssize_t libewf_segment_file_write_chunk_data(
 		 "\n" );
 	}
 #endif
-	write_count = libewf_chunk_data_write(
-	               chunk_data,
-	               file_io_pool,
-	               file_io_pool_entry,
-	               error );
+	/* The chunks are gathered in the write buffer and written in large batches
+	 */
+	if( segment_file->write_buffer == NULL )
+	{
+		segment_file->write_buffer = (uint8_t *) memory_allocate(
+		                                          sizeof( uint8_t ) * LIBEWF_SEGMENT_FILE_WRITE_BUFFER_SIZE );
+
+		if( segment_file->write_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create write buffer.",
+			 function );
+
+			return( -1 );
+		}
+		segment_file->write_buffer_size      = LIBEWF_SEGMENT_FILE_WRITE_BUFFER_SIZE;
+		segment_file->write_buffer_data_size = 0;
+	}
+	if( (size_t) chunk_write_size > ( segment_file->write_buffer_size - segment_file->write_buffer_data_size ) )
+	{
+		if( libewf_segment_file_flush_write_buffer(
+		     segment_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     0,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush write buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( (size_t) chunk_write_size <= ( segment_file->write_buffer_size - segment_file->write_buffer_data_size ) )
+	{
+		write_count = libewf_chunk_data_write_to_buffer(
+		               chunk_data,
+		               &( segment_file->write_buffer[ segment_file->write_buffer_data_size ] ),
+		               segment_file->write_buffer_size - segment_file->write_buffer_data_size,
+		               error );
+
+		if( write_count > 0 )
+		{
+			segment_file->write_buffer_data_size += (size_t) write_count;
+		}
+	}
+	else
+	{
+		/* Chunks that do not fit in the write buffer are written directly
+		 */
+		if( libewf_segment_file_flush_write_buffer(
+		     segment_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     1,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush write buffer.",
+			 function );
 
+			return( -1 );
+		}
+		write_count = libewf_chunk_data_write(
+		               chunk_data,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               error );
+	}
 	if( write_count != (ssize_t) chunk_write_size )
 	{
 		libcerror_error_set(
@@ -4257,180 +4407,972 @@ ssize_t libewf_segment_file_write_chunk_data(
 	return( write_count );
 }
 
-/* Writes the hash sections to file
- * Returns the number of bytes written or -1 on error
+/* Truncates a preallocated file
+ * The file is opened only for the duration of the truncate, so that no
+ * file descriptor is held outside the file IO pool
+ * If offset is -1 the file is truncated to its end of file, which releases
+ * the unused preallocated space without changing the data that was written
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_segment_file_write_hash_sections(
-         libewf_segment_file_t *segment_file,
-         libbfio_pool_t *file_io_pool,
-         int file_io_pool_entry,
-         libewf_hash_sections_t *hash_sections,
-         libfvalue_table_t *hash_values,
-         libcerror_error_t **error )
+int libewf_segment_file_truncate_preallocated(
+     const system_character_t *filename,
+     off64_t offset,
+     libcerror_error_t **error )
 {
-	libewf_section_descriptor_t *section_descriptor = NULL;
-	static char *function                           = "libewf_segment_file_write_hash_sections";
-	ssize_t total_write_count                       = 0;
-	ssize_t write_count                             = 0;
-	int element_index                               = 0;
-	int result                                      = 0;
+	static char *function = "libewf_segment_file_truncate_preallocated";
+	int result            = 1;
 
-	if( segment_file == NULL )
+#if defined( HAVE_LIBEWF_SEGMENT_FILE_PREALLOCATE )
+	off_t truncate_offset = 0;
+	int file_descriptor   = -1;
+#endif
+
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment file.",
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( segment_file->io_handle == NULL )
+	if( offset < -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid segment file - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( hash_sections == NULL )
+#if defined( HAVE_LIBEWF_SEGMENT_FILE_PREALLOCATE )
+	file_descriptor = open(
+	                   filename,
+	                   O_WRONLY );
+
+	if( file_descriptor == -1 )
 	{
-		libcerror_error_set(
+		libcerror_system_set_error(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid hash sections.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
 
 		return( -1 );
 	}
-	if( ( segment_file->io_handle->format == LIBEWF_FORMAT_ENCASE6 )
-	 || ( segment_file->io_handle->format == LIBEWF_FORMAT_ENCASE7 )
-	 || ( segment_file->io_handle->format == LIBEWF_FORMAT_LINEN6 )
-	 || ( segment_file->io_handle->format == LIBEWF_FORMAT_LINEN7 ) )
+	if( offset == -1 )
 	{
-		/* Write the digest section if required
-		 */
-		if( hash_sections->sha1_digest_set != 0 )
-		{
-			if( libewf_section_descriptor_initialize(
-			     &section_descriptor,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create section descriptor.",
-				 function );
-
-				goto on_error;
-			}
-			write_count = libewf_digest_section_write_file_io_pool(
-				       section_descriptor,
-				       segment_file->io_handle,
-				       file_io_pool,
-				       file_io_pool_entry,
-				       segment_file->current_offset,
-				       hash_sections,
-				       error );
-
-			if( write_count == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write digest section.",
-				 function );
-
-				goto on_error;
-			}
-			if( libfdata_list_append_element(
-			     segment_file->sections_list,
-			     &element_index,
-			     file_io_pool_entry,
-			     segment_file->current_offset,
-			     sizeof( ewf_section_descriptor_v1_t ),
-			     0,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append element to sections list.",
-				 function );
-
-				goto on_error;
-			}
-			segment_file->current_offset += write_count;
-			total_write_count            += write_count;
-
-			if( libewf_section_descriptor_free(
-			     &section_descriptor,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free section.",
-				 function );
+		truncate_offset = lseek(
+		                   file_descriptor,
+		                   0,
+		                   SEEK_END );
 
-				goto on_error;
-			}
-		}
-	}
-	/* Write the MD5 hash section if required
-	 */
-	if( hash_sections->md5_hash_set != 0 )
-	{
-		if( libewf_section_descriptor_initialize(
-		     &section_descriptor,
-		     error ) != 1 )
+		if( truncate_offset == -1 )
 		{
-			libcerror_error_set(
+			libcerror_system_set_error(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create section descriptor.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 errno,
+			 "%s: unable to seek end of file: %" PRIs_SYSTEM ".",
+			 function,
+			 filename );
 
-			goto on_error;
+			result = -1;
 		}
-		write_count = libewf_md5_hash_section_write_file_io_pool(
-			       section_descriptor,
-			       segment_file->io_handle,
-			       file_io_pool,
-			       file_io_pool_entry,
-			       segment_file->major_version,
-			       segment_file->current_offset,
-			       hash_sections,
-			       error );
-
-		if( write_count == -1 )
+	}
+	else
+	{
+		truncate_offset = (off_t) offset;
+	}
+	if( result == 1 )
+	{
+		if( ftruncate(
+		     file_descriptor,
+		     truncate_offset ) != 0 )
 		{
-			libcerror_error_set(
+			libcerror_system_set_error(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write MD5 hash section.",
-			 function );
+			 errno,
+			 "%s: unable to truncate file: %" PRIs_SYSTEM ".",
+			 function,
+			 filename );
 
-			goto on_error;
+			result = -1;
 		}
-		if( segment_file->major_version == 1 )
-		{
-			result = libfdata_list_append_element(
-			          segment_file->sections_list,
-			          &element_index,
-			          file_io_pool_entry,
-			          segment_file->current_offset,
+	}
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		result = -1;
+	}
+#endif /* defined( HAVE_LIBEWF_SEGMENT_FILE_PREALLOCATE ) */
+
+	return( result );
+}
+
+/* Sets the filename of the preallocated segment file
+ * The filename is used to release the unused preallocated space
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_set_preallocated_filename(
+     libewf_segment_file_t *segment_file,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_set_preallocated_filename";
+	size_t filename_size  = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->preallocated_filename != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment file - preallocated filename value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_size = system_string_length(
+	                 filename ) + 1;
+
+	segment_file->preallocated_filename = system_string_allocate(
+	                                       filename_size );
+
+	if( segment_file->preallocated_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create preallocated filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( system_string_copy(
+	     segment_file->preallocated_filename,
+	     filename,
+	     filename_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy preallocated filename.",
+		 function );
+
+		memory_free(
+		 segment_file->preallocated_filename );
+
+		segment_file->preallocated_filename = NULL;
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Preallocates the space of a segment file
+ * The file size is not changed, the unused preallocated space is released
+ * when the segment file is closed for writing
+ * The file is only opened for the duration of the preallocation
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int libewf_segment_file_preallocate(
+     libewf_segment_file_t *segment_file,
+     const system_character_t *filename,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_preallocate";
+
+#if defined( HAVE_LIBEWF_SEGMENT_FILE_PREALLOCATE )
+	int file_descriptor   = -1;
+	int result            = 1;
+#endif
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->preallocated_filename != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment file - preallocated filename value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_SEGMENT_FILE_PREALLOCATE )
+	if( size == 0 )
+	{
+		return( 0 );
+	}
+	file_descriptor = open(
+	                   filename,
+	                   O_WRONLY );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	/* Preallocation is an optimization, the segment file is written without
+	 * if the file system does not support it or does not have sufficient space
+	 * The segment file is empty when it is preallocated, hence truncating it
+	 * releases any space that was partially preallocated
+	 */
+	if( fallocate(
+	     file_descriptor,
+	     FALLOC_FL_KEEP_SIZE,
+	     0,
+	     (off_t) size ) != 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to preallocate: %" PRIu64 " bytes with error: %d.\n",
+			 function,
+			 size,
+			 errno );
+		}
+#endif
+		if( ftruncate(
+		     file_descriptor,
+		     0 ) != 0 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to truncate file with error: %d.\n",
+				 function,
+				 errno );
+			}
+#endif
+		}
+		result = 0;
+	}
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	if( result == 1 )
+	{
+		if( libewf_segment_file_set_preallocated_filename(
+		     segment_file,
+		     filename,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set preallocated filename.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+#else
+	return( 0 );
+#endif /* defined( HAVE_LIBEWF_SEGMENT_FILE_PREALLOCATE ) */
+}
+
+/* Releases the unused preallocated space of a segment file
+ * The segment file is truncated to the current offset
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_release_preallocation(
+     libewf_segment_file_t *segment_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_release_preallocation";
+	int result            = 1;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment file - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->write_buffer_data_size != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment file - write buffer was not flushed.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->preallocated_filename == NULL )
+	{
+		return( 1 );
+	}
+	if( libewf_segment_file_truncate_preallocated(
+	     segment_file->preallocated_filename,
+	     segment_file->current_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to truncate segment file: %" PRIu32 ".",
+		 function,
+		 segment_file->segment_number );
+
+		result = -1;
+	}
+	memory_free(
+	 segment_file->preallocated_filename );
+
+	segment_file->preallocated_filename = NULL;
+
+	return( result );
+}
+
+/* Creates the file of a segment file ahead of writing it
+ * The file is created empty and its space is preallocated, so that this file system
+ * work can be done while the previous segment file is being written
+ * An existing file is not created ahead, so that it is never truncated or removed
+ * Returns 1 if successful, 0 if not supported or the file already exists or -1 on error
+ */
+int libewf_segment_file_create_ahead(
+     const system_character_t *filename,
+     size64_t size,
+     int *file_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_create_ahead";
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	*file_descriptor = -1;
+
+#if defined( HAVE_LIBEWF_SEGMENT_FILE_PREALLOCATE )
+	*file_descriptor = open(
+	                    filename,
+	                    O_WRONLY | O_CREAT | O_EXCL,
+	                    0644 );
+
+	if( *file_descriptor == -1 )
+	{
+		/* The segment file is created when it is needed instead
+		 */
+		if( errno == EEXIST )
+		{
+			return( 0 );
+		}
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to create file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	/* Preallocation is an optimization, the file remains usable if it fails
+	 */
+	if( size != 0 )
+	{
+		if( fallocate(
+		     *file_descriptor,
+		     FALLOC_FL_KEEP_SIZE,
+		     0,
+		     (off_t) size ) != 0 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to preallocate: %" PRIu64 " bytes with error: %d.\n",
+				 function,
+				 size,
+				 errno );
+			}
+#endif
+			if( ftruncate(
+			     *file_descriptor,
+			     0 ) != 0 )
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: unable to truncate file with error: %d.\n",
+					 function,
+					 errno );
+				}
+#endif
+			}
+		}
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif /* defined( HAVE_LIBEWF_SEGMENT_FILE_PREALLOCATE ) */
+}
+
+/* Sets a segment file that was created ahead
+ * The file descriptor of the file created ahead is closed, since the segment file
+ * is accessed through the file IO pool, and the filename is used to release
+ * the unused preallocated space
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_set_created_ahead(
+     libewf_segment_file_t *segment_file,
+     const system_character_t *filename,
+     int file_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_set_created_ahead";
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_SEGMENT_FILE_PREALLOCATE )
+	if( file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file descriptor value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_file_set_preallocated_filename(
+	     segment_file,
+	     filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set preallocated filename.",
+		 function );
+
+		return( -1 );
+	}
+#endif /* defined( HAVE_LIBEWF_SEGMENT_FILE_PREALLOCATE ) */
+
+	return( 1 );
+}
+
+/* Removes the file of a segment file that was created ahead but is not written
+ * Only a file that was created ahead, hence has a file descriptor, is removed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_remove_created_ahead(
+     const system_character_t *filename,
+     int file_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_remove_created_ahead";
+	int result            = 1;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_SEGMENT_FILE_PREALLOCATE )
+	if( file_descriptor == -1 )
+	{
+		return( 1 );
+	}
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file descriptor.",
+		 function );
+
+		result = -1;
+	}
+	if( unlink(
+	     filename ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+		 errno,
+		 "%s: unable to remove file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		result = -1;
+	}
+#endif /* defined( HAVE_LIBEWF_SEGMENT_FILE_PREALLOCATE ) */
+
+	return( result );
+}
+
+/* Writes the data in the write buffer to the segment file
+ * If flush all is not set the data after the last aligned offset remains in
+ * the write buffer, so that the batches of chunk data end on an aligned offset
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_segment_file_flush_write_buffer(
+         libewf_segment_file_t *segment_file,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         uint8_t flush_all,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_flush_write_buffer";
+	size_t remaining_size = 0;
+	size_t write_size     = 0;
+	ssize_t write_count   = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->write_buffer_data_size > segment_file->write_buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment file - write buffer data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->write_buffer_data_size == 0 )
+	{
+		return( 0 );
+	}
+	write_size = segment_file->write_buffer_data_size;
+
+	if( flush_all == 0 )
+	{
+		/* The current offset includes the data in the write buffer
+		 */
+		remaining_size = (size_t) ( segment_file->current_offset % LIBEWF_SEGMENT_FILE_WRITE_ALIGNMENT );
+
+		if( remaining_size <= ( write_size - remaining_size ) )
+		{
+			write_size -= remaining_size;
+		}
+		else
+		{
+			remaining_size = 0;
+		}
+	}
+	write_count = libbfio_pool_write_buffer(
+	               file_io_pool,
+	               file_io_pool_entry,
+	               segment_file->write_buffer,
+	               write_size,
+	               error );
+
+	if( write_count != (ssize_t) write_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( remaining_size > 0 )
+	{
+		if( memory_copy(
+		     segment_file->write_buffer,
+		     &( segment_file->write_buffer[ write_size ] ),
+		     remaining_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy remaining data in write buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	segment_file->write_buffer_data_size = remaining_size;
+
+	return( write_count );
+}
+
+/* Writes the hash sections to file
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_segment_file_write_hash_sections(
+         libewf_segment_file_t *segment_file,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         libewf_hash_sections_t *hash_sections,
+         libfvalue_table_t *hash_values,
+         libcerror_error_t **error )
+{
+	libewf_section_descriptor_t *section_descriptor = NULL;
+	static char *function                           = "libewf_segment_file_write_hash_sections";
+	ssize_t total_write_count                       = 0;
+	ssize_t write_count                             = 0;
+	int element_index                               = 0;
+	int result                                      = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_sections == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash sections.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_file->io_handle->format == LIBEWF_FORMAT_ENCASE6 )
+	 || ( segment_file->io_handle->format == LIBEWF_FORMAT_ENCASE7 )
+	 || ( segment_file->io_handle->format == LIBEWF_FORMAT_LINEN6 )
+	 || ( segment_file->io_handle->format == LIBEWF_FORMAT_LINEN7 ) )
+	{
+		/* Write the digest section if required
+		 */
+		if( hash_sections->sha1_digest_set != 0 )
+		{
+			if( libewf_section_descriptor_initialize(
+			     &section_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create section descriptor.",
+				 function );
+
+				goto on_error;
+			}
+			write_count = libewf_digest_section_write_file_io_pool(
+				       section_descriptor,
+				       segment_file->io_handle,
+				       file_io_pool,
+				       file_io_pool_entry,
+				       segment_file->current_offset,
+				       hash_sections,
+				       error );
+
+			if( write_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write digest section.",
+				 function );
+
+				goto on_error;
+			}
+			if( libfdata_list_append_element(
+			     segment_file->sections_list,
+			     &element_index,
+			     file_io_pool_entry,
+			     segment_file->current_offset,
+			     sizeof( ewf_section_descriptor_v1_t ),
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append element to sections list.",
+				 function );
+
+				goto on_error;
+			}
+			segment_file->current_offset += write_count;
+			total_write_count            += write_count;
+
+			if( libewf_section_descriptor_free(
+			     &section_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free section.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	/* Write the MD5 hash section if required
+	 */
+	if( hash_sections->md5_hash_set != 0 )
+	{
+		if( libewf_section_descriptor_initialize(
+		     &section_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create section descriptor.",
+			 function );
+
+			goto on_error;
+		}
+		write_count = libewf_md5_hash_section_write_file_io_pool(
+			       section_descriptor,
+			       segment_file->io_handle,
+			       file_io_pool,
+			       file_io_pool_entry,
+			       segment_file->major_version,
+			       segment_file->current_offset,
+			       hash_sections,
+			       error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write MD5 hash section.",
+			 function );
+
+			goto on_error;
+		}
+		if( segment_file->major_version == 1 )
+		{
+			result = libfdata_list_append_element(
+			          segment_file->sections_list,
+			          &element_index,
+			          file_io_pool_entry,
+			          segment_file->current_offset,
 			          sizeof( ewf_section_descriptor_v1_t ),
 			          0,
 			          error );
@@ -4791,6 +5733,30 @@ ssize_t libewf_segment_file_write_close(
 
 		return( -1 );
 	}
+	if( libewf_segment_file_flush_write_buffer(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     1,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush write buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( segment_file->write_buffer != NULL )
+	{
+		memory_free(
+		 segment_file->write_buffer );
+
+		segment_file->write_buffer      = NULL;
+		segment_file->write_buffer_size = 0;
+	}
 	if( last_segment_file != 0 )
 	{
 		/* Write the data section for a single segment file only for EWF-E01
@@ -5177,6 +6143,23 @@ ssize_t libewf_segment_file_write_close(
 
 		goto on_error;
 	}
+	if( segment_file->preallocated_filename != NULL )
+	{
+		if( libewf_segment_file_release_preallocation(
+		     segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to release preallocation of segment file: %" PRIu16 ".",
+			 function,
+			 segment_file->segment_number );
+
+			goto on_error;
+		}
+	}
 	segment_file->flags &= ~( LIBEWF_SEGMENT_FILE_FLAG_WRITE_OPEN );
 
 	return( total_write_count );
@@ -5968,61 +6951,177 @@ on_error:
 	return( -1 );
 }
 
-/* Reads a segment file
- * Callback function for the segment files list
+/* Restores the segment file values from an index file
+ * Returns 1 if successful, 0 if the segment file is not stored in the index file or -1 on error
+ */
+int libewf_segment_file_read_index_file(
+     libewf_segment_file_t *segment_file,
+     libewf_index_file_t *index_file,
+     uint32_t segment_index,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error )
+{
+	libewf_index_file_segment_t index_file_segment;
+
+	static char *function          = "libewf_segment_file_read_index_file";
+	size_t section_descriptor_size = 0;
+	int result                     = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_index_file_get_segment_by_index(
+	          index_file,
+	          segment_index,
+	          &index_file_segment,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment: %" PRIu32 " from index file.",
+		 function,
+		 segment_index );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( ( index_file_segment.segment_number != ( segment_index + 1 ) )
+	 || ( index_file_segment.segment_file_size != segment_file_size ) )
+	{
+		return( 0 );
+	}
+	if( index_file->major_version == 1 )
+	{
+		section_descriptor_size = sizeof( ewf_section_descriptor_v1_t );
+	}
+	else if( index_file->major_version == 2 )
+	{
+		section_descriptor_size = sizeof( ewf_section_descriptor_v2_t );
+	}
+	else
+	{
+		return( 0 );
+	}
+	if( memory_copy(
+	     segment_file->set_identifier,
+	     index_file->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	segment_file->type                             = index_file_segment.type;
+	segment_file->major_version                    = index_file->major_version;
+	segment_file->minor_version                    = index_file->minor_version;
+	segment_file->compression_method               = index_file->compression_method;
+	segment_file->segment_number                   = index_file_segment.segment_number;
+	segment_file->flags                            = index_file_segment.flags;
+	segment_file->last_section_offset              = index_file_segment.last_section_offset;
+	segment_file->device_information_section_index = index_file_segment.device_information_section_index;
+	segment_file->storage_media_size               = index_file_segment.storage_media_size;
+	segment_file->number_of_chunks                 = index_file_segment.number_of_chunks;
+	segment_file->last_chunk_filled                = index_file_segment.last_chunk_filled;
+	segment_file->previous_last_chunk_filled       = index_file_segment.last_chunk_filled;
+
+	if( libewf_index_file_fill_segment_lists(
+	     index_file,
+	     segment_index,
+	     file_io_pool_entry,
+	     section_descriptor_size,
+	     segment_file->sections_list,
+	     segment_file->chunk_groups_list,
+	     &( segment_file->chunk_groups_index ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to fill sections and chunk groups lists from index file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the segment file header, the section descriptors and the tables if the chunk size is known
+ * The segment file does not need to be stored in the segment files list
  * Returns 1 if successful or -1 on error
  */
-int libewf_segment_file_read_element_data(
-     libewf_io_handle_t *io_handle,
+int libewf_segment_file_read_file_io_pool(
+     libewf_segment_file_t *segment_file,
      libbfio_pool_t *file_io_pool,
-     libfdata_list_element_t *element,
-     libfdata_cache_t *segment_file_cache,
      int file_io_pool_entry,
-     off64_t segment_file_offset,
      size64_t segment_file_size,
-     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
-     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
      libcerror_error_t **error )
 {
 	libewf_section_descriptor_t *section_descriptor = NULL;
-	libewf_segment_file_t *segment_file             = NULL;
 	libfcache_cache_t *sections_cache               = NULL;
-	static char *function                           = "libewf_segment_file_read_element_data";
+	static char *function                           = "libewf_segment_file_read_file_io_pool";
 	ssize_t read_count                              = 0;
 	off64_t section_data_offset                     = 0;
+	off64_t segment_file_offset                     = 0;
 	int element_index                               = 0;
 	int last_section                                = 0;
 	int number_of_sections                          = 0;
 	int result                                      = 0;
 	int section_index                               = 0;
 
-	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
-	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
-
-	if( io_handle == NULL )
+	if( segment_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
+		 "%s: invalid segment file.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_file_initialize(
-	     &segment_file,
-	     io_handle,
-	     error ) != 1 )
+	if( segment_file->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create segment file.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	read_count = libewf_segment_file_read_file_header(
 		      segment_file,
@@ -6057,23 +7156,6 @@ int libewf_segment_file_read_element_data(
 
 		goto on_error;
 	}
-	if( ( io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-	 && ( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 ) )
-	{
-		segment_file->type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
-	}
-	else if( ( io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED )
-	      && ( io_handle->segment_file_type != segment_file->type ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_INPUT,
-		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-		 "%s: segment file type value mismatch.",
-		 function );
-
-		goto on_error;
-	}
 	if( segment_file->major_version == 2 )
 	{
 		if( ( segment_file->compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
@@ -6086,7 +7168,7 @@ int libewf_segment_file_read_element_data(
 			 "%s: unsupported compression method.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 	}
 	/* Read the section descriptors:
@@ -6328,7 +7410,7 @@ int libewf_segment_file_read_element_data(
 			                                               - segment_file->device_information_section_index;
 		}
 	}
-	if( io_handle->chunk_size != 0 )
+	if( segment_file->io_handle->chunk_size != 0 )
 	{
 		if( libfcache_cache_initialize(
 		     &sections_cache,
@@ -6422,7 +7504,7 @@ int libewf_segment_file_read_element_data(
 					      section_descriptor,
 					      file_io_pool,
 					      file_io_pool_entry,
-					      io_handle->chunk_size,
+					      segment_file->io_handle->chunk_size,
 					      error );
 
 				if( read_count == -1 )
@@ -6475,45 +7557,245 @@ int libewf_segment_file_read_element_data(
 					 section_index,
 					 section_data_offset );
 
-					goto on_error;
-				}
-				read_count = libewf_segment_file_read_table2_section(
-					      segment_file,
-					      section_descriptor,
-					      file_io_pool,
-					      file_io_pool_entry,
-					      error );
+					goto on_error;
+				}
+				read_count = libewf_segment_file_read_table2_section(
+					      segment_file,
+					      section_descriptor,
+					      file_io_pool,
+					      file_io_pool_entry,
+					      error );
+
+				if( read_count == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read section: %s.",
+					 function,
+					 section_descriptor->type_string );
+
+					section_descriptor = NULL;
+
+					goto on_error;
+				}
+			}
+			section_descriptor = NULL;
+		}
+		if( libfcache_cache_free(
+		     &sections_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sections cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( sections_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &sections_cache,
+		 NULL );
+	}
+	if( section_descriptor != NULL )
+	{
+		libewf_section_descriptor_free(
+		 &section_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Validates the segment file type against the segment file type of the set
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_validate_type(
+     libewf_segment_file_t *segment_file,
+     uint8_t segment_file_type,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_validate_type";
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+	 && ( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 ) )
+	{
+		segment_file->type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
+	}
+	else if( ( segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED )
+	      && ( segment_file_type != segment_file->type ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: segment file type value mismatch.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads a segment file
+ * Callback function for the segment files list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_read_element_data(
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libfdata_list_element_t *element,
+     libfdata_cache_t *segment_file_cache,
+     int file_io_pool_entry,
+     off64_t segment_file_offset LIBEWF_ATTRIBUTE_UNUSED,
+     size64_t segment_file_size,
+     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
+     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_segment_file_read_element_data";
+	int element_index                   = 0;
+	int result                          = 0;
+
+	LIBEWF_UNREFERENCED_PARAMETER( segment_file_offset )
+	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
+	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
 
-				if( read_count == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read section: %s.",
-					 function,
-					 section_descriptor->type_string );
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
 
-					section_descriptor = NULL;
+		return( -1 );
+	}
+	if( libewf_segment_file_initialize(
+	     &segment_file,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
+		 function );
 
-					goto on_error;
-				}
-			}
-			section_descriptor = NULL;
-		}
-		if( libfcache_cache_free(
-		     &sections_cache,
+		goto on_error;
+	}
+	/* If the segment file is stored in the index file the section descriptors
+	 * and tables do not need to be read
+	 */
+	if( io_handle->index_file != NULL )
+	{
+		if( libfdata_list_element_get_element_index(
+		     element,
+		     &element_index,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free sections cache.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element index.",
+			 function );
+
+			goto on_error;
+		}
+		result = libewf_segment_file_read_index_file(
+		          segment_file,
+		          io_handle->index_file,
+		          (uint32_t) element_index,
+		          file_io_pool_entry,
+		          segment_file_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment file from index file.",
 			 function );
 
 			goto on_error;
 		}
+		else if( result != 0 )
+		{
+			if( libfdata_list_element_set_element_value(
+			     element,
+			     (intptr_t *) file_io_pool,
+			     (libfdata_cache_t *) segment_file_cache,
+			     (intptr_t *) segment_file,
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_segment_file_free,
+			     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set segment file as element value.",
+				 function );
+
+				goto on_error;
+			}
+			return( 1 );
+		}
+	}
+	if( libewf_segment_file_read_file_io_pool(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     segment_file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_validate_type(
+	     segment_file,
+	     io_handle->segment_file_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported segment file type.",
+		 function );
+
+		goto on_error;
 	}
 	if( libfdata_list_element_set_element_value(
 	     element,
@@ -6536,18 +7818,6 @@ int libewf_segment_file_read_element_data(
 	return( 1 );
 
 on_error:
-	if( sections_cache != NULL )
-	{
-		libfcache_cache_free(
-		 &sections_cache,
-		 NULL );
-	}
-	if( section_descriptor != NULL )
-	{
-		libewf_section_descriptor_free(
-		 &section_descriptor,
-		 NULL );
-	}
 	if( segment_file != NULL )
 	{
 		libewf_segment_file_free(
@@ -7077,3 +8347,207 @@ int libewf_segment_file_get_chunk_group_by_offset(
 	return( result );
 }
 
+/* Appends the segment file values to an index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_append_to_index_file(
+     libewf_segment_file_t *segment_file,
+     libewf_index_file_t *index_file,
+     libbfio_pool_t *file_io_pool,
+     size64_t segment_file_size,
+     int64_t modification_time,
+     libcerror_error_t **error )
+{
+	libewf_index_file_segment_t index_file_segment;
+
+	libewf_section_descriptor_t *section_descriptor = NULL;
+	libfcache_cache_t *sections_cache               = NULL;
+	static char *function                           = "libewf_segment_file_append_to_index_file";
+	int number_of_sections                          = 0;
+	int section_index                               = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &index_file_segment,
+	     0,
+	     sizeof( libewf_index_file_segment_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index file segment.",
+		 function );
+
+		return( -1 );
+	}
+	index_file_segment.segment_number                   = segment_file->segment_number;
+	index_file_segment.type                             = segment_file->type;
+	index_file_segment.flags                            = segment_file->flags;
+	index_file_segment.segment_file_size                = segment_file_size;
+	index_file_segment.modification_time                = modification_time;
+	index_file_segment.last_section_offset              = segment_file->last_section_offset;
+	index_file_segment.storage_media_size               = segment_file->storage_media_size;
+	index_file_segment.number_of_chunks                 = segment_file->number_of_chunks;
+	index_file_segment.last_chunk_filled                = segment_file->last_chunk_filled;
+	index_file_segment.device_information_section_index = segment_file->device_information_section_index;
+
+	/* The first segment file contains the media values, other segment files
+	 * only need their section data to be read if they contain sections other
+	 * than the chunk data and tables
+	 */
+	if( segment_file->segment_number == 1 )
+	{
+		index_file_segment.has_section_data = 1;
+	}
+	else
+	{
+		if( libfdata_list_get_number_of_elements(
+		     segment_file->sections_list,
+		     &number_of_sections,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve the number of elements from sections list.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfcache_cache_initialize(
+		     &sections_cache,
+		     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create sections cache.",
+			 function );
+
+			goto on_error;
+		}
+		for( section_index = 0;
+		     section_index < number_of_sections;
+		     section_index++ )
+		{
+			if( libewf_segment_file_get_section_by_index(
+			     segment_file,
+			     section_index,
+			     file_io_pool,
+			     sections_cache,
+			     &section_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve section: %d.",
+				 function,
+				 section_index );
+
+				goto on_error;
+			}
+			if( section_descriptor == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing section: %d.",
+				 function,
+				 section_index );
+
+				goto on_error;
+			}
+			if( ( section_descriptor->type == LIBEWF_SECTION_TYPE_SECTOR_DATA )
+			 || ( section_descriptor->type == LIBEWF_SECTION_TYPE_SECTOR_TABLE )
+			 || ( section_descriptor->type == LIBEWF_SECTION_TYPE_NEXT )
+			 || ( section_descriptor->type == LIBEWF_SECTION_TYPE_DONE ) )
+			{
+				continue;
+			}
+			if( segment_file->major_version == 1 )
+			{
+				/* The data section of subsequent segment files only contains
+				 * a copy of the media values
+				 */
+				if( ( section_descriptor->type_string_length == 4 )
+				 && ( memory_compare(
+				       (void *) section_descriptor->type_string,
+				       (void *) "data",
+				       4 ) == 0 ) )
+				{
+					continue;
+				}
+				if( ( section_descriptor->type_string_length == 6 )
+				 && ( memory_compare(
+				       (void *) section_descriptor->type_string,
+				       (void *) "table2",
+				       6 ) == 0 ) )
+				{
+					continue;
+				}
+			}
+			index_file_segment.has_section_data = 1;
+
+			break;
+		}
+		section_descriptor = NULL;
+
+		if( libfcache_cache_free(
+		     &sections_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sections cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_index_file_append_segment(
+	     index_file,
+	     &index_file_segment,
+	     segment_file->sections_list,
+	     segment_file->chunk_groups_list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append segment to index file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( sections_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &sections_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
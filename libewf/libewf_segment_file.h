@@ -38,6 +38,7 @@
 #include "libewf_chunk_group.h"
 #include "libewf_hash_sections.h"
 #include "libewf_header_sections.h"
+#include "libewf_index_file.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
@@ -141,6 +142,24 @@ struct libewf_segment_file
 	/* Flags
 	 */
 	uint8_t flags;
+
+	/* The write buffer
+	 * Contains chunk data that has not been written to the segment file yet
+	 */
+	uint8_t *write_buffer;
+
+	/* The write buffer size
+	 */
+	size_t write_buffer_size;
+
+	/* The size of the data in the write buffer
+	 */
+	size_t write_buffer_data_size;
+
+	/* The filename used to release the unused preallocated space
+	 * or NULL if the segment file was not preallocated
+	 */
+	system_character_t *preallocated_filename;
 };
 
 int libewf_segment_file_initialize(
@@ -320,6 +339,50 @@ ssize_t libewf_segment_file_write_chunk_data(
          libewf_chunk_data_t *chunk_data,
          libcerror_error_t **error );
 
+int libewf_segment_file_truncate_preallocated(
+     const system_character_t *filename,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int libewf_segment_file_set_preallocated_filename(
+     libewf_segment_file_t *segment_file,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int libewf_segment_file_preallocate(
+     libewf_segment_file_t *segment_file,
+     const system_character_t *filename,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libewf_segment_file_release_preallocation(
+     libewf_segment_file_t *segment_file,
+     libcerror_error_t **error );
+
+int libewf_segment_file_create_ahead(
+     const system_character_t *filename,
+     size64_t size,
+     int *file_descriptor,
+     libcerror_error_t **error );
+
+int libewf_segment_file_set_created_ahead(
+     libewf_segment_file_t *segment_file,
+     const system_character_t *filename,
+     int file_descriptor,
+     libcerror_error_t **error );
+
+int libewf_segment_file_remove_created_ahead(
+     const system_character_t *filename,
+     int file_descriptor,
+     libcerror_error_t **error );
+
+ssize_t libewf_segment_file_flush_write_buffer(
+         libewf_segment_file_t *segment_file,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         uint8_t flush_all,
+         libcerror_error_t **error );
+
 ssize_t libewf_segment_file_write_hash_sections(
          libewf_segment_file_t *segment_file,
          libbfio_pool_t *file_io_pool,
@@ -372,6 +435,26 @@ int libewf_segment_file_write_sections_correction(
      ewf_data_t **data_section,
      libcerror_error_t **error );
 
+int libewf_segment_file_read_index_file(
+     libewf_segment_file_t *segment_file,
+     libewf_index_file_t *index_file,
+     uint32_t segment_index,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error );
+
+int libewf_segment_file_read_file_io_pool(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error );
+
+int libewf_segment_file_validate_type(
+     libewf_segment_file_t *segment_file,
+     uint8_t segment_file_type,
+     libcerror_error_t **error );
+
 int libewf_segment_file_read_element_data(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
@@ -418,6 +501,14 @@ int libewf_segment_file_get_chunk_group_by_offset(
      libewf_chunk_group_t **chunk_group,
      libcerror_error_t **error );
 
+int libewf_segment_file_append_to_index_file(
+     libewf_segment_file_t *segment_file,
+     libewf_index_file_t *index_file,
+     libbfio_pool_t *file_io_pool,
+     size64_t segment_file_size,
+     int64_t modification_time,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
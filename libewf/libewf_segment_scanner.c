@@ -0,0 +1,678 @@
+/*
+ * Segment scanner functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_segment_file.h"
+#include "libewf_segment_scanner.h"
+#include "libewf_segment_table.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates a segment scanner
+ * Make sure the value segment_scanner is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_scanner_initialize(
+     libewf_segment_scanner_t **segment_scanner,
+     libewf_io_handle_t *io_handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_scanner_initialize";
+
+	if( segment_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_scanner != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment scanner value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_SEGMENT_SCANNER_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*segment_scanner = memory_allocate_structure(
+	                    libewf_segment_scanner_t );
+
+	if( *segment_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     *segment_scanner,
+	     0,
+	     sizeof( libewf_segment_scanner_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment scanner.",
+		 function );
+
+		memory_free(
+		 *segment_scanner );
+
+		*segment_scanner = NULL;
+
+		return( -1 );
+	}
+	( *segment_scanner )->number_of_threads = number_of_threads;
+	( *segment_scanner )->io_handle         = io_handle;
+
+	return( 1 );
+}
+
+/* Frees a segment scanner
+ * Frees the segment files that were scanned but not retrieved
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_scanner_free(
+     libewf_segment_scanner_t **segment_scanner,
+     libcerror_error_t **error )
+{
+	libewf_segment_scanner_request_t *request = NULL;
+	static char *function                     = "libewf_segment_scanner_free";
+	uint32_t segment_index                    = 0;
+	int result                                = 1;
+
+	if( segment_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_scanner != NULL )
+	{
+		if( ( *segment_scanner )->requests != NULL )
+		{
+			for( segment_index = 0;
+			     segment_index < ( *segment_scanner )->number_of_segments;
+			     segment_index++ )
+			{
+				request = &( ( ( *segment_scanner )->requests )[ segment_index ] );
+
+				if( request->segment_file != NULL )
+				{
+					if( libewf_segment_file_free(
+					     &( request->segment_file ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free segment file: %" PRIu32 ".",
+						 function,
+						 segment_index );
+
+						result = -1;
+					}
+				}
+				if( request->file_io_pool != NULL )
+				{
+					if( libbfio_pool_free(
+					     &( request->file_io_pool ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free file IO pool of segment file: %" PRIu32 ".",
+						 function,
+						 segment_index );
+
+						result = -1;
+					}
+				}
+			}
+			memory_free(
+			 ( *segment_scanner )->requests );
+		}
+		memory_free(
+		 *segment_scanner );
+
+		*segment_scanner = NULL;
+	}
+	return( result );
+}
+
+/* Processes a segment scanner request
+ * Callback function for the segment scanner thread pool
+ * Errors are not propagated, the segment file is read again when it is accessed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_scanner_process_request(
+     libewf_segment_scanner_request_t *request,
+     libewf_segment_scanner_t *segment_scanner )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_segment_scanner_process_request";
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		goto on_error;
+	}
+	if( segment_scanner == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment scanner.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_initialize(
+	     &( request->segment_file ),
+	     segment_scanner->io_handle,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_read_file_io_pool(
+	     request->segment_file,
+	     request->file_io_pool,
+	     request->file_io_pool_entry,
+	     request->segment_file_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment file.",
+		 function );
+
+		goto on_error;
+	}
+	/* Free the file IO pool to close the cloned file IO handle
+	 */
+	if( libbfio_pool_free(
+	     &( request->file_io_pool ),
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	if( request != NULL )
+	{
+		if( request->segment_file != NULL )
+		{
+			libewf_segment_file_free(
+			 &( request->segment_file ),
+			 NULL );
+		}
+		if( request->file_io_pool != NULL )
+		{
+			libbfio_pool_free(
+			 &( request->file_io_pool ),
+			 NULL );
+		}
+	}
+	return( -1 );
+}
+
+/* Scans the segment files in the segment table
+ * Every segment file is read using a clone of its file IO handle, so that
+ * the segment files can be read concurrently without accessing the file IO pool
+ * Segment files that cannot be scanned are read when they are accessed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_scanner_scan(
+     libewf_segment_scanner_t *segment_scanner,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle          = NULL;
+	libbfio_handle_t *scan_file_io_handle     = NULL;
+	libcthreads_thread_pool_t *thread_pool    = NULL;
+	libewf_segment_scanner_request_t *request = NULL;
+	static char *function                     = "libewf_segment_scanner_scan";
+	size_t requests_size                      = 0;
+	uint32_t number_of_segments               = 0;
+	uint32_t segment_index                    = 0;
+	int number_of_threads                     = 0;
+
+	if( segment_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_scanner->requests != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment scanner - requests value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments == 0 )
+	{
+		return( 1 );
+	}
+	if( (size_t) number_of_segments > ( (size_t) SSIZE_MAX / sizeof( libewf_segment_scanner_request_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	requests_size = sizeof( libewf_segment_scanner_request_t ) * number_of_segments;
+
+	segment_scanner->requests = (libewf_segment_scanner_request_t *) memory_allocate(
+	                                                                  requests_size );
+
+	if( segment_scanner->requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create requests.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     segment_scanner->requests,
+	     0,
+	     requests_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear requests.",
+		 function );
+
+		memory_free(
+		 segment_scanner->requests );
+
+		segment_scanner->requests = NULL;
+
+		return( -1 );
+	}
+	segment_scanner->number_of_segments = number_of_segments;
+
+	/* The file IO handles are cloned up front so that the threads
+	 * do not access the file IO pool
+	 */
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		request = &( ( segment_scanner->requests )[ segment_index ] );
+
+		if( libewf_segment_table_get_segment_by_index(
+		     segment_table,
+		     segment_index,
+		     &( request->file_io_pool_entry ),
+		     &( request->segment_file_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( libbfio_pool_get_handle(
+		     file_io_pool,
+		     request->file_io_pool_entry,
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file IO handle: %d from pool.",
+			 function,
+			 request->file_io_pool_entry );
+
+			goto on_error;
+		}
+		/* Not every type of file IO handle can be cloned
+		 */
+		if( libbfio_handle_clone(
+		     &scan_file_io_handle,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+
+			continue;
+		}
+		if( libbfio_pool_initialize(
+		     &( request->file_io_pool ),
+		     request->file_io_pool_entry + 1,
+		     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_pool_set_handle(
+		     request->file_io_pool,
+		     request->file_io_pool_entry,
+		     scan_file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set file IO handle: %d in pool.",
+			 function,
+			 request->file_io_pool_entry );
+
+			goto on_error;
+		}
+		scan_file_io_handle = NULL;
+	}
+	number_of_threads = segment_scanner->number_of_threads;
+
+	if( (uint32_t) number_of_threads > number_of_segments )
+	{
+		number_of_threads = (int) number_of_segments;
+	}
+	if( libcthreads_thread_pool_create(
+	     &thread_pool,
+	     NULL,
+	     number_of_threads,
+	     number_of_threads,
+	     (int (*)(intptr_t *, void *)) &libewf_segment_scanner_process_request,
+	     (void *) segment_scanner,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		request = &( ( segment_scanner->requests )[ segment_index ] );
+
+		if( request->file_io_pool == NULL )
+		{
+			continue;
+		}
+		/* The push blocks while the thread pool queue is full
+		 */
+		if( libcthreads_thread_pool_push(
+		     thread_pool,
+		     (intptr_t *) request,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push request: %" PRIu32 " onto thread pool queue.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_thread_pool_join(
+	     &thread_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	if( scan_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &scan_file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves a scanned segment file
+ * The ownership of the segment file is transferred to the caller
+ * Returns 1 if successful, 0 if the segment file was not scanned or -1 on error
+ */
+int libewf_segment_scanner_get_segment_file(
+     libewf_segment_scanner_t *segment_scanner,
+     uint32_t segment_index,
+     libewf_segment_file_t **segment_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_scanner_get_segment_file";
+
+	if( segment_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_scanner->requests == NULL )
+	 || ( segment_index >= segment_scanner->number_of_segments ) )
+	{
+		return( 0 );
+	}
+	if( segment_scanner->requests[ segment_index ].segment_file == NULL )
+	{
+		return( 0 );
+	}
+	*segment_file = segment_scanner->requests[ segment_index ].segment_file;
+
+	segment_scanner->requests[ segment_index ].segment_file = NULL;
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
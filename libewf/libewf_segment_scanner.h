@@ -0,0 +1,123 @@
+/*
+ * Segment scanner functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SEGMENT_SCANNER_H )
+#define _LIBEWF_SEGMENT_SCANNER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_segment_file.h"
+#include "libewf_segment_table.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_segment_scanner_request libewf_segment_scanner_request_t;
+
+struct libewf_segment_scanner_request
+{
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The segment file size
+	 */
+	size64_t segment_file_size;
+
+	/* The file IO pool
+	 * Contains a clone of the file IO handle of the segment file
+	 * at the same entry as in the file IO pool of the handle
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The segment file
+	 * Contains NULL if the segment file was not scanned
+	 */
+	libewf_segment_file_t *segment_file;
+};
+
+typedef struct libewf_segment_scanner libewf_segment_scanner_t;
+
+/* The segment scanner reads the file header and section descriptors
+ * of the segment files of a set concurrently
+ */
+struct libewf_segment_scanner
+{
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The requests
+	 * Contains a request per segment file
+	 */
+	libewf_segment_scanner_request_t *requests;
+
+	/* The number of segments
+	 */
+	uint32_t number_of_segments;
+};
+
+int libewf_segment_scanner_initialize(
+     libewf_segment_scanner_t **segment_scanner,
+     libewf_io_handle_t *io_handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_segment_scanner_free(
+     libewf_segment_scanner_t **segment_scanner,
+     libcerror_error_t **error );
+
+int libewf_segment_scanner_process_request(
+     libewf_segment_scanner_request_t *request,
+     libewf_segment_scanner_t *segment_scanner );
+
+int libewf_segment_scanner_scan(
+     libewf_segment_scanner_t *segment_scanner,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libcerror_error_t **error );
+
+int libewf_segment_scanner_get_segment_file(
+     libewf_segment_scanner_t *segment_scanner,
+     uint32_t segment_index,
+     libewf_segment_file_t **segment_file,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SEGMENT_SCANNER_H ) */
+
@@ -27,6 +27,7 @@
 
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
@@ -48,6 +49,11 @@ struct libewf_segment_table
 	 */
 	size_t basename_size;
 
+	/* The stripe basenames
+	 * Contains NULL if the segment files are not striped
+	 */
+	libcdata_array_t *stripe_basenames;
+
 	/* The maximum segment size
 	 */
 	size64_t maximum_segment_size;
@@ -126,6 +132,33 @@ int libewf_segment_table_set_basename_wide(
 
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
+int libewf_segment_table_free_stripe_basename(
+     system_character_t **stripe_basename,
+     libcerror_error_t **error );
+
+int libewf_segment_table_append_stripe_basename(
+     libewf_segment_table_t *segment_table,
+     const char *basename,
+     size_t basename_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+int libewf_segment_table_append_stripe_basename_wide(
+     libewf_segment_table_t *segment_table,
+     const wchar_t *basename,
+     size_t basename_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+int libewf_segment_table_get_segment_basename(
+     libewf_segment_table_t *segment_table,
+     uint32_t segment_index,
+     system_character_t **basename,
+     size_t *basename_size,
+     libcerror_error_t **error );
+
 int libewf_segment_table_set_maximum_segment_size(
      libewf_segment_table_t *segment_table,
      size64_t maximum_segment_size,
@@ -36,6 +36,7 @@
 #if defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI )
 typedef struct libewf_access_control_entry {}	libewf_access_control_entry_t;
 typedef struct libewf_attribute {}		libewf_attribute_t;
+typedef struct libewf_chunk_view {}		libewf_chunk_view_t;
 typedef struct libewf_data_chunk {}		libewf_data_chunk_t;
 typedef struct libewf_file_entry {}		libewf_file_entry_t;
 typedef struct libewf_handle {}			libewf_handle_t;
@@ -45,6 +46,7 @@ typedef struct libewf_subject {}		libewf_subject_t;
 #else
 typedef intptr_t libewf_access_control_entry_t;
 typedef intptr_t libewf_attribute_t;
+typedef intptr_t libewf_chunk_view_t;
 typedef intptr_t libewf_data_chunk_t;
 typedef intptr_t libewf_file_entry_t;
 typedef intptr_t libewf_handle_t;
@@ -0,0 +1,1093 @@
+/*
+ * Unpack pool functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_table.h"
+#include "libewf_definitions.h"
+#include "libewf_io_uring.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_unpack_pool.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates an unpack pool
+ * Make sure the value unpack_pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unpack_pool_initialize(
+     libewf_unpack_pool_t **unpack_pool,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_unpack_pool_initialize";
+	size_t requests_size  = 0;
+
+	if( unpack_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid unpack pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *unpack_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid unpack pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_UNPACK_POOL_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*unpack_pool = memory_allocate_structure(
+	                libewf_unpack_pool_t );
+
+	if( *unpack_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create unpack pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *unpack_pool,
+	     0,
+	     sizeof( libewf_unpack_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear unpack pool.",
+		 function );
+
+		memory_free(
+		 *unpack_pool );
+
+		*unpack_pool = NULL;
+
+		return( -1 );
+	}
+	( *unpack_pool )->number_of_requests = number_of_threads * LIBEWF_UNPACK_POOL_NUMBER_OF_CHUNKS_PER_THREAD;
+
+	requests_size = sizeof( libewf_unpack_pool_request_t ) * ( *unpack_pool )->number_of_requests;
+
+	( *unpack_pool )->requests = (libewf_unpack_pool_request_t *) memory_allocate(
+	                                                               requests_size );
+
+	if( ( *unpack_pool )->requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *unpack_pool )->requests,
+	     0,
+	     requests_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *unpack_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *unpack_pool )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	( *unpack_pool )->number_of_threads = number_of_threads;
+
+	return( 1 );
+
+on_error:
+	if( *unpack_pool != NULL )
+	{
+		if( ( *unpack_pool )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *unpack_pool )->mutex ),
+			 NULL );
+		}
+		if( ( *unpack_pool )->requests != NULL )
+		{
+			memory_free(
+			 ( *unpack_pool )->requests );
+		}
+		memory_free(
+		 *unpack_pool );
+
+		*unpack_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an unpack pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unpack_pool_free(
+     libewf_unpack_pool_t **unpack_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_unpack_pool_free";
+	int result            = 1;
+
+	if( unpack_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid unpack pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *unpack_pool != NULL )
+	{
+		if( ( *unpack_pool )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *unpack_pool )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *unpack_pool )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *unpack_pool )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_IO_URING )
+		if( ( *unpack_pool )->io_uring != NULL )
+		{
+			if( libewf_io_uring_free(
+			     &( ( *unpack_pool )->io_uring ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free io_uring.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *unpack_pool )->read_requests != NULL )
+		{
+			memory_free(
+			 ( *unpack_pool )->read_requests );
+		}
+#endif
+		memory_free(
+		 ( *unpack_pool )->requests );
+
+		memory_free(
+		 *unpack_pool );
+
+		*unpack_pool = NULL;
+	}
+	return( result );
+}
+
+#if defined( HAVE_LIBEWF_IO_URING )
+
+/* Enables reading the packed chunk data of a batch using io_uring
+ * The io_uring is only used to read from the specified file IO pool
+ * which must consist of file handles
+ * Returns 1 if successful, 0 if io_uring is not supported or -1 on error
+ */
+int libewf_unpack_pool_enable_io_uring(
+     libewf_unpack_pool_t *unpack_pool,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	static char *function     = "libewf_unpack_pool_enable_io_uring";
+	size_t read_requests_size = 0;
+	int result                = 0;
+
+	if( unpack_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid unpack pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( unpack_pool->io_uring != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid unpack pool - io_uring value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	read_requests_size = sizeof( libewf_io_uring_read_request_t ) * unpack_pool->number_of_requests;
+
+	unpack_pool->read_requests = (libewf_io_uring_read_request_t *) memory_allocate(
+	                                                                 read_requests_size );
+
+	if( unpack_pool->read_requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     unpack_pool->read_requests,
+	     0,
+	     read_requests_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read requests.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_io_uring_initialize(
+	          &( unpack_pool->io_uring ),
+	          LIBEWF_IO_URING_DEFAULT_QUEUE_DEPTH,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create io_uring.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		memory_free(
+		 unpack_pool->read_requests );
+
+		unpack_pool->read_requests = NULL;
+
+		return( 0 );
+	}
+	unpack_pool->io_uring_file_io_pool = file_io_pool;
+
+	return( 1 );
+
+on_error:
+	if( unpack_pool->read_requests != NULL )
+	{
+		memory_free(
+		 unpack_pool->read_requests );
+
+		unpack_pool->read_requests = NULL;
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_IO_URING ) */
+
+/* Processes an unpack pool request
+ * Callback function for the unpack pool thread pool
+ * Errors are not propagated, the request unpack count is set to -1 instead
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unpack_pool_process_request(
+     libewf_unpack_pool_request_t *request,
+     libewf_unpack_pool_t *unpack_pool )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_unpack_pool_process_request";
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		goto on_error;
+	}
+	if( unpack_pool == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid unpack pool.",
+		 function );
+
+		goto on_error;
+	}
+	request->unpack_count = libewf_chunk_data_unpack_buffer(
+	                         request->chunk_data,
+	                         unpack_pool->io_handle,
+	                         request->buffer,
+	                         request->buffer_size,
+	                         &error );
+
+	if( request->unpack_count < 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk: %" PRIu64 " data.",
+		 function,
+		 request->chunk_index );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( libcthreads_mutex_grab(
+	     unpack_pool->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	unpack_pool->number_of_pending_requests -= 1;
+
+	if( libcthreads_condition_broadcast(
+	     unpack_pool->condition,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		libcthreads_mutex_release(
+		 unpack_pool->mutex,
+		 NULL );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     unpack_pool->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+/* Pushes a request onto the thread pool queue
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unpack_pool_push_request(
+     libewf_unpack_pool_t *unpack_pool,
+     libewf_unpack_pool_request_t *request,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_unpack_pool_push_request";
+
+	if( unpack_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid unpack pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     unpack_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	unpack_pool->number_of_pending_requests += 1;
+
+	if( libcthreads_mutex_release(
+	     unpack_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_pool_push(
+	     unpack_pool->thread_pool,
+	     (intptr_t *) request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push request onto thread pool queue.",
+		 function );
+
+		if( libcthreads_mutex_grab(
+		     unpack_pool->mutex,
+		     NULL ) == 1 )
+		{
+			unpack_pool->number_of_pending_requests -= 1;
+
+			libcthreads_mutex_release(
+			 unpack_pool->mutex,
+			 NULL );
+		}
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Waits for the pending requests to complete
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unpack_pool_wait(
+     libewf_unpack_pool_t *unpack_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_unpack_pool_wait";
+
+	if( unpack_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid unpack pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     unpack_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( unpack_pool->number_of_pending_requests > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     unpack_pool->condition,
+		     unpack_pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 unpack_pool->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     unpack_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the full chunks that fit in the buffer, starting with a specific chunk
+ * The packed chunk data is read sequentially, or in batches if io_uring is enabled,
+ * and unpacked in parallel directly into the buffer, chunks that are cached are
+ * copied from the chunk cache
+ * The unpacked chunks are not added to the chunk cache
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_unpack_pool_read_buffer(
+         libewf_unpack_pool_t *unpack_pool,
+         libewf_chunk_table_t *chunk_table,
+         uint64_t chunk_index,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_media_values_t *media_values,
+         libewf_segment_table_t *segment_table,
+         libfcache_cache_t *chunk_groups_cache,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_io_uring_read_request_t *read_request = NULL;
+	libewf_unpack_pool_request_t *request        = NULL;
+	static char *function                        = "libewf_unpack_pool_read_buffer";
+	size_t buffer_offset                         = 0;
+	size_t data_size                             = 0;
+	ssize_t read_count                           = 0;
+	uint64_t number_of_chunks                    = 0;
+	int number_of_batch_chunks                   = 0;
+	int number_of_batch_requests                 = 0;
+	int request_index                            = 0;
+	int result                                   = 0;
+	uint8_t is_short_read                        = 0;
+
+#if defined( HAVE_LIBEWF_IO_URING )
+	uint8_t use_io_uring                         = 0;
+#endif
+
+	if( unpack_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid unpack pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index >= media_values->number_of_chunks )
+	{
+		return( 0 );
+	}
+	number_of_chunks = (uint64_t) ( buffer_size / media_values->chunk_size );
+
+	if( number_of_chunks > ( media_values->number_of_chunks - chunk_index ) )
+	{
+		number_of_chunks = media_values->number_of_chunks - chunk_index;
+	}
+	if( number_of_chunks == 0 )
+	{
+		return( 0 );
+	}
+	if( unpack_pool->thread_pool == NULL )
+	{
+		unpack_pool->io_handle = io_handle;
+
+		if( libcthreads_thread_pool_create(
+		     &( unpack_pool->thread_pool ),
+		     NULL,
+		     unpack_pool->number_of_threads,
+		     unpack_pool->number_of_requests,
+		     (int (*)(intptr_t *, void *)) &libewf_unpack_pool_process_request,
+		     (void *) unpack_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_LIBEWF_IO_URING )
+	/* The io_uring can only read from the file IO pool it was enabled for
+	 */
+	if( ( unpack_pool->io_uring != NULL )
+	 && ( unpack_pool->io_uring_file_io_pool == file_io_pool ) )
+	{
+		use_io_uring = 1;
+	}
+#endif
+	while( number_of_chunks > 0 )
+	{
+		if( number_of_chunks > (uint64_t) unpack_pool->number_of_requests )
+		{
+			number_of_batch_chunks = unpack_pool->number_of_requests;
+		}
+		else
+		{
+			number_of_batch_chunks = (int) number_of_chunks;
+		}
+		/* The packed chunk data is read in order, the chunks are unpacked in parallel
+		 * When io_uring is used the reads of the batch are submitted at once
+		 */
+		for( number_of_batch_requests = 0;
+		     number_of_batch_requests < number_of_batch_chunks;
+		     number_of_batch_requests++ )
+		{
+			request = &( unpack_pool->requests[ number_of_batch_requests ] );
+
+			request->chunk_index  = chunk_index + number_of_batch_requests;
+			request->chunk_data   = NULL;
+			request->buffer       = &( buffer[ buffer_offset + ( (size_t) number_of_batch_requests * media_values->chunk_size ) ] );
+			request->buffer_size  = (size_t) media_values->chunk_size;
+			request->unpack_count = 0;
+
+#if defined( HAVE_LIBEWF_IO_URING )
+			if( use_io_uring != 0 )
+			{
+				read_request = &( unpack_pool->read_requests[ number_of_batch_requests ] );
+
+				read_request->buffer     = NULL;
+				read_request->size       = 0;
+				read_request->read_count = 0;
+			}
+#endif
+			result = libewf_chunk_table_read_packed_chunk_data(
+			          chunk_table,
+			          request->chunk_index,
+			          file_io_pool,
+			          media_values,
+			          segment_table,
+			          chunk_groups_cache,
+			          request->buffer,
+			          request->buffer_size,
+			          &data_size,
+			          &( request->chunk_data ),
+			          read_request,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " data.",
+				 function,
+				 request->chunk_index );
+
+				number_of_batch_requests += 1;
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				request->unpack_count = (ssize_t) data_size;
+
+				continue;
+			}
+#if defined( HAVE_LIBEWF_IO_URING )
+			/* The requests are pushed once the reads of the batch have completed
+			 */
+			if( use_io_uring != 0 )
+			{
+				continue;
+			}
+#endif
+			if( libewf_unpack_pool_push_request(
+			     unpack_pool,
+			     request,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push request for chunk: %" PRIu64 ".",
+				 function,
+				 request->chunk_index );
+
+				number_of_batch_requests += 1;
+
+				goto on_error;
+			}
+		}
+#if defined( HAVE_LIBEWF_IO_URING )
+		if( use_io_uring != 0 )
+		{
+			if( libewf_io_uring_read_buffers(
+			     unpack_pool->io_uring,
+			     file_io_pool,
+			     unpack_pool->read_requests,
+			     number_of_batch_requests,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read packed chunk data.",
+				 function );
+
+				goto on_error;
+			}
+			for( request_index = 0;
+			     request_index < number_of_batch_requests;
+			     request_index++ )
+			{
+				request = &( unpack_pool->requests[ request_index ] );
+
+				if( request->chunk_data == NULL )
+				{
+					continue;
+				}
+				if( libewf_unpack_pool_push_request(
+				     unpack_pool,
+				     request,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to push request for chunk: %" PRIu64 ".",
+					 function,
+					 request->chunk_index );
+
+					goto on_error;
+				}
+			}
+		}
+#endif
+		if( libewf_unpack_pool_wait(
+		     unpack_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for pending requests.",
+			 function );
+
+			goto on_error;
+		}
+		for( request_index = 0;
+		     request_index < number_of_batch_requests;
+		     request_index++ )
+		{
+			request = &( unpack_pool->requests[ request_index ] );
+
+			if( request->unpack_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to unpack chunk: %" PRIu64 " data.",
+				 function,
+				 request->chunk_index );
+
+				goto on_error;
+			}
+			if( request->chunk_data != NULL )
+			{
+				if( ( request->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+				{
+					if( libewf_chunk_table_set_chunk_corrupted(
+					     chunk_table,
+					     request->chunk_index,
+					     media_values,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+						 "%s: unable to add checksum error for chunk: %" PRIu64 ".",
+						 function,
+						 request->chunk_index );
+
+						goto on_error;
+					}
+				}
+				if( libewf_chunk_data_free(
+				     &( request->chunk_data ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free chunk: %" PRIu64 " data.",
+					 function,
+					 request->chunk_index );
+
+					goto on_error;
+				}
+			}
+			/* Only the last chunk can be smaller than the chunk size
+			 */
+			if( is_short_read == 0 )
+			{
+				read_count += request->unpack_count;
+
+				if( (size_t) request->unpack_count < request->buffer_size )
+				{
+					is_short_read = 1;
+				}
+			}
+		}
+		if( is_short_read != 0 )
+		{
+			break;
+		}
+		buffer_offset    += (size_t) number_of_batch_chunks * media_values->chunk_size;
+		chunk_index      += number_of_batch_chunks;
+		number_of_chunks -= number_of_batch_chunks;
+
+		if( io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	return( read_count );
+
+on_error:
+	libewf_unpack_pool_wait(
+	 unpack_pool,
+	 NULL );
+
+	for( request_index = 0;
+	     request_index < number_of_batch_requests;
+	     request_index++ )
+	{
+		if( unpack_pool->requests[ request_index ].chunk_data != NULL )
+		{
+			libewf_chunk_data_free(
+			 &( unpack_pool->requests[ request_index ].chunk_data ),
+			 NULL );
+		}
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,181 @@
+/*
+ * Unpack pool functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_UNPACK_POOL_H )
+#define _LIBEWF_UNPACK_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_table.h"
+#include "libewf_io_handle.h"
+#include "libewf_io_uring.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfcache.h"
+#include "libewf_media_values.h"
+#include "libewf_segment_table.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_unpack_pool_request libewf_unpack_pool_request_t;
+
+struct libewf_unpack_pool_request
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The packed chunk data
+	 * Contains NULL if the chunk was copied from the chunk cache
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The buffer the chunk is unpacked into
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The number of bytes unpacked
+	 * Contains -1 if the chunk could not be unpacked
+	 */
+	ssize_t unpack_count;
+};
+
+typedef struct libewf_unpack_pool libewf_unpack_pool_t;
+
+/* The unpack pool reads the packed chunks of a single large read
+ * and unpacks them in parallel directly into the read buffer
+ */
+struct libewf_unpack_pool
+{
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The requests
+	 * Contains a request per chunk that can be unpacked in a single batch
+	 */
+	libewf_unpack_pool_request_t *requests;
+
+	/* The number of requests
+	 */
+	int number_of_requests;
+
+	/* The number of pending requests
+	 */
+	int number_of_pending_requests;
+
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The thread pool
+	 * Contains NULL until the first chunks are unpacked
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex protecting the number of pending requests
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition signalled when a request completes
+	 */
+	libcthreads_condition_t *condition;
+
+#if defined( HAVE_LIBEWF_IO_URING )
+	/* The io_uring used to read the packed chunk data of a batch
+	 * Contains NULL if io_uring is not enabled
+	 */
+	libewf_io_uring_t *io_uring;
+
+	/* The file IO pool the io_uring reads from
+	 */
+	libbfio_pool_t *io_uring_file_io_pool;
+
+	/* The io_uring read requests
+	 * Contains a read request per request
+	 */
+	libewf_io_uring_read_request_t *read_requests;
+#endif
+};
+
+int libewf_unpack_pool_initialize(
+     libewf_unpack_pool_t **unpack_pool,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_unpack_pool_free(
+     libewf_unpack_pool_t **unpack_pool,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_IO_URING )
+
+int libewf_unpack_pool_enable_io_uring(
+     libewf_unpack_pool_t *unpack_pool,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_IO_URING ) */
+
+int libewf_unpack_pool_process_request(
+     libewf_unpack_pool_request_t *request,
+     libewf_unpack_pool_t *unpack_pool );
+
+int libewf_unpack_pool_push_request(
+     libewf_unpack_pool_t *unpack_pool,
+     libewf_unpack_pool_request_t *request,
+     libcerror_error_t **error );
+
+int libewf_unpack_pool_wait(
+     libewf_unpack_pool_t *unpack_pool,
+     libcerror_error_t **error );
+
+ssize_t libewf_unpack_pool_read_buffer(
+         libewf_unpack_pool_t *unpack_pool,
+         libewf_chunk_table_t *chunk_table,
+         uint64_t chunk_index,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_media_values_t *media_values,
+         libewf_segment_table_t *segment_table,
+         libfcache_cache_t *chunk_groups_cache,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_UNPACK_POOL_H ) */
+
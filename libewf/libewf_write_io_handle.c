@@ -38,6 +38,7 @@
 #include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
 #include "libewf_compression.h"
+#include "libewf_compression_context.h"
 #include "libewf_definitions.h"
 #include "libewf_filename.h"
 #include "libewf_header_sections.h"
@@ -47,6 +48,7 @@
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
 #include "libewf_libfvalue.h"
@@ -153,6 +155,22 @@ int libewf_write_io_handle_initialize(
 
 		goto on_error;
 	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *write_io_handle )->compression_contexts_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create compression contexts mutex.",
+		 function );
+
+		goto on_error;
+	}
+	( *write_io_handle )->create_ahead_file_descriptor = -1;
+#endif
 	( *write_io_handle )->pack_flags                  = LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM;
 	( *write_io_handle )->section_descriptor_size     = sizeof( ewf_section_descriptor_v1_t );
 	( *write_io_handle )->table_header_size           = sizeof( ewf_table_header_v1_t );
@@ -167,6 +185,12 @@ int libewf_write_io_handle_initialize(
 on_error:
 	if( *write_io_handle != NULL )
 	{
+		if( ( *write_io_handle )->chunk_group != NULL )
+		{
+			libewf_chunk_group_free(
+			 &( ( *write_io_handle )->chunk_group ),
+			 NULL );
+		}
 		memory_free(
 		 *write_io_handle );
 
@@ -183,6 +207,7 @@ int libewf_write_io_handle_free(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_write_io_handle_free";
+	int context_index     = 0;
 	int result            = 1;
 
 	if( write_io_handle == NULL )
@@ -236,6 +261,61 @@ int libewf_write_io_handle_free(
 
 			result = -1;
 		}
+		if( ( *write_io_handle )->compression_contexts != NULL )
+		{
+			for( context_index = 0;
+			     context_index < ( *write_io_handle )->number_of_compression_contexts;
+			     context_index++ )
+			{
+				if( libewf_compression_context_free(
+				     &( ( *write_io_handle )->compression_contexts[ context_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free compression context: %d.",
+					 function,
+					 context_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *write_io_handle )->compression_contexts );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libewf_write_io_handle_discard_created_ahead(
+		     *write_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to discard segment file created ahead.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *write_io_handle )->compression_contexts_mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *write_io_handle )->compression_contexts_mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free compression contexts mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		memory_free(
 		 *write_io_handle );
 
@@ -322,6 +402,18 @@ int libewf_write_io_handle_clone(
 	( *destination_write_io_handle )->number_of_table_entries = 0;
 	( *destination_write_io_handle )->chunk_group             = NULL;
 
+	( *destination_write_io_handle )->compression_contexts                     = NULL;
+	( *destination_write_io_handle )->number_of_compression_contexts           = 0;
+	( *destination_write_io_handle )->number_of_allocated_compression_contexts = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	( *destination_write_io_handle )->compression_contexts_mutex   = NULL;
+	( *destination_write_io_handle )->create_ahead_thread          = NULL;
+	( *destination_write_io_handle )->create_ahead_filename        = NULL;
+	( *destination_write_io_handle )->create_ahead_filename_size   = 0;
+	( *destination_write_io_handle )->create_ahead_file_descriptor = -1;
+#endif
+
 	if( source_write_io_handle->case_data != NULL )
 	{
 		( *destination_write_io_handle )->case_data = (uint8_t *) memory_allocate(
@@ -466,11 +558,32 @@ int libewf_write_io_handle_clone(
 
 		goto on_error;
 	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *destination_write_io_handle )->compression_contexts_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination compression contexts mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
 	if( *destination_write_io_handle != NULL )
 	{
+		if( ( *destination_write_io_handle )->chunk_group != NULL )
+		{
+			libewf_chunk_group_free(
+			 &( ( *destination_write_io_handle )->chunk_group ),
+			 NULL );
+		}
 		if( ( *destination_write_io_handle )->table_section_data != NULL )
 		{
 			memory_free(
@@ -499,6 +612,230 @@ on_error:
 	return( -1 );
 }
 
+/* Grabs an unused compression context
+ * A new compression context is created if no unused compression context is available
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_grab_compression_context(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_io_handle_grab_compression_context";
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression context value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     write_io_handle->compression_contexts_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab compression contexts mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( write_io_handle->number_of_compression_contexts > 0 )
+	{
+		write_io_handle->number_of_compression_contexts -= 1;
+
+		*compression_context = write_io_handle->compression_contexts[ write_io_handle->number_of_compression_contexts ];
+
+		write_io_handle->compression_contexts[ write_io_handle->number_of_compression_contexts ] = NULL;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     write_io_handle->compression_contexts_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release compression contexts mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( *compression_context == NULL )
+	{
+		if( libewf_compression_context_initialize(
+		     compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create compression context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 compression_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Releases a compression context so that it can be reused
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_release_compression_context(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	libewf_compression_context_t **compression_contexts = NULL;
+	static char *function                               = "libewf_write_io_handle_release_compression_context";
+	void *reallocation                                  = NULL;
+	int number_of_allocated_compression_contexts        = 0;
+	int result                                          = 1;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     write_io_handle->compression_contexts_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab compression contexts mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( write_io_handle->number_of_compression_contexts >= write_io_handle->number_of_allocated_compression_contexts )
+	{
+		number_of_allocated_compression_contexts = write_io_handle->number_of_allocated_compression_contexts + 8;
+
+		reallocation = memory_reallocate(
+		                write_io_handle->compression_contexts,
+		                sizeof( libewf_compression_context_t * ) * number_of_allocated_compression_contexts );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize compression contexts.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			compression_contexts = (libewf_compression_context_t **) reallocation;
+
+			write_io_handle->compression_contexts                     = compression_contexts;
+			write_io_handle->number_of_allocated_compression_contexts = number_of_allocated_compression_contexts;
+		}
+	}
+	if( result == 1 )
+	{
+		write_io_handle->compression_contexts[ write_io_handle->number_of_compression_contexts ] = *compression_context;
+
+		write_io_handle->number_of_compression_contexts += 1;
+
+		*compression_context = NULL;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     write_io_handle->compression_contexts_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release compression contexts mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result != 1 )
+	{
+		libewf_compression_context_free(
+		 compression_context,
+		 NULL );
+	}
+	return( result );
+}
+
 /* Initializes the write IO handle value to start writing
  * Returns 1 if successful or -1 on error
  */
@@ -2298,88 +2635,155 @@ int libewf_write_io_handle_test_chunks_section_full(
 	return( 0 );
 }
 
-/* Creates a new segment file and opens it for writing
- * The necessary sections at the start of the segment file are written
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates the next segment file ahead
+ * Callback function for the create ahead thread
+ * A segment file that cannot be created ahead is created when it is needed instead,
+ * hence this is not considered an error of the thread
  * Returns 1 if successful or -1 on error
  */
-int libewf_write_io_handle_create_segment_file(
-     libewf_io_handle_t *io_handle,
-     libbfio_pool_t *file_io_pool,
-     libewf_segment_table_t *segment_table,
-     uint8_t segment_file_type,
-     uint32_t segment_number,
-     uint32_t maximum_number_of_segments,
-     const uint8_t *set_identifier,
-     int *file_io_pool_entry,
-     libewf_segment_file_t **segment_file,
-     libcerror_error_t **error )
+int libewf_write_io_handle_create_ahead_callback(
+     libewf_write_io_handle_t *write_io_handle )
 {
-	libbfio_handle_t *file_io_handle = NULL;
-	system_character_t *filename     = NULL;
-	static char *function            = "libewf_write_io_handle_create_segment_file";
-	size_t filename_size             = 0;
-	int bfio_access_flags            = 0;
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_write_io_handle_create_ahead_callback";
 
-	if( segment_table == NULL )
+	if( write_io_handle == NULL )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment table.",
+		 "%s: invalid write IO handle.",
 		 function );
 
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
 		return( -1 );
 	}
-	if( io_handle == NULL )
+	if( libewf_segment_file_create_ahead(
+	     write_io_handle->create_ahead_filename,
+	     write_io_handle->create_ahead_size,
+	     &( write_io_handle->create_ahead_file_descriptor ),
+	     &error ) == -1 )
 	{
 		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to create segment file: %" PRIu32 " ahead.",
+		 function,
+		 write_io_handle->create_ahead_segment_number );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
+		/* The segment file is created when it is needed instead
+		 */
+		write_io_handle->create_ahead_file_descriptor = -1;
+	}
+	return( 1 );
+}
+
+/* Starts creating a segment file ahead on a separate thread
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_start_create_ahead(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libewf_segment_table_t *segment_table,
+     uint8_t segment_file_type,
+     uint32_t segment_number,
+     uint32_t maximum_number_of_segments,
+     libcerror_error_t **error )
+{
+	system_character_t *basename = NULL;
+	static char *function        = "libewf_write_io_handle_start_create_ahead";
+	size_t basename_size         = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( file_io_pool_entry == NULL )
+	if( ( write_io_handle->create_ahead_thread != NULL )
+	 || ( write_io_handle->create_ahead_filename != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid write IO handle - segment file already created ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file IO pool entry.",
+		 "%s: invalid IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( segment_file == NULL )
+	if( segment_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment file.",
+		 "%s: invalid segment table.",
 		 function );
 
 		return( -1 );
 	}
-	if( *segment_file != NULL )
+	if( libewf_segment_table_get_segment_basename(
+	     segment_table,
+	     segment_number,
+	     &basename,
+	     &basename_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid segment file - value already set.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment: %" PRIu32 " basename.",
+		 function,
+		 segment_number );
 
-		return( -1 );
+		goto on_error;
 	}
 	if( libewf_filename_create(
-	     &filename,
-	     &filename_size,
-	     segment_table->basename,
-	     segment_table->basename_size - 1,
+	     &( write_io_handle->create_ahead_filename ),
+	     &( write_io_handle->create_ahead_filename_size ),
+	     basename,
+	     basename_size - 1,
 	     segment_number + 1,
 	     maximum_number_of_segments,
 	     segment_file_type,
@@ -2396,6 +2800,311 @@ int libewf_write_io_handle_create_segment_file(
 
 		goto on_error;
 	}
+	write_io_handle->create_ahead_segment_number  = segment_number;
+	write_io_handle->create_ahead_size            = segment_table->maximum_segment_size;
+	write_io_handle->create_ahead_file_descriptor = -1;
+
+	if( libcthreads_thread_create(
+	     &( write_io_handle->create_ahead_thread ),
+	     NULL,
+	     (int (*)(void *)) &libewf_write_io_handle_create_ahead_callback,
+	     (void *) write_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( write_io_handle->create_ahead_filename != NULL )
+	{
+		memory_free(
+		 write_io_handle->create_ahead_filename );
+
+		write_io_handle->create_ahead_filename = NULL;
+	}
+	write_io_handle->create_ahead_filename_size = 0;
+
+	return( -1 );
+}
+
+/* Waits until the segment file being created ahead, if any, has been created
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_stop_create_ahead(
+     libewf_write_io_handle_t *write_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_io_handle_stop_create_ahead";
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->create_ahead_thread != NULL )
+	{
+		if( libcthreads_thread_join(
+		     &( write_io_handle->create_ahead_thread ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Discards the segment file created ahead, if any
+ * The segment file is removed since it was not written
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_discard_created_ahead(
+     libewf_write_io_handle_t *write_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_io_handle_discard_created_ahead";
+	int result            = 1;
+
+	if( libewf_write_io_handle_stop_create_ahead(
+	     write_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop creating segment file ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->create_ahead_filename != NULL )
+	{
+		if( libewf_segment_file_remove_created_ahead(
+		     write_io_handle->create_ahead_filename,
+		     write_io_handle->create_ahead_file_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 "%s: unable to remove segment file: %" PRIu32 " created ahead.",
+			 function,
+			 write_io_handle->create_ahead_segment_number );
+
+			result = -1;
+		}
+		memory_free(
+		 write_io_handle->create_ahead_filename );
+
+		write_io_handle->create_ahead_filename = NULL;
+	}
+	write_io_handle->create_ahead_filename_size   = 0;
+	write_io_handle->create_ahead_file_descriptor = -1;
+
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Creates a new segment file and opens it for writing
+ * The necessary sections at the start of the segment file are written
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_create_segment_file(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint8_t segment_file_type,
+     uint32_t segment_number,
+     uint32_t maximum_number_of_segments,
+     const uint8_t *set_identifier,
+     int *file_io_pool_entry,
+     libewf_segment_file_t **segment_file,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	system_character_t *basename     = NULL;
+	system_character_t *filename     = NULL;
+	static char *function            = "libewf_write_io_handle_create_segment_file";
+	size_t basename_size             = 0;
+	size_t filename_size             = 0;
+	int bfio_access_flags            = 0;
+	int file_descriptor              = -1;
+	int result                       = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment file - value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libewf_write_io_handle_stop_create_ahead(
+	     write_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop creating segment file ahead.",
+		 function );
+
+		goto on_error;
+	}
+	/* Use the segment file created ahead if it was created successfully
+	 */
+	if( ( write_io_handle->create_ahead_filename != NULL )
+	 && ( write_io_handle->create_ahead_segment_number == segment_number )
+	 && ( write_io_handle->create_ahead_file_descriptor != -1 ) )
+	{
+		filename        = write_io_handle->create_ahead_filename;
+		filename_size   = write_io_handle->create_ahead_filename_size;
+		file_descriptor = write_io_handle->create_ahead_file_descriptor;
+
+		write_io_handle->create_ahead_filename        = NULL;
+		write_io_handle->create_ahead_filename_size   = 0;
+		write_io_handle->create_ahead_file_descriptor = -1;
+	}
+	else if( libewf_write_io_handle_discard_created_ahead(
+	          write_io_handle,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to discard segment file created ahead.",
+		 function );
+
+		goto on_error;
+	}
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	if( filename == NULL )
+	{
+		if( libewf_segment_table_get_segment_basename(
+		     segment_table,
+		     segment_number,
+		     &basename,
+		     &basename_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " basename.",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		if( libewf_filename_create(
+		     &filename,
+		     &filename_size,
+		     basename,
+		     basename_size - 1,
+		     segment_number + 1,
+		     maximum_number_of_segments,
+		     segment_file_type,
+		     io_handle->format,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment file: %" PRIu32 " filename.",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+	}
 	if( filename == NULL )
 	{
 		libcerror_error_set(
@@ -2453,12 +3162,16 @@ int libewf_write_io_handle_create_segment_file(
 
 		goto on_error;
 	}
-	memory_free(
-	 filename );
-
-	filename = NULL;
-
-	bfio_access_flags = LIBBFIO_OPEN_WRITE_TRUNCATE;
+	/* The segment file created ahead is empty and truncating it would release its preallocated space
+	 */
+	if( file_descriptor != -1 )
+	{
+		bfio_access_flags = LIBBFIO_OPEN_WRITE;
+	}
+	else
+	{
+		bfio_access_flags = LIBBFIO_OPEN_WRITE_TRUNCATE;
+	}
 
 	if( libbfio_pool_append_handle(
 	     file_io_pool,
@@ -2542,6 +3255,54 @@ int libewf_write_io_handle_create_segment_file(
 			goto on_error;
 		}
 	}
+	/* Preallocate the segment file to reduce fragmentation
+	 * The segment file created ahead already is preallocated, its file descriptor
+	 * is closed since the segment file is accessed through the file IO pool
+	 */
+	if( file_descriptor != -1 )
+	{
+		result = libewf_segment_file_set_created_ahead(
+		          *segment_file,
+		          filename,
+		          file_descriptor,
+		          error );
+
+		file_descriptor = -1;
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set segment file: %" PRIu32 " created ahead.",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+	}
+	else if( libewf_segment_file_preallocate(
+	          *segment_file,
+	          filename,
+	          segment_table->maximum_segment_size,
+	          error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to preallocate segment file: %" PRIu32 ".",
+		 function,
+		 segment_number );
+
+		goto on_error;
+	}
+	memory_free(
+	 filename );
+
+	filename = NULL;
+
 	if( libewf_segment_table_append_segment_by_segment_file(
 	     segment_table,
 	     *segment_file,
@@ -2576,6 +3337,35 @@ int libewf_write_io_handle_create_segment_file(
 
 		goto on_error;
 	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* When the segment files are striped the next segment file is created
+	 * in another location while this segment file is being written
+	 */
+	if( ( segment_table->stripe_basenames != NULL )
+	 && ( ( segment_number + 1 ) < maximum_number_of_segments ) )
+	{
+		if( libewf_write_io_handle_start_create_ahead(
+		     write_io_handle,
+		     io_handle,
+		     segment_table,
+		     segment_file_type,
+		     segment_number + 1,
+		     maximum_number_of_segments,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start creating segment file: %" PRIu32 " ahead.",
+			 function,
+			 segment_number + 1 );
+
+			return( -1 );
+		}
+	}
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
 	return( 1 );
 
 on_error:
@@ -2593,6 +3383,13 @@ on_error:
 	}
 	if( filename != NULL )
 	{
+		if( file_descriptor != -1 )
+		{
+			libewf_segment_file_remove_created_ahead(
+			 filename,
+			 file_descriptor,
+			 NULL );
+		}
 		memory_free(
 		 filename );
 	}
@@ -2786,6 +3583,26 @@ ssize_t libewf_write_io_handle_write_chunks_section_end(
 			return( -1 );
 		}
 	}
+	/* The chunk offsets in the chunk group can refer to chunk data that is
+	 * still in the write buffer, hence the write buffer is flushed before
+	 * the table entries are generated from the chunk group
+	 */
+	if( libewf_segment_file_flush_write_buffer(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     1,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush write buffer.",
+		 function );
+
+		return( -1 );
+	}
 /* TODO what about linen 7 */
 	if( ( io_handle->format == LIBEWF_FORMAT_ENCASE6 )
 	 || ( io_handle->format == LIBEWF_FORMAT_ENCASE7 ) )
@@ -3053,6 +3870,7 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 		}
 #endif
 		if( libewf_write_io_handle_create_segment_file(
+		     write_io_handle,
 		     io_handle,
 		     file_io_pool,
 		     segment_table,
@@ -3343,6 +4161,10 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 	total_write_count += write_count;
 
 /* TODO re-implement using set by index instead of append ? */
+	/* The chunk data can still be in the write buffer of the segment file,
+	 * the chunk group is only used to generate the table entries after
+	 * the write buffer has been flushed
+	 */
 	if( libfdata_list_append_element(
 	     write_io_handle->chunk_group->chunks_list,
 	     &element_index,
@@ -37,10 +37,12 @@
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
+#include "libewf_compression_context.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcdata.h"
+#include "libewf_libcthreads.h"
 #include "libewf_libfdata.h"
 #include "libewf_libfvalue.h"
 #include "libewf_io_handle.h"
@@ -207,6 +209,53 @@ struct libewf_write_io_handle
 	/* The size of the compressed zero byte empty block
 	 */
 	size_t compressed_zero_byte_empty_block_size;
+
+	/* The unused compression contexts
+	 * A compression context is grabbed for every chunk that is packed and
+	 * released afterwards, hence the number of compression contexts
+	 * corresponds to the number of threads packing chunks concurrently
+	 */
+	libewf_compression_context_t **compression_contexts;
+
+	/* The number of unused compression contexts
+	 */
+	int number_of_compression_contexts;
+
+	/* The number of allocated compression contexts entries
+	 */
+	int number_of_allocated_compression_contexts;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The compression contexts mutex
+	 */
+	libcthreads_mutex_t *compression_contexts_mutex;
+
+	/* The thread that creates the next segment file ahead
+	 * Contains NULL if no segment file is being created ahead
+	 */
+	libcthreads_thread_t *create_ahead_thread;
+
+	/* The segment number of the segment file created ahead
+	 */
+	uint32_t create_ahead_segment_number;
+
+	/* The filename of the segment file created ahead
+	 */
+	system_character_t *create_ahead_filename;
+
+	/* The filename size of the segment file created ahead
+	 */
+	size_t create_ahead_filename_size;
+
+	/* The size to preallocate of the segment file created ahead
+	 */
+	size64_t create_ahead_size;
+
+	/* The file descriptor of the segment file created ahead
+	 * or -1 if the segment file was not created
+	 */
+	int create_ahead_file_descriptor;
+#endif
 };
 
 int libewf_write_io_handle_initialize(
@@ -223,6 +272,16 @@ int libewf_write_io_handle_clone(
      libewf_write_io_handle_t *source_write_io_handle,
      libcerror_error_t **error );
 
+int libewf_write_io_handle_grab_compression_context(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
+int libewf_write_io_handle_release_compression_context(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
 int libewf_write_io_handle_initialize_values(
      libewf_write_io_handle_t *write_io_handle,
      libewf_io_handle_t *io_handle,
@@ -272,7 +331,32 @@ int libewf_write_io_handle_test_chunks_section_full(
      uint8_t format,
      libcerror_error_t **error );
 
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_write_io_handle_create_ahead_callback(
+     libewf_write_io_handle_t *write_io_handle );
+
+int libewf_write_io_handle_start_create_ahead(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libewf_segment_table_t *segment_table,
+     uint8_t segment_file_type,
+     uint32_t segment_number,
+     uint32_t maximum_number_of_segments,
+     libcerror_error_t **error );
+
+int libewf_write_io_handle_stop_create_ahead(
+     libewf_write_io_handle_t *write_io_handle,
+     libcerror_error_t **error );
+
+int libewf_write_io_handle_discard_created_ahead(
+     libewf_write_io_handle_t *write_io_handle,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
 int libewf_write_io_handle_create_segment_file(
+     libewf_write_io_handle_t *write_io_handle,
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
      libewf_segment_table_t *segment_table,
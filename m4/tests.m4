@@ -6,7 +6,7 @@ dnl Function to detect if tests dependencies are available
 AC_DEFUN([AX_TESTS_CHECK_LOCAL],
   [AC_CHECK_HEADERS([dlfcn.h])
 
-  AC_CHECK_FUNCS([fmemopen getopt mkstemp setenv tzset unlink])
+  AC_CHECK_FUNCS([clock_gettime fmemopen getopt mkstemp setenv tzset unlink])
 
   AC_CHECK_LIB(
     dl,
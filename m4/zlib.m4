@@ -158,6 +158,43 @@ AC_DEFUN([AX_ZLIB_CHECK_COMPRESSBOUND],
     ])
   ])
 
+dnl Function to detect if the deflate functions are available
+AC_DEFUN([AX_ZLIB_CHECK_DEFLATE],
+  [AS_IF(
+    [test "x$ac_cv_zlib" = xzlib],
+    [ac_cv_deflate=zlib
+
+    AC_CHECK_LIB(
+      z,
+      deflate,
+      [ac_zlib_dummy=yes],
+      [ac_cv_deflate=no])
+    AC_CHECK_LIB(
+      z,
+      deflateInit_,
+      [ac_zlib_dummy=yes],
+      [ac_cv_deflate=no])
+    AC_CHECK_LIB(
+      z,
+      deflateReset,
+      [ac_zlib_dummy=yes],
+      [ac_cv_deflate=no])
+    AC_CHECK_LIB(
+      z,
+      deflateEnd,
+      [ac_zlib_dummy=yes],
+      [ac_cv_deflate=no])
+
+    AS_IF(
+      [test "x$ac_cv_deflate" = xzlib],
+      [AC_DEFINE(
+        [HAVE_ZLIB_DEFLATE],
+        [1],
+        [Define to 1 if you have the `deflateInit', `deflate', `deflateReset' and `deflateEnd' functions.])
+      ])
+    ])
+  ])
+
 dnl Function to detect if the inflate functions are available
 AC_DEFUN([AX_ZLIB_CHECK_INFLATE],
   [AS_IF(
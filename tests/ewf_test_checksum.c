@@ -0,0 +1,408 @@
+/*
+ * Library checksum functions test program
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_checksum.h"
+#include "../libewf/libewf_deflate.h"
+
+#define EWF_TEST_CHECKSUM_BUFFER_SIZE	( 65536 + 4 )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Fills the buffer with pseudo random data
+ */
+void ewf_test_checksum_fill_buffer(
+      uint8_t *buffer,
+      size_t size,
+      uint32_t seed )
+{
+	size_t buffer_offset = 0;
+
+	for( buffer_offset = 0;
+	     buffer_offset < size;
+	     buffer_offset++ )
+	{
+		seed = ( seed * 1103515245UL ) + 12345;
+
+		buffer[ buffer_offset ] = (uint8_t) ( seed >> 16 );
+	}
+}
+
+/* Tests the libewf_checksum_get_adler32_blocks_function function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_checksum_get_adler32_blocks_function(
+     void )
+{
+	uint8_t buffer[ 32 * 64 ];
+
+	void (*blocks_function)(
+	       const uint8_t *buffer,
+	       size_t number_of_blocks,
+	       uint32_t *lower_word,
+	       uint32_t *upper_word ) = NULL;
+
+	size_t buffer_offset           = 0;
+	uint32_t expected_lower_word   = 0;
+	uint32_t expected_upper_word   = 0;
+	uint32_t lower_word            = 0;
+	uint32_t upper_word            = 0;
+	int result                     = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_checksum_get_adler32_blocks_function(
+	          &blocks_function );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	if( result == 0 )
+	{
+		EWF_TEST_ASSERT_IS_NULL(
+		 "blocks_function",
+		 blocks_function );
+	}
+	else
+	{
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "blocks_function",
+		 blocks_function );
+
+		ewf_test_checksum_fill_buffer(
+		 buffer,
+		 32 * 64,
+		 0x12345678UL );
+
+		lower_word          = 0x0000fff0UL;
+		upper_word          = 0x0000fff0UL;
+		expected_lower_word = 0x0000fff0UL;
+		expected_upper_word = 0x0000fff0UL;
+
+		for( buffer_offset = 0;
+		     buffer_offset < 32 * 64;
+		     buffer_offset++ )
+		{
+			expected_lower_word += buffer[ buffer_offset ];
+			expected_upper_word += expected_lower_word;
+		}
+		blocks_function(
+		 buffer,
+		 64,
+		 &lower_word,
+		 &upper_word );
+
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "lower_word",
+		 lower_word,
+		 expected_lower_word );
+
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "upper_word",
+		 upper_word,
+		 expected_upper_word );
+	}
+	/* Test error cases
+	 */
+	result = libewf_checksum_get_adler32_blocks_function(
+	          NULL );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libewf_checksum_calculate_adler32 function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_checksum_calculate_adler32(
+     void )
+{
+	size_t sizes[ 12 ] = {
+		0, 1, 31, 32, 33, 5535, 5536, 5537, 5552, 11104, 32768, 65536 };
+
+	uint32_t initial_values[ 3 ] = {
+		1, 0x0000fff0UL, 0xfff0fff0UL };
+
+	libcerror_error_t *error   = NULL;
+	uint8_t *buffer            = NULL;
+	size_t buffer_offset       = 0;
+	uint32_t checksum          = 0;
+	uint32_t expected_checksum = 0;
+	int initial_value_index    = 0;
+	int result                 = 0;
+	int size_index             = 0;
+	int test_index             = 0;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * EWF_TEST_CHECKSUM_BUFFER_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	/* Test regular cases
+	 */
+	result = memory_set(
+	          buffer,
+	          0,
+	          sizeof( uint8_t ) * EWF_TEST_CHECKSUM_BUFFER_SIZE ) != NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_checksum_calculate_adler32(
+	          &checksum,
+	          buffer,
+	          32768,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum",
+	 checksum,
+	 (uint32_t) 0x80000001UL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test the worst case for the modulo calculation and pseudo random data
+	 * at different alignments against the scalar implementation
+	 */
+	for( test_index = 0;
+	     test_index < 2;
+	     test_index++ )
+	{
+		if( test_index == 0 )
+		{
+			result = memory_set(
+			          buffer,
+			          0xff,
+			          sizeof( uint8_t ) * EWF_TEST_CHECKSUM_BUFFER_SIZE ) != NULL;
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+		}
+		else
+		{
+			ewf_test_checksum_fill_buffer(
+			 buffer,
+			 EWF_TEST_CHECKSUM_BUFFER_SIZE,
+			 0x87654321UL );
+		}
+		for( size_index = 0;
+		     size_index < 12;
+		     size_index++ )
+		{
+			for( initial_value_index = 0;
+			     initial_value_index < 3;
+			     initial_value_index++ )
+			{
+				for( buffer_offset = 0;
+				     buffer_offset < 4;
+				     buffer_offset++ )
+				{
+					result = libewf_deflate_calculate_adler32(
+					          &expected_checksum,
+					          &( buffer[ buffer_offset ] ),
+					          sizes[ size_index ],
+					          initial_values[ initial_value_index ],
+					          &error );
+
+					EWF_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 1 );
+
+					EWF_TEST_ASSERT_IS_NULL(
+					 "error",
+					 error );
+
+					result = libewf_checksum_calculate_adler32(
+					          &checksum,
+					          &( buffer[ buffer_offset ] ),
+					          sizes[ size_index ],
+					          initial_values[ initial_value_index ],
+					          &error );
+
+					EWF_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 1 );
+
+					EWF_TEST_ASSERT_EQUAL_UINT32(
+					 "checksum",
+					 checksum,
+					 expected_checksum );
+
+					EWF_TEST_ASSERT_IS_NULL(
+					 "error",
+					 error );
+				}
+			}
+		}
+	}
+	/* Test error cases
+	 */
+	result = libewf_checksum_calculate_adler32(
+	          NULL,
+	          buffer,
+	          32768,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_checksum_calculate_adler32(
+	          &checksum,
+	          NULL,
+	          32768,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_checksum_calculate_adler32(
+	          &checksum,
+	          buffer,
+	          (size_t) SSIZE_MAX + 1,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	memory_free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_checksum_get_adler32_blocks_function",
+	 ewf_test_checksum_get_adler32_blocks_function );
+
+	EWF_TEST_RUN(
+	 "libewf_checksum_calculate_adler32",
+	 ewf_test_checksum_calculate_adler32 );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
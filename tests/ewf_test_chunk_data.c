@@ -1045,6 +1045,9 @@ on_error:
 int ewf_test_chunk_data_pack(
      void )
 {
+	uint8_t compressed_zero_byte_empty_block[ 16 ] = {
+		0x78, 0x9c, 0x63, 0x60, 0x18, 0x05, 0xa3, 0x60, 0x14, 0x0c, 0x77, 0x00, 0x00, 0x02, 0x00, 0x01 };
+
 	libcerror_error_t *error        = NULL;
 	libewf_chunk_data_t *chunk_data = NULL;
 	libewf_io_handle_t *io_handle   = NULL;
@@ -1099,6 +1102,7 @@ int ewf_test_chunk_data_pack(
 	          chunk_data,
 	          io_handle,
 	          NULL,
+	          NULL,
 	          0,
 	          0,
 	          &error );
@@ -1112,6 +1116,54 @@ int ewf_test_chunk_data_pack(
 	 "error",
 	 error );
 
+	/* Test that a zero byte chunk is not compressed but uses the compressed zero byte empty block
+	 */
+	chunk_data->range_flags = 0;
+
+	io_handle->compression_level = LIBEWF_COMPRESSION_DEFAULT;
+
+	result = libewf_chunk_data_pack(
+	          chunk_data,
+	          io_handle,
+	          NULL,
+	          compressed_zero_byte_empty_block,
+	          16,
+	          0,
+	          &error );
+
+	io_handle->compression_level = LIBEWF_COMPRESSION_NONE;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = (int) ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data->data_size",
+	 chunk_data->data_size,
+	 (size_t) 16 );
+
+	result = memory_compare(
+	          chunk_data->data,
+	          compressed_zero_byte_empty_block,
+	          16 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
 	/* Test error cases
 	 */
 	chunk_data->range_flags = 0;
@@ -1120,6 +1172,7 @@ int ewf_test_chunk_data_pack(
 	          NULL,
 	          io_handle,
 	          NULL,
+	          NULL,
 	          0,
 	          0,
 	          &error );
@@ -1144,6 +1197,7 @@ int ewf_test_chunk_data_pack(
 	          chunk_data,
 	          io_handle,
 	          NULL,
+	          NULL,
 	          0,
 	          0,
 	          &error );
@@ -1166,6 +1220,7 @@ int ewf_test_chunk_data_pack(
 	          chunk_data,
 	          NULL,
 	          NULL,
+	          NULL,
 	          0,
 	          0,
 	          &error );
@@ -1188,6 +1243,7 @@ int ewf_test_chunk_data_pack(
 	          chunk_data,
 	          io_handle,
 	          NULL,
+	          NULL,
 	          0,
 	          0,
 	          &error );
@@ -1540,6 +1596,532 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_chunk_data_unpack_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_unpack_buffer(
+     void )
+{
+	uint8_t buffer[ 512 ];
+
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_data_t *chunk_data = NULL;
+	libewf_io_handle_t *io_handle   = NULL;
+	size_t buffer_offset            = 0;
+	ssize_t unpack_count            = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data->data_size = 512;
+
+	/* Test regular cases
+	 */
+	unpack_count = libewf_chunk_data_unpack_buffer(
+	                chunk_data,
+	                io_handle,
+	                buffer,
+	                512,
+	                &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "unpack_count",
+	 unpack_count,
+	 (ssize_t) 512 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test unpacking a pattern fill chunk
+	 */
+	for( buffer_offset = 0;
+	     buffer_offset < 8;
+	     buffer_offset++ )
+	{
+		( chunk_data->data )[ buffer_offset ] = (uint8_t) ( 'A' + buffer_offset );
+	}
+	chunk_data->data_size   = 8;
+	chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL;
+
+	unpack_count = libewf_chunk_data_unpack_buffer(
+	                chunk_data,
+	                io_handle,
+	                buffer,
+	                512,
+	                &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "unpack_count",
+	 unpack_count,
+	 (ssize_t) 512 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 (uint8_t) 'A' );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 511 ]",
+	 buffer[ 511 ],
+	 (uint8_t) 'H' );
+
+	/* The chunk data itself remains packed
+	 */
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data->data_size",
+	 chunk_data->data_size,
+	 (size_t) 8 );
+
+	/* Test error cases
+	 */
+	unpack_count = libewf_chunk_data_unpack_buffer(
+	                NULL,
+	                io_handle,
+	                buffer,
+	                512,
+	                &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "unpack_count",
+	 unpack_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	unpack_count = libewf_chunk_data_unpack_buffer(
+	                chunk_data,
+	                NULL,
+	                buffer,
+	                512,
+	                &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "unpack_count",
+	 unpack_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	unpack_count = libewf_chunk_data_unpack_buffer(
+	                chunk_data,
+	                io_handle,
+	                NULL,
+	                512,
+	                &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "unpack_count",
+	 unpack_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	unpack_count = libewf_chunk_data_unpack_buffer(
+	                chunk_data,
+	                io_handle,
+	                buffer,
+	                256,
+	                &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "unpack_count",
+	 unpack_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	unpack_count = libewf_chunk_data_unpack_buffer(
+	                chunk_data,
+	                io_handle,
+	                buffer,
+	                (size_t) SSIZE_MAX + 1,
+	                &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "unpack_count",
+	 unpack_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_fill_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_fill_buffer(
+     void )
+{
+	uint8_t buffer[ 509 ];
+	uint8_t fill_pattern[ 8 ]      = { 'f', 'i', 'l', 'l', 'p', 'a', 't', 't' };
+	uint8_t zero_fill_pattern[ 8 ] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+	libcerror_error_t *error = NULL;
+	size_t buffer_offset     = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_fill_buffer(
+	          buffer,
+	          509,
+	          fill_pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( buffer_offset = 0;
+	     buffer_offset < 509;
+	     buffer_offset++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_UINT8(
+		 "buffer[ buffer_offset ]",
+		 buffer[ buffer_offset ],
+		 fill_pattern[ buffer_offset % 8 ] );
+	}
+	result = libewf_chunk_data_fill_buffer(
+	          buffer,
+	          509,
+	          zero_fill_pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( buffer_offset = 0;
+	     buffer_offset < 509;
+	     buffer_offset++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_UINT8(
+		 "buffer[ buffer_offset ]",
+		 buffer[ buffer_offset ],
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_fill_buffer(
+	          NULL,
+	          509,
+	          fill_pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_fill_buffer(
+	          buffer,
+	          (size_t) SSIZE_MAX + 1,
+	          fill_pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_fill_buffer(
+	          buffer,
+	          509,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_get_compare_fill_blocks_function function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_get_compare_fill_blocks_function(
+     void )
+{
+	uint8_t buffer[ 256 ];
+
+	int (*compare_fill_blocks_function)(
+	       const uint8_t *data,
+	       size_t number_of_blocks,
+	       uint64_t fill_pattern ) = NULL;
+
+	void *memset_result            = NULL;
+	size_t buffer_offset           = 0;
+	int result                     = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_get_compare_fill_blocks_function(
+	          &compare_fill_blocks_function );
+
+	if( result == 0 )
+	{
+		/* The CPU does not support the SIMD functions
+		 */
+		EWF_TEST_ASSERT_IS_NULL(
+		 "compare_fill_blocks_function",
+		 compare_fill_blocks_function );
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "compare_fill_blocks_function",
+		 compare_fill_blocks_function );
+
+		memset_result = memory_set(
+		                 buffer,
+		                 0xa5,
+		                 256 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "memset_result",
+		 memset_result );
+
+		result = compare_fill_blocks_function(
+		          buffer,
+		          8,
+		          (uint64_t) 0xa5a5a5a5a5a5a5a5ULL );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = compare_fill_blocks_function(
+		          &( buffer[ 3 ] ),
+		          7,
+		          (uint64_t) 0xa5a5a5a5a5a5a5a5ULL );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		/* Test a difference at every offset of the blocks
+		 */
+		for( buffer_offset = 0;
+		     buffer_offset < 256;
+		     buffer_offset++ )
+		{
+			buffer[ buffer_offset ] = 0;
+
+			result = compare_fill_blocks_function(
+			          buffer,
+			          8,
+			          (uint64_t) 0xa5a5a5a5a5a5a5a5ULL );
+
+			buffer[ buffer_offset ] = 0xa5;
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+		/* Test that data after the blocks is not compared
+		 */
+		buffer[ 224 ] = 0;
+
+		result = compare_fill_blocks_function(
+		          buffer,
+		          7,
+		          (uint64_t) 0xa5a5a5a5a5a5a5a5ULL );
+
+		buffer[ 224 ] = 0xa5;
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_get_compare_fill_blocks_function(
+	          NULL );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
 /* Tests the libewf_chunk_data_check_for_empty_block function
  * Returns 1 if successful or 0 if not
  */
@@ -1550,6 +2132,7 @@ int ewf_test_chunk_data_check_for_empty_block(
 
 	libcerror_error_t *error = NULL;
 	void *memset_result      = NULL;
+	size_t buffer_offset     = 0;
 	int result               = 0;
 
 	/* Initialize test
@@ -1611,6 +2194,53 @@ int ewf_test_chunk_data_check_for_empty_block(
 	 "error",
 	 error );
 
+	/* Test a difference at every offset, both inside and outside the first and last cache line
+	 */
+	for( buffer_offset = 0;
+	     buffer_offset < 512;
+	     buffer_offset++ )
+	{
+		buffer[ buffer_offset ] = (uint8_t) 'A';
+
+		result = libewf_chunk_data_check_for_empty_block(
+		          buffer,
+		          512,
+		          &error );
+
+		buffer[ buffer_offset ] = 0;
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( buffer_offset = 1;
+	     buffer_offset < 512;
+	     buffer_offset++ )
+	{
+		buffer[ buffer_offset ] = (uint8_t) 'A';
+
+		result = libewf_chunk_data_check_for_empty_block(
+		          &( buffer[ 1 ] ),
+		          512 - 1,
+		          &error );
+
+		buffer[ buffer_offset ] = 0;
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+
 	result = libewf_chunk_data_check_for_empty_block(
 	          buffer,
 	          0,
@@ -1696,6 +2326,7 @@ int ewf_test_chunk_data_check_for_64_bit_pattern_fill(
 
 	libcerror_error_t *error = NULL;
 	void *memset_result      = NULL;
+	size_t buffer_offset     = 0;
 	uint64_t pattern         = 0;
 	int result               = 0;
 
@@ -1766,7 +2397,7 @@ int ewf_test_chunk_data_check_for_64_bit_pattern_fill(
 	          &pattern,
 	          &error );
 
-	buffer[ 500 ] = 0;
+	buffer[ 500 ] = (uint8_t) 'X';
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
@@ -1782,6 +2413,115 @@ int ewf_test_chunk_data_check_for_64_bit_pattern_fill(
 	 "error",
 	 error );
 
+	/* Test a difference at every offset, both inside and outside the first and last cache line
+	 */
+	for( buffer_offset = 0;
+	     buffer_offset < 512;
+	     buffer_offset++ )
+	{
+		buffer[ buffer_offset ] = (uint8_t) 'A';
+
+		result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+		          buffer,
+		          512,
+		          &pattern,
+		          &error );
+
+		buffer[ buffer_offset ] = (uint8_t) 'X';
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test a pattern of different byte values
+	 */
+	for( buffer_offset = 0;
+	     buffer_offset < 512;
+	     buffer_offset++ )
+	{
+		buffer[ buffer_offset ] = (uint8_t) ( 'A' + ( buffer_offset % 8 ) );
+	}
+	pattern = 0;
+
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+	          buffer,
+	          512,
+	          &pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "pattern",
+	 pattern,
+	 (uint64_t) 0x4847464544434241UL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	pattern = 0;
+
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+	          &( buffer[ 8 ] ),
+	          512 - 16,
+	          &pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "pattern",
+	 pattern,
+	 (uint64_t) 0x4847464544434241UL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+	          &( buffer[ 1 ] ),
+	          512 - 8,
+	          &pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	buffer[ 300 ] = (uint8_t) 'Z';
+
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+	          buffer,
+	          512,
+	          &pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libewf_chunk_data_check_for_64_bit_pattern_fill(
 	          buffer,
 	          0,
@@ -2010,6 +2750,184 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_chunk_data_write_to_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_write_to_buffer(
+     void )
+{
+	uint8_t buffer[ 1024 ];
+
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_data_t *chunk_data = NULL;
+	ssize_t write_count             = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data->data_size = 512;
+
+	memory_set(
+	 chunk_data->data,
+	 'A',
+	 512 );
+
+	/* Test regular cases
+	 */
+	write_count = libewf_chunk_data_write_to_buffer(
+	               chunk_data,
+	               buffer,
+	               1024,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 512 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          chunk_data->data,
+	          512 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	write_count = libewf_chunk_data_write_to_buffer(
+	               NULL,
+	               buffer,
+	               1024,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libewf_chunk_data_write_to_buffer(
+	               chunk_data,
+	               NULL,
+	               1024,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libewf_chunk_data_write_to_buffer(
+	               chunk_data,
+	               buffer,
+	               (size_t) SSIZE_MAX + 1,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libewf_chunk_data_write_to_buffer(
+	               chunk_data,
+	               buffer,
+	               256,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_chunk_data_get_write_size function
  * Returns 1 if successful or 0 if not
  */
@@ -2392,6 +3310,18 @@ int main(
 	 "libewf_chunk_data_unpack",
 	 ewf_test_chunk_data_unpack );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_unpack_buffer",
+	 ewf_test_chunk_data_unpack_buffer );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_fill_buffer",
+	 ewf_test_chunk_data_fill_buffer );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_get_compare_fill_blocks_function",
+	 ewf_test_chunk_data_get_compare_fill_blocks_function );
+
 	EWF_TEST_RUN(
 	 "libewf_chunk_data_check_for_empty_block",
 	 ewf_test_chunk_data_check_for_empty_block );
@@ -2404,6 +3334,10 @@ int main(
 	 "libewf_chunk_data_write",
 	 ewf_test_chunk_data_write );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_write_to_buffer",
+	 ewf_test_chunk_data_write_to_buffer );
+
 	EWF_TEST_RUN(
 	 "libewf_chunk_data_get_write_size",
 	 ewf_test_chunk_data_get_write_size );
@@ -35,6 +35,8 @@
 #include "ewf_test_unused.h"
 
 #include "../libewf/libewf_chunk_group.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_io_handle.h"
 #include "../libewf/libewf_section_descriptor.h"
 
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
@@ -790,6 +792,401 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_chunk_group_append_chunk function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_group_append_chunk(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_group_t *chunk_group = NULL;
+	libewf_io_handle_t *io_handle     = NULL;
+	off64_t chunk_data_offset         = 0;
+	off64_t element_data_offset       = 0;
+	size64_t chunk_data_size          = 0;
+	uint32_t range_flags              = 0;
+	int element_index                 = 0;
+	int file_io_pool_entry            = 0;
+	int number_of_chunks              = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A chunk group of a file opened read-only uses a packed chunk index
+	 */
+	io_handle->access_flags = LIBEWF_ACCESS_FLAG_READ;
+	io_handle->chunk_size   = 32768;
+
+	result = libewf_chunk_group_initialize(
+	          &chunk_group,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_group",
+	 chunk_group );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_group->packed_chunk_index",
+	 chunk_group->packed_chunk_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_group_append_chunk(
+	          chunk_group,
+	          &element_index,
+	          1,
+	          0x0000004cUL,
+	          32772,
+	          LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_append_chunk(
+	          chunk_group,
+	          &element_index,
+	          1,
+	          0x00008050UL,
+	          1024,
+	          LIBEWF_RANGE_FLAG_IS_COMPRESSED,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_group->packed_chunk_index",
+	 chunk_group->packed_chunk_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_get_number_of_chunks(
+	          chunk_group,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_chunks",
+	 number_of_chunks,
+	 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_get_chunk_at_offset(
+	          chunk_group,
+	          32768 + 100,
+	          &element_index,
+	          &element_data_offset,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "element_index",
+	 element_index,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "element_data_offset",
+	 (int64_t) element_data_offset,
+	 (int64_t) 100 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "chunk_data_offset",
+	 (int64_t) chunk_data_offset,
+	 (int64_t) 0x00008050UL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_data_size",
+	 (uint64_t) chunk_data_size,
+	 (uint64_t) 1024 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) LIBEWF_RANGE_FLAG_IS_COMPRESSED );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A chunk that cannot be packed moves the chunks into the chunks list
+	 */
+	result = libewf_chunk_group_append_chunk(
+	          chunk_group,
+	          &element_index,
+	          1,
+	          0x00008450UL,
+	          (size64_t) INT32_MAX,
+	          LIBEWF_RANGE_FLAG_HAS_CHECKSUM | LIBEWF_RANGE_FLAG_IS_CORRUPTED,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_group->packed_chunk_index",
+	 chunk_group->packed_chunk_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_get_number_of_chunks(
+	          chunk_group,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_chunks",
+	 number_of_chunks,
+	 3 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_get_chunk_by_index(
+	          chunk_group,
+	          0,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_entry",
+	 file_io_pool_entry,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "chunk_data_offset",
+	 (int64_t) chunk_data_offset,
+	 (int64_t) 0x0000004cUL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_data_size",
+	 (uint64_t) chunk_data_size,
+	 (uint64_t) 32772 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) LIBEWF_RANGE_FLAG_HAS_CHECKSUM );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_get_chunk_at_offset(
+	          chunk_group,
+	          ( 2 * 32768 ) + 8,
+	          &element_index,
+	          &element_data_offset,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "element_index",
+	 element_index,
+	 2 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "element_data_offset",
+	 (int64_t) element_data_offset,
+	 (int64_t) 8 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_data_size",
+	 (uint64_t) chunk_data_size,
+	 (uint64_t) INT32_MAX );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_group_append_chunk(
+	          NULL,
+	          &element_index,
+	          1,
+	          0x0000004cUL,
+	          32772,
+	          LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_group_get_chunk_at_offset(
+	          NULL,
+	          0,
+	          &element_index,
+	          &element_data_offset,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_group_free(
+	          &chunk_group,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_group",
+	 chunk_group );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_group != NULL )
+	{
+		libewf_chunk_group_free(
+		 &chunk_group,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_chunk_group_fill_v1 function
  * Returns 1 if successful or 0 if not
  */
@@ -1886,6 +2283,10 @@ int main(
 	 "libewf_chunk_group_clone",
 	 ewf_test_chunk_group_clone );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_group_append_chunk",
+	 ewf_test_chunk_group_append_chunk );
+
 	EWF_TEST_RUN(
 	 "libewf_chunk_group_fill_v1",
 	 ewf_test_chunk_group_fill_v1 );
@@ -34,8 +34,12 @@
 #include "ewf_test_memory.h"
 #include "ewf_test_unused.h"
 
+#include "../libewf/libewf_chunk_cache.h"
+#include "../libewf/libewf_chunk_data.h"
 #include "../libewf/libewf_chunk_table.h"
+#include "../libewf/libewf_definitions.h"
 #include "../libewf/libewf_io_handle.h"
+#include "../libewf/libewf_media_values.h"
 
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
@@ -1659,9 +1663,1113 @@ int ewf_test_chunk_table_get_chunk_data_by_offset(
 	          NULL,
 	          NULL,
 	          NULL,
+	          0,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_table_free(
+	          &chunk_table,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_table",
+	 chunk_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_table != NULL )
+	{
+		libewf_chunk_table_free(
+		 &chunk_table,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_table_get_cached_chunk_view and libewf_chunk_table_release_chunk_view functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_table_get_cached_chunk_view(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libewf_chunk_data_t *cached_chunk_data = NULL;
+	libewf_chunk_data_t *chunk_data        = NULL;
+	libewf_chunk_data_t *chunk_view        = NULL;
+	libewf_chunk_table_t *chunk_table      = NULL;
+	libewf_io_handle_t *io_handle          = NULL;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_table_initialize(
+	          &chunk_table,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_table",
+	 chunk_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_set_chunk_data(
+	          chunk_table->chunk_cache,
+	          0,
+	          chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The chunk cache takes over management of the chunk data
+	 */
+	cached_chunk_data = chunk_data;
+	chunk_data        = NULL;
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_table_get_cached_chunk_view(
+	          chunk_table,
+	          0,
+	          &chunk_view,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INTPTR(
+	 "chunk_view",
+	 (intptr_t) chunk_view,
+	 (intptr_t) cached_chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "cached_chunk_data->number_of_references",
+	 cached_chunk_data->number_of_references,
+	 1 );
+
+	result = libewf_chunk_table_release_chunk_view(
+	          chunk_table,
+	          &chunk_view,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_view",
+	 chunk_view );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "cached_chunk_data->number_of_references",
+	 cached_chunk_data->number_of_references,
+	 0 );
+
+	/* Test a chunk that is not cached
+	 */
+	result = libewf_chunk_table_get_cached_chunk_view(
+	          chunk_table,
+	          1,
+	          &chunk_view,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_view",
+	 chunk_view );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test if corrupted chunk data is not referenced
+	 */
+	cached_chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+
+	result = libewf_chunk_table_get_cached_chunk_view(
+	          chunk_table,
+	          0,
+	          &chunk_view,
+	          &error );
+
+	cached_chunk_data->range_flags &= ~( LIBEWF_RANGE_FLAG_IS_CORRUPTED );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_view",
+	 chunk_view );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "cached_chunk_data->number_of_references",
+	 cached_chunk_data->number_of_references,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_table_get_cached_chunk_view(
+	          NULL,
+	          0,
+	          &chunk_view,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_table_get_cached_chunk_view(
+	          chunk_table,
+	          0,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_table_release_chunk_view(
+	          NULL,
+	          &chunk_view,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_table_release_chunk_view(
+	          chunk_table,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test releasing a view that is not referenced
+	 */
+	chunk_view = cached_chunk_data;
+
+	result = libewf_chunk_table_release_chunk_view(
+	          chunk_table,
+	          &chunk_view,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_table_free(
+	          &chunk_table,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_table",
+	 chunk_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( chunk_table != NULL )
+	{
+		libewf_chunk_table_free(
+		 &chunk_table,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_table_get_shared_fill_chunk_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_table_get_shared_fill_chunk_data(
+     void )
+{
+	uint8_t fill_pattern[ 8 ]             = { 0, 0, 0, 0, 0, 0, 0, 0 };
+	uint8_t pattern_fill_pattern[ 8 ]     = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+	libcerror_error_t *error              = NULL;
+	libewf_chunk_data_t *chunk_data       = NULL;
+	libewf_chunk_data_t *fill_chunk_data  = NULL;
+	libewf_chunk_table_t *chunk_table     = NULL;
+	libewf_io_handle_t *io_handle         = NULL;
+	libewf_media_values_t *media_values   = NULL;
+	int result                            = 0;
+	int shared_fill_chunk_index           = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_media_values_initialize(
+	          &media_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "media_values",
+	 media_values );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	media_values->chunk_size       = 512;
+	media_values->media_size       = 1436;
+	media_values->number_of_chunks = 3;
+
+	result = libewf_chunk_table_initialize(
+	          &chunk_table,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_table",
+	 chunk_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_table_get_shared_fill_chunk_data(
+	          chunk_table,
+	          0,
+	          media_values,
+	          fill_pattern,
+	          &fill_chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "fill_chunk_data",
+	 fill_chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "fill_chunk_data->data_size",
+	 fill_chunk_data->data_size,
+	 (size_t) 512 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "fill_chunk_data->is_shared",
+	 fill_chunk_data->is_shared,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "fill_chunk_data->data[ 511 ]",
+	 fill_chunk_data->data[ 511 ],
+	 0 );
+
+	/* Test if chunks with the same fill pattern and data size share the fill chunk data
+	 */
+	result = libewf_chunk_table_get_shared_fill_chunk_data(
+	          chunk_table,
+	          1,
+	          media_values,
+	          fill_pattern,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INTPTR(
+	 "chunk_data",
+	 (intptr_t) chunk_data,
+	 (intptr_t) fill_chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test if a different fill pattern does not share the fill chunk data
+	 */
+	chunk_data = NULL;
+
+	result = libewf_chunk_table_get_shared_fill_chunk_data(
+	          chunk_table,
+	          1,
+	          media_values,
+	          pattern_fill_pattern,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INTPTR(
+	 "chunk_data",
+	 (intptr_t) chunk_data,
+	 (intptr_t) fill_chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "chunk_data->data[ 0 ]",
+	 chunk_data->data[ 0 ],
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "chunk_data->data[ 15 ]",
+	 chunk_data->data[ 15 ],
+	 8 );
+
+	/* Test if a different data size does not share the fill chunk data
+	 */
+	chunk_data = NULL;
+
+	result = libewf_chunk_table_get_shared_fill_chunk_data(
+	          chunk_table,
+	          2,
+	          media_values,
+	          fill_pattern,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INTPTR(
+	 "chunk_data",
+	 (intptr_t) chunk_data,
+	 (intptr_t) fill_chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data->data_size",
+	 chunk_data->data_size,
+	 (size_t) 412 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_table->number_of_shared_fill_chunks",
+	 chunk_table->number_of_shared_fill_chunks,
+	 3 );
+
+	/* Test if releasing a view of shared fill chunk data does not change the number of references
+	 */
+	result = libewf_chunk_table_release_chunk_view(
+	          chunk_table,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "fill_chunk_data->number_of_references",
+	 fill_chunk_data->number_of_references,
+	 0 );
+
+	/* Test if no more shared fill chunk data is created when the maximum was reached
+	 */
+	for( shared_fill_chunk_index = 3;
+	     shared_fill_chunk_index <= LIBEWF_MAXIMUM_NUMBER_OF_SHARED_FILL_CHUNKS;
+	     shared_fill_chunk_index++ )
+	{
+		pattern_fill_pattern[ 0 ] = (uint8_t) ( 0x10 + shared_fill_chunk_index );
+
+		chunk_data = NULL;
+
+		result = libewf_chunk_table_get_shared_fill_chunk_data(
+		          chunk_table,
+		          0,
+		          media_values,
+		          pattern_fill_pattern,
+		          &chunk_data,
+		          &error );
+
+		if( shared_fill_chunk_index < LIBEWF_MAXIMUM_NUMBER_OF_SHARED_FILL_CHUNKS )
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "chunk_data",
+			 chunk_data );
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_data",
+			 chunk_data );
+		}
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_table->number_of_shared_fill_chunks",
+	 chunk_table->number_of_shared_fill_chunks,
+	 LIBEWF_MAXIMUM_NUMBER_OF_SHARED_FILL_CHUNKS );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_table_get_shared_fill_chunk_data(
+	          NULL,
+	          0,
+	          media_values,
+	          fill_pattern,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_table_get_shared_fill_chunk_data(
+	          chunk_table,
+	          0,
+	          NULL,
+	          fill_pattern,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_table_get_shared_fill_chunk_data(
+	          chunk_table,
+	          0,
+	          media_values,
+	          NULL,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_table_get_shared_fill_chunk_data(
+	          chunk_table,
+	          0,
+	          media_values,
+	          fill_pattern,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_table_free(
+	          &chunk_table,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_table",
+	 chunk_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_media_values_free(
+	          &media_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "media_values",
+	 media_values );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_table != NULL )
+	{
+		libewf_chunk_table_free(
+		 &chunk_table,
+		 NULL );
+	}
+	if( media_values != NULL )
+	{
+		libewf_media_values_free(
+		 &media_values,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_table_read_packed_chunk_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_table_read_packed_chunk_data(
+     void )
+{
+	uint8_t buffer[ 512 ];
+
+	libcerror_error_t *error               = NULL;
+	libewf_chunk_data_t *cached_chunk_data = NULL;
+	libewf_chunk_data_t *chunk_data        = NULL;
+	libewf_chunk_table_t *chunk_table      = NULL;
+	libewf_io_handle_t *io_handle          = NULL;
+	libewf_media_values_t *media_values    = NULL;
+	size_t data_size                       = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_media_values_initialize(
+	          &media_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "media_values",
+	 media_values );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	media_values->chunk_size       = 512;
+	media_values->media_size       = 1024;
+	media_values->number_of_chunks = 2;
+
+	result = libewf_chunk_table_initialize(
+	          &chunk_table,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_table",
+	 chunk_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data->data[ 0 ]   = 0x41;
+	chunk_data->data[ 511 ] = 0x5a;
+	chunk_data->data_size   = 512;
+
+	result = libewf_chunk_cache_set_chunk_data(
+	          chunk_table->chunk_cache,
+	          0,
+	          chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The chunk cache takes over management of the chunk data
+	 */
+	cached_chunk_data = chunk_data;
+	chunk_data        = NULL;
+
+	/* Test if cached chunk data is copied into the buffer
+	 */
+	result = libewf_chunk_table_read_packed_chunk_data(
+	          chunk_table,
+	          0,
+	          NULL,
+	          media_values,
+	          NULL,
+	          NULL,
+	          buffer,
+	          512,
+	          &data_size,
+	          &chunk_data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) 512 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 0x41 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 511 ]",
+	 buffer[ 511 ],
+	 0x5a );
+
+	/* Test if the cached chunk data is no longer referenced after the copy
+	 */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "cached_chunk_data->number_of_references",
+	 cached_chunk_data->number_of_references,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_table_read_packed_chunk_data(
+	          NULL,
+	          0,
+	          NULL,
+	          media_values,
+	          NULL,
 	          NULL,
+	          buffer,
+	          512,
+	          &data_size,
+	          &chunk_data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_table_read_packed_chunk_data(
+	          chunk_table,
+	          0,
+	          NULL,
+	          media_values,
+	          NULL,
+	          NULL,
+	          buffer,
+	          256,
+	          &data_size,
+	          &chunk_data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_table_read_packed_chunk_data(
+	          chunk_table,
 	          0,
 	          NULL,
+	          media_values,
+	          NULL,
+	          NULL,
+	          buffer,
+	          512,
+	          NULL,
+	          &chunk_data,
 	          NULL,
 	          &error );
 
@@ -1696,6 +2804,23 @@ int ewf_test_chunk_table_get_chunk_data_by_offset(
 	 "error",
 	 error );
 
+	result = libewf_media_values_free(
+	          &media_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "media_values",
+	 media_values );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libewf_io_handle_free(
 	          &io_handle,
 	          &error );
@@ -1721,12 +2846,24 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
 	if( chunk_table != NULL )
 	{
 		libewf_chunk_table_free(
 		 &chunk_table,
 		 NULL );
 	}
+	if( media_values != NULL )
+	{
+		libewf_media_values_free(
+		 &media_values,
+		 NULL );
+	}
 	if( io_handle != NULL )
 	{
 		libewf_io_handle_free(
@@ -1793,6 +2930,18 @@ int main(
 
 	/* TODO: add tests for libewf_chunk_table_set_chunk_data_by_offset */
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_table_get_cached_chunk_view",
+	 ewf_test_chunk_table_get_cached_chunk_view );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_table_get_shared_fill_chunk_data",
+	 ewf_test_chunk_table_get_shared_fill_chunk_data );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_table_read_packed_chunk_data",
+	 ewf_test_chunk_table_read_packed_chunk_data );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
@@ -0,0 +1,403 @@
+/*
+ * Library compression benchmark testing program
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_compression.h"
+#include "../libewf/libewf_compression_context.h"
+#include "../libewf/libewf_definitions.h"
+
+#define EWF_TEST_COMPRESSION_BENCHMARK_CHUNK_SIZE		32768
+#define EWF_TEST_COMPRESSION_BENCHMARK_NUMBER_OF_ITERATIONS	512
+
+/* The number of chunks of a 64 GiB acquisition
+ */
+#define EWF_TEST_COMPRESSION_BENCHMARK_NUMBER_OF_ACQUISITION_CHUNKS	( ( (uint64_t) 64 * 1024 * 1024 * 1024 ) / EWF_TEST_COMPRESSION_BENCHMARK_CHUNK_SIZE )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Retrieves a timestamp in micro seconds
+ * Returns the timestamp
+ */
+uint64_t ewf_test_compression_benchmark_get_timestamp(
+          void )
+{
+#if defined( HAVE_CLOCK_GETTIME )
+	struct timespec time_structure;
+
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_structure.tv_sec * 1000000 ) + ( (uint64_t) time_structure.tv_nsec / 1000 ) );
+#else
+	return( (uint64_t) time( NULL ) * 1000000 );
+#endif
+}
+
+/* Fills the chunk with partially compressible data that differs per chunk
+ */
+void ewf_test_compression_benchmark_fill_chunk(
+      uint8_t *chunk_data,
+      size_t chunk_data_size,
+      uint32_t chunk_index )
+{
+	size_t chunk_data_offset = 0;
+	uint32_t value_32bit     = 0;
+
+	value_32bit = ( chunk_index * 2654435761UL ) + 1;
+
+	for( chunk_data_offset = 0;
+	     chunk_data_offset < chunk_data_size;
+	     chunk_data_offset++ )
+	{
+		value_32bit = ( value_32bit * 1103515245UL ) + 12345;
+
+		if( ( chunk_data_offset % 64 ) < 48 )
+		{
+			chunk_data[ chunk_data_offset ] = (uint8_t) ( 'a' + ( ( chunk_data_offset / 16 ) % 26 ) );
+		}
+		else
+		{
+			chunk_data[ chunk_data_offset ] = (uint8_t) ( value_32bit >> 24 );
+		}
+	}
+}
+
+/* Prints the benchmark results
+ */
+void ewf_test_compression_benchmark_print_results(
+      const char *function_name,
+      uint64_t number_of_bytes,
+      uint64_t elapsed_time,
+      uint64_t number_of_initializations )
+{
+	uint64_t estimated_number_of_initializations = 0;
+
+	/* The throughput is informational only, it depends on the system
+	 */
+	if( elapsed_time == 0 )
+	{
+		elapsed_time = 1;
+	}
+	fprintf(
+	 stdout,
+	 "%s: %" PRIu64 " bytes in %" PRIu64 " us (%" PRIu64 " MiB/s), %" PRIu64 " compression state initializations\n",
+	 function_name,
+	 number_of_bytes,
+	 elapsed_time,
+	 ( number_of_bytes * 1000000 / elapsed_time ) / ( 1024 * 1024 ),
+	 number_of_initializations );
+
+	/* A compression state that is initialized per chunk is initialized for every chunk
+	 * of the acquisition, a reused compression state is only initialized once
+	 */
+	if( number_of_initializations > 1 )
+	{
+		estimated_number_of_initializations = EWF_TEST_COMPRESSION_BENCHMARK_NUMBER_OF_ACQUISITION_CHUNKS;
+	}
+	else
+	{
+		estimated_number_of_initializations = number_of_initializations;
+	}
+	fprintf(
+	 stdout,
+	 "%s: estimated for a 64 GiB acquisition: %" PRIu64 " s, %" PRIu64 " compression state initializations\n",
+	 function_name,
+	 ( elapsed_time * ( EWF_TEST_COMPRESSION_BENCHMARK_NUMBER_OF_ACQUISITION_CHUNKS / EWF_TEST_COMPRESSION_BENCHMARK_NUMBER_OF_ITERATIONS ) ) / 1000000,
+	 estimated_number_of_initializations );
+}
+
+/* Benchmarks the libewf_compress_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_benchmark_compress_data(
+     void )
+{
+	uint8_t chunk_data[ EWF_TEST_COMPRESSION_BENCHMARK_CHUNK_SIZE ];
+	uint8_t compressed_data[ 2 * EWF_TEST_COMPRESSION_BENCHMARK_CHUNK_SIZE ];
+
+	libcerror_error_t *error    = NULL;
+	uint64_t elapsed_time       = 0;
+	uint64_t number_of_bytes    = 0;
+	uint64_t start_time         = 0;
+	size_t compressed_data_size = 0;
+	uint32_t iteration          = 0;
+	int result                  = 0;
+
+	start_time = ewf_test_compression_benchmark_get_timestamp();
+
+	for( iteration = 0;
+	     iteration < EWF_TEST_COMPRESSION_BENCHMARK_NUMBER_OF_ITERATIONS;
+	     iteration++ )
+	{
+		ewf_test_compression_benchmark_fill_chunk(
+		 chunk_data,
+		 EWF_TEST_COMPRESSION_BENCHMARK_CHUNK_SIZE,
+		 iteration );
+
+		compressed_data_size = 2 * EWF_TEST_COMPRESSION_BENCHMARK_CHUNK_SIZE;
+
+		result = libewf_compress_data(
+		          compressed_data,
+		          &compressed_data_size,
+		          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+		          LIBEWF_COMPRESSION_DEFAULT,
+		          chunk_data,
+		          EWF_TEST_COMPRESSION_BENCHMARK_CHUNK_SIZE,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		number_of_bytes += EWF_TEST_COMPRESSION_BENCHMARK_CHUNK_SIZE;
+	}
+	elapsed_time = ewf_test_compression_benchmark_get_timestamp() - start_time;
+
+	/* libewf_compress_data initializes a compression state for every chunk
+	 */
+	ewf_test_compression_benchmark_print_results(
+	 "libewf_compress_data",
+	 number_of_bytes,
+	 elapsed_time,
+	 (uint64_t) EWF_TEST_COMPRESSION_BENCHMARK_NUMBER_OF_ITERATIONS );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Benchmarks the libewf_compression_context_compress_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_benchmark_compression_context_compress_data(
+     void )
+{
+	uint8_t chunk_data[ EWF_TEST_COMPRESSION_BENCHMARK_CHUNK_SIZE ];
+	uint8_t compressed_data[ 2 * EWF_TEST_COMPRESSION_BENCHMARK_CHUNK_SIZE ];
+	uint8_t verification_data[ EWF_TEST_COMPRESSION_BENCHMARK_CHUNK_SIZE ];
+
+	libcerror_error_t *error                          = NULL;
+	libewf_compression_context_t *compression_context = NULL;
+	uint64_t elapsed_time                             = 0;
+	uint64_t number_of_bytes                          = 0;
+	uint64_t number_of_initializations                = 0;
+	uint64_t start_time                               = 0;
+	size_t compressed_data_size                       = 0;
+	size_t verification_data_size                     = 0;
+	uint32_t iteration                                = 0;
+	int result                                        = 0;
+
+	result = libewf_compression_context_initialize(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	start_time = ewf_test_compression_benchmark_get_timestamp();
+
+	for( iteration = 0;
+	     iteration < EWF_TEST_COMPRESSION_BENCHMARK_NUMBER_OF_ITERATIONS;
+	     iteration++ )
+	{
+		ewf_test_compression_benchmark_fill_chunk(
+		 chunk_data,
+		 EWF_TEST_COMPRESSION_BENCHMARK_CHUNK_SIZE,
+		 iteration );
+
+		compressed_data_size = 2 * EWF_TEST_COMPRESSION_BENCHMARK_CHUNK_SIZE;
+
+		result = libewf_compression_context_compress_data(
+		          compression_context,
+		          compressed_data,
+		          &compressed_data_size,
+		          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+		          LIBEWF_COMPRESSION_DEFAULT,
+		          chunk_data,
+		          EWF_TEST_COMPRESSION_BENCHMARK_CHUNK_SIZE,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		number_of_bytes += EWF_TEST_COMPRESSION_BENCHMARK_CHUNK_SIZE;
+	}
+	elapsed_time = ewf_test_compression_benchmark_get_timestamp() - start_time;
+
+	/* Make sure the last chunk compressed with the reused compression state is valid
+	 */
+	verification_data_size = EWF_TEST_COMPRESSION_BENCHMARK_CHUNK_SIZE;
+
+	result = libewf_decompress_data(
+	          compressed_data,
+	          compressed_data_size,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          verification_data,
+	          &verification_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          verification_data,
+	          chunk_data,
+	          EWF_TEST_COMPRESSION_BENCHMARK_CHUNK_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+#if defined( HAVE_LIBEWF_COMPRESSION_CONTEXT_ZLIB_STREAM )
+	number_of_initializations = compression_context->number_of_initializations;
+#else
+	number_of_initializations = (uint64_t) EWF_TEST_COMPRESSION_BENCHMARK_NUMBER_OF_ITERATIONS;
+#endif
+	ewf_test_compression_benchmark_print_results(
+	 "libewf_compression_context_compress_data",
+	 number_of_bytes,
+	 elapsed_time,
+	 number_of_initializations );
+
+	result = libewf_compression_context_free(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_compress_data",
+	 ewf_test_compression_benchmark_compress_data );
+
+	EWF_TEST_RUN(
+	 "libewf_compression_context_compress_data",
+	 ewf_test_compression_benchmark_compression_context_compress_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -687,8 +687,180 @@ uint8_t ewf_test_deflate_uncompressed_byte_stream[ 7640 ] = {
 	0x72, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x74, 0x68, 0x65, 0x0a, 0x4c, 0x69,
 	0x62, 0x72, 0x61, 0x72, 0x79, 0x2e, 0x0a, 0x0a };
 
+uint8_t ewf_test_deflate_full_flush_compressed_byte_stream[ 63 ] = {
+	0x78, 0xda, 0xca, 0xc9, 0x4c, 0x4a, 0x2d, 0x4f, 0x53, 0x48, 0x49, 0x4d, 0xcb, 0x49, 0x2c, 0x49,
+	0x55, 0x28, 0x49, 0x2d, 0x2e, 0x51, 0x48, 0x49, 0x2c, 0x49, 0xd4, 0x51, 0xc8, 0x21, 0x43, 0x06,
+	0x00, 0x00, 0x00, 0xff, 0xff, 0x4b, 0xcb, 0x29, 0x2d, 0xce, 0x48, 0x4d, 0x51, 0x48, 0x49, 0x2c,
+	0x49, 0x54, 0x48, 0xcb, 0xcf, 0xc9, 0xc9, 0x2f, 0x2f, 0x06, 0x00, 0xe6, 0x45, 0x23, 0xc8 };
+
+uint8_t ewf_test_deflate_full_flush_uncompressed_byte_stream[ 98 ] = {
+	0x6c, 0x69, 0x62, 0x65, 0x77, 0x66, 0x20, 0x64, 0x65, 0x66, 0x6c, 0x61, 0x74, 0x65, 0x20, 0x74,
+	0x65, 0x73, 0x74, 0x20, 0x64, 0x61, 0x74, 0x61, 0x2c, 0x20, 0x6c, 0x69, 0x62, 0x65, 0x77, 0x66,
+	0x20, 0x64, 0x65, 0x66, 0x6c, 0x61, 0x74, 0x65, 0x20, 0x74, 0x65, 0x73, 0x74, 0x20, 0x64, 0x61,
+	0x74, 0x61, 0x2c, 0x20, 0x6c, 0x69, 0x62, 0x65, 0x77, 0x66, 0x20, 0x64, 0x65, 0x66, 0x6c, 0x61,
+	0x74, 0x65, 0x20, 0x74, 0x65, 0x73, 0x74, 0x20, 0x64, 0x61, 0x74, 0x61, 0x2c, 0x20, 0x66, 0x6c,
+	0x75, 0x73, 0x68, 0x65, 0x64, 0x20, 0x64, 0x61, 0x74, 0x61, 0x20, 0x66, 0x6f, 0x6c, 0x6c, 0x6f,
+	0x77, 0x73 };
+
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
+/* Tests the libewf_deflate_bit_stream_read function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_bit_stream_read(
+     void )
+{
+	libewf_deflate_bit_stream_t bit_stream;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	bit_stream.byte_stream        = ewf_test_deflate_compressed_byte_stream;
+	bit_stream.byte_stream_size   = 2627;
+	bit_stream.byte_stream_offset = 0;
+	bit_stream.bit_buffer         = 0;
+	bit_stream.bit_buffer_size    = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_deflate_bit_stream_read(
+	          &bit_stream,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "bit_stream.byte_stream_offset",
+	 bit_stream.byte_stream_offset,
+	 (size_t) 7 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "bit_stream.bit_buffer",
+	 bit_stream.bit_buffer,
+	 (uint64_t) 0x00db8f6d59bdda78ULL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_stream.bit_buffer_size",
+	 bit_stream.bit_buffer_size,
+	 (uint8_t) 56 );
+
+	/* Test a bit buffer that cannot hold another whole byte
+	 */
+	result = libewf_deflate_bit_stream_read(
+	          &bit_stream,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "bit_stream.byte_stream_offset",
+	 bit_stream.byte_stream_offset,
+	 (size_t) 7 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_stream.bit_buffer_size",
+	 bit_stream.bit_buffer_size,
+	 (uint8_t) 56 );
+
+	/* Test the end of the byte stream
+	 */
+	bit_stream.byte_stream_offset = 2624;
+	bit_stream.bit_buffer         = 0;
+	bit_stream.bit_buffer_size    = 0;
+
+	result = libewf_deflate_bit_stream_read(
+	          &bit_stream,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "bit_stream.byte_stream_offset",
+	 bit_stream.byte_stream_offset,
+	 (size_t) 2627 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "bit_stream.bit_buffer",
+	 bit_stream.bit_buffer,
+	 (uint64_t) 0x00a4564aULL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_stream.bit_buffer_size",
+	 bit_stream.bit_buffer_size,
+	 (uint8_t) 24 );
+
+	/* Test error cases
+	 */
+	result = libewf_deflate_bit_stream_read(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	bit_stream.byte_stream_offset = 2628;
+
+	result = libewf_deflate_bit_stream_read(
+	          &bit_stream,
+	          &error );
+
+	bit_stream.byte_stream_offset = 0;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_deflate_bit_stream_get_value function
  * Returns 1 if successful or 0 if not
  */
@@ -736,10 +908,10 @@ int ewf_test_deflate_bit_stream_get_value(
 	 bit_stream.byte_stream_offset,
 	 (size_t) 0 );
 
-	EWF_TEST_ASSERT_EQUAL_UINT32(
+	EWF_TEST_ASSERT_EQUAL_UINT64(
 	 "bit_stream.bit_buffer",
 	 bit_stream.bit_buffer,
-	 (uint32_t) 0x00000000UL );
+	 (uint64_t) 0x00000000UL );
 
 	EWF_TEST_ASSERT_EQUAL_UINT8(
 	 "bit_stream.bit_buffer_size",
@@ -771,10 +943,10 @@ int ewf_test_deflate_bit_stream_get_value(
 	 bit_stream.byte_stream_offset,
 	 (size_t) 1 );
 
-	EWF_TEST_ASSERT_EQUAL_UINT32(
+	EWF_TEST_ASSERT_EQUAL_UINT64(
 	 "bit_stream.bit_buffer",
 	 bit_stream.bit_buffer,
-	 (uint32_t) 0x00000007UL );
+	 (uint64_t) 0x00000007UL );
 
 	EWF_TEST_ASSERT_EQUAL_UINT8(
 	 "bit_stream.bit_buffer_size",
@@ -806,10 +978,10 @@ int ewf_test_deflate_bit_stream_get_value(
 	 bit_stream.byte_stream_offset,
 	 (size_t) 2 );
 
-	EWF_TEST_ASSERT_EQUAL_UINT32(
+	EWF_TEST_ASSERT_EQUAL_UINT64(
 	 "bit_stream.bit_buffer",
 	 bit_stream.bit_buffer,
-	 (uint32_t) 0x00000000UL );
+	 (uint64_t) 0x00000000UL );
 
 	EWF_TEST_ASSERT_EQUAL_UINT8(
 	 "bit_stream.bit_buffer_size",
@@ -841,10 +1013,10 @@ int ewf_test_deflate_bit_stream_get_value(
 	 bit_stream.byte_stream_offset,
 	 (size_t) 6 );
 
-	EWF_TEST_ASSERT_EQUAL_UINT32(
+	EWF_TEST_ASSERT_EQUAL_UINT64(
 	 "bit_stream.bit_buffer",
 	 bit_stream.bit_buffer,
-	 (uint32_t) 0x00000000UL );
+	 (uint64_t) 0x00000000UL );
 
 	EWF_TEST_ASSERT_EQUAL_UINT8(
 	 "bit_stream.bit_buffer_size",
@@ -956,7 +1128,7 @@ int ewf_test_deflate_huffman_table_construct(
 	int result                      = 0;
 
 #if defined( HAVE_EWF_TEST_MEMORY )
-	int number_of_memset_fail_tests = 2;
+	int number_of_memset_fail_tests = 3;
 	int test_number                 = 0;
 #endif
 
@@ -1276,7 +1448,7 @@ int ewf_test_deflate_initialize_dynamic_huffman_tables(
 	int result                      = 0;
 
 #if defined( HAVE_EWF_TEST_MEMORY )
-	int number_of_memset_fail_tests = 6;
+	int number_of_memset_fail_tests = 9;
 	int test_number                 = 0;
 #endif
 
@@ -1416,7 +1588,7 @@ int ewf_test_deflate_initialize_fixed_huffman_tables(
 	int result                      = 0;
 
 #if defined( HAVE_EWF_TEST_MEMORY )
-	int number_of_memset_fail_tests = 4;
+	int number_of_memset_fail_tests = 6;
 	int test_number                 = 0;
 #endif
 
@@ -2228,6 +2400,53 @@ int ewf_test_deflate_decompress_zlib(
 	 "error",
 	 error );
 
+	result = memory_compare(
+	          uncompressed_data,
+	          ewf_test_deflate_uncompressed_byte_stream,
+	          7640 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test data with an empty uncompressed block after a Huffman compressed block
+	 */
+	uncompressed_data_size = 8192;
+
+	result = libewf_deflate_decompress_zlib(
+	          ewf_test_deflate_full_flush_compressed_byte_stream,
+	          63,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) 98 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          uncompressed_data,
+	          ewf_test_deflate_full_flush_uncompressed_byte_stream,
+	          98 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	uncompressed_data_size = 7640;
+
 /* TODO: test uncompressed data too small */
 
 	/* Test error cases
@@ -2346,6 +2565,10 @@ int main(
 
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
+	EWF_TEST_RUN(
+	 "libewf_deflate_bit_stream_read",
+	 ewf_test_deflate_bit_stream_read );
+
 	EWF_TEST_RUN(
 	 "libewf_deflate_bit_stream_get_value",
 	 ewf_test_deflate_bit_stream_get_value );
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -2402,21 +2403,34 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_data_chunk function
+/* Tests the libewf_handle_pread_buffer function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_data_chunk(
+int ewf_test_handle_pread_buffer(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error        = NULL;
-	libewf_data_chunk_t *data_chunk = NULL;
-	int result                      = 0;
+	uint8_t buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+	uint8_t expected_buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
 
-	/* Test regular cases
+	libcerror_error_t *error      = NULL;
+	time_t timestamp              = 0;
+	size64_t media_size           = 0;
+	size64_t remaining_media_size = 0;
+	size_t read_size              = 0;
+	ssize_t read_count            = 0;
+	off64_t current_offset        = 0;
+	off64_t offset                = 0;
+	off64_t read_offset           = 0;
+	int number_of_tests           = 1024;
+	int random_number             = 0;
+	int result                    = 0;
+	int test_number               = 0;
+
+	/* Determine size
 	 */
-	result = libewf_handle_get_data_chunk(
+	result = libewf_handle_get_media_size(
 	          handle,
-	          &data_chunk,
+	          &media_size,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2428,187 +2442,194 @@ int ewf_test_handle_get_data_chunk(
 	 "error",
 	 error );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "data_chunk",
-	 data_chunk );
+	/* Make sure the current offset is not 0
+	 */
+	current_offset = (off64_t) ( media_size / 2 );
 
-	result = libewf_data_chunk_free(
-	          &data_chunk,
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          current_offset,
+	          SEEK_SET,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 current_offset );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
+	/* Test regular cases
 	 */
-	result = libewf_handle_get_data_chunk(
-	          NULL,
-	          &data_chunk,
-	          &error );
+	read_size = EWF_TEST_HANDLE_READ_BUFFER_SIZE;
 
-	EWF_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+	if( media_size < EWF_TEST_HANDLE_READ_BUFFER_SIZE )
+	{
+		read_size = (size_t) media_size;
+	}
+	read_count = libewf_handle_pread_buffer(
+	              handle,
+	              buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "data_chunk",
-	 data_chunk );
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	if( media_size > 8 )
+	{
+		/* Read buffer on media_size boundary
+		 */
+		read_count = libewf_handle_pread_buffer(
+		              handle,
+		              buffer,
+		              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+		              media_size - 8,
+		              &error );
 
-	result = libewf_handle_get_data_chunk(
-	          handle,
-	          NULL,
-	          &error );
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 8 );
 
-	EWF_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "data_chunk",
-	 data_chunk );
+		/* Read buffer beyond media_size boundary
+		 */
+		read_count = libewf_handle_pread_buffer(
+		              handle,
+		              buffer,
+		              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+		              media_size + 8,
+		              &error );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 0 );
 
-	libcerror_error_free(
-	 &error );
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Stress test read buffer and compare with libewf_handle_read_buffer_at_offset
+	 */
+	timestamp = time(
+	             NULL );
 
-	return( 1 );
+	srand(
+	 (unsigned int) timestamp );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	if( data_chunk != NULL )
+	for( test_number = 0;
+	     test_number < number_of_tests;
+	     test_number++ )
 	{
-		libewf_data_chunk_free(
-		 &data_chunk,
-		 NULL );
-	}
-	return( 0 );
-}
+		random_number = rand();
 
-/* Tests the libewf_handle_seek_offset function
- * Returns 1 if successful or 0 if not
- */
-int ewf_test_handle_seek_offset(
-     libewf_handle_t *handle )
-{
-	libcerror_error_t *error = NULL;
-	size64_t size            = 0;
-	off64_t offset           = 0;
+		EWF_TEST_ASSERT_GREATER_THAN_INT(
+		 "random_number",
+		 random_number,
+		 -1 );
 
-	/* Test regular cases
-	 */
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          0,
-	          SEEK_END,
-	          &error );
+		if( media_size > 0 )
+		{
+			read_offset = (off64_t) random_number % media_size;
+		}
+		read_size = (size_t) random_number % EWF_TEST_HANDLE_READ_BUFFER_SIZE;
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+		read_count = libewf_handle_pread_buffer(
+		              handle,
+		              buffer,
+		              read_size,
+		              read_offset,
+		              &error );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		remaining_media_size = media_size - read_offset;
 
-	size = (size64_t) offset;
+		if( read_size > remaining_media_size )
+		{
+			read_size = (size_t) remaining_media_size;
+		}
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) read_size );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          1024,
-	          SEEK_SET,
-	          &error );
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 1024 );
+		result = libewf_handle_get_offset(
+		          handle,
+		          &offset,
+		          &error );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          -512,
-	          SEEK_CUR,
-	          &error );
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 current_offset );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 512 );
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              expected_buffer,
+		              read_size,
+		              read_offset,
+		              &error );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          (off64_t) ( size + 512 ),
-	          SEEK_SET,
-	          &error );
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) read_size );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) ( size + 512 ) );
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		result = memory_compare(
+		          buffer,
+		          expected_buffer,
+		          read_size );
 
-	/* Reset offset to 0
-	 */
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          0,
-	          SEEK_SET,
-	          &error );
-
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
-
-	EWF_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
 
+		current_offset = read_offset + read_count;
+	}
 	/* Test error cases
 	 */
-	offset = libewf_handle_seek_offset(
-	          NULL,
-	          0,
-	          SEEK_SET,
-	          &error );
+	read_count = libewf_handle_pread_buffer(
+	              NULL,
+	              buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2617,16 +2638,17 @@ int ewf_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          -1,
-	          SEEK_SET,
-	          &error );
+	read_count = libewf_handle_pread_buffer(
+	              handle,
+	              NULL,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2635,31 +2657,36 @@ int ewf_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          -1,
-	          SEEK_CUR,
-	          &error );
+	read_count = libewf_handle_pread_buffer(
+	              handle,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          (off64_t) ( -1 * ( size + 1 ) ),
-	          SEEK_END,
-	          &error );
+	libcerror_error_free(
+	 &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	read_count = libewf_handle_pread_buffer(
+	              handle,
+	              buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              -1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2670,26 +2697,27 @@ int ewf_test_handle_seek_offset(
 
 #if defined( HAVE_EWF_TEST_RWLOCK )
 
-	/* Test libewf_handle_seek_offset with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
+	/* Test libewf_handle_pread_buffer with pthread_rwlock_rdlock failing in libcthreads_read_write_lock_grab_for_read
 	 */
-	ewf_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
+	ewf_test_pthread_rwlock_rdlock_attempts_before_fail = 0;
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          0,
-	          SEEK_SET,
-	          &error );
+	read_count = libewf_handle_pread_buffer(
+	              handle,
+	              buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
 
-	if( ewf_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
+	if( ewf_test_pthread_rwlock_rdlock_attempts_before_fail != -1 )
 	{
-		ewf_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
+		ewf_test_pthread_rwlock_rdlock_attempts_before_fail = -1;
 	}
 	else
 	{
-		EWF_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 (int64_t) offset,
-		 (int64_t) -1 );
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
 
 		EWF_TEST_ASSERT_IS_NOT_NULL(
 		 "error",
@@ -2698,15 +2726,16 @@ int ewf_test_handle_seek_offset(
 		libcerror_error_free(
 		 &error );
 	}
-	/* Test libewf_handle_seek_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
+	/* Test libewf_handle_pread_buffer with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_read
 	 */
 	ewf_test_pthread_rwlock_unlock_attempts_before_fail = 0;
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          0,
-	          SEEK_SET,
-	          &error );
+	read_count = libewf_handle_pread_buffer(
+	              handle,
+	              buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
 
 	if( ewf_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
 	{
@@ -2714,62 +2743,2324 @@ int ewf_test_handle_seek_offset(
 	}
 	else
 	{
-		EWF_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 (int64_t) offset,
-		 (int64_t) -1 );
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+#endif /* defined( HAVE_EWF_TEST_RWLOCK ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_chunk_view and libewf_handle_release_chunk_view functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_chunk_view(
+     libewf_handle_t *handle )
+{
+	uint8_t expected_buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_view_t *chunk_view = NULL;
+	const uint8_t *data             = NULL;
+	size64_t media_size             = 0;
+	uint64_t number_of_chunks       = 0;
+	size32_t chunk_size             = 0;
+	size_t compare_size             = 0;
+	size_t data_size                = 0;
+	size_t expected_data_size       = 0;
+	ssize_t read_count              = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_chunk_size(
+	          handle,
+	          &chunk_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( ( media_size == 0 )
+	 || ( chunk_size == 0 ) )
+	{
+		return( 1 );
+	}
+	number_of_chunks = ( media_size + chunk_size - 1 ) / chunk_size;
+
+	expected_data_size = (size_t) chunk_size;
+
+	if( media_size < (size64_t) chunk_size )
+	{
+		expected_data_size = (size_t) media_size;
+	}
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          0,
+	          &chunk_view,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_view",
+	 chunk_view );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 expected_data_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	compare_size = data_size;
+
+	if( compare_size > EWF_TEST_HANDLE_READ_BUFFER_SIZE )
+	{
+		compare_size = EWF_TEST_HANDLE_READ_BUFFER_SIZE;
+	}
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              expected_buffer,
+	              compare_size,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) compare_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          expected_buffer,
+	          compare_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_handle_release_chunk_view(
+	          handle,
+	          &chunk_view,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_view",
+	 chunk_view );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Releasing a released chunk view is a no-op
+	 */
+	result = libewf_handle_release_chunk_view(
+	          handle,
+	          &chunk_view,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_chunk_view(
+	          NULL,
+	          0,
+	          &chunk_view,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          number_of_chunks,
+	          &chunk_view,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_view",
+	 chunk_view );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          0,
+	          NULL,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          0,
+	          &chunk_view,
+	          NULL,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          0,
+	          &chunk_view,
+	          &data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_release_chunk_view(
+	          NULL,
+	          &chunk_view,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_release_chunk_view(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_view != NULL )
+	{
+		libewf_handle_release_chunk_view(
+		 handle,
+		 &chunk_view,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_data_chunk function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_data_chunk(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_data_chunk_t *data_chunk = NULL;
+	int result                      = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_data_chunk(
+	          handle,
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	result = libewf_data_chunk_free(
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_data_chunk(
+	          NULL,
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_data_chunk(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_seek_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_seek_offset(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	off64_t offset           = 0;
+
+	/* Test regular cases
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	size = (size64_t) offset;
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          1024,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 1024 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -512,
+	          SEEK_CUR,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 512 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          (off64_t) ( size + 512 ),
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) ( size + 512 ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reset offset to 0
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	offset = libewf_handle_seek_offset(
+	          NULL,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_CUR,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          (off64_t) ( -1 * ( size + 1 ) ),
+	          SEEK_END,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_RWLOCK )
+
+	/* Test libewf_handle_seek_offset with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
+	 */
+	ewf_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	if( ewf_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
+	{
+		ewf_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Test libewf_handle_seek_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
+	 */
+	ewf_test_pthread_rwlock_unlock_attempts_before_fail = 0;
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	if( ewf_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
+	{
+		ewf_test_pthread_rwlock_unlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+#endif /* defined( HAVE_EWF_TEST_RWLOCK ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_offset(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	off64_t offset           = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_offset(
+	          handle,
+	          &offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_offset(
+	          NULL,
+	          &offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_offset(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_cache_memory_limit and libewf_handle_set_cache_memory_limit functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_cache_memory_limit(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 4096 ];
+
+	libcerror_error_t *error          = NULL;
+	size64_t cache_memory_limit       = 0;
+	size64_t saved_cache_memory_limit = 0;
+	ssize_t read_count                = 0;
+	int result                        = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_cache_memory_limit(
+	          handle,
+	          &saved_cache_memory_limit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_cache_memory_limit(
+	          handle,
+	          4 * 1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_cache_memory_limit(
+	          handle,
+	          &cache_memory_limit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "cache_memory_limit",
+	 (uint64_t) cache_memory_limit,
+	 (uint64_t) 4 * 1024 * 1024 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Make sure the handle can still be read after the caches were resized
+	 */
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              4096,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_cache_memory_limit(
+	          handle,
+	          saved_cache_memory_limit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_cache_memory_limit(
+	          NULL,
+	          &cache_memory_limit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_cache_memory_limit(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_cache_memory_limit(
+	          NULL,
+	          saved_cache_memory_limit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_cache_statistics function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_cache_statistics(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 4096 ];
+
+	libcerror_error_t *error  = NULL;
+	uint64_t number_of_hits   = 0;
+	uint64_t number_of_misses = 0;
+	ssize_t read_count        = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              4096,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_cache_statistics(
+	          handle,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( read_count > 0 )
+	{
+		EWF_TEST_ASSERT_NOT_EQUAL_INT(
+		 "number_of_lookups",
+		 (int) ( ( number_of_hits + number_of_misses ) != 0 ),
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libewf_handle_get_cache_statistics(
+	          NULL,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_cache_statistics(
+	          handle,
+	          NULL,
+	          &number_of_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_cache_statistics(
+	          handle,
+	          &number_of_hits,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_read_ahead and libewf_handle_set_read_ahead functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_ahead(
+     libewf_handle_t *handle )
+{
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+	uint8_t buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+	uint8_t expected_buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+#endif
+
+	libcerror_error_t *error    = NULL;
+	int number_of_chunks        = 0;
+	int number_of_threads       = 0;
+	int result                  = 0;
+	int saved_number_of_chunks  = 0;
+	int saved_number_of_threads = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+	size64_t media_size         = 0;
+	size_t read_size            = 0;
+	ssize_t read_count          = 0;
+	off64_t offset              = 0;
+	off64_t read_offset         = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_read_ahead(
+	          handle,
+	          &saved_number_of_threads,
+	          &saved_number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+	result = libewf_handle_set_read_ahead(
+	          handle,
+	          2,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_read_ahead(
+	          handle,
+	          &number_of_threads,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 2 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_chunks",
+	 number_of_chunks,
+	 8 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Read the start of the media sequentially and compare the data
+	 * with data read by positional reads
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size > (size64_t) ( 1024 * 1024 ) )
+	{
+		media_size = 1024 * 1024;
+	}
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	while( (size64_t) read_offset < media_size )
+	{
+		read_size = EWF_TEST_HANDLE_READ_BUFFER_SIZE;
+
+		if( (size64_t) read_size > ( media_size - read_offset ) )
+		{
+			read_size = (size_t) ( media_size - read_offset );
+		}
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              read_size,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) read_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libewf_handle_pread_buffer(
+		              handle,
+		              expected_buffer,
+		              read_size,
+		              read_offset,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) read_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer,
+		          expected_buffer,
+		          read_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		read_offset += read_count;
+	}
+	result = libewf_handle_set_read_ahead(
+	          handle,
+	          saved_number_of_threads,
+	          saved_number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF ) */
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_read_ahead(
+	          NULL,
+	          &number_of_threads,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_read_ahead(
+	          handle,
+	          NULL,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_read_ahead(
+	          NULL,
+	          saved_number_of_threads,
+	          saved_number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_read_ahead(
+	          handle,
+	          -1,
+	          saved_number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_read_ahead(
+	          handle,
+	          saved_number_of_threads,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_number_of_unpack_threads and libewf_handle_set_number_of_unpack_threads functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_number_of_unpack_threads(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error    = NULL;
+	int number_of_threads       = 0;
+	int result                  = 0;
+	int saved_number_of_threads = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+	uint8_t *buffer             = NULL;
+	uint8_t *expected_buffer    = NULL;
+	size64_t media_size         = 0;
+	size_t read_size            = 0;
+	ssize_t read_count          = 0;
+	off64_t offset              = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_number_of_unpack_threads(
+	          handle,
+	          &saved_number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+	result = libewf_handle_set_number_of_unpack_threads(
+	          handle,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_number_of_unpack_threads(
+	          handle,
+	          &number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Read the start of the media in a single large read and compare the data
+	 * with data read by a positional read
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size > (size64_t) ( 1024 * 1024 ) )
+	{
+		media_size = 1024 * 1024;
+	}
+	read_size = (size_t) media_size;
+
+	if( read_size > 0 )
+	{
+		buffer = (uint8_t *) memory_allocate(
+		                      sizeof( uint8_t ) * read_size );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "buffer",
+		 buffer );
+
+		expected_buffer = (uint8_t *) memory_allocate(
+		                               sizeof( uint8_t ) * read_size );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "expected_buffer",
+		 expected_buffer );
+
+		offset = libewf_handle_seek_offset(
+		          handle,
+		          0,
+		          SEEK_SET,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 (int64_t) 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              read_size,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) read_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libewf_handle_pread_buffer(
+		              handle,
+		              expected_buffer,
+		              read_size,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) read_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer,
+		          expected_buffer,
+		          read_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		memory_free(
+		 expected_buffer );
+
+		expected_buffer = NULL;
+
+		memory_free(
+		 buffer );
+
+		buffer = NULL;
+	}
+	result = libewf_handle_set_number_of_unpack_threads(
+	          handle,
+	          saved_number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF ) */
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_number_of_unpack_threads(
+	          NULL,
+	          &number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_number_of_unpack_threads(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_number_of_unpack_threads(
+	          NULL,
+	          saved_number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_number_of_unpack_threads(
+	          handle,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+	if( expected_buffer != NULL )
+	{
+		memory_free(
+		 expected_buffer );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+#endif
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_number_of_pack_threads and libewf_handle_set_number_of_pack_threads functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_number_of_pack_threads(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error    = NULL;
+	int number_of_threads       = 0;
+	int result                  = 0;
+	int saved_number_of_threads = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_number_of_pack_threads(
+	          handle,
+	          &saved_number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "saved_number_of_threads",
+	 saved_number_of_threads,
+	 0 );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+	result = libewf_handle_set_number_of_pack_threads(
+	          handle,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_number_of_pack_threads(
+	          handle,
+	          &number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_number_of_pack_threads(
+	          handle,
+	          saved_number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF ) */
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_number_of_pack_threads(
+	          NULL,
+	          &number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_number_of_pack_threads(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_number_of_pack_threads(
+	          NULL,
+	          saved_number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_number_of_pack_threads(
+	          handle,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_reorder_buffer and libewf_handle_set_reorder_buffer functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_reorder_buffer(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error           = NULL;
+	size64_t maximum_memory_size       = 0;
+	size64_t saved_maximum_memory_size = 0;
+	int maximum_number_of_chunks       = 0;
+	int result                         = 0;
+	int saved_maximum_number_of_chunks = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_reorder_buffer(
+	          handle,
+	          &saved_maximum_number_of_chunks,
+	          &saved_maximum_memory_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_reorder_buffer(
+	          handle,
+	          16,
+	          1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_reorder_buffer(
+	          handle,
+	          &maximum_number_of_chunks,
+	          &maximum_memory_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "maximum_number_of_chunks",
+	 maximum_number_of_chunks,
+	 16 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "maximum_memory_size",
+	 (uint64_t) maximum_memory_size,
+	 (uint64_t) 1024 * 1024 );
+
+	result = libewf_handle_set_reorder_buffer(
+	          handle,
+	          saved_maximum_number_of_chunks,
+	          saved_maximum_memory_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_reorder_buffer(
+	          NULL,
+	          &maximum_number_of_chunks,
+	          &maximum_memory_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_reorder_buffer(
+	          handle,
+	          NULL,
+	          &maximum_memory_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_reorder_buffer(
+	          handle,
+	          &maximum_number_of_chunks,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_reorder_buffer(
+	          NULL,
+	          saved_maximum_number_of_chunks,
+	          saved_maximum_memory_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_reorder_buffer(
+	          handle,
+	          0,
+	          saved_maximum_memory_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_reorder_buffer(
+	          handle,
+	          saved_maximum_number_of_chunks,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_memory_mapped_io_mode and libewf_handle_set_memory_mapped_io_mode functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_memory_mapped_io_mode(
+     const system_character_t *source,
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+	uint8_t expected_buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+
+	libcerror_error_t *error       = NULL;
+	libewf_handle_t *mapped_handle = NULL;
+	system_character_t **filenames = NULL;
+	size64_t media_size            = 0;
+	size_t filename_size           = 0;
+	size_t read_size               = 0;
+	size_t source_length           = 0;
+	ssize_t read_count             = 0;
+	off64_t read_offset            = 0;
+	int memory_mapped_io_mode      = 0;
+	int number_of_filenames        = 0;
+	int result                     = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_memory_mapped_io_mode(
+	          handle,
+	          &memory_mapped_io_mode,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "memory_mapped_io_mode",
+	 memory_mapped_io_mode,
+	 LIBEWF_MEMORY_MAPPED_IO_MODE_DISABLED );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_initialize(
+	          &mapped_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "mapped_handle",
+	 mapped_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_memory_mapped_io_mode(
+	          mapped_handle,
+	          LIBEWF_MEMORY_MAPPED_IO_MODE_SEQUENTIAL,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Memory-mapped IO is not supported on every platform
+	 */
+	if( result == -1 )
+	{
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	else
+	{
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_get_memory_mapped_io_mode(
+		          mapped_handle,
+		          &memory_mapped_io_mode,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "memory_mapped_io_mode",
+		 memory_mapped_io_mode,
+		 LIBEWF_MEMORY_MAPPED_IO_MODE_SEQUENTIAL );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Open the source with memory-mapped segment files and compare
+		 * the start of the media with the data read using file IO
+		 */
+		source_length = system_string_length(
+		                 source );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libewf_glob_wide(
+		          source,
+		          source_length,
+		          LIBEWF_FORMAT_UNKNOWN,
+		          &filenames,
+		          &number_of_filenames,
+		          &error );
+#else
+		result = libewf_glob(
+		          source,
+		          source_length,
+		          LIBEWF_FORMAT_UNKNOWN,
+		          &filenames,
+		          &number_of_filenames,
+		          &error );
+#endif
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libewf_handle_open_wide(
+		          mapped_handle,
+		          (wchar_t * const *) filenames,
+		          number_of_filenames,
+		          LIBEWF_OPEN_READ,
+		          &error );
+#else
+		result = libewf_handle_open(
+		          mapped_handle,
+		          (char * const *) filenames,
+		          number_of_filenames,
+		          LIBEWF_OPEN_READ,
+		          &error );
+#endif
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_get_media_size(
+		          mapped_handle,
+		          &media_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( media_size > (size64_t) ( 1024 * 1024 ) )
+		{
+			media_size = 1024 * 1024;
+		}
+		while( (size64_t) read_offset < media_size )
+		{
+			read_size = EWF_TEST_HANDLE_READ_BUFFER_SIZE;
+
+			if( (size64_t) read_size > ( media_size - read_offset ) )
+			{
+				read_size = (size_t) ( media_size - read_offset );
+			}
+			read_count = libewf_handle_read_buffer_at_offset(
+			              mapped_handle,
+			              buffer,
+			              read_size,
+			              read_offset,
+			              &error );
+
+			EWF_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) read_size );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			read_count = libewf_handle_read_buffer_at_offset(
+			              handle,
+			              expected_buffer,
+			              read_size,
+			              read_offset,
+			              &error );
+
+			EWF_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) read_size );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = memory_compare(
+			          buffer,
+			          expected_buffer,
+			          read_size );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+
+			read_offset += read_count;
+		}
+		result = libewf_handle_get_filename_size(
+		          mapped_handle,
+		          &filename_size,
+		          &error );
+
+		EWF_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_close(
+		          mapped_handle,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libewf_glob_wide_free(
+		          filenames,
+		          number_of_filenames,
+		          &error );
+#else
+		result = libewf_glob_free(
+		          filenames,
+		          number_of_filenames,
+		          &error );
+#endif
 
-		EWF_TEST_ASSERT_IS_NOT_NULL(
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
 		 "error",
 		 error );
-
-		libcerror_error_free(
-		 &error );
 	}
-#endif /* defined( HAVE_EWF_TEST_RWLOCK ) */
+	result = libewf_handle_free(
+	          &mapped_handle,
+	          &error );
 
-	return( 1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	EWF_TEST_ASSERT_IS_NULL(
+	 "mapped_handle",
+	 mapped_handle );
 
-/* Tests the libewf_handle_get_offset function
- * Returns 1 if successful or 0 if not
- */
-int ewf_test_handle_get_offset(
-     libewf_handle_t *handle )
-{
-	libcerror_error_t *error = NULL;
-	off64_t offset           = 0;
-	int result               = 0;
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* Test regular cases
+	/* Test error cases
 	 */
-	result = libewf_handle_get_offset(
+	result = libewf_handle_get_memory_mapped_io_mode(
+	          NULL,
+	          &memory_mapped_io_mode,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_memory_mapped_io_mode(
 	          handle,
-	          &offset,
+	          NULL,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libewf_handle_get_offset(
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_memory_mapped_io_mode(
 	          NULL,
-	          &offset,
+	          LIBEWF_MEMORY_MAPPED_IO_MODE_DISABLED,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2784,9 +5075,9 @@ int ewf_test_handle_get_offset(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_offset(
+	result = libewf_handle_set_memory_mapped_io_mode(
 	          handle,
-	          NULL,
+	          -1,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2809,6 +5100,26 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( mapped_handle != NULL )
+	{
+		libewf_handle_free(
+		 &mapped_handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
 	return( 0 );
 }
 
@@ -4273,6 +6584,174 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_handle_get_number_of_extents function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_number_of_extents(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t extent_size     = 0;
+	size64_t media_size      = 0;
+	size64_t total_size      = 0;
+	off64_t extent_offset    = 0;
+	uint32_t extent_flags    = 0;
+	int extent_index         = 0;
+	int number_of_extents    = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_number_of_extents(
+	          handle,
+	          &number_of_extents,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The extents are contiguous and cover the media data
+	 */
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		result = libewf_handle_get_extent(
+		          handle,
+		          extent_index,
+		          &extent_offset,
+		          &extent_size,
+		          &extent_flags,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "extent_offset",
+		 (uint64_t) extent_offset,
+		 (uint64_t) total_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		total_size += extent_size;
+	}
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "total_size",
+	 (uint64_t) total_size,
+	 (uint64_t) media_size );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_number_of_extents(
+	          NULL,
+	          &number_of_extents,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_number_of_extents(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_extent(
+	          NULL,
+	          0,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_extent(
+	          handle,
+	          -1,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_handle_get_number_of_sessions function
  * Returns 1 if successful or 0 if not
  */
@@ -4903,6 +7382,16 @@ int main(
 		 ewf_test_handle_read_buffer_at_offset,
 		 handle );
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_pread_buffer",
+		 ewf_test_handle_pread_buffer,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_chunk_view",
+		 ewf_test_handle_get_chunk_view,
+		 handle );
+
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
 		/* TODO: add tests for libewf_internal_handle_write_buffer_to_file_io_pool */
@@ -4960,6 +7449,42 @@ int main(
 
 		/* TODO: add tests for libewf_handle_set_maximum_number_of_open_handles */
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_cache_memory_limit",
+		 ewf_test_handle_cache_memory_limit,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_cache_statistics",
+		 ewf_test_handle_get_cache_statistics,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_read_ahead",
+		 ewf_test_handle_read_ahead,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_number_of_unpack_threads",
+		 ewf_test_handle_number_of_unpack_threads,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_number_of_pack_threads",
+		 ewf_test_handle_number_of_pack_threads,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_reorder_buffer",
+		 ewf_test_handle_reorder_buffer,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_memory_mapped_io_mode",
+		 ewf_test_handle_memory_mapped_io_mode,
+		 source,
+		 handle );
+
 		/* TODO: add tests for libewf_handle_segment_files_corrupted */
 
 		/* TODO: add tests for libewf_handle_segment_files_encrypted */
@@ -5157,6 +7682,11 @@ int main(
 
 		/* TODO: add tests for libewf_handle_append_checksum_error */
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_number_of_extents",
+		 ewf_test_handle_get_number_of_extents,
+		 handle );
+
 		EWF_TEST_RUN_WITH_ARGS(
 		 "libewf_handle_get_number_of_sessions",
 		 ewf_test_handle_get_number_of_sessions,
@@ -0,0 +1,2647 @@
+/*
+ * Library index_file type test program
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "ewf_test_libbfio.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_index_file.h"
+#include "../libewf/libewf_libfdata.h"
+
+uint8_t ewf_test_index_file_set_identifier[ 16 ] = {
+	0x0f, 0x1e, 0x2d, 0x3c, 0x4b, 0x5a, 0x69, 0x78, 0x87, 0x96, 0xa5, 0xb4, 0xc3, 0xd2, 0xe1, 0xf0 };
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Creates an index file with a single segment for testing
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_index_file_create(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error )
+{
+	libewf_index_file_segment_t index_file_segment;
+	libewf_media_values_t media_values;
+
+	libfdata_list_t *chunk_groups_list = NULL;
+	libfdata_list_t *sections_list     = NULL;
+	int element_index                  = 0;
+	int result                         = 0;
+
+	if( libewf_index_file_initialize(
+	     index_file,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libewf_index_file_set_header_values(
+	     *index_file,
+	     2,
+	     1,
+	     1,
+	     ewf_test_index_file_set_identifier,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( memory_set(
+	     &media_values,
+	     0,
+	     sizeof( libewf_media_values_t ) ) == NULL )
+	{
+		goto on_error;
+	}
+	media_values.media_size        = 65536;
+	media_values.chunk_size        = 32768;
+	media_values.sectors_per_chunk = 64;
+	media_values.bytes_per_sector  = 512;
+	media_values.number_of_chunks  = 2;
+	media_values.number_of_sectors = 128;
+
+	if( libewf_index_file_set_media_values(
+	     *index_file,
+	     &media_values,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libfdata_list_initialize(
+	     &sections_list,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libfdata_list_initialize(
+	     &chunk_groups_list,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libfdata_list_append_element(
+	     sections_list,
+	     &element_index,
+	     0,
+	     32,
+	     64,
+	     0,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libfdata_list_append_element(
+	     sections_list,
+	     &element_index,
+	     0,
+	     8192,
+	     64,
+	     0,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libfdata_list_append_element_with_mapped_size(
+	     chunk_groups_list,
+	     &element_index,
+	     0,
+	     4096,
+	     48,
+	     0,
+	     65536,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( memory_set(
+	     &index_file_segment,
+	     0,
+	     sizeof( libewf_index_file_segment_t ) ) == NULL )
+	{
+		goto on_error;
+	}
+	index_file_segment.segment_number                   = 1;
+	index_file_segment.type                             = 1;
+	index_file_segment.has_section_data                 = 1;
+	index_file_segment.segment_file_size                = 8256;
+	index_file_segment.modification_time                = 1577836800;
+	index_file_segment.last_section_offset              = 8192;
+	index_file_segment.storage_media_size               = 65536;
+	index_file_segment.number_of_chunks                 = 2;
+	index_file_segment.last_chunk_filled                = 2;
+	index_file_segment.device_information_section_index = -1;
+
+	result = libewf_index_file_append_segment(
+	          *index_file,
+	          &index_file_segment,
+	          sections_list,
+	          chunk_groups_list,
+	          error );
+
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	if( libfdata_list_free(
+	     &chunk_groups_list,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libfdata_list_free(
+	     &sections_list,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( chunk_groups_list != NULL )
+	{
+		libfdata_list_free(
+		 &chunk_groups_list,
+		 NULL );
+	}
+	if( sections_list != NULL )
+	{
+		libfdata_list_free(
+		 &sections_list,
+		 NULL );
+	}
+	if( *index_file != NULL )
+	{
+		libewf_index_file_free(
+		 index_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the libewf_index_file_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_file_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_index_file_t *index_file = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_index_file_initialize(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_file",
+	 index_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_free(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "index_file",
+	 index_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_index_file_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	index_file = (libewf_index_file_t *) 0x12345678UL;
+
+	result = libewf_index_file_initialize(
+	          &index_file,
+	          &error );
+
+	index_file = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_index_file_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_index_file_initialize(
+		          &index_file,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( index_file != NULL )
+			{
+				libewf_index_file_free(
+				 &index_file,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "index_file",
+			 index_file );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_index_file_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_index_file_initialize(
+		          &index_file,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( index_file != NULL )
+			{
+				libewf_index_file_free(
+				 &index_file,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "index_file",
+			 index_file );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( index_file != NULL )
+	{
+		libewf_index_file_free(
+		 &index_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_index_file_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_file_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_index_file_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_index_file_resize_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_file_resize_data(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_index_file_t *index_file = NULL;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_index_file_initialize(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_file",
+	 index_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_index_file_resize_data(
+	          index_file,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_file->data",
+	 index_file->data );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "index_file->data_size",
+	 index_file->data_size,
+	 (size_t) 64 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "index_file->allocated_data_size",
+	 index_file->allocated_data_size,
+	 (size_t) 64 );
+
+	/* Test if the data grows by half of the allocated data size
+	 */
+	result = libewf_index_file_resize_data(
+	          index_file,
+	          80,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "index_file->data_size",
+	 index_file->data_size,
+	 (size_t) 80 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "index_file->allocated_data_size",
+	 index_file->allocated_data_size,
+	 (size_t) 96 );
+
+	/* Test if the data grows to the requested size when that exceeds half of the allocated data size
+	 */
+	result = libewf_index_file_resize_data(
+	          index_file,
+	          256,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "index_file->data_size",
+	 index_file->data_size,
+	 (size_t) 256 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "index_file->allocated_data_size",
+	 index_file->allocated_data_size,
+	 (size_t) 256 );
+
+	/* Test if shrinking the data retains the allocation
+	 */
+	result = libewf_index_file_resize_data(
+	          index_file,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "index_file->data_size",
+	 index_file->data_size,
+	 (size_t) 16 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "index_file->allocated_data_size",
+	 index_file->allocated_data_size,
+	 (size_t) 256 );
+
+	/* Test error cases
+	 */
+	result = libewf_index_file_resize_data(
+	          NULL,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_file_resize_data(
+	          index_file,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "index_file->data_size",
+	 index_file->data_size,
+	 (size_t) 16 );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	/* Test libewf_index_file_resize_data with realloc failing
+	 */
+	ewf_test_realloc_attempts_before_fail = 0;
+
+	result = libewf_index_file_resize_data(
+	          index_file,
+	          1024,
+	          &error );
+
+	if( ewf_test_realloc_attempts_before_fail != -1 )
+	{
+		ewf_test_realloc_attempts_before_fail = -1;
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "index_file->data_size",
+		 index_file->data_size,
+		 (size_t) 16 );
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	/* Clean up
+	 */
+	result = libewf_index_file_free(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( index_file != NULL )
+	{
+		libewf_index_file_free(
+		 &index_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_index_file_set_header_values function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_file_set_header_values(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_index_file_t *index_file = NULL;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_index_file_initialize(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_file",
+	 index_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_index_file_set_header_values(
+	          index_file,
+	          2,
+	          1,
+	          1,
+	          ewf_test_index_file_set_identifier,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "index_file->major_version",
+	 index_file->major_version,
+	 2 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "index_file->minor_version",
+	 index_file->minor_version,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT16(
+	 "index_file->compression_method",
+	 index_file->compression_method,
+	 1 );
+
+	result = memory_compare(
+	          index_file->set_identifier,
+	          ewf_test_index_file_set_identifier,
+	          16 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_index_file_set_header_values(
+	          NULL,
+	          2,
+	          1,
+	          1,
+	          ewf_test_index_file_set_identifier,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_file_set_header_values(
+	          index_file,
+	          2,
+	          1,
+	          1,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY ) && defined( OPTIMIZATION_DISABLED )
+
+	/* Test libewf_index_file_set_header_values with memcpy failing
+	 */
+	ewf_test_memcpy_attempts_before_fail = 0;
+
+	result = libewf_index_file_set_header_values(
+	          index_file,
+	          2,
+	          1,
+	          1,
+	          ewf_test_index_file_set_identifier,
+	          &error );
+
+	if( ewf_test_memcpy_attempts_before_fail != -1 )
+	{
+		ewf_test_memcpy_attempts_before_fail = -1;
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) && defined( OPTIMIZATION_DISABLED ) */
+
+	/* Clean up
+	 */
+	result = libewf_index_file_free(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( index_file != NULL )
+	{
+		libewf_index_file_free(
+		 &index_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_index_file_compare_header_values function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_file_compare_header_values(
+     void )
+{
+	uint8_t set_identifier[ 16 ];
+
+	libcerror_error_t *error        = NULL;
+	libewf_index_file_t *index_file = NULL;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_index_file_create(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_file",
+	 index_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_index_file_compare_header_values(
+	          index_file,
+	          2,
+	          1,
+	          1,
+	          ewf_test_index_file_set_identifier,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_compare_header_values(
+	          index_file,
+	          1,
+	          0,
+	          1,
+	          ewf_test_index_file_set_identifier,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_copy(
+	 set_identifier,
+	 ewf_test_index_file_set_identifier,
+	 16 );
+
+	set_identifier[ 15 ] = 0x00;
+
+	result = libewf_index_file_compare_header_values(
+	          index_file,
+	          2,
+	          1,
+	          1,
+	          set_identifier,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_index_file_compare_header_values(
+	          NULL,
+	          2,
+	          1,
+	          1,
+	          ewf_test_index_file_set_identifier,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_file_compare_header_values(
+	          index_file,
+	          2,
+	          1,
+	          1,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_index_file_free(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( index_file != NULL )
+	{
+		libewf_index_file_free(
+		 &index_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_index_file_append_segment function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_file_append_segment(
+     void )
+{
+	libewf_index_file_segment_t index_file_segment;
+
+	libcerror_error_t *error           = NULL;
+	libewf_index_file_t *index_file    = NULL;
+	libfdata_list_t *chunk_groups_list = NULL;
+	libfdata_list_t *sections_list     = NULL;
+	size_t data_size                   = 0;
+	uint32_t number_of_segments        = 0;
+	int element_index                  = 0;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_index_file_create(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_file",
+	 index_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_list_initialize(
+	          &sections_list,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_list_initialize(
+	          &chunk_groups_list,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_list_append_element(
+	          sections_list,
+	          &element_index,
+	          1,
+	          32,
+	          64,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( memory_set(
+	     &index_file_segment,
+	     0,
+	     sizeof( libewf_index_file_segment_t ) ) == NULL )
+	{
+		goto on_error;
+	}
+	index_file_segment.segment_number                   = 2;
+	index_file_segment.type                             = 1;
+	index_file_segment.segment_file_size                = 96;
+	index_file_segment.modification_time                = 1577923200;
+	index_file_segment.last_section_offset              = 32;
+	index_file_segment.storage_media_size               = 65536;
+	index_file_segment.number_of_chunks                 = 2;
+	index_file_segment.last_chunk_filled                = 2;
+	index_file_segment.device_information_section_index = -1;
+
+	data_size = index_file->data_size;
+
+	/* Test regular cases
+	 */
+	result = libewf_index_file_append_segment(
+	          index_file,
+	          &index_file_segment,
+	          sections_list,
+	          chunk_groups_list,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_get_number_of_segments(
+	          index_file,
+	          &number_of_segments,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_segments",
+	 number_of_segments,
+	 2 );
+
+	/* The segment is stored after the data of the first segment
+	 */
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "index_file->segment_data_offsets[ 1 ]",
+	 index_file->segment_data_offsets[ 1 ],
+	 data_size );
+
+	if( memory_set(
+	     &index_file_segment,
+	     0,
+	     sizeof( libewf_index_file_segment_t ) ) == NULL )
+	{
+		goto on_error;
+	}
+	result = libewf_index_file_get_segment_by_index(
+	          index_file,
+	          1,
+	          &index_file_segment,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "index_file_segment.segment_number",
+	 index_file_segment.segment_number,
+	 2 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "index_file_segment.segment_file_size",
+	 (uint64_t) index_file_segment.segment_file_size,
+	 (uint64_t) 96 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "index_file_segment.modification_time",
+	 index_file_segment.modification_time,
+	 (int64_t) 1577923200 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "index_file_segment.has_section_data",
+	 index_file_segment.has_section_data,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_index_file_append_segment(
+	          NULL,
+	          &index_file_segment,
+	          sections_list,
+	          chunk_groups_list,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_file_append_segment(
+	          index_file,
+	          NULL,
+	          sections_list,
+	          chunk_groups_list,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_file_append_segment(
+	          index_file,
+	          &index_file_segment,
+	          NULL,
+	          chunk_groups_list,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_file_append_segment(
+	          index_file,
+	          &index_file_segment,
+	          sections_list,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test if a failed append does not change the segments
+	 */
+	result = libewf_index_file_get_number_of_segments(
+	          index_file,
+	          &number_of_segments,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_segments",
+	 number_of_segments,
+	 2 );
+
+	/* Clean up
+	 */
+	result = libfdata_list_free(
+	          &chunk_groups_list,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_list_free(
+	          &sections_list,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_free(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_groups_list != NULL )
+	{
+		libfdata_list_free(
+		 &chunk_groups_list,
+		 NULL );
+	}
+	if( sections_list != NULL )
+	{
+		libfdata_list_free(
+		 &sections_list,
+		 NULL );
+	}
+	if( index_file != NULL )
+	{
+		libewf_index_file_free(
+		 &index_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_index_file_get_segment_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_file_get_segment_by_index(
+     void )
+{
+	libewf_index_file_segment_t index_file_segment;
+
+	libcerror_error_t *error        = NULL;
+	libewf_index_file_t *index_file = NULL;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_index_file_create(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_file",
+	 index_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_index_file_get_segment_by_index(
+	          index_file,
+	          0,
+	          &index_file_segment,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "index_file_segment.segment_number",
+	 index_file_segment.segment_number,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "index_file_segment.segment_file_size",
+	 (uint64_t) index_file_segment.segment_file_size,
+	 (uint64_t) 8256 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "index_file_segment.modification_time",
+	 index_file_segment.modification_time,
+	 (int64_t) 1577836800 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "index_file_segment.storage_media_size",
+	 (uint64_t) index_file_segment.storage_media_size,
+	 (uint64_t) 65536 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "index_file_segment.device_information_section_index",
+	 index_file_segment.device_information_section_index,
+	 -1 );
+
+	result = libewf_index_file_get_segment_by_index(
+	          index_file,
+	          1,
+	          &index_file_segment,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_index_file_get_segment_by_index(
+	          NULL,
+	          0,
+	          &index_file_segment,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_file_get_segment_by_index(
+	          index_file,
+	          0,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_index_file_free(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( index_file != NULL )
+	{
+		libewf_index_file_free(
+		 &index_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_index_file_fill_segment_lists function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_file_fill_segment_lists(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libewf_index_file_t *index_file    = NULL;
+	libfdata_list_t *chunk_groups_list = NULL;
+	libfdata_list_t *sections_list     = NULL;
+	size64_t element_size              = 0;
+	size64_t mapped_size               = 0;
+	off64_t element_offset             = 0;
+	uint32_t element_flags             = 0;
+	int chunk_groups_index             = 0;
+	int element_file_index             = 0;
+	int number_of_elements             = 0;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_index_file_create(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_file",
+	 index_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_list_initialize(
+	          &sections_list,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_list_initialize(
+	          &chunk_groups_list,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_index_file_fill_segment_lists(
+	          index_file,
+	          0,
+	          3,
+	          64,
+	          sections_list,
+	          chunk_groups_list,
+	          &chunk_groups_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_list_get_number_of_elements(
+	          sections_list,
+	          &number_of_elements,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_elements",
+	 number_of_elements,
+	 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_list_get_element_by_index(
+	          sections_list,
+	          1,
+	          &element_file_index,
+	          &element_offset,
+	          &element_size,
+	          &element_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "element_file_index",
+	 element_file_index,
+	 3 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "element_offset",
+	 (int64_t) element_offset,
+	 (int64_t) 8192 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_list_get_element_by_index(
+	          chunk_groups_list,
+	          0,
+	          &element_file_index,
+	          &element_offset,
+	          &element_size,
+	          &element_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "element_offset",
+	 (int64_t) element_offset,
+	 (int64_t) 4096 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "element_size",
+	 (uint64_t) element_size,
+	 (uint64_t) 48 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_list_get_mapped_size_by_index(
+	          chunk_groups_list,
+	          0,
+	          &mapped_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "mapped_size",
+	 (uint64_t) mapped_size,
+	 (uint64_t) 65536 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_fill_segment_lists(
+	          index_file,
+	          1,
+	          3,
+	          64,
+	          sections_list,
+	          chunk_groups_list,
+	          &chunk_groups_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_index_file_fill_segment_lists(
+	          NULL,
+	          0,
+	          3,
+	          64,
+	          sections_list,
+	          chunk_groups_list,
+	          &chunk_groups_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_file_fill_segment_lists(
+	          index_file,
+	          0,
+	          3,
+	          64,
+	          sections_list,
+	          chunk_groups_list,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_list_free(
+	          &chunk_groups_list,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_list_free(
+	          &sections_list,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_free(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_groups_list != NULL )
+	{
+		libfdata_list_free(
+		 &chunk_groups_list,
+		 NULL );
+	}
+	if( sections_list != NULL )
+	{
+		libfdata_list_free(
+		 &sections_list,
+		 NULL );
+	}
+	if( index_file != NULL )
+	{
+		libewf_index_file_free(
+		 &index_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_index_file_read_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_file_read_data(
+     void )
+{
+	uint8_t data[ 96 ];
+
+	libcerror_error_t *error        = NULL;
+	libewf_index_file_t *index_file = NULL;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_index_file_initialize(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_file",
+	 index_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 data,
+	 0,
+	 96 );
+
+	/* Test regular cases
+	 */
+	result = libewf_index_file_read_data(
+	          index_file,
+	          data,
+	          96,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_read_data(
+	          index_file,
+	          data,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_index_file_read_data(
+	          NULL,
+	          data,
+	          96,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_file_read_data(
+	          index_file,
+	          NULL,
+	          96,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_file_read_data(
+	          index_file,
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_index_file_free(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( index_file != NULL )
+	{
+		libewf_index_file_free(
+		 &index_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_index_file_write_file_io_handle and libewf_index_file_read_file_io_handle functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_file_write_file_io_handle(
+     void )
+{
+	libewf_index_file_segment_t index_file_segment;
+	libewf_media_values_t media_values;
+
+	/* The size of the header, a segment, 2 sections and 1 chunk group
+	 */
+	uint8_t data[ 216 ];
+
+	libbfio_handle_t *file_io_handle     = NULL;
+	libcerror_error_t *error             = NULL;
+	libewf_index_file_t *index_file      = NULL;
+	libewf_index_file_t *read_index_file = NULL;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_index_file_create(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_file",
+	 index_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_set(
+	          file_io_handle,
+	          data,
+	          216,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ_WRITE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_index_file_write_file_io_handle(
+	          index_file,
+	          file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_initialize(
+	          &read_index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_read_file_io_handle(
+	          read_index_file,
+	          file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_compare_header_values(
+	          read_index_file,
+	          2,
+	          1,
+	          1,
+	          ewf_test_index_file_set_identifier,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_get_media_values(
+	          read_index_file,
+	          &media_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "media_values.chunk_size",
+	 (uint32_t) media_values.chunk_size,
+	 32768 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "media_values.number_of_sectors",
+	 media_values.number_of_sectors,
+	 (uint64_t) 128 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_get_segment_by_index(
+	          read_index_file,
+	          0,
+	          &index_file_segment,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "index_file_segment.last_section_offset",
+	 (int64_t) index_file_segment.last_section_offset,
+	 (int64_t) 8192 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_free(
+	          &read_index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test read with corrupted data
+	 */
+	data[ 150 ] ^= 0xff;
+
+	result = libewf_index_file_initialize(
+	          &read_index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_read_file_io_handle(
+	          read_index_file,
+	          file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_free(
+	          &read_index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_index_file_write_file_io_handle(
+	          NULL,
+	          file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_file_read_file_io_handle(
+	          NULL,
+	          file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfio_handle_close(
+	          file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_free(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( read_index_file != NULL )
+	{
+		libewf_index_file_free(
+		 &read_index_file,
+		 NULL );
+	}
+	if( index_file != NULL )
+	{
+		libewf_index_file_free(
+		 &index_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_STAT ) && defined( HAVE_UNISTD_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+/* Tests the libewf_index_file_get_modification_time function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_file_get_modification_time(
+     void )
+{
+	char filename[ 32 ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	int64_t modification_time        = 0;
+	int file_descriptor              = -1;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	narrow_string_copy(
+	 filename,
+	 "ewf_test_index_file.XXXXXX",
+	 27 );
+
+	file_descriptor = mkstemp(
+	                   filename );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "file_descriptor",
+	 file_descriptor,
+	 -1 );
+
+	close(
+	 file_descriptor );
+
+	result = libbfio_file_initialize(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_file_set_name(
+	          file_io_handle,
+	          filename,
+	          narrow_string_length(
+	           filename ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_index_file_get_modification_time(
+	          file_io_handle,
+	          &modification_time,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "modification_time",
+	 modification_time,
+	 (int64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_index_file_get_modification_time(
+	          file_io_handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test if a file that does not exist is an error
+	 */
+	unlink(
+	 filename );
+
+	result = libewf_index_file_get_modification_time(
+	          file_io_handle,
+	          &modification_time,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( file_descriptor != -1 )
+	{
+		unlink(
+		 filename );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_STAT ) && defined( HAVE_UNISTD_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_index_file_initialize",
+	 ewf_test_index_file_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_index_file_free",
+	 ewf_test_index_file_free );
+
+	EWF_TEST_RUN(
+	 "libewf_index_file_resize_data",
+	 ewf_test_index_file_resize_data );
+
+	EWF_TEST_RUN(
+	 "libewf_index_file_set_header_values",
+	 ewf_test_index_file_set_header_values );
+
+	EWF_TEST_RUN(
+	 "libewf_index_file_compare_header_values",
+	 ewf_test_index_file_compare_header_values );
+
+	EWF_TEST_RUN(
+	 "libewf_index_file_append_segment",
+	 ewf_test_index_file_append_segment );
+
+	EWF_TEST_RUN(
+	 "libewf_index_file_get_segment_by_index",
+	 ewf_test_index_file_get_segment_by_index );
+
+	EWF_TEST_RUN(
+	 "libewf_index_file_fill_segment_lists",
+	 ewf_test_index_file_fill_segment_lists );
+
+	EWF_TEST_RUN(
+	 "libewf_index_file_read_data",
+	 ewf_test_index_file_read_data );
+
+	EWF_TEST_RUN(
+	 "libewf_index_file_write_file_io_handle",
+	 ewf_test_index_file_write_file_io_handle );
+
+#if defined( HAVE_STAT ) && defined( HAVE_UNISTD_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+	EWF_TEST_RUN(
+	 "libewf_index_file_get_modification_time",
+	 ewf_test_index_file_get_modification_time );
+
+#endif /* defined( HAVE_STAT ) && defined( HAVE_UNISTD_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
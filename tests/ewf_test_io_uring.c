@@ -0,0 +1,808 @@
+/*
+ * Library io_uring type test program
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "ewf_test_libbfio.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_io_uring.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_IO_URING )
+
+/* The test file is not a multiple of the read size, so that a read can cross the end of the file
+ */
+#define EWF_TEST_IO_URING_FILE_SIZE	( ( 8 * 4096 ) + 1000 )
+#define EWF_TEST_IO_URING_READ_SIZE	4096
+
+uint8_t ewf_test_io_uring_file_data[ EWF_TEST_IO_URING_FILE_SIZE ];
+
+/* Creates a test file with the test file data
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_io_uring_create_test_file(
+     char *filename )
+{
+	size_t data_offset  = 0;
+	ssize_t write_count = 0;
+	int file_descriptor = -1;
+
+	for( data_offset = 0;
+	     data_offset < EWF_TEST_IO_URING_FILE_SIZE;
+	     data_offset++ )
+	{
+		ewf_test_io_uring_file_data[ data_offset ] = (uint8_t) ( ( data_offset * 31 ) + ( data_offset >> 8 ) );
+	}
+	file_descriptor = mkstemp(
+	                   filename );
+
+	if( file_descriptor == -1 )
+	{
+		return( -1 );
+	}
+	for( data_offset = 0;
+	     data_offset < EWF_TEST_IO_URING_FILE_SIZE;
+	     data_offset += (size_t) write_count )
+	{
+		write_count = write(
+		               file_descriptor,
+		               &( ewf_test_io_uring_file_data[ data_offset ] ),
+		               EWF_TEST_IO_URING_FILE_SIZE - data_offset );
+
+		if( write_count <= 0 )
+		{
+			close(
+			 file_descriptor );
+
+			return( -1 );
+		}
+	}
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the libewf_io_uring_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_io_uring_initialize(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	libewf_io_uring_t *io_uring = NULL;
+	int result                  = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_io_uring_initialize(
+	          &io_uring,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The kernel does not support io_uring
+	 */
+	if( result == 0 )
+	{
+		EWF_TEST_ASSERT_IS_NULL(
+		 "io_uring",
+		 io_uring );
+
+		return( 1 );
+	}
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_uring",
+	 io_uring );
+
+	result = libewf_io_uring_free(
+	          &io_uring,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_uring",
+	 io_uring );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_io_uring_initialize(
+	          NULL,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	io_uring = (libewf_io_uring_t *) 0x12345678UL;
+
+	result = libewf_io_uring_initialize(
+	          &io_uring,
+	          4,
+	          &error );
+
+	io_uring = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_io_uring_initialize(
+	          &io_uring,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_io_uring_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_io_uring_initialize(
+		          &io_uring,
+		          4,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( io_uring != NULL )
+			{
+				libewf_io_uring_free(
+				 &io_uring,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "io_uring",
+			 io_uring );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_io_uring_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_io_uring_initialize(
+		          &io_uring,
+		          4,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( io_uring != NULL )
+			{
+				libewf_io_uring_free(
+				 &io_uring,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "io_uring",
+			 io_uring );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_uring != NULL )
+	{
+		libewf_io_uring_free(
+		 &io_uring,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_io_uring_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_io_uring_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_io_uring_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_io_uring_read_buffers function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_io_uring_read_buffers(
+     void )
+{
+	libewf_io_uring_read_request_t read_requests[ 6 ];
+	uint8_t buffers[ 6 ][ EWF_TEST_IO_URING_READ_SIZE ];
+
+	char filename[ 32 ]              = "ewf_test_io_uring.XXXXXX";
+	off64_t read_offsets[ 6 ]        = { 8192, 0, 20480, 4096, 12288, 8 * 4096 };
+	size_t read_sizes[ 6 ]           = { 4096, 4096, 4096, 4096, 100, 1000 };
+	libbfio_handle_t *file_io_handle = NULL;
+	libbfio_pool_t *file_io_pool     = NULL;
+	libcerror_error_t *error         = NULL;
+	libewf_io_uring_t *io_uring      = NULL;
+	int file_created                 = 0;
+	int read_request_index           = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_uring_initialize(
+	          &io_uring,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The kernel does not support io_uring
+	 */
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	result = ewf_test_io_uring_create_test_file(
+	          filename );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	file_created = 1;
+
+	result = libbfio_pool_initialize(
+	          &file_io_pool,
+	          1,
+	          LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_file_initialize(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_file_set_name(
+	          file_io_handle,
+	          filename,
+	          narrow_string_length(
+	           filename ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_set_handle(
+	          file_io_pool,
+	          0,
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	file_io_handle = NULL;
+
+	/* Test regular cases
+	 * More read requests than the queue depth are read out of order
+	 * and the last read request ends at the end of the file
+	 */
+	for( read_request_index = 0;
+	     read_request_index < 6;
+	     read_request_index++ )
+	{
+		read_requests[ read_request_index ].file_io_pool_entry = 0;
+		read_requests[ read_request_index ].offset             = read_offsets[ read_request_index ];
+		read_requests[ read_request_index ].buffer             = buffers[ read_request_index ];
+		read_requests[ read_request_index ].size               = read_sizes[ read_request_index ];
+		read_requests[ read_request_index ].read_count         = 0;
+	}
+	result = libewf_io_uring_read_buffers(
+	          io_uring,
+	          file_io_pool,
+	          read_requests,
+	          6,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( read_request_index = 0;
+	     read_request_index < 6;
+	     read_request_index++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "read_count",
+		 read_requests[ read_request_index ].read_count,
+		 read_sizes[ read_request_index ] );
+
+		result = memory_compare(
+		          buffers[ read_request_index ],
+		          &( ewf_test_io_uring_file_data[ read_offsets[ read_request_index ] ] ),
+		          read_sizes[ read_request_index ] );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test no read requests
+	 */
+	result = libewf_io_uring_read_buffers(
+	          io_uring,
+	          file_io_pool,
+	          read_requests,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a read request that crosses the end of the file
+	 * The short read is resubmitted for the remaining data, which fails at the end of the file
+	 */
+	read_requests[ 0 ].offset     = 4096;
+	read_requests[ 0 ].size       = EWF_TEST_IO_URING_READ_SIZE;
+	read_requests[ 0 ].read_count = 0;
+
+	read_requests[ 1 ].offset     = EWF_TEST_IO_URING_FILE_SIZE - 1000;
+	read_requests[ 1 ].size       = EWF_TEST_IO_URING_READ_SIZE;
+	read_requests[ 1 ].read_count = 0;
+
+	result = libewf_io_uring_read_buffers(
+	          io_uring,
+	          file_io_pool,
+	          read_requests,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "read_count",
+	 read_requests[ 0 ].read_count,
+	 (size_t) EWF_TEST_IO_URING_READ_SIZE );
+
+	result = memory_compare(
+	          buffers[ 0 ],
+	          &( ewf_test_io_uring_file_data[ 4096 ] ),
+	          EWF_TEST_IO_URING_READ_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "read_count",
+	 read_requests[ 1 ].read_count,
+	 (size_t) 1000 );
+
+	result = memory_compare(
+	          buffers[ 1 ],
+	          &( ewf_test_io_uring_file_data[ EWF_TEST_IO_URING_FILE_SIZE - 1000 ] ),
+	          1000 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test that the io_uring remains usable after a failed read
+	 * since all the completions of the failed read were reaped
+	 */
+	read_requests[ 0 ].offset     = 16384;
+	read_requests[ 0 ].size       = EWF_TEST_IO_URING_READ_SIZE;
+	read_requests[ 0 ].read_count = 0;
+
+	result = libewf_io_uring_read_buffers(
+	          io_uring,
+	          file_io_pool,
+	          read_requests,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "read_count",
+	 read_requests[ 0 ].read_count,
+	 (size_t) EWF_TEST_IO_URING_READ_SIZE );
+
+	result = memory_compare(
+	          buffers[ 0 ],
+	          &( ewf_test_io_uring_file_data[ 16384 ] ),
+	          EWF_TEST_IO_URING_READ_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_io_uring_read_buffers(
+	          NULL,
+	          file_io_pool,
+	          read_requests,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_io_uring_read_buffers(
+	          io_uring,
+	          file_io_pool,
+	          NULL,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_io_uring_read_buffers(
+	          io_uring,
+	          file_io_pool,
+	          read_requests,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_io_uring_free(
+	          &io_uring,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_free(
+	          &file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	unlink(
+	 filename );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	if( io_uring != NULL )
+	{
+		libewf_io_uring_free(
+		 &io_uring,
+		 NULL );
+	}
+	if( file_created != 0 )
+	{
+		unlink(
+		 filename );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_IO_URING ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_IO_URING )
+
+	EWF_TEST_RUN(
+	 "libewf_io_uring_initialize",
+	 ewf_test_io_uring_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_io_uring_free",
+	 ewf_test_io_uring_free );
+
+	EWF_TEST_RUN(
+	 "libewf_io_uring_read_buffers",
+	 ewf_test_io_uring_read_buffers );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_IO_URING ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1522 @@
+/*
+ * Library memory-mapped file IO handle type test program
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "ewf_test_getopt.h"
+#include "ewf_test_libbfio.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_mmap_file_io_handle.h"
+
+/* The test file is not a multiple of the read size, so that a read can cross the end of the file
+ */
+#define EWF_TEST_MMAP_FILE_IO_HANDLE_FILE_SIZE		( ( 2 * 4096 ) + 1000 )
+#define EWF_TEST_MMAP_FILE_IO_HANDLE_READ_SIZE		4096
+#define EWF_TEST_MMAP_FILE_IO_HANDLE_MAXIMUM_DATA_SIZE	( 16 * 1024 * 1024 )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MMAP_FILE_IO_HANDLE )
+
+uint8_t ewf_test_mmap_file_io_handle_file_data[ EWF_TEST_MMAP_FILE_IO_HANDLE_FILE_SIZE ];
+
+/* Creates a test file with the test file data
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_mmap_file_io_handle_create_test_file(
+     char *filename,
+     size_t file_size )
+{
+	size_t data_offset  = 0;
+	ssize_t write_count = 0;
+	int file_descriptor = -1;
+
+	if( file_size > EWF_TEST_MMAP_FILE_IO_HANDLE_FILE_SIZE )
+	{
+		return( -1 );
+	}
+	for( data_offset = 0;
+	     data_offset < EWF_TEST_MMAP_FILE_IO_HANDLE_FILE_SIZE;
+	     data_offset++ )
+	{
+		ewf_test_mmap_file_io_handle_file_data[ data_offset ] = (uint8_t) ( ( data_offset * 31 ) + ( data_offset >> 8 ) );
+	}
+	file_descriptor = mkstemp(
+	                   filename );
+
+	if( file_descriptor == -1 )
+	{
+		return( -1 );
+	}
+	for( data_offset = 0;
+	     data_offset < file_size;
+	     data_offset += (size_t) write_count )
+	{
+		write_count = write(
+		               file_descriptor,
+		               &( ewf_test_mmap_file_io_handle_file_data[ data_offset ] ),
+		               file_size - data_offset );
+
+		if( write_count <= 0 )
+		{
+			close(
+			 file_descriptor );
+
+			unlink(
+			 filename );
+
+			return( -1 );
+		}
+	}
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		unlink(
+		 filename );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the libewf_mmap_file_io_handle_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_mmap_file_io_handle_initialize(
+     void )
+{
+	libcerror_error_t *error                          = NULL;
+	libewf_mmap_file_io_handle_t *mmap_file_io_handle = NULL;
+	int result                                        = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests                   = 1;
+	int number_of_memset_fail_tests                   = 1;
+	int test_number                                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_mmap_file_io_handle_initialize(
+	          &mmap_file_io_handle,
+	          LIBEWF_MEMORY_MAPPED_IO_MODE_RANDOM,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "mmap_file_io_handle",
+	 mmap_file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_mmap_file_io_handle_free(
+	          &mmap_file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "mmap_file_io_handle",
+	 mmap_file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_mmap_file_io_handle_initialize(
+	          NULL,
+	          LIBEWF_MEMORY_MAPPED_IO_MODE_RANDOM,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	mmap_file_io_handle = (libewf_mmap_file_io_handle_t *) 0x12345678UL;
+
+	result = libewf_mmap_file_io_handle_initialize(
+	          &mmap_file_io_handle,
+	          LIBEWF_MEMORY_MAPPED_IO_MODE_RANDOM,
+	          &error );
+
+	mmap_file_io_handle = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_mmap_file_io_handle_initialize(
+	          &mmap_file_io_handle,
+	          LIBEWF_MEMORY_MAPPED_IO_MODE_DISABLED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_mmap_file_io_handle_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_mmap_file_io_handle_initialize(
+		          &mmap_file_io_handle,
+		          LIBEWF_MEMORY_MAPPED_IO_MODE_RANDOM,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( mmap_file_io_handle != NULL )
+			{
+				libewf_mmap_file_io_handle_free(
+				 &mmap_file_io_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "mmap_file_io_handle",
+			 mmap_file_io_handle );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_mmap_file_io_handle_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_mmap_file_io_handle_initialize(
+		          &mmap_file_io_handle,
+		          LIBEWF_MEMORY_MAPPED_IO_MODE_RANDOM,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( mmap_file_io_handle != NULL )
+			{
+				libewf_mmap_file_io_handle_free(
+				 &mmap_file_io_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "mmap_file_io_handle",
+			 mmap_file_io_handle );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( mmap_file_io_handle != NULL )
+	{
+		libewf_mmap_file_io_handle_free(
+		 &mmap_file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_mmap_file_io_handle_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_mmap_file_io_handle_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_mmap_file_io_handle_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_UNISTD_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+/* Tests the libewf_mmap_file_io_handle_open, libewf_mmap_file_io_handle_read,
+ * libewf_mmap_file_io_handle_seek_offset and libewf_mmap_file_io_handle_close functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_mmap_file_io_handle_read(
+     void )
+{
+	uint8_t buffer[ EWF_TEST_MMAP_FILE_IO_HANDLE_READ_SIZE ];
+	char filename[ 40 ];
+
+	libcerror_error_t *error                          = NULL;
+	libewf_mmap_file_io_handle_t *mmap_file_io_handle = NULL;
+	size64_t file_size                                = 0;
+	ssize_t read_count                                = 0;
+	off64_t offset                                    = 0;
+	int file_created                                  = 0;
+	int result                                        = 0;
+
+	/* Initialize test
+	 */
+	narrow_string_copy(
+	 filename,
+	 "ewf_test_mmap_file_io_handle.XXXXXX",
+	 36 );
+
+	result = ewf_test_mmap_file_io_handle_create_test_file(
+	          filename,
+	          EWF_TEST_MMAP_FILE_IO_HANDLE_FILE_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	file_created = 1;
+
+	result = libewf_mmap_file_io_handle_initialize(
+	          &mmap_file_io_handle,
+	          LIBEWF_MEMORY_MAPPED_IO_MODE_RANDOM,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "mmap_file_io_handle",
+	 mmap_file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_mmap_file_io_handle_set_name(
+	          mmap_file_io_handle,
+	          filename,
+	          narrow_string_length(
+	           filename ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open
+	 */
+	result = libewf_mmap_file_io_handle_open(
+	          mmap_file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "mmap_file_io_handle->mapped_data",
+	 mmap_file_io_handle->mapped_data );
+
+	result = libewf_mmap_file_io_handle_is_open(
+	          mmap_file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_mmap_file_io_handle_get_size(
+	          mmap_file_io_handle,
+	          &file_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "file_size",
+	 (uint64_t) file_size,
+	 (uint64_t) EWF_TEST_MMAP_FILE_IO_HANDLE_FILE_SIZE );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test read from the start of the file
+	 */
+	read_count = libewf_mmap_file_io_handle_read(
+	              mmap_file_io_handle,
+	              buffer,
+	              EWF_TEST_MMAP_FILE_IO_HANDLE_READ_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) EWF_TEST_MMAP_FILE_IO_HANDLE_READ_SIZE );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          ewf_test_mmap_file_io_handle_file_data,
+	          EWF_TEST_MMAP_FILE_IO_HANDLE_READ_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test seek and read that crosses the end of the file
+	 */
+	offset = libewf_mmap_file_io_handle_seek_offset(
+	          mmap_file_io_handle,
+	          2 * EWF_TEST_MMAP_FILE_IO_HANDLE_READ_SIZE,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) ( 2 * EWF_TEST_MMAP_FILE_IO_HANDLE_READ_SIZE ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libewf_mmap_file_io_handle_read(
+	              mmap_file_io_handle,
+	              buffer,
+	              EWF_TEST_MMAP_FILE_IO_HANDLE_READ_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 1000 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( ewf_test_mmap_file_io_handle_file_data[ 2 * EWF_TEST_MMAP_FILE_IO_HANDLE_READ_SIZE ] ),
+	          1000 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test read at the end of the file
+	 */
+	read_count = libewf_mmap_file_io_handle_read(
+	              mmap_file_io_handle,
+	              buffer,
+	              EWF_TEST_MMAP_FILE_IO_HANDLE_READ_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test read beyond the end of the file
+	 */
+	offset = libewf_mmap_file_io_handle_seek_offset(
+	          mmap_file_io_handle,
+	          EWF_TEST_MMAP_FILE_IO_HANDLE_FILE_SIZE + 512,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) ( EWF_TEST_MMAP_FILE_IO_HANDLE_FILE_SIZE + 512 ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libewf_mmap_file_io_handle_read(
+	              mmap_file_io_handle,
+	              buffer,
+	              EWF_TEST_MMAP_FILE_IO_HANDLE_READ_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test seek relative to the end and the current offset
+	 */
+	offset = libewf_mmap_file_io_handle_seek_offset(
+	          mmap_file_io_handle,
+	          -2000,
+	          SEEK_END,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) ( EWF_TEST_MMAP_FILE_IO_HANDLE_FILE_SIZE - 2000 ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_mmap_file_io_handle_seek_offset(
+	          mmap_file_io_handle,
+	          500,
+	          SEEK_CUR,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) ( EWF_TEST_MMAP_FILE_IO_HANDLE_FILE_SIZE - 1500 ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libewf_mmap_file_io_handle_read(
+	              mmap_file_io_handle,
+	              buffer,
+	              EWF_TEST_MMAP_FILE_IO_HANDLE_READ_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 1500 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( ewf_test_mmap_file_io_handle_file_data[ EWF_TEST_MMAP_FILE_IO_HANDLE_FILE_SIZE - 1500 ] ),
+	          1500 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	offset = libewf_mmap_file_io_handle_seek_offset(
+	          mmap_file_io_handle,
+	          -1,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_mmap_file_io_handle_read(
+	              mmap_file_io_handle,
+	              NULL,
+	              EWF_TEST_MMAP_FILE_IO_HANDLE_READ_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_mmap_file_io_handle_write(
+	              mmap_file_io_handle,
+	              buffer,
+	              EWF_TEST_MMAP_FILE_IO_HANDLE_READ_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_mmap_file_io_handle_open(
+	          mmap_file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test close
+	 */
+	result = libewf_mmap_file_io_handle_close(
+	          mmap_file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "mmap_file_io_handle->mapped_data",
+	 mmap_file_io_handle->mapped_data );
+
+	result = libewf_mmap_file_io_handle_is_open(
+	          mmap_file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libewf_mmap_file_io_handle_read(
+	              mmap_file_io_handle,
+	              buffer,
+	              EWF_TEST_MMAP_FILE_IO_HANDLE_READ_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_mmap_file_io_handle_close(
+	          mmap_file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_mmap_file_io_handle_open(
+	          mmap_file_io_handle,
+	          LIBBFIO_OPEN_READ_WRITE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_mmap_file_io_handle_free(
+	          &mmap_file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	unlink(
+	 filename );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( mmap_file_io_handle != NULL )
+	{
+		libewf_mmap_file_io_handle_free(
+		 &mmap_file_io_handle,
+		 NULL );
+	}
+	if( file_created != 0 )
+	{
+		unlink(
+		 filename );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_mmap_file_io_handle_open function with an empty file
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_mmap_file_io_handle_open_empty_file(
+     void )
+{
+	uint8_t buffer[ EWF_TEST_MMAP_FILE_IO_HANDLE_READ_SIZE ];
+	char filename[ 40 ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	size64_t file_size               = 0;
+	ssize_t read_count               = 0;
+	int file_created                 = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	narrow_string_copy(
+	 filename,
+	 "ewf_test_mmap_file_io_handle.XXXXXX",
+	 36 );
+
+	result = ewf_test_mmap_file_io_handle_create_test_file(
+	          filename,
+	          0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	file_created = 1;
+
+	result = libewf_mmap_file_initialize(
+	          &file_io_handle,
+	          LIBEWF_MEMORY_MAPPED_IO_MODE_SEQUENTIAL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_mmap_file_set_name(
+	          file_io_handle,
+	          filename,
+	          narrow_string_length(
+	           filename ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test if an empty file is opened without being mapped
+	 */
+	result = libbfio_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_get_size(
+	          file_io_handle,
+	          &file_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "file_size",
+	 (uint64_t) file_size,
+	 (uint64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              buffer,
+	              EWF_TEST_MMAP_FILE_IO_HANDLE_READ_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_close(
+	          file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	unlink(
+	 filename );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( file_created != 0 )
+	{
+		unlink(
+		 filename );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_UNISTD_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MMAP_FILE_IO_HANDLE ) */
+
+#if defined( HAVE_LIBEWF_MMAP_FILE_IO_HANDLE ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+/* Opens a handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_mmap_file_io_handle_open_handle(
+     libewf_handle_t **handle,
+     char * const filenames[],
+     int number_of_filenames,
+     int memory_mapped_io_mode,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_mmap_file_io_handle_open_handle";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_initialize(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_memory_mapped_io_mode(
+	     *handle,
+	     memory_mapped_io_mode,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set memory-mapped IO mode.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_open(
+	     *handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *handle != NULL )
+	{
+		libewf_handle_free(
+		 handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests reading the media data using memory-mapped IO
+ * The media data read using memory-mapped IO must match the media data read using regular IO
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_mmap_file_io_handle_read_media_data(
+     char * const filenames[],
+     int number_of_filenames )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_handle_t *handle         = NULL;
+	libewf_handle_t *mmap_handle    = NULL;
+	uint8_t *data                   = NULL;
+	uint8_t *mmap_data              = NULL;
+	size64_t media_size             = 0;
+	size64_t mmap_media_size        = 0;
+	size_t data_size                = 0;
+	ssize_t read_count              = 0;
+	int memory_mapped_io_mode       = 0;
+	int result                      = 0;
+
+	result = ewf_test_mmap_file_io_handle_open_handle(
+	          &handle,
+	          filenames,
+	          number_of_filenames,
+	          LIBEWF_MEMORY_MAPPED_IO_MODE_DISABLED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_mmap_file_io_handle_open_handle(
+	          &mmap_handle,
+	          filenames,
+	          number_of_filenames,
+	          LIBEWF_MEMORY_MAPPED_IO_MODE_RANDOM,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_memory_mapped_io_mode(
+	          mmap_handle,
+	          &memory_mapped_io_mode,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "memory_mapped_io_mode",
+	 memory_mapped_io_mode,
+	 LIBEWF_MEMORY_MAPPED_IO_MODE_RANDOM );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_media_size(
+	          mmap_handle,
+	          &mmap_media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "mmap_media_size",
+	 (uint64_t) mmap_media_size,
+	 (uint64_t) media_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_size = EWF_TEST_MMAP_FILE_IO_HANDLE_MAXIMUM_DATA_SIZE;
+
+	if( media_size < (size64_t) data_size )
+	{
+		data_size = (size_t) media_size;
+	}
+	if( data_size > 0 )
+	{
+		data = (uint8_t *) memory_allocate(
+		                    sizeof( uint8_t ) * data_size );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "data",
+		 data );
+
+		mmap_data = (uint8_t *) memory_allocate(
+		                         sizeof( uint8_t ) * data_size );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "mmap_data",
+		 mmap_data );
+
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              data,
+		              data_size,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) data_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libewf_handle_read_buffer_at_offset(
+		              mmap_handle,
+		              mmap_data,
+		              data_size,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) data_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          mmap_data,
+		          data,
+		          data_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		memory_free(
+		 mmap_data );
+
+		mmap_data = NULL;
+
+		memory_free(
+		 data );
+
+		data = NULL;
+	}
+	/* Clean up
+	 */
+	result = libewf_handle_close(
+	          mmap_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_free(
+	          &mmap_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_close(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_free(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( mmap_data != NULL )
+	{
+		memory_free(
+		 mmap_data );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( mmap_handle != NULL )
+	{
+		libewf_handle_free(
+		 &mmap_handle,
+		 NULL );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MMAP_FILE_IO_HANDLE ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+	libcerror_error_t *error       = NULL;
+	system_character_t **filenames = NULL;
+	system_character_t *source     = NULL;
+	system_integer_t option        = 0;
+	size_t string_length           = 0;
+	int number_of_filenames        = 0;
+	int result                     = 0;
+
+	while( ( option = ewf_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+		}
+	}
+	if( optind < argc )
+	{
+		source = argv[ optind ];
+	}
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MMAP_FILE_IO_HANDLE )
+
+	EWF_TEST_RUN(
+	 "libewf_mmap_file_io_handle_initialize",
+	 ewf_test_mmap_file_io_handle_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_mmap_file_io_handle_free",
+	 ewf_test_mmap_file_io_handle_free );
+
+#if defined( HAVE_UNISTD_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+	EWF_TEST_RUN(
+	 "libewf_mmap_file_io_handle_read",
+	 ewf_test_mmap_file_io_handle_read );
+
+	EWF_TEST_RUN(
+	 "libewf_mmap_file_io_handle_open_empty_file",
+	 ewf_test_mmap_file_io_handle_open_empty_file );
+
+#endif /* defined( HAVE_UNISTD_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MMAP_FILE_IO_HANDLE ) */
+
+#if defined( HAVE_LIBEWF_MMAP_FILE_IO_HANDLE ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( source != NULL )
+	{
+		string_length = system_string_length(
+		                 source );
+
+		result = libewf_glob(
+		          source,
+		          string_length,
+		          LIBEWF_FORMAT_UNKNOWN,
+		          &filenames,
+		          &number_of_filenames,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_memory_mapped_io_mode",
+		 ewf_test_mmap_file_io_handle_read_media_data,
+		 filenames,
+		 number_of_filenames );
+
+		/* Clean up
+		 */
+		result = libewf_glob_free(
+		          filenames,
+		          number_of_filenames,
+		          &error );
+
+		filenames = NULL;
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+#endif /* defined( HAVE_LIBEWF_MMAP_FILE_IO_HANDLE ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+#if defined( HAVE_LIBEWF_MMAP_FILE_IO_HANDLE ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( filenames != NULL )
+	{
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+	}
+#endif
+	return( EXIT_FAILURE );
+}
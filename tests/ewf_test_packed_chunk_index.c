@@ -0,0 +1,1318 @@
+/*
+ * Library packed_chunk_index type test program
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_packed_chunk_index.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_packed_chunk_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_packed_chunk_index_initialize(
+     void )
+{
+	libcerror_error_t *error                        = NULL;
+	libewf_packed_chunk_index_t *packed_chunk_index = NULL;
+	int result                                      = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests                 = 1;
+	int number_of_memset_fail_tests                 = 1;
+	int test_number                                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_packed_chunk_index_initialize(
+	          &packed_chunk_index,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "packed_chunk_index",
+	 packed_chunk_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_packed_chunk_index_free(
+	          &packed_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "packed_chunk_index",
+	 packed_chunk_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_packed_chunk_index_initialize(
+	          NULL,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	packed_chunk_index = (libewf_packed_chunk_index_t *) 0x12345678UL;
+
+	result = libewf_packed_chunk_index_initialize(
+	          &packed_chunk_index,
+	          32768,
+	          &error );
+
+	packed_chunk_index = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_packed_chunk_index_initialize(
+	          &packed_chunk_index,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "packed_chunk_index",
+	 packed_chunk_index );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_packed_chunk_index_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_packed_chunk_index_initialize(
+		          &packed_chunk_index,
+		          32768,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( packed_chunk_index != NULL )
+			{
+				libewf_packed_chunk_index_free(
+				 &packed_chunk_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "packed_chunk_index",
+			 packed_chunk_index );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_packed_chunk_index_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_packed_chunk_index_initialize(
+		          &packed_chunk_index,
+		          32768,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( packed_chunk_index != NULL )
+			{
+				libewf_packed_chunk_index_free(
+				 &packed_chunk_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "packed_chunk_index",
+			 packed_chunk_index );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( packed_chunk_index != NULL )
+	{
+		libewf_packed_chunk_index_free(
+		 &packed_chunk_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_packed_chunk_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_packed_chunk_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_packed_chunk_index_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_packed_chunk_index_append_entry function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_packed_chunk_index_append_entry(
+     void )
+{
+	libcerror_error_t *error                        = NULL;
+	libewf_packed_chunk_index_t *packed_chunk_index = NULL;
+	off64_t chunk_data_offset                       = 0;
+	size64_t chunk_data_size                        = 0;
+	uint32_t range_flags                            = 0;
+	int entry_index                                 = 0;
+	int file_io_pool_entry                          = 0;
+	int number_of_entries                           = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_packed_chunk_index_initialize(
+	          &packed_chunk_index,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "packed_chunk_index",
+	 packed_chunk_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( entry_index = 0;
+	     entry_index < 100;
+	     entry_index++ )
+	{
+		if( ( entry_index % 2 ) == 0 )
+		{
+			range_flags = LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+		}
+		else
+		{
+			range_flags = LIBEWF_RANGE_FLAG_HAS_CHECKSUM | LIBEWF_RANGE_FLAG_IS_TAINTED;
+		}
+		result = libewf_packed_chunk_index_append_entry(
+		          packed_chunk_index,
+		          &number_of_entries,
+		          3,
+		          (off64_t) 0x100004c0UL + ( (off64_t) entry_index * 32772 ),
+		          32772,
+		          range_flags,
+		          32768,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "number_of_entries",
+		 number_of_entries,
+		 entry_index );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Append a chunk that uses pattern fill, its chunk data offset refers to its table entry
+	 */
+	result = libewf_packed_chunk_index_append_entry(
+	          packed_chunk_index,
+	          &entry_index,
+	          3,
+	          (off64_t) 0x20000050UL + ( 100 * 16 ),
+	          8,
+	          LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "entry_index",
+	 entry_index,
+	 100 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_packed_chunk_index_get_number_of_entries(
+	          packed_chunk_index,
+	          &number_of_entries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 101 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_packed_chunk_index_get_entry_by_index(
+	          packed_chunk_index,
+	          99,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_entry",
+	 file_io_pool_entry,
+	 3 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "chunk_data_offset",
+	 (int64_t) chunk_data_offset,
+	 (int64_t) 0x100004c0UL + ( 99 * 32772 ) );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_data_size",
+	 (uint64_t) chunk_data_size,
+	 (uint64_t) 32772 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) ( LIBEWF_RANGE_FLAG_HAS_CHECKSUM | LIBEWF_RANGE_FLAG_IS_TAINTED ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_packed_chunk_index_get_entry_by_index(
+	          packed_chunk_index,
+	          100,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "chunk_data_offset",
+	 (int64_t) chunk_data_offset,
+	 (int64_t) 0x20000050UL + ( 100 * 16 ) );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_data_size",
+	 (uint64_t) chunk_data_size,
+	 (uint64_t) 8 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) ( LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test values that cannot be packed
+	 */
+	result = libewf_packed_chunk_index_append_entry(
+	          packed_chunk_index,
+	          &entry_index,
+	          3,
+	          0x10000000UL,
+	          32772,
+	          LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_packed_chunk_index_append_entry(
+	          packed_chunk_index,
+	          &entry_index,
+	          3,
+	          (off64_t) 0x100004c0UL + 0x100000000ULL,
+	          32772,
+	          LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_packed_chunk_index_append_entry(
+	          packed_chunk_index,
+	          &entry_index,
+	          3,
+	          0x20000000UL,
+	          LIBEWF_PACKED_CHUNK_INDEX_MAXIMUM_CHUNK_DATA_SIZE + 1,
+	          LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_packed_chunk_index_append_entry(
+	          packed_chunk_index,
+	          &entry_index,
+	          4,
+	          0x20000000UL,
+	          32772,
+	          LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_packed_chunk_index_append_entry(
+	          packed_chunk_index,
+	          &entry_index,
+	          3,
+	          0x20000000UL,
+	          32772,
+	          LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+	          65536,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_packed_chunk_index_append_entry(
+	          packed_chunk_index,
+	          &entry_index,
+	          3,
+	          0x20000060UL + ( 101 * 16 ),
+	          8,
+	          LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_packed_chunk_index_get_number_of_entries(
+	          packed_chunk_index,
+	          &number_of_entries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 101 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_packed_chunk_index_append_entry(
+	          NULL,
+	          &entry_index,
+	          3,
+	          0x20000000UL,
+	          32772,
+	          LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_packed_chunk_index_append_entry(
+	          packed_chunk_index,
+	          NULL,
+	          3,
+	          0x20000000UL,
+	          32772,
+	          LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_packed_chunk_index_free(
+	          &packed_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "packed_chunk_index",
+	 packed_chunk_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( packed_chunk_index != NULL )
+	{
+		libewf_packed_chunk_index_free(
+		 &packed_chunk_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_packed_chunk_index_set_entry_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_packed_chunk_index_set_entry_by_index(
+     void )
+{
+	libcerror_error_t *error                        = NULL;
+	libewf_packed_chunk_index_t *packed_chunk_index = NULL;
+	off64_t chunk_data_offset                       = 0;
+	size64_t chunk_data_size                        = 0;
+	uint32_t range_flags                            = 0;
+	int entry_index                                 = 0;
+	int file_io_pool_entry                          = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_packed_chunk_index_initialize(
+	          &packed_chunk_index,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "packed_chunk_index",
+	 packed_chunk_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( entry_index = 0;
+	     entry_index < 4;
+	     entry_index++ )
+	{
+		result = libewf_packed_chunk_index_append_entry(
+		          packed_chunk_index,
+		          &file_io_pool_entry,
+		          1,
+		          (off64_t) 0x0000004cUL + ( (off64_t) entry_index * 32772 ),
+		          32772,
+		          LIBEWF_RANGE_FLAG_HAS_CHECKSUM | LIBEWF_RANGE_FLAG_IS_TAINTED,
+		          32768,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	result = libewf_packed_chunk_index_set_entry_by_index(
+	          packed_chunk_index,
+	          2,
+	          1,
+	          0x0000104cUL,
+	          1234,
+	          LIBEWF_RANGE_FLAG_IS_COMPRESSED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_packed_chunk_index_get_entry_by_index(
+	          packed_chunk_index,
+	          2,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "chunk_data_offset",
+	 (int64_t) chunk_data_offset,
+	 (int64_t) 0x0000104cUL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_data_size",
+	 (uint64_t) chunk_data_size,
+	 (uint64_t) 1234 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) LIBEWF_RANGE_FLAG_IS_COMPRESSED );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test values that cannot be packed, the entry is not changed
+	 */
+	result = libewf_packed_chunk_index_set_entry_by_index(
+	          packed_chunk_index,
+	          2,
+	          1,
+	          0x00000000UL,
+	          32772,
+	          LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_packed_chunk_index_set_entry_by_index(
+	          packed_chunk_index,
+	          2,
+	          1,
+	          0x0000104cUL,
+	          32772,
+	          0x80000000UL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_packed_chunk_index_get_entry_by_index(
+	          packed_chunk_index,
+	          2,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "chunk_data_offset",
+	 (int64_t) chunk_data_offset,
+	 (int64_t) 0x0000104cUL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_data_size",
+	 (uint64_t) chunk_data_size,
+	 (uint64_t) 1234 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_packed_chunk_index_set_entry_by_index(
+	          NULL,
+	          2,
+	          1,
+	          0x0000104cUL,
+	          1234,
+	          LIBEWF_RANGE_FLAG_IS_COMPRESSED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_packed_chunk_index_set_entry_by_index(
+	          packed_chunk_index,
+	          4,
+	          1,
+	          0x0000104cUL,
+	          1234,
+	          LIBEWF_RANGE_FLAG_IS_COMPRESSED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_packed_chunk_index_get_entry_by_index(
+	          packed_chunk_index,
+	          -1,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_packed_chunk_index_free(
+	          &packed_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "packed_chunk_index",
+	 packed_chunk_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( packed_chunk_index != NULL )
+	{
+		libewf_packed_chunk_index_free(
+		 &packed_chunk_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_packed_chunk_index_get_entry_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_packed_chunk_index_get_entry_at_offset(
+     void )
+{
+	libcerror_error_t *error                        = NULL;
+	libewf_packed_chunk_index_t *packed_chunk_index = NULL;
+	off64_t chunk_data_offset                       = 0;
+	off64_t entry_data_offset                       = 0;
+	size64_t chunk_data_size                        = 0;
+	uint32_t range_flags                            = 0;
+	int entry_index                                 = 0;
+	int file_io_pool_entry                          = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_packed_chunk_index_initialize(
+	          &packed_chunk_index,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "packed_chunk_index",
+	 packed_chunk_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_packed_chunk_index_reserve(
+	          packed_chunk_index,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( entry_index = 0;
+	     entry_index < 16;
+	     entry_index++ )
+	{
+		result = libewf_packed_chunk_index_append_entry(
+		          packed_chunk_index,
+		          &file_io_pool_entry,
+		          0,
+		          (off64_t) 0x00001000UL + ( (off64_t) entry_index * 0x1000 ),
+		          (size64_t) 0x00000100UL + entry_index,
+		          LIBEWF_RANGE_FLAG_IS_COMPRESSED,
+		          32768,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	result = libewf_packed_chunk_index_get_entry_at_offset(
+	          packed_chunk_index,
+	          ( 7 * 32768 ) + 17,
+	          &entry_index,
+	          &entry_data_offset,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "entry_index",
+	 entry_index,
+	 7 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "entry_data_offset",
+	 (int64_t) entry_data_offset,
+	 (int64_t) 17 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_entry",
+	 file_io_pool_entry,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "chunk_data_offset",
+	 (int64_t) chunk_data_offset,
+	 (int64_t) 0x00008000UL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_data_size",
+	 (uint64_t) chunk_data_size,
+	 (uint64_t) 0x00000107UL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) LIBEWF_RANGE_FLAG_IS_COMPRESSED );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_packed_chunk_index_get_entry_at_offset(
+	          packed_chunk_index,
+	          16 * 32768,
+	          &entry_index,
+	          &entry_data_offset,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_packed_chunk_index_get_entry_at_offset(
+	          NULL,
+	          0,
+	          &entry_index,
+	          &entry_data_offset,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_packed_chunk_index_get_entry_at_offset(
+	          packed_chunk_index,
+	          -1,
+	          &entry_index,
+	          &entry_data_offset,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_packed_chunk_index_get_entry_at_offset(
+	          packed_chunk_index,
+	          0,
+	          NULL,
+	          &entry_data_offset,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libewf_packed_chunk_index_empty
+	 */
+	result = libewf_packed_chunk_index_empty(
+	          packed_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_packed_chunk_index_get_entry_at_offset(
+	          packed_chunk_index,
+	          0,
+	          &entry_index,
+	          &entry_data_offset,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libewf_packed_chunk_index_free(
+	          &packed_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "packed_chunk_index",
+	 packed_chunk_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( packed_chunk_index != NULL )
+	{
+		libewf_packed_chunk_index_free(
+		 &packed_chunk_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_packed_chunk_index_initialize",
+	 ewf_test_packed_chunk_index_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_packed_chunk_index_free",
+	 ewf_test_packed_chunk_index_free );
+
+	EWF_TEST_RUN(
+	 "libewf_packed_chunk_index_append_entry",
+	 ewf_test_packed_chunk_index_append_entry );
+
+	EWF_TEST_RUN(
+	 "libewf_packed_chunk_index_set_entry_by_index",
+	 ewf_test_packed_chunk_index_set_entry_by_index );
+
+	EWF_TEST_RUN(
+	 "libewf_packed_chunk_index_get_entry_at_offset",
+	 ewf_test_packed_chunk_index_get_entry_at_offset );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,587 @@
+/*
+ * Library concurrent read benchmark testing program
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "ewf_test_getopt.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcthreads.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+
+#define EWF_TEST_READ_THREADS_BENCHMARK_MAXIMUM_NUMBER_OF_THREADS	8
+#define EWF_TEST_READ_THREADS_BENCHMARK_MAXIMUM_DATA_SIZE		( 64 * 1024 * 1024 )
+#define EWF_TEST_READ_THREADS_BENCHMARK_NUMBER_OF_READS		512
+#define EWF_TEST_READ_THREADS_BENCHMARK_READ_BUFFER_SIZE		( 64 * 1024 )
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+
+typedef struct ewf_test_read_threads_benchmark_context ewf_test_read_threads_benchmark_context_t;
+
+struct ewf_test_read_threads_benchmark_context
+{
+	/* The handle
+	 */
+	libewf_handle_t *handle;
+
+	/* The reference data
+	 */
+	const uint8_t *reference_data;
+
+	/* The reference data size
+	 */
+	size_t reference_data_size;
+
+	/* The seed of the pseudo random number generator
+	 */
+	uint32_t seed;
+
+	/* The number of bytes read
+	 */
+	size64_t number_of_bytes_read;
+
+	/* The number of mismatches
+	 */
+	int number_of_mismatches;
+
+	/* The number of read errors
+	 */
+	int number_of_read_errors;
+};
+
+/* Retrieves a timestamp in micro seconds
+ * Returns the timestamp
+ */
+uint64_t ewf_test_read_threads_benchmark_get_timestamp(
+          void )
+{
+#if defined( HAVE_CLOCK_GETTIME )
+	struct timespec time_structure;
+
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_structure.tv_sec * 1000000 ) + ( (uint64_t) time_structure.tv_nsec / 1000 ) );
+#else
+	return( (uint64_t) time( NULL ) * 1000000 );
+#endif
+}
+
+/* Reads random ranges using libewf_handle_pread_buffer and compares them with the reference data
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_read_threads_benchmark_callback(
+     ewf_test_read_threads_benchmark_context_t *context )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t *buffer          = NULL;
+	size_t read_size         = 0;
+	ssize_t read_count       = 0;
+	off64_t read_offset      = 0;
+	uint32_t seed            = 0;
+	int read_number          = 0;
+
+	if( context == NULL )
+	{
+		return( -1 );
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * EWF_TEST_READ_THREADS_BENCHMARK_READ_BUFFER_SIZE );
+
+	if( buffer == NULL )
+	{
+		return( -1 );
+	}
+	seed = context->seed;
+
+	for( read_number = 0;
+	     read_number < EWF_TEST_READ_THREADS_BENCHMARK_NUMBER_OF_READS;
+	     read_number++ )
+	{
+		/* Linear congruential generator, rand() is not thread-safe
+		 */
+		seed        = ( seed * 1103515245UL ) + 12345;
+		read_offset = (off64_t) ( seed % context->reference_data_size );
+
+		seed      = ( seed * 1103515245UL ) + 12345;
+		read_size = (size_t) ( seed % EWF_TEST_READ_THREADS_BENCHMARK_READ_BUFFER_SIZE ) + 1;
+
+		if( read_size > ( context->reference_data_size - read_offset ) )
+		{
+			read_size = context->reference_data_size - read_offset;
+		}
+		read_count = libewf_handle_pread_buffer(
+		              context->handle,
+		              buffer,
+		              read_size,
+		              read_offset,
+		              &error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_free(
+			 &error );
+
+			context->number_of_read_errors += 1;
+
+			continue;
+		}
+		if( memory_compare(
+		     buffer,
+		     &( context->reference_data[ read_offset ] ),
+		     read_size ) != 0 )
+		{
+			context->number_of_mismatches += 1;
+		}
+		context->number_of_bytes_read += read_size;
+	}
+	memory_free(
+	 buffer );
+
+	return( 1 );
+}
+
+/* Reads the reference data and measures the throughput of the concurrent reads for 1 up to 8 threads
+ * The speed-up is relative to the throughput of a single thread
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_threads_benchmark_pread_buffer(
+     libewf_handle_t *handle )
+{
+	ewf_test_read_threads_benchmark_context_t contexts[ EWF_TEST_READ_THREADS_BENCHMARK_MAXIMUM_NUMBER_OF_THREADS ];
+	libcthreads_thread_t *threads[ EWF_TEST_READ_THREADS_BENCHMARK_MAXIMUM_NUMBER_OF_THREADS ];
+
+	libcerror_error_t *error        = NULL;
+	uint8_t *reference_data         = NULL;
+	size64_t media_size             = 0;
+	size64_t number_of_bytes_read   = 0;
+	size_t reference_data_size      = 0;
+	ssize_t read_count              = 0;
+	uint64_t elapsed_time           = 0;
+	uint64_t single_thread_time     = 0;
+	uint64_t start_time             = 0;
+	int number_of_mismatches        = 0;
+	int number_of_read_errors       = 0;
+	int number_of_threads           = 0;
+	int result                      = 0;
+	int thread_index                = 0;
+
+	for( thread_index = 0;
+	     thread_index < EWF_TEST_READ_THREADS_BENCHMARK_MAXIMUM_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		threads[ thread_index ] = NULL;
+	}
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size == 0 )
+	{
+		return( 1 );
+	}
+	reference_data_size = EWF_TEST_READ_THREADS_BENCHMARK_MAXIMUM_DATA_SIZE;
+
+	if( media_size < (size64_t) reference_data_size )
+	{
+		reference_data_size = (size_t) media_size;
+	}
+	reference_data = (uint8_t *) memory_allocate(
+	                              sizeof( uint8_t ) * reference_data_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "reference_data",
+	 reference_data );
+
+	/* Read the reference data single threaded using the current offset
+	 */
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              reference_data,
+	              reference_data_size,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) reference_data_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( number_of_threads = 1;
+	     number_of_threads <= EWF_TEST_READ_THREADS_BENCHMARK_MAXIMUM_NUMBER_OF_THREADS;
+	     number_of_threads *= 2 )
+	{
+		for( thread_index = 0;
+		     thread_index < number_of_threads;
+		     thread_index++ )
+		{
+			contexts[ thread_index ].handle                = handle;
+			contexts[ thread_index ].reference_data        = reference_data;
+			contexts[ thread_index ].reference_data_size   = reference_data_size;
+			contexts[ thread_index ].seed                  = (uint32_t) ( thread_index + 1 ) * 2654435761UL;
+			contexts[ thread_index ].number_of_bytes_read  = 0;
+			contexts[ thread_index ].number_of_mismatches  = 0;
+			contexts[ thread_index ].number_of_read_errors = 0;
+		}
+		start_time = ewf_test_read_threads_benchmark_get_timestamp();
+
+		for( thread_index = 0;
+		     thread_index < number_of_threads;
+		     thread_index++ )
+		{
+			result = libcthreads_thread_create(
+			          &( threads[ thread_index ] ),
+			          NULL,
+			          (int (*)(void *)) &ewf_test_read_threads_benchmark_callback,
+			          (void *) &( contexts[ thread_index ] ),
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		for( thread_index = 0;
+		     thread_index < number_of_threads;
+		     thread_index++ )
+		{
+			result = libcthreads_thread_join(
+			          &( threads[ thread_index ] ),
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		elapsed_time = ewf_test_read_threads_benchmark_get_timestamp() - start_time;
+
+		number_of_bytes_read  = 0;
+		number_of_mismatches  = 0;
+		number_of_read_errors = 0;
+
+		for( thread_index = 0;
+		     thread_index < number_of_threads;
+		     thread_index++ )
+		{
+			number_of_bytes_read  += contexts[ thread_index ].number_of_bytes_read;
+			number_of_mismatches  += contexts[ thread_index ].number_of_mismatches;
+			number_of_read_errors += contexts[ thread_index ].number_of_read_errors;
+		}
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "number_of_read_errors",
+		 number_of_read_errors,
+		 0 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "number_of_mismatches",
+		 number_of_mismatches,
+		 0 );
+
+		if( elapsed_time == 0 )
+		{
+			elapsed_time = 1;
+		}
+		if( number_of_threads == 1 )
+		{
+			single_thread_time = elapsed_time;
+		}
+		fprintf(
+		 stdout,
+		 "Concurrent read with %d thread(s): %" PRIu64 " bytes in %" PRIu64 " us (%" PRIu64 " MiB/s, speed-up: %" PRIu64 ".%02" PRIu64 ")\n",
+		 number_of_threads,
+		 number_of_bytes_read,
+		 elapsed_time,
+		 ( number_of_bytes_read / elapsed_time ) * 1000000 / ( 1024 * 1024 ),
+		 ( single_thread_time * number_of_threads ) / elapsed_time,
+		 ( ( single_thread_time * number_of_threads * 100 ) / elapsed_time ) % 100 );
+	}
+	memory_free(
+	 reference_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( thread_index = 0;
+	     thread_index < EWF_TEST_READ_THREADS_BENCHMARK_MAXIMUM_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		if( threads[ thread_index ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( threads[ thread_index ] ),
+			 NULL );
+		}
+	}
+	if( reference_data != NULL )
+	{
+		memory_free(
+		 reference_data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+	libcerror_error_t *error       = NULL;
+	libewf_handle_t *handle        = NULL;
+	system_character_t **filenames = NULL;
+	system_character_t *source     = NULL;
+	system_integer_t option        = 0;
+	size_t string_length           = 0;
+	int number_of_filenames        = 0;
+	int result                     = 0;
+
+	while( ( option = ewf_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+		}
+	}
+	if( optind < argc )
+	{
+		source = argv[ optind ];
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+	if( source != NULL )
+	{
+		string_length = system_string_length(
+		                 source );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libewf_glob_wide(
+		          source,
+		          string_length,
+		          LIBEWF_FORMAT_UNKNOWN,
+		          &filenames,
+		          &number_of_filenames,
+		          &error );
+#else
+		result = libewf_glob(
+		          source,
+		          string_length,
+		          LIBEWF_FORMAT_UNKNOWN,
+		          &filenames,
+		          &number_of_filenames,
+		          &error );
+#endif
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_initialize(
+		          &handle,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libewf_handle_open_wide(
+		          handle,
+		          filenames,
+		          number_of_filenames,
+		          LIBEWF_OPEN_READ,
+		          &error );
+#else
+		result = libewf_handle_open(
+		          handle,
+		          filenames,
+		          number_of_filenames,
+		          LIBEWF_OPEN_READ,
+		          &error );
+#endif
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_pread_buffer",
+		 ewf_test_read_threads_benchmark_pread_buffer,
+		 handle );
+
+		/* Clean up
+		 */
+		result = libewf_handle_close(
+		          handle,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_free(
+		          &handle,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libewf_glob_wide_free(
+		          filenames,
+		          number_of_filenames,
+		          &error );
+#else
+		result = libewf_glob_free(
+		          filenames,
+		          number_of_filenames,
+		          &error );
+#endif
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( EXIT_FAILURE );
+}
+
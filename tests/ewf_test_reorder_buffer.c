@@ -0,0 +1,672 @@
+/*
+ * Library reorder_buffer type test program
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_reorder_buffer.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_reorder_buffer_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_reorder_buffer_initialize(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libewf_reorder_buffer_t *reorder_buffer = NULL;
+	int result                              = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests         = 2;
+	int number_of_memset_fail_tests         = 2;
+	int test_number                         = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_reorder_buffer_initialize(
+	          &reorder_buffer,
+	          4,
+	          LIBEWF_DEFAULT_REORDER_BUFFER_MEMORY_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "reorder_buffer",
+	 reorder_buffer );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_reorder_buffer_free(
+	          &reorder_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "reorder_buffer",
+	 reorder_buffer );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_reorder_buffer_initialize(
+	          NULL,
+	          4,
+	          LIBEWF_DEFAULT_REORDER_BUFFER_MEMORY_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	reorder_buffer = (libewf_reorder_buffer_t *) 0x12345678UL;
+
+	result = libewf_reorder_buffer_initialize(
+	          &reorder_buffer,
+	          4,
+	          LIBEWF_DEFAULT_REORDER_BUFFER_MEMORY_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	reorder_buffer = NULL;
+
+	result = libewf_reorder_buffer_initialize(
+	          &reorder_buffer,
+	          0,
+	          LIBEWF_DEFAULT_REORDER_BUFFER_MEMORY_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_reorder_buffer_initialize(
+	          &reorder_buffer,
+	          LIBEWF_MAXIMUM_REORDER_BUFFER_NUMBER_OF_CHUNKS + 1,
+	          LIBEWF_DEFAULT_REORDER_BUFFER_MEMORY_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_reorder_buffer_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_reorder_buffer_initialize(
+		          &reorder_buffer,
+		          4,
+		          LIBEWF_DEFAULT_REORDER_BUFFER_MEMORY_SIZE,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( reorder_buffer != NULL )
+			{
+				libewf_reorder_buffer_free(
+				 &reorder_buffer,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "reorder_buffer",
+			 reorder_buffer );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_reorder_buffer_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_reorder_buffer_initialize(
+		          &reorder_buffer,
+		          4,
+		          LIBEWF_DEFAULT_REORDER_BUFFER_MEMORY_SIZE,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( reorder_buffer != NULL )
+			{
+				libewf_reorder_buffer_free(
+				 &reorder_buffer,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "reorder_buffer",
+			 reorder_buffer );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( reorder_buffer != NULL )
+	{
+		libewf_reorder_buffer_free(
+		 &reorder_buffer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_reorder_buffer_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_reorder_buffer_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_reorder_buffer_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_reorder_buffer_insert_chunk and libewf_reorder_buffer_remove_chunk functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_reorder_buffer_insert_and_remove_chunk(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libewf_chunk_data_t *chunk_data         = NULL;
+	libewf_chunk_data_t *removed_chunk_data = NULL;
+	libewf_reorder_buffer_t *reorder_buffer = NULL;
+	size_t data_size                        = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_reorder_buffer_initialize(
+	          &reorder_buffer,
+	          4,
+	          LIBEWF_DEFAULT_REORDER_BUFFER_MEMORY_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_reorder_buffer_insert_chunk(
+	          reorder_buffer,
+	          0,
+	          2,
+	          chunk_data,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "reorder_buffer->number_of_chunks",
+	 reorder_buffer->number_of_chunks,
+	 1 );
+
+	/* The reorder buffer now owns the chunk data
+	 */
+	removed_chunk_data = chunk_data;
+	chunk_data         = NULL;
+
+	result = libewf_reorder_buffer_remove_chunk(
+	          reorder_buffer,
+	          1,
+	          &chunk_data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_reorder_buffer_remove_chunk(
+	          reorder_buffer,
+	          2,
+	          &chunk_data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data",
+	 ( chunk_data == removed_chunk_data ),
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) 512 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "reorder_buffer->number_of_chunks",
+	 reorder_buffer->number_of_chunks,
+	 0 );
+
+	removed_chunk_data = NULL;
+
+	/* Test a chunk outside the reorder window
+	 */
+	result = libewf_reorder_buffer_insert_chunk(
+	          reorder_buffer,
+	          0,
+	          4,
+	          chunk_data,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_reorder_buffer_insert_chunk(
+	          NULL,
+	          0,
+	          2,
+	          chunk_data,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_reorder_buffer_insert_chunk(
+	          reorder_buffer,
+	          2,
+	          1,
+	          chunk_data,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_reorder_buffer_insert_chunk(
+	          reorder_buffer,
+	          0,
+	          2,
+	          NULL,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_reorder_buffer_remove_chunk(
+	          NULL,
+	          2,
+	          &chunk_data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_reorder_buffer_remove_chunk(
+	          reorder_buffer,
+	          2,
+	          NULL,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_reorder_buffer_remove_chunk(
+	          reorder_buffer,
+	          2,
+	          &chunk_data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_reorder_buffer_free(
+	          &reorder_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( reorder_buffer != NULL )
+	{
+		libewf_reorder_buffer_free(
+		 &reorder_buffer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_reorder_buffer_initialize",
+	 ewf_test_reorder_buffer_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_reorder_buffer_free",
+	 ewf_test_reorder_buffer_free );
+
+	EWF_TEST_RUN(
+	 "libewf_reorder_buffer_insert_chunk",
+	 ewf_test_reorder_buffer_insert_and_remove_chunk );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
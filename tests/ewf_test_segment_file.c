@@ -21,12 +21,23 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
 #include <stdlib.h>
 #endif
 
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "ewf_test_functions.h"
 #include "ewf_test_libbfio.h"
 #include "ewf_test_libcerror.h"
 #include "ewf_test_libewf.h"
@@ -34,8 +45,19 @@
 #include "ewf_test_memory.h"
 #include "ewf_test_unused.h"
 
+#include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_definitions.h"
 #include "../libewf/libewf_segment_file.h"
 
+#include "../libewf/ewf_section.h"
+#include "../libewf/ewf_table.h"
+
+/* The chunk data size is not a multiple of the write alignment, so that
+ * an aligned remainder stays in the write buffer
+ */
+#define EWF_TEST_SEGMENT_FILE_CHUNK_DATA_SIZE	5000
+#define EWF_TEST_SEGMENT_FILE_PREALLOCATE_SIZE	( 1024 * 1024 )
+
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
 /* Tests the libewf_segment_file_initialize function
@@ -1019,86 +1041,2043 @@ on_error:
 	return( 0 );
 }
 
-#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
-
-/* The main program
+/* Tests the libewf_segment_file_validate_type function
+ * Returns 1 if successful or 0 if not
  */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-int wmain(
-     int argc EWF_TEST_ATTRIBUTE_UNUSED,
-     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
-#else
-int main(
-     int argc EWF_TEST_ATTRIBUTE_UNUSED,
-     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
-#endif
+int ewf_test_segment_file_validate_type(
+     void )
 {
-	EWF_TEST_UNREFERENCED_PARAMETER( argc )
-	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+	libcerror_error_t *error            = NULL;
+	libewf_io_handle_t *io_handle       = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	int result                          = 0;
 
-#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
 
-	EWF_TEST_RUN(
-	 "libewf_segment_file_initialize",
-	 ewf_test_segment_file_initialize );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	EWF_TEST_RUN(
-	 "libewf_segment_file_free",
-	 ewf_test_segment_file_free );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
 
-	EWF_TEST_RUN(
-	 "libewf_segment_file_clone",
-	 ewf_test_segment_file_clone );
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	EWF_TEST_RUN(
-	 "libewf_segment_file_get_number_of_sections",
-	 ewf_test_segment_file_get_number_of_sections );
+	result = libewf_segment_file_initialize(
+	          &segment_file,
+	          io_handle,
+	          &error );
 
-	/* TODO: add tests for libewf_segment_file_get_section_by_index */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	/* TODO: add tests for libewf_segment_file_read_file_header */
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_file",
+	 segment_file );
 
-	/* TODO: add tests for libewf_segment_file_write_file_header */
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	EWF_TEST_RUN(
-	 "libewf_segment_file_seek_offset",
-	 ewf_test_segment_file_seek_offset );
+	/* Test regular cases
+	 */
+	segment_file->type = LIBEWF_SEGMENT_FILE_TYPE_EWF1;
 
-	/* TODO: add tests for libewf_segment_file_read_table_section */
+	result = libewf_segment_file_validate_type(
+	          segment_file,
+	          LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED,
+	          &error );
 
-	/* TODO: add tests for libewf_segment_file_read_table2_section */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	/* TODO: add tests for libewf_segment_file_read_volume_section */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "segment_file->type",
+	 (int) segment_file->type,
+	 LIBEWF_SEGMENT_FILE_TYPE_EWF1 );
 
-	/* TODO: add tests for libewf_segment_file_write_device_information_section */
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* TODO: add tests for libewf_segment_file_write_case_data_section */
+	result = libewf_segment_file_validate_type(
+	          segment_file,
+	          LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART,
+	          &error );
 
-	/* TODO: add tests for libewf_segment_file_write_header_section */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	/* TODO: add tests for libewf_segment_file_write_header2_section */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "segment_file->type",
+	 (int) segment_file->type,
+	 LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART );
 
-	/* TODO: add tests for libewf_segment_file_write_xheader_section */
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* TODO: add tests for libewf_segment_file_write_header_sections */
+	/* Test error cases
+	 */
+	result = libewf_segment_file_validate_type(
+	          NULL,
+	          LIBEWF_SEGMENT_FILE_TYPE_EWF1,
+	          &error );
 
-	/* TODO: add tests for libewf_segment_file_write_last_section */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	/* TODO: add tests for libewf_segment_file_write_start */
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-	/* TODO: add tests for libewf_segment_file_write_chunks_section_start */
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_file_validate_type(
+	          segment_file,
+	          LIBEWF_SEGMENT_FILE_TYPE_EWF2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	/* TODO: add tests for libewf_segment_file_write_chunks_section_end */
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-	/* TODO: add tests for libewf_segment_file_write_chunk_data */
+	libcerror_error_free(
+	 &error );
 
-	/* TODO: add tests for libewf_segment_file_write_hash_sections */
+	/* Clean up
+	 */
+	result = libewf_segment_file_free(
+	          &segment_file,
+	          &error );
 
-	/* TODO: add tests for libewf_segment_file_write_close */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	/* TODO: add tests for libewf_segment_file_reopen */
+	EWF_TEST_ASSERT_IS_NULL(
+	 "segment_file",
+	 segment_file );
 
-	/* TODO: add tests for libewf_segment_file_write_sections_correction */
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_STAT ) && defined( HAVE_UNISTD_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+/* Creates a temporary file and a file IO pool with the file opened for reading and writing
+ * The filename must contain a mkstemp template and is updated with the name of the file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_segment_file_open_temporary_file_io_pool(
+     char *filename,
+     libbfio_pool_t **file_io_pool,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "ewf_test_segment_file_open_temporary_file_io_pool";
+	int file_descriptor              = -1;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	file_descriptor = mkstemp(
+	                   filename );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to create temporary file.",
+		 function );
+
+		return( -1 );
+	}
+	close(
+	 file_descriptor );
+
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     narrow_string_length(
+	      filename ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name of file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ_WRITE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_initialize(
+	     file_io_pool,
+	     1,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_set_handle(
+	     *file_io_pool,
+	     0,
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ_WRITE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set file IO handle: 0 in pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 file_io_pool,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	unlink(
+	 filename );
+
+	return( -1 );
+}
+
+/* Creates chunk data with test data
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_segment_file_create_chunk_data(
+     libewf_chunk_data_t **chunk_data,
+     size32_t data_size,
+     uint8_t seed,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_segment_file_create_chunk_data";
+	size_t data_offset    = 0;
+
+	if( libewf_chunk_data_initialize(
+	     chunk_data,
+	     data_size,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	for( data_offset = 0;
+	     data_offset < (size_t) data_size;
+	     data_offset++ )
+	{
+		( *chunk_data )->data[ data_offset ] = (uint8_t) ( ( data_offset * 31 ) + ( data_offset >> 8 ) + seed );
+	}
+	( *chunk_data )->data_size   = (size_t) data_size;
+	( *chunk_data )->range_flags = 0;
+
+	return( 1 );
+}
+
+/* Compares the data in the file at a specific offset with the expected data
+ * Returns 1 if equal, 0 if not or -1 on error
+ */
+int ewf_test_segment_file_compare_file_data(
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer       = NULL;
+	static char *function = "ewf_test_segment_file_compare_file_data";
+	ssize_t read_count    = 0;
+	int result            = 0;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * data_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     0,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		memory_free(
+		 buffer );
+
+		return( -1 );
+	}
+	read_count = libbfio_pool_read_buffer(
+	              file_io_pool,
+	              0,
+	              buffer,
+	              data_size,
+	              error );
+
+	if( read_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data.",
+		 function );
+
+		memory_free(
+		 buffer );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     buffer,
+	     data,
+	     data_size ) == 0 )
+	{
+		result = 1;
+	}
+	memory_free(
+	 buffer );
+
+	return( result );
+}
+
+/* Retrieves the size and the allocated size of a file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_segment_file_get_file_size(
+     const char *filename,
+     size64_t *file_size,
+     size64_t *allocated_size )
+{
+	struct stat file_stat;
+
+	if( stat(
+	     filename,
+	     &file_stat ) != 0 )
+	{
+		return( -1 );
+	}
+	*file_size      = (size64_t) file_stat.st_size;
+	*allocated_size = (size64_t) file_stat.st_blocks * 512;
+
+	return( 1 );
+}
+
+/* Tests the libewf_segment_file_write_chunk_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_file_write_chunk_data(
+     void )
+{
+	char filename[ 32 ];
+
+	libbfio_pool_t *file_io_pool            = NULL;
+	libcerror_error_t *error                = NULL;
+	libewf_chunk_data_t *chunk_data         = NULL;
+	libewf_chunk_data_t *large_chunk_data   = NULL;
+	libewf_io_handle_t *io_handle           = NULL;
+	libewf_segment_file_t *segment_file     = NULL;
+	size64_t allocated_size                 = 0;
+	size64_t file_size                      = 0;
+	ssize_t write_count                     = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	narrow_string_copy(
+	 filename,
+	 "ewf_test_segment_file.XXXXXX",
+	 29 );
+
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_file_initialize(
+	          &segment_file,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_file",
+	 segment_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_segment_file_open_temporary_file_io_pool(
+	          filename,
+	          &file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_pool",
+	 file_io_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_segment_file_create_chunk_data(
+	          &chunk_data,
+	          EWF_TEST_SEGMENT_FILE_CHUNK_DATA_SIZE,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The chunk is larger than the write buffer
+	 */
+	result = ewf_test_segment_file_create_chunk_data(
+	          &large_chunk_data,
+	          LIBEWF_SEGMENT_FILE_WRITE_BUFFER_SIZE + LIBEWF_SEGMENT_FILE_WRITE_ALIGNMENT,
+	          0x5a,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test if a chunk that fits in the write buffer is buffered
+	 */
+	write_count = libewf_segment_file_write_chunk_data(
+	               segment_file,
+	               file_io_pool,
+	               0,
+	               0,
+	               chunk_data,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) EWF_TEST_SEGMENT_FILE_CHUNK_DATA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "segment_file->write_buffer_data_size",
+	 segment_file->write_buffer_data_size,
+	 (size_t) EWF_TEST_SEGMENT_FILE_CHUNK_DATA_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "segment_file->current_offset",
+	 (int64_t) segment_file->current_offset,
+	 (int64_t) EWF_TEST_SEGMENT_FILE_CHUNK_DATA_SIZE );
+
+	result = ewf_test_segment_file_get_file_size(
+	          filename,
+	          &file_size,
+	          &allocated_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "file_size",
+	 (uint64_t) file_size,
+	 (uint64_t) 0 );
+
+	/* Test if the data after the last aligned offset remains in the write buffer
+	 */
+	write_count = libewf_segment_file_flush_write_buffer(
+	               segment_file,
+	               file_io_pool,
+	               0,
+	               0,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) LIBEWF_SEGMENT_FILE_WRITE_ALIGNMENT );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "segment_file->write_buffer_data_size",
+	 segment_file->write_buffer_data_size,
+	 (size_t) ( EWF_TEST_SEGMENT_FILE_CHUNK_DATA_SIZE - LIBEWF_SEGMENT_FILE_WRITE_ALIGNMENT ) );
+
+	result = memory_compare(
+	          segment_file->write_buffer,
+	          &( chunk_data->data[ LIBEWF_SEGMENT_FILE_WRITE_ALIGNMENT ] ),
+	          EWF_TEST_SEGMENT_FILE_CHUNK_DATA_SIZE - LIBEWF_SEGMENT_FILE_WRITE_ALIGNMENT );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = ewf_test_segment_file_get_file_size(
+	          filename,
+	          &file_size,
+	          &allocated_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "file_size",
+	 (uint64_t) file_size,
+	 (uint64_t) LIBEWF_SEGMENT_FILE_WRITE_ALIGNMENT );
+
+	/* Test if a chunk that is larger than the write buffer is written directly
+	 * after the data in the write buffer
+	 */
+	write_count = libewf_segment_file_write_chunk_data(
+	               segment_file,
+	               file_io_pool,
+	               0,
+	               1,
+	               large_chunk_data,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) large_chunk_data->data_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "segment_file->write_buffer_data_size",
+	 segment_file->write_buffer_data_size,
+	 (size_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "segment_file->current_offset",
+	 (int64_t) segment_file->current_offset,
+	 (int64_t) ( EWF_TEST_SEGMENT_FILE_CHUNK_DATA_SIZE + large_chunk_data->data_size ) );
+
+	result = ewf_test_segment_file_get_file_size(
+	          filename,
+	          &file_size,
+	          &allocated_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "file_size",
+	 (uint64_t) file_size,
+	 (uint64_t) segment_file->current_offset );
+
+	result = ewf_test_segment_file_compare_file_data(
+	          file_io_pool,
+	          0,
+	          chunk_data->data,
+	          EWF_TEST_SEGMENT_FILE_CHUNK_DATA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_segment_file_compare_file_data(
+	          file_io_pool,
+	          EWF_TEST_SEGMENT_FILE_CHUNK_DATA_SIZE,
+	          large_chunk_data->data,
+	          large_chunk_data->data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	write_count = libewf_segment_file_write_chunk_data(
+	               NULL,
+	               file_io_pool,
+	               0,
+	               0,
+	               chunk_data,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libewf_segment_file_write_chunk_data(
+	               segment_file,
+	               file_io_pool,
+	               0,
+	               0,
+	               NULL,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libewf_segment_file_flush_write_buffer(
+	               NULL,
+	               file_io_pool,
+	               0,
+	               1,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &large_chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_close_file_io_pool(
+	          &file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_file_free(
+	          &segment_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	unlink(
+	 filename );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( large_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &large_chunk_data,
+		 NULL );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		ewf_test_close_file_io_pool(
+		 &file_io_pool,
+		 NULL );
+
+		unlink(
+		 filename );
+	}
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_segment_file_write_chunks_section_end function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_file_write_chunks_section_end(
+     void )
+{
+	uint8_t section_descriptor_data[ sizeof( ewf_section_descriptor_v1_t ) ];
+	uint8_t table_section_data[ 256 ];
+	char filename[ 32 ];
+
+	libbfio_pool_t *file_io_pool        = NULL;
+	libcerror_error_t *error            = NULL;
+	libewf_chunk_data_t *chunk_data     = NULL;
+	libewf_io_handle_t *io_handle       = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	off64_t table_section_offset        = 0;
+	ssize_t write_count                 = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	narrow_string_copy(
+	 filename,
+	 "ewf_test_segment_file.XXXXXX",
+	 29 );
+
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->format = LIBEWF_FORMAT_ENCASE6;
+
+	result = libewf_segment_file_initialize(
+	          &segment_file,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_file",
+	 segment_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	segment_file->type          = LIBEWF_SEGMENT_FILE_TYPE_EWF1;
+	segment_file->major_version = 1;
+
+	result = ewf_test_segment_file_open_temporary_file_io_pool(
+	          filename,
+	          &file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_pool",
+	 file_io_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_segment_file_create_chunk_data(
+	          &chunk_data,
+	          EWF_TEST_SEGMENT_FILE_CHUNK_DATA_SIZE,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reserve the sectors section descriptor that is corrected at the end of the chunks section
+	 */
+	result = memory_set(
+	          section_descriptor_data,
+	          0,
+	          sizeof( ewf_section_descriptor_v1_t ) ) != NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	write_count = libbfio_pool_write_buffer(
+	               file_io_pool,
+	               0,
+	               section_descriptor_data,
+	               sizeof( ewf_section_descriptor_v1_t ),
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) sizeof( ewf_section_descriptor_v1_t ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	segment_file->current_offset = (off64_t) sizeof( ewf_section_descriptor_v1_t );
+
+	write_count = libewf_segment_file_write_chunk_data(
+	               segment_file,
+	               file_io_pool,
+	               0,
+	               0,
+	               chunk_data,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) EWF_TEST_SEGMENT_FILE_CHUNK_DATA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "segment_file->write_buffer_data_size",
+	 segment_file->write_buffer_data_size,
+	 (size_t) EWF_TEST_SEGMENT_FILE_CHUNK_DATA_SIZE );
+
+	table_section_offset = segment_file->current_offset;
+
+	result = memory_set(
+	          table_section_data,
+	          0,
+	          256 ) != NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test if the write buffer is flushed before the chunks section descriptor
+	 * is corrected and the table section is written
+	 */
+	write_count = libewf_segment_file_write_chunks_section_end(
+	               segment_file,
+	               file_io_pool,
+	               0,
+	               table_section_data,
+	               256,
+	               &( table_section_data[ sizeof( ewf_table_header_v1_t ) ] ),
+	               sizeof( ewf_table_entry_v1_t ),
+	               1,
+	               0,
+	               (size64_t) table_section_offset,
+	               0,
+	               0,
+	               0,
+	               &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "segment_file->write_buffer_data_size",
+	 segment_file->write_buffer_data_size,
+	 (size_t) 0 );
+
+	result = ewf_test_segment_file_compare_file_data(
+	          file_io_pool,
+	          (off64_t) sizeof( ewf_section_descriptor_v1_t ),
+	          chunk_data->data,
+	          EWF_TEST_SEGMENT_FILE_CHUNK_DATA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The sectors section descriptor was corrected at the start of the chunks section
+	 */
+	result = ewf_test_segment_file_compare_file_data(
+	          file_io_pool,
+	          0,
+	          (uint8_t *) "sectors",
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The table section follows directly after the chunk data
+	 */
+	result = ewf_test_segment_file_compare_file_data(
+	          file_io_pool,
+	          table_section_offset,
+	          (uint8_t *) "table",
+	          6,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_close_file_io_pool(
+	          &file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_file_free(
+	          &segment_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	unlink(
+	 filename );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		ewf_test_close_file_io_pool(
+		 &file_io_pool,
+		 NULL );
+
+		unlink(
+		 filename );
+	}
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_segment_file_release_preallocation function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_file_release_preallocation(
+     void )
+{
+	char filename[ 32 ];
+
+	libbfio_pool_t *file_io_pool        = NULL;
+	libcerror_error_t *error            = NULL;
+	libewf_chunk_data_t *chunk_data     = NULL;
+	libewf_io_handle_t *io_handle       = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	size64_t allocated_size             = 0;
+	size64_t file_size                  = 0;
+	ssize_t write_count                 = 0;
+	int preallocated                    = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	narrow_string_copy(
+	 filename,
+	 "ewf_test_segment_file.XXXXXX",
+	 29 );
+
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_file_initialize(
+	          &segment_file,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_file",
+	 segment_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_segment_file_open_temporary_file_io_pool(
+	          filename,
+	          &file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_pool",
+	 file_io_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_segment_file_create_chunk_data(
+	          &chunk_data,
+	          EWF_TEST_SEGMENT_FILE_CHUNK_DATA_SIZE,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Preallocation is not supported by every platform and file system
+	 */
+	preallocated = libewf_segment_file_preallocate(
+	                segment_file,
+	                filename,
+	                EWF_TEST_SEGMENT_FILE_PREALLOCATE_SIZE,
+	                &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "preallocated",
+	 preallocated,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_segment_file_get_file_size(
+	          filename,
+	          &file_size,
+	          &allocated_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "file_size",
+	 (uint64_t) file_size,
+	 (uint64_t) 0 );
+
+	if( preallocated != 0 )
+	{
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "segment_file->preallocated_filename",
+		 segment_file->preallocated_filename );
+
+		result = ( allocated_size >= EWF_TEST_SEGMENT_FILE_PREALLOCATE_SIZE );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	write_count = libewf_segment_file_write_chunk_data(
+	               segment_file,
+	               file_io_pool,
+	               0,
+	               0,
+	               chunk_data,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) EWF_TEST_SEGMENT_FILE_CHUNK_DATA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test if the preallocation cannot be released before the write buffer is flushed
+	 */
+	result = libewf_segment_file_release_preallocation(
+	          segment_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libewf_segment_file_flush_write_buffer(
+	               segment_file,
+	               file_io_pool,
+	               0,
+	               1,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) EWF_TEST_SEGMENT_FILE_CHUNK_DATA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_close(
+	          file_io_pool,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test if the file is truncated to the size of the data written on close
+	 */
+	result = libewf_segment_file_release_preallocation(
+	          segment_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "segment_file->preallocated_filename",
+	 segment_file->preallocated_filename );
+
+	result = ewf_test_segment_file_get_file_size(
+	          filename,
+	          &file_size,
+	          &allocated_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "file_size",
+	 (uint64_t) file_size,
+	 (uint64_t) EWF_TEST_SEGMENT_FILE_CHUNK_DATA_SIZE );
+
+	if( preallocated != 0 )
+	{
+		EWF_TEST_ASSERT_LESS_THAN_UINT64(
+		 "allocated_size",
+		 (uint64_t) allocated_size,
+		 (uint64_t) EWF_TEST_SEGMENT_FILE_PREALLOCATE_SIZE );
+	}
+	/* Test error cases
+	 */
+	result = libewf_segment_file_release_preallocation(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_file_truncate_preallocated(
+	          NULL,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_file_truncate_preallocated(
+	          filename,
+	          -2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_close_file_io_pool(
+	          &file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_file_free(
+	          &segment_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	unlink(
+	 filename );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		ewf_test_close_file_io_pool(
+		 &file_io_pool,
+		 NULL );
+
+		unlink(
+		 filename );
+	}
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_segment_file_create_ahead and libewf_segment_file_remove_created_ahead functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_file_create_ahead(
+     void )
+{
+	char filename[ 32 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t allocated_size  = 0;
+	size64_t file_size       = 0;
+	ssize_t write_count      = 0;
+	int file_descriptor      = -1;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	narrow_string_copy(
+	 filename,
+	 "ewf_test_segment_file.XXXXXX",
+	 29 );
+
+	file_descriptor = mkstemp(
+	                   filename );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "file_descriptor",
+	 file_descriptor,
+	 -1 );
+
+	write_count = write(
+	               file_descriptor,
+	               "create ahead",
+	               12 );
+
+	close(
+	 file_descriptor );
+
+	file_descriptor = -1;
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 12 );
+
+	/* Test if an existing file is not created ahead
+	 */
+	result = libewf_segment_file_create_ahead(
+	          filename,
+	          EWF_TEST_SEGMENT_FILE_PREALLOCATE_SIZE,
+	          &file_descriptor,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_descriptor",
+	 file_descriptor,
+	 -1 );
+
+	result = ewf_test_segment_file_get_file_size(
+	          filename,
+	          &file_size,
+	          &allocated_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "file_size",
+	 (uint64_t) file_size,
+	 (uint64_t) 12 );
+
+	/* Test if a file that was not created ahead is not removed
+	 */
+	result = libewf_segment_file_remove_created_ahead(
+	          filename,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_segment_file_get_file_size(
+	          filename,
+	          &file_size,
+	          &allocated_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "file_size",
+	 (uint64_t) file_size,
+	 (uint64_t) 12 );
+
+	unlink(
+	 filename );
+
+	/* Test if a file that does not exist is created ahead
+	 * Creating a file ahead is not supported by every platform
+	 */
+	result = libewf_segment_file_create_ahead(
+	          filename,
+	          EWF_TEST_SEGMENT_FILE_PREALLOCATE_SIZE,
+	          &file_descriptor,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result == 0 )
+	{
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "file_descriptor",
+		 file_descriptor,
+		 -1 );
+	}
+	else
+	{
+		EWF_TEST_ASSERT_NOT_EQUAL_INT(
+		 "file_descriptor",
+		 file_descriptor,
+		 -1 );
+
+		result = ewf_test_segment_file_get_file_size(
+		          filename,
+		          &file_size,
+		          &allocated_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "file_size",
+		 (uint64_t) file_size,
+		 (uint64_t) 0 );
+
+		/* Test if a file that was created ahead is removed
+		 */
+		result = libewf_segment_file_remove_created_ahead(
+		          filename,
+		          file_descriptor,
+		          &error );
+
+		file_descriptor = -1;
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = ewf_test_segment_file_get_file_size(
+		          filename,
+		          &file_size,
+		          &allocated_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+	}
+	/* Test error cases
+	 */
+	result = libewf_segment_file_create_ahead(
+	          NULL,
+	          EWF_TEST_SEGMENT_FILE_PREALLOCATE_SIZE,
+	          &file_descriptor,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_file_create_ahead(
+	          filename,
+	          EWF_TEST_SEGMENT_FILE_PREALLOCATE_SIZE,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_file_remove_created_ahead(
+	          NULL,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+	unlink(
+	 filename );
+
+	return( 0 );
+}
+
+#endif /* defined( HAVE_STAT ) && defined( HAVE_UNISTD_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_segment_file_initialize",
+	 ewf_test_segment_file_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_segment_file_free",
+	 ewf_test_segment_file_free );
+
+	EWF_TEST_RUN(
+	 "libewf_segment_file_clone",
+	 ewf_test_segment_file_clone );
+
+	EWF_TEST_RUN(
+	 "libewf_segment_file_get_number_of_sections",
+	 ewf_test_segment_file_get_number_of_sections );
+
+	/* TODO: add tests for libewf_segment_file_get_section_by_index */
+
+	/* TODO: add tests for libewf_segment_file_read_file_header */
+
+	/* TODO: add tests for libewf_segment_file_write_file_header */
+
+	EWF_TEST_RUN(
+	 "libewf_segment_file_seek_offset",
+	 ewf_test_segment_file_seek_offset );
+
+	/* TODO: add tests for libewf_segment_file_read_table_section */
+
+	/* TODO: add tests for libewf_segment_file_read_table2_section */
+
+	/* TODO: add tests for libewf_segment_file_read_volume_section */
+
+	/* TODO: add tests for libewf_segment_file_write_device_information_section */
+
+	/* TODO: add tests for libewf_segment_file_write_case_data_section */
+
+	/* TODO: add tests for libewf_segment_file_write_header_section */
+
+	/* TODO: add tests for libewf_segment_file_write_header2_section */
+
+	/* TODO: add tests for libewf_segment_file_write_xheader_section */
+
+	/* TODO: add tests for libewf_segment_file_write_header_sections */
+
+	/* TODO: add tests for libewf_segment_file_write_last_section */
+
+	/* TODO: add tests for libewf_segment_file_write_start */
+
+	/* TODO: add tests for libewf_segment_file_write_chunks_section_start */
+
+#if defined( HAVE_STAT ) && defined( HAVE_UNISTD_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+	EWF_TEST_RUN(
+	 "libewf_segment_file_write_chunks_section_end",
+	 ewf_test_segment_file_write_chunks_section_end );
+
+	EWF_TEST_RUN(
+	 "libewf_segment_file_write_chunk_data",
+	 ewf_test_segment_file_write_chunk_data );
+
+	EWF_TEST_RUN(
+	 "libewf_segment_file_release_preallocation",
+	 ewf_test_segment_file_release_preallocation );
+
+	EWF_TEST_RUN(
+	 "libewf_segment_file_create_ahead",
+	 ewf_test_segment_file_create_ahead );
+
+#endif /* defined( HAVE_STAT ) && defined( HAVE_UNISTD_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+	/* TODO: add tests for libewf_segment_file_write_hash_sections */
+
+	/* TODO: add tests for libewf_segment_file_write_close */
+
+	/* TODO: add tests for libewf_segment_file_reopen */
+
+	/* TODO: add tests for libewf_segment_file_write_sections_correction */
+
+	/* TODO: add tests for libewf_segment_file_read_file_io_pool */
+
+	EWF_TEST_RUN(
+	 "libewf_segment_file_validate_type",
+	 ewf_test_segment_file_validate_type );
 
 	/* TODO: add tests for libewf_segment_file_read_element_data */
 
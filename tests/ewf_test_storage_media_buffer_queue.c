@@ -0,0 +1,452 @@
+/*
+ * Tools storage_media_buffer_queue functions test program
+ *
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcthreads.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/storage_media_buffer.h"
+#include "../ewftools/storage_media_buffer_queue.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Tests the storage_media_buffer_queue_initialize and storage_media_buffer_queue_free functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_storage_media_buffer_queue_initialize(
+     void )
+{
+	libcerror_error_t *error   = NULL;
+	libcthreads_queue_t *queue = NULL;
+	int result                 = 0;
+
+	/* Test regular cases
+	 */
+	result = storage_media_buffer_queue_initialize(
+	          &queue,
+	          NULL,
+	          2,
+	          STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "queue",
+	 queue );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = storage_media_buffer_queue_free(
+	          &queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "queue",
+	 queue );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = storage_media_buffer_queue_initialize(
+	          NULL,
+	          NULL,
+	          2,
+	          STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = storage_media_buffer_queue_initialize(
+	          &queue,
+	          NULL,
+	          -1,
+	          STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "queue",
+	 queue );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( queue != NULL )
+	{
+		storage_media_buffer_queue_free(
+		 &queue,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the storage_media_buffer_queue_grab_buffer and storage_media_buffer_queue_release_buffer functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_storage_media_buffer_queue_grab_and_release_buffer(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libcthreads_queue_t *queue            = NULL;
+	storage_media_buffer_t *buffer        = NULL;
+	storage_media_buffer_t *first_buffer  = NULL;
+	storage_media_buffer_t *second_buffer = NULL;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = storage_media_buffer_queue_initialize(
+	          &queue,
+	          NULL,
+	          2,
+	          STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "queue",
+	 queue );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = storage_media_buffer_queue_grab_buffer(
+	          queue,
+	          &first_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "first_buffer",
+	 first_buffer );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "first_buffer->number_of_references",
+	 first_buffer->number_of_references,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = storage_media_buffer_queue_grab_buffer(
+	          queue,
+	          &second_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "second_buffer",
+	 second_buffer );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = storage_media_buffer_queue_release_buffer(
+	          queue,
+	          first_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "first_buffer->number_of_references",
+	 first_buffer->number_of_references,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+
+	/* Releasing a buffer that has no references should fail
+	 */
+	result = storage_media_buffer_queue_release_buffer(
+	          queue,
+	          first_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "first_buffer->number_of_references",
+	 first_buffer->number_of_references,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = storage_media_buffer_queue_release_buffer(
+	          queue,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The queue is first in first out, if the failed release had pushed
+	 * the first buffer again it would be returned a second time
+	 */
+	result = storage_media_buffer_queue_grab_buffer(
+	          queue,
+	          &buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer == first_buffer",
+	 (int) ( buffer == first_buffer ),
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = storage_media_buffer_queue_release_buffer(
+	          queue,
+	          second_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	second_buffer = NULL;
+
+	result = storage_media_buffer_queue_grab_buffer(
+	          queue,
+	          &second_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "second_buffer != first_buffer",
+	 (int) ( second_buffer != first_buffer ),
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = storage_media_buffer_queue_release_buffer(
+	          queue,
+	          buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	buffer = NULL;
+
+	result = storage_media_buffer_queue_release_buffer(
+	          queue,
+	          second_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	second_buffer = NULL;
+
+	result = storage_media_buffer_queue_free(
+	          &queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( queue != NULL )
+	{
+		storage_media_buffer_queue_free(
+		 &queue,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "storage_media_buffer_queue_initialize",
+	 ewf_test_storage_media_buffer_queue_initialize );
+
+	EWF_TEST_RUN(
+	 "storage_media_buffer_queue_grab_buffer",
+	 ewf_test_storage_media_buffer_queue_grab_and_release_buffer );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
@@ -0,0 +1,558 @@
+/*
+ * Tools storage_media_buffer_ring contention benchmark program
+ *
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcthreads.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/storage_media_buffer.h"
+#include "../ewftools/storage_media_buffer_ring.h"
+
+#define EWF_TEST_STORAGE_MEDIA_BUFFER_RING_BENCHMARK_BUFFER_SIZE		4096
+#define EWF_TEST_STORAGE_MEDIA_BUFFER_RING_BENCHMARK_NUMBER_OF_BUFFERS		65536
+#define EWF_TEST_STORAGE_MEDIA_BUFFER_RING_BENCHMARK_NUMBER_OF_QUEUED_BUFFERS	256
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+
+typedef struct ewf_test_storage_media_buffer_ring_benchmark_context ewf_test_storage_media_buffer_ring_benchmark_context_t;
+
+struct ewf_test_storage_media_buffer_ring_benchmark_context
+{
+	/* The output thread pool
+	 */
+	libcthreads_thread_pool_t *output_thread_pool;
+
+	/* The queue of unused buffers
+	 */
+	libcthreads_queue_t *buffer_queue;
+
+	/* The output ring
+	 */
+	storage_media_buffer_ring_t *output_ring;
+
+	/* The last offset written
+	 */
+	off64_t last_offset_written;
+
+	/* The number of buffers written
+	 */
+	int number_of_buffers_written;
+
+	/* The number of errors
+	 */
+	int number_of_errors;
+};
+
+/* Retrieves a timestamp in micro seconds
+ * Returns the timestamp
+ */
+uint64_t ewf_test_storage_media_buffer_ring_benchmark_get_timestamp(
+          void )
+{
+#if defined( HAVE_CLOCK_GETTIME )
+	struct timespec time_structure;
+
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_structure.tv_sec * 1000000 ) + ( (uint64_t) time_structure.tv_nsec / 1000 ) );
+#else
+	return( (uint64_t) time( NULL ) * 1000000 );
+#endif
+}
+
+/* Frees a buffer
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_storage_media_buffer_ring_benchmark_free_buffer(
+     storage_media_buffer_t **buffer,
+     libcerror_error_t **error EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( ( buffer != NULL )
+	 && ( *buffer != NULL ) )
+	{
+		memory_free(
+		 *buffer );
+
+		*buffer = NULL;
+	}
+	return( 1 );
+}
+
+/* Processes a buffer
+ * The processing time differs per buffer so that the buffers complete out of order
+ * Callback function for the process thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_storage_media_buffer_ring_benchmark_process_callback(
+     storage_media_buffer_t *buffer,
+     ewf_test_storage_media_buffer_ring_benchmark_context_t *context )
+{
+	uint32_t iteration            = 0;
+	uint32_t number_of_iterations = 0;
+	uint32_t value_32bit          = 0;
+
+	value_32bit          = (uint32_t) ( buffer->storage_media_offset / EWF_TEST_STORAGE_MEDIA_BUFFER_RING_BENCHMARK_BUFFER_SIZE );
+	number_of_iterations = (uint32_t) ( value_32bit * 2654435761UL ) >> 22;
+
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		value_32bit = ( value_32bit * 1103515245UL ) + 12345;
+	}
+	buffer->raw_buffer_data_size = (size_t) ( value_32bit & 0x01 );
+	buffer->processed_size       = buffer->requested_size;
+
+	if( libcthreads_thread_pool_push(
+	     context->output_thread_pool,
+	     (intptr_t *) buffer,
+	     NULL ) == -1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Puts the buffers back in order
+ * Callback function for the output thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_storage_media_buffer_ring_benchmark_output_callback(
+     storage_media_buffer_t *buffer,
+     ewf_test_storage_media_buffer_ring_benchmark_context_t *context )
+{
+	int result = 0;
+
+	if( storage_media_buffer_ring_insert_buffer(
+	     context->output_ring,
+	     buffer,
+	     NULL ) != 1 )
+	{
+		context->number_of_errors += 1;
+
+		return( -1 );
+	}
+	while( context->output_ring->number_of_buffers > 0 )
+	{
+		result = storage_media_buffer_ring_remove_buffer(
+		          context->output_ring,
+		          context->last_offset_written,
+		          &buffer,
+		          NULL );
+
+		if( result == -1 )
+		{
+			context->number_of_errors += 1;
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		context->last_offset_written       = buffer->storage_media_offset + buffer->processed_size;
+		context->number_of_buffers_written += 1;
+
+		if( libcthreads_queue_push(
+		     context->buffer_queue,
+		     (intptr_t *) buffer,
+		     NULL ) != 1 )
+		{
+			context->number_of_errors += 1;
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Benchmarks the storage media buffer ring with a specific number of process threads
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_storage_media_buffer_ring_benchmark_run(
+     int number_of_threads )
+{
+	ewf_test_storage_media_buffer_ring_benchmark_context_t context;
+
+	libcerror_error_t *error                       = NULL;
+	libcthreads_thread_pool_t *process_thread_pool = NULL;
+	storage_media_buffer_t *buffer                 = NULL;
+	uint64_t elapsed_time                          = 0;
+	uint64_t start_time                            = 0;
+	int buffer_index                               = 0;
+	int result                                     = 0;
+
+	result = memory_set(
+	          &context,
+	          0,
+	          sizeof( ewf_test_storage_media_buffer_ring_benchmark_context_t ) ) != NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = storage_media_buffer_ring_initialize(
+	          &( context.output_ring ),
+	          EWF_TEST_STORAGE_MEDIA_BUFFER_RING_BENCHMARK_NUMBER_OF_QUEUED_BUFFERS,
+	          EWF_TEST_STORAGE_MEDIA_BUFFER_RING_BENCHMARK_BUFFER_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_queue_initialize(
+	          &( context.buffer_queue ),
+	          EWF_TEST_STORAGE_MEDIA_BUFFER_RING_BENCHMARK_NUMBER_OF_QUEUED_BUFFERS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( buffer_index = 0;
+	     buffer_index < EWF_TEST_STORAGE_MEDIA_BUFFER_RING_BENCHMARK_NUMBER_OF_QUEUED_BUFFERS;
+	     buffer_index++ )
+	{
+		buffer = memory_allocate_structure(
+		          storage_media_buffer_t );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "buffer",
+		 buffer );
+
+		result = memory_set(
+		          buffer,
+		          0,
+		          sizeof( storage_media_buffer_t ) ) != NULL;
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libcthreads_queue_push(
+		          context.buffer_queue,
+		          (intptr_t *) buffer,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		buffer = NULL;
+	}
+	result = libcthreads_thread_pool_create(
+	          &process_thread_pool,
+	          NULL,
+	          number_of_threads,
+	          EWF_TEST_STORAGE_MEDIA_BUFFER_RING_BENCHMARK_NUMBER_OF_QUEUED_BUFFERS,
+	          (int (*)(intptr_t *, void *)) &ewf_test_storage_media_buffer_ring_benchmark_process_callback,
+	          (void *) &context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_pool_create(
+	          &( context.output_thread_pool ),
+	          NULL,
+	          1,
+	          EWF_TEST_STORAGE_MEDIA_BUFFER_RING_BENCHMARK_NUMBER_OF_QUEUED_BUFFERS,
+	          (int (*)(intptr_t *, void *)) &ewf_test_storage_media_buffer_ring_benchmark_output_callback,
+	          (void *) &context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	start_time = ewf_test_storage_media_buffer_ring_benchmark_get_timestamp();
+
+	for( buffer_index = 0;
+	     buffer_index < EWF_TEST_STORAGE_MEDIA_BUFFER_RING_BENCHMARK_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		result = libcthreads_queue_pop(
+		          context.buffer_queue,
+		          (intptr_t **) &buffer,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		buffer->storage_media_offset = (off64_t) buffer_index * EWF_TEST_STORAGE_MEDIA_BUFFER_RING_BENCHMARK_BUFFER_SIZE;
+		buffer->requested_size       = EWF_TEST_STORAGE_MEDIA_BUFFER_RING_BENCHMARK_BUFFER_SIZE;
+		buffer->processed_size       = 0;
+
+		result = libcthreads_thread_pool_push(
+		          process_thread_pool,
+		          (intptr_t *) buffer,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		buffer = NULL;
+	}
+	result = libcthreads_thread_pool_join(
+	          &process_thread_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_pool_join(
+	          &( context.output_thread_pool ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	elapsed_time = ewf_test_storage_media_buffer_ring_benchmark_get_timestamp() - start_time;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "context.number_of_errors",
+	 context.number_of_errors,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "context.number_of_buffers_written",
+	 context.number_of_buffers_written,
+	 EWF_TEST_STORAGE_MEDIA_BUFFER_RING_BENCHMARK_NUMBER_OF_BUFFERS );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "context.last_offset_written",
+	 (int64_t) context.last_offset_written,
+	 (int64_t) EWF_TEST_STORAGE_MEDIA_BUFFER_RING_BENCHMARK_NUMBER_OF_BUFFERS * EWF_TEST_STORAGE_MEDIA_BUFFER_RING_BENCHMARK_BUFFER_SIZE );
+
+	if( elapsed_time == 0 )
+	{
+		elapsed_time = 1;
+	}
+	/* The throughput is informational only, it depends on the system
+	 */
+	fprintf(
+	 stdout,
+	 "Reorder with %d process thread(s): %d buffers in %" PRIu64 " us (%" PRIu64 " buffers/s)\n",
+	 number_of_threads,
+	 context.number_of_buffers_written,
+	 elapsed_time,
+	 ( (uint64_t) context.number_of_buffers_written * 1000000 ) / elapsed_time );
+
+	result = libcthreads_queue_free(
+	          &( context.buffer_queue ),
+	          (int (*)(intptr_t **, libcerror_error_t **)) &ewf_test_storage_media_buffer_ring_benchmark_free_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = storage_media_buffer_ring_free(
+	          &( context.output_ring ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( process_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &process_thread_pool,
+		 NULL );
+	}
+	if( context.output_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( context.output_thread_pool ),
+		 NULL );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( context.buffer_queue != NULL )
+	{
+		libcthreads_queue_free(
+		 &( context.buffer_queue ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &ewf_test_storage_media_buffer_ring_benchmark_free_buffer,
+		 NULL );
+	}
+	if( context.output_ring != NULL )
+	{
+		storage_media_buffer_ring_free(
+		 &( context.output_ring ),
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Benchmarks the storage media buffer ring with 1, 4, 16 and 32 process threads
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_storage_media_buffer_ring_benchmark_contention(
+     void )
+{
+	int number_of_threads[ 4 ] = { 1, 4, 16, 32 };
+	int run_index              = 0;
+
+	for( run_index = 0;
+	     run_index < 4;
+	     run_index++ )
+	{
+		if( ewf_test_storage_media_buffer_ring_benchmark_run(
+		     number_of_threads[ run_index ] ) != 1 )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+
+	EWF_TEST_RUN(
+	 "storage_media_buffer_ring_contention",
+	 ewf_test_storage_media_buffer_ring_benchmark_contention );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -21,20 +21,44 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
 #include <stdlib.h>
 #endif
 
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "ewf_test_functions.h"
+#include "ewf_test_libbfio.h"
 #include "ewf_test_libcerror.h"
 #include "ewf_test_libewf.h"
 #include "ewf_test_macros.h"
 #include "ewf_test_memory.h"
 #include "ewf_test_unused.h"
 
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_filename.h"
+#include "../libewf/libewf_io_handle.h"
+#include "../libewf/libewf_segment_file.h"
+#include "../libewf/libewf_segment_table.h"
 #include "../libewf/libewf_write_io_handle.h"
 
+#define EWF_TEST_WRITE_IO_HANDLE_SEGMENT_FILE_SIZE			( 1024 * 1024 )
+#define EWF_TEST_WRITE_IO_HANDLE_MAXIMUM_NUMBER_OF_SEGMENTS		14971
+
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
 /* Tests the libewf_write_io_handle_initialize function
@@ -648,52 +672,1300 @@ on_error:
 	return( 0 );
 }
 
-#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
-
-/* The main program
+/* Tests the libewf_write_io_handle_grab_compression_context and
+ * libewf_write_io_handle_release_compression_context functions
+ * Returns 1 if successful or 0 if not
  */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-int wmain(
-     int argc EWF_TEST_ATTRIBUTE_UNUSED,
-     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
-#else
-int main(
-     int argc EWF_TEST_ATTRIBUTE_UNUSED,
-     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
-#endif
+int ewf_test_write_io_handle_grab_compression_context(
+     void )
 {
-	EWF_TEST_UNREFERENCED_PARAMETER( argc )
-	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+	libcerror_error_t *error                                   = NULL;
+	libewf_compression_context_t *compression_context          = NULL;
+	libewf_compression_context_t *second_compression_context   = NULL;
+	libewf_compression_context_t *released_compression_context = NULL;
+	libewf_io_handle_t *io_handle                              = NULL;
+	libewf_write_io_handle_t *write_io_handle                  = NULL;
+	int result                                                 = 0;
 
-#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
 
-	EWF_TEST_RUN(
-	 "libewf_write_io_handle_initialize",
-	 ewf_test_write_io_handle_initialize );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	EWF_TEST_RUN(
-	 "libewf_write_io_handle_free",
-	 ewf_test_write_io_handle_free );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
 
-	EWF_TEST_RUN(
-	 "libewf_write_io_handle_clone",
-	 ewf_test_write_io_handle_clone );
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* TODO: add tests for libewf_write_io_handle_initialize_values */
+	result = libewf_write_io_handle_initialize(
+	          &write_io_handle,
+	          io_handle,
+	          &error );
 
-	/* TODO: add tests for libewf_write_io_handle_initialize_resume */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	/* TODO: add tests for libewf_write_io_handle_resize_table_entries */
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "write_io_handle",
+	 write_io_handle );
 
-	/* TODO: add tests for libewf_write_io_handle_calculate_chunks_per_segment_file */
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* TODO: add tests for libewf_write_io_handle_calculate_chunks_per_section */
+	/* Test regular cases
+	 */
+	result = libewf_write_io_handle_grab_compression_context(
+	          write_io_handle,
+	          &compression_context,
+	          &error );
 
-	/* TODO: add tests for libewf_write_io_handle_test_segment_file_full */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	/* TODO: add tests for libewf_write_io_handle_test_chunks_section_full */
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a second concurrent grab creates a separate compression context
+	 */
+	result = libewf_write_io_handle_grab_compression_context(
+	          write_io_handle,
+	          &second_compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "second_compression_context",
+	 second_compression_context );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INTPTR(
+	 "second_compression_context",
+	 (intptr_t) second_compression_context,
+	 (intptr_t) compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_write_io_handle_release_compression_context(
+	          write_io_handle,
+	          &second_compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "second_compression_context",
+	 second_compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a released compression context is reused
+	 */
+	released_compression_context = compression_context;
+
+	result = libewf_write_io_handle_release_compression_context(
+	          write_io_handle,
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_write_io_handle_grab_compression_context(
+	          write_io_handle,
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INTPTR(
+	 "compression_context",
+	 (intptr_t) compression_context,
+	 (intptr_t) released_compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_write_io_handle_release_compression_context(
+	          write_io_handle,
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_write_io_handle_grab_compression_context(
+	          NULL,
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_io_handle_grab_compression_context(
+	          write_io_handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_io_handle_release_compression_context(
+	          NULL,
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_io_handle_release_compression_context(
+	          write_io_handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_write_io_handle_free(
+	          &write_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_io_handle",
+	 write_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( second_compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &second_compression_context,
+		 NULL );
+	}
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
+	if( write_io_handle != NULL )
+	{
+		libewf_write_io_handle_free(
+		 &write_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) && defined( HAVE_STAT ) && defined( HAVE_UNISTD_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+/* Sets the segment file to create ahead in the write IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_write_io_handle_set_create_ahead(
+     libewf_write_io_handle_t *write_io_handle,
+     const char *filename,
+     uint32_t segment_number,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_write_io_handle_set_create_ahead";
+	size_t filename_size  = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_size = narrow_string_length(
+	                 filename ) + 1;
+
+	write_io_handle->create_ahead_filename = (system_character_t *) memory_allocate(
+	                                                                 sizeof( system_character_t ) * filename_size );
+
+	if( write_io_handle->create_ahead_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		return( -1 );
+	}
+	narrow_string_copy(
+	 write_io_handle->create_ahead_filename,
+	 filename,
+	 filename_size );
+
+	write_io_handle->create_ahead_filename_size   = filename_size;
+	write_io_handle->create_ahead_segment_number  = segment_number;
+	write_io_handle->create_ahead_size            = EWF_TEST_WRITE_IO_HANDLE_SEGMENT_FILE_SIZE;
+	write_io_handle->create_ahead_file_descriptor = -1;
+
+	return( 1 );
+}
+
+/* Retrieves the size of a file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_write_io_handle_get_file_size(
+     const char *filename,
+     size64_t *file_size )
+{
+	struct stat file_stat;
+
+	if( stat(
+	     filename,
+	     &file_stat ) != 0 )
+	{
+		return( -1 );
+	}
+	*file_size = (size64_t) file_stat.st_size;
+
+	return( 1 );
+}
+
+/* Tests the libewf_write_io_handle_discard_created_ahead function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_io_handle_discard_created_ahead(
+     void )
+{
+	char filename[ 32 ];
+
+	libcerror_error_t *error                   = NULL;
+	libewf_io_handle_t *io_handle              = NULL;
+	libewf_write_io_handle_t *write_io_handle  = NULL;
+	size64_t file_size                         = 0;
+	ssize_t write_count                        = 0;
+	int file_descriptor                        = -1;
+	int result                                 = 0;
+
+	/* Initialize test
+	 */
+	narrow_string_copy(
+	 filename,
+	 "ewf_test_write_io_handle.XXXXXX",
+	 32 );
+
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_write_io_handle_initialize(
+	          &write_io_handle,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "write_io_handle",
+	 write_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	file_descriptor = mkstemp(
+	                   filename );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "file_descriptor",
+	 file_descriptor,
+	 -1 );
+
+	write_count = write(
+	               file_descriptor,
+	               "existing",
+	               8 );
+
+	close(
+	 file_descriptor );
+
+	file_descriptor = -1;
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 8 );
+
+	/* Test if a file that already exists is not created ahead and not removed on discard
+	 */
+	result = ewf_test_write_io_handle_set_create_ahead(
+	          write_io_handle,
+	          filename,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_write_io_handle_create_ahead_callback(
+	          write_io_handle );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "write_io_handle->create_ahead_file_descriptor",
+	 write_io_handle->create_ahead_file_descriptor,
+	 -1 );
+
+	result = libewf_write_io_handle_discard_created_ahead(
+	          write_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_io_handle->create_ahead_filename",
+	 write_io_handle->create_ahead_filename );
+
+	result = ewf_test_write_io_handle_get_file_size(
+	          filename,
+	          &file_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "file_size",
+	 (uint64_t) file_size,
+	 (uint64_t) 8 );
+
+	unlink(
+	 filename );
+
+	/* Test if a file that was created ahead is removed on discard
+	 */
+	result = ewf_test_write_io_handle_set_create_ahead(
+	          write_io_handle,
+	          filename,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_write_io_handle_create_ahead_callback(
+	          write_io_handle );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Creating a file ahead is not supported by every platform
+	 */
+	if( write_io_handle->create_ahead_file_descriptor != -1 )
+	{
+		result = ewf_test_write_io_handle_get_file_size(
+		          filename,
+		          &file_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	result = libewf_write_io_handle_discard_created_ahead(
+	          write_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_io_handle->create_ahead_filename",
+	 write_io_handle->create_ahead_filename );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "write_io_handle->create_ahead_file_descriptor",
+	 write_io_handle->create_ahead_file_descriptor,
+	 -1 );
+
+	result = ewf_test_write_io_handle_get_file_size(
+	          filename,
+	          &file_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* Test error cases
+	 */
+	result = libewf_write_io_handle_discard_created_ahead(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_io_handle_create_ahead_callback(
+	          NULL );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* Clean up
+	 */
+	result = libewf_write_io_handle_free(
+	          &write_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+	if( write_io_handle != NULL )
+	{
+		libewf_write_io_handle_free(
+		 &write_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	unlink(
+	 filename );
+
+	return( 0 );
+}
+
+/* Tests the libewf_write_io_handle_create_segment_file function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_io_handle_create_segment_file(
+     void )
+{
+	uint8_t set_identifier[ 16 ];
+	char basename[ 32 ];
+	char segment_filename1[ 64 ];
+	char segment_filename2[ 64 ];
+
+	libbfio_pool_t *file_io_pool              = NULL;
+	libcerror_error_t *error                  = NULL;
+	libewf_io_handle_t *io_handle             = NULL;
+	libewf_segment_file_t *segment_file       = NULL;
+	libewf_segment_table_t *segment_table     = NULL;
+	libewf_write_io_handle_t *write_io_handle = NULL;
+	system_character_t *filename              = NULL;
+	size64_t file_size                        = 0;
+	size_t filename_size                      = 0;
+	ssize_t write_count                       = 0;
+	int file_descriptor                       = -1;
+	int file_io_pool_entry                    = -1;
+	int result                                = 0;
+
+	/* Initialize test
+	 */
+	narrow_string_copy(
+	 basename,
+	 "ewf_test_write_io_handle.XXXXXX",
+	 32 );
+
+	segment_filename1[ 0 ] = 0;
+	segment_filename2[ 0 ] = 0;
+
+	result = memory_set(
+	          set_identifier,
+	          0,
+	          16 ) != NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* The file with the basename reserves a unique basename for the segment files
+	 */
+	file_descriptor = mkstemp(
+	                   basename );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "file_descriptor",
+	 file_descriptor,
+	 -1 );
+
+	close(
+	 file_descriptor );
+
+	file_descriptor = -1;
+
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->format = LIBEWF_FORMAT_ENCASE6;
+
+	result = libewf_write_io_handle_initialize(
+	          &write_io_handle,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "write_io_handle",
+	 write_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_table_initialize(
+	          &segment_table,
+	          io_handle,
+	          EWF_TEST_WRITE_IO_HANDLE_SEGMENT_FILE_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_table",
+	 segment_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_table_set_basename(
+	          segment_table,
+	          basename,
+	          narrow_string_length(
+	           basename ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_initialize(
+	          &file_io_pool,
+	          0,
+	          LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_pool",
+	 file_io_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test if the first segment file is created when it already exists
+	 * and hence could not be created ahead
+	 */
+	result = libewf_filename_create(
+	          &filename,
+	          &filename_size,
+	          basename,
+	          narrow_string_length(
+	           basename ),
+	          1,
+	          EWF_TEST_WRITE_IO_HANDLE_MAXIMUM_NUMBER_OF_SEGMENTS,
+	          LIBEWF_SEGMENT_FILE_TYPE_EWF1,
+	          LIBEWF_FORMAT_ENCASE6,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	narrow_string_copy(
+	 segment_filename1,
+	 filename,
+	 filename_size );
+
+	memory_free(
+	 filename );
+
+	filename = NULL;
+
+	file_descriptor = open(
+	                   segment_filename1,
+	                   O_WRONLY | O_CREAT | O_EXCL,
+	                   0644 );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "file_descriptor",
+	 file_descriptor,
+	 -1 );
+
+	write_count = write(
+	               file_descriptor,
+	               "existing",
+	               8 );
+
+	close(
+	 file_descriptor );
+
+	file_descriptor = -1;
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 8 );
+
+	result = ewf_test_write_io_handle_set_create_ahead(
+	          write_io_handle,
+	          segment_filename1,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_write_io_handle_create_ahead_callback(
+	          write_io_handle );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "write_io_handle->create_ahead_file_descriptor",
+	 write_io_handle->create_ahead_file_descriptor,
+	 -1 );
+
+	result = libewf_write_io_handle_create_segment_file(
+	          write_io_handle,
+	          io_handle,
+	          file_io_pool,
+	          segment_table,
+	          LIBEWF_SEGMENT_FILE_TYPE_EWF1,
+	          0,
+	          EWF_TEST_WRITE_IO_HANDLE_MAXIMUM_NUMBER_OF_SEGMENTS,
+	          set_identifier,
+	          &file_io_pool_entry,
+	          &segment_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_file",
+	 segment_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The segment file is managed by the segment table
+	 */
+	segment_file = NULL;
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_io_handle->create_ahead_filename",
+	 write_io_handle->create_ahead_filename );
+
+	/* The segment file is created normally, which truncates the existing file
+	 */
+	result = ewf_test_write_io_handle_get_file_size(
+	          segment_filename1,
+	          &file_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "file_size",
+	 (uint64_t) file_size,
+	 (uint64_t) 0 );
+
+	/* Test if the second segment file that was created ahead is used without truncating it
+	 */
+	result = libewf_filename_create(
+	          &filename,
+	          &filename_size,
+	          basename,
+	          narrow_string_length(
+	           basename ),
+	          2,
+	          EWF_TEST_WRITE_IO_HANDLE_MAXIMUM_NUMBER_OF_SEGMENTS,
+	          LIBEWF_SEGMENT_FILE_TYPE_EWF1,
+	          LIBEWF_FORMAT_ENCASE6,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	narrow_string_copy(
+	 segment_filename2,
+	 filename,
+	 filename_size );
+
+	memory_free(
+	 filename );
+
+	filename = NULL;
+
+	result = ewf_test_write_io_handle_set_create_ahead(
+	          write_io_handle,
+	          segment_filename2,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_write_io_handle_create_ahead_callback(
+	          write_io_handle );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Creating a file ahead is not supported by every platform
+	 */
+	if( write_io_handle->create_ahead_file_descriptor != -1 )
+	{
+		/* Data written to the file created ahead is lost if the file is truncated
+		 */
+		write_count = write(
+		               write_io_handle->create_ahead_file_descriptor,
+		               "created ahead",
+		               13 );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "write_count",
+		 write_count,
+		 (ssize_t) 13 );
+
+		result = libewf_write_io_handle_create_segment_file(
+		          write_io_handle,
+		          io_handle,
+		          file_io_pool,
+		          segment_table,
+		          LIBEWF_SEGMENT_FILE_TYPE_EWF1,
+		          1,
+		          EWF_TEST_WRITE_IO_HANDLE_MAXIMUM_NUMBER_OF_SEGMENTS,
+		          set_identifier,
+		          &file_io_pool_entry,
+		          &segment_file,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "segment_file",
+		 segment_file );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "segment_file->preallocated_filename",
+		 segment_file->preallocated_filename );
+
+		segment_file = NULL;
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "write_io_handle->create_ahead_filename",
+		 write_io_handle->create_ahead_filename );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "write_io_handle->create_ahead_file_descriptor",
+		 write_io_handle->create_ahead_file_descriptor,
+		 -1 );
+
+		result = ewf_test_write_io_handle_get_file_size(
+		          segment_filename2,
+		          &file_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "file_size",
+		 (uint64_t) file_size,
+		 (uint64_t) 13 );
+	}
+	/* Clean up
+	 */
+	result = ewf_test_close_file_io_pool(
+	          &file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_table_free(
+	          &segment_table,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_write_io_handle_free(
+	          &write_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	unlink(
+	 segment_filename2 );
+
+	unlink(
+	 segment_filename1 );
+
+	unlink(
+	 basename );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+	if( file_io_pool != NULL )
+	{
+		ewf_test_close_file_io_pool(
+		 &file_io_pool,
+		 NULL );
+	}
+	if( segment_table != NULL )
+	{
+		libewf_segment_table_free(
+		 &segment_table,
+		 NULL );
+	}
+	if( write_io_handle != NULL )
+	{
+		libewf_write_io_handle_free(
+		 &write_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	if( segment_filename2[ 0 ] != 0 )
+	{
+		unlink(
+		 segment_filename2 );
+	}
+	if( segment_filename1[ 0 ] != 0 )
+	{
+		unlink(
+		 segment_filename1 );
+	}
+	unlink(
+	 basename );
+
+	return( 0 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) && defined( HAVE_STAT ) && defined( HAVE_UNISTD_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_write_io_handle_initialize",
+	 ewf_test_write_io_handle_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_write_io_handle_free",
+	 ewf_test_write_io_handle_free );
+
+	EWF_TEST_RUN(
+	 "libewf_write_io_handle_clone",
+	 ewf_test_write_io_handle_clone );
+
+	EWF_TEST_RUN(
+	 "libewf_write_io_handle_grab_compression_context",
+	 ewf_test_write_io_handle_grab_compression_context );
+
+	/* TODO: add tests for libewf_write_io_handle_initialize_values */
+
+	/* TODO: add tests for libewf_write_io_handle_initialize_resume */
+
+	/* TODO: add tests for libewf_write_io_handle_resize_table_entries */
+
+	/* TODO: add tests for libewf_write_io_handle_calculate_chunks_per_segment_file */
+
+	/* TODO: add tests for libewf_write_io_handle_calculate_chunks_per_section */
+
+	/* TODO: add tests for libewf_write_io_handle_test_segment_file_full */
+
+	/* TODO: add tests for libewf_write_io_handle_test_chunks_section_full */
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) && defined( HAVE_STAT ) && defined( HAVE_UNISTD_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+	EWF_TEST_RUN(
+	 "libewf_write_io_handle_discard_created_ahead",
+	 ewf_test_write_io_handle_discard_created_ahead );
+
+	EWF_TEST_RUN(
+	 "libewf_write_io_handle_create_segment_file",
+	 ewf_test_write_io_handle_create_segment_file );
 
-	/* TODO: add tests for libewf_write_io_handle_create_segment_file */
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) && defined( HAVE_STAT ) && defined( HAVE_UNISTD_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
 
 	/* TODO: add tests for libewf_write_io_handle_write_chunks_section_start */
 
@@ -7,8 +7,8 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
-LIBRARY_TESTS="access_control_entry analytical_data attribute bit_stream case_data chunk_data chunk_group chunk_table compression data_chunk date_time date_time_values deflate device_information digest_section error error2_section file_entry hash_sections hash_values header_sections header_values huffman_tree io_handle lef_extended_attribute lef_file_entry lef_permission lef_source lef_subject ltree_section md5_hash_section media_values notify permission_group read_io_handle restart_data section_descriptor sector_range segment_file segment_table serialized_string session_section sha1_hash_section single_file_tree single_files source volume_section write_io_handle";
-LIBRARY_TESTS_WITH_INPUT="handle support";
+LIBRARY_TESTS="access_control_entry analytical_data attribute bit_stream case_data checksum chunk_cache chunk_data chunk_group chunk_table compression compression_benchmark compression_context data_chunk date_time date_time_values deflate deflate_benchmark device_information digest_section error error2_section extent file_entry hash_sections hash_values header_sections header_values huffman_tree index_file io_handle io_uring lef_extended_attribute lef_file_entry lef_permission lef_source lef_subject ltree_section md5_hash_section media_values notify pack_pool packed_chunk_index permission_group read_ahead read_io_handle reorder_buffer restart_data section_descriptor sector_range segment_file segment_scanner segment_table serialized_string session_section sha1_hash_section single_file_tree single_files source unpack_pool volume_section write_io_handle";
+LIBRARY_TESTS_WITH_INPUT="handle mmap_file_io_handle read_threads read_threads_benchmark support";
 OPTION_SETS="";
 
 INPUT_GLOB="*.[Ees]*01";
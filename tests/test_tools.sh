@@ -7,7 +7,7 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
-TOOLS_TESTS="byte_size_string device_handle digest_hash guid info_handle platform verification_handle";
+TOOLS_TESTS="byte_size_string device_handle digest_hash guid info_handle platform storage_media_buffer_queue storage_media_buffer_ring storage_media_buffer_ring_benchmark verification_handle";
 TOOLS_TESTS_WITH_INPUT="";
 OPTION_SETS="";
 